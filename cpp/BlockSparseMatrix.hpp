@@ -0,0 +1,283 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <Vector.hpp>
+#include <ThreeMatrix.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+
+/**
+@brief A c++ implementation of a block compressed sparse row (BCSR) matrix with 3x3 blocks
+@details Each stored block is a ThreeMatrix, so that a matrix with one block per pair of coupled nodes, as arises in 3-d elasticity, can be multiplied by a vector of ThreeVector displacements. Matrix-vector products are split between threads by block row ranges that each hold about the same number of blocks. Use BlockSparseMatrixBuilder to assemble a matrix from (block row, block column, ThreeMatrix) triplets.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class BlockSparseMatrix
+{
+private:
+	int _blockRows;
+	int _blockColumns;
+	std::vector<int> _rowStart;
+	std::vector<int> _columnIndex;
+	std::vector<ThreeMatrix> _blocks;
+	std::vector<int> _partition;
+	std::vector<int> _spanFirst;
+	std::vector<int> _spanEnd;
+	std::vector<long> _spanOffset;
+
+	void partition(void)
+	{
+		int TcI;
+		int parts = ThreadPool::instance().size();
+		long count = (long)_blocks.size();
+		_partition.resize(parts + 1);
+		_partition[0] = 0;
+		for (TcI = 1; TcI < parts; TcI++)
+		{
+			long target = count * TcI / parts;
+			_partition[TcI] = (int)(std::lower_bound(_rowStart.begin(),_rowStart.end(),(int)target) - _rowStart.begin());
+			if (_partition[TcI] > _blockRows)
+				_partition[TcI] = _blockRows;
+			if (_partition[TcI] < _partition[TcI - 1])
+				_partition[TcI] = _partition[TcI - 1];
+		}
+		_partition[parts] = _blockRows;
+		// the range of block columns each part touches, and where its share of the scratch for transposeMultiply starts
+		_spanFirst.assign(parts,0);
+		_spanEnd.assign(parts,0);
+		_spanOffset.assign(parts + 1,0);
+		for (TcI = 0; TcI < parts; TcI++)
+		{
+			int first = _blockColumns, end = 0;
+			int TcJ;
+			for (TcJ = _partition[TcI]; TcJ < _partition[TcI + 1]; TcJ++)
+			{
+				if (_rowStart[TcJ + 1] > _rowStart[TcJ])
+				{
+					first = std::min(first,_columnIndex[_rowStart[TcJ]]);
+					end = std::max(end,_columnIndex[_rowStart[TcJ + 1] - 1] + 1);
+				}
+			}
+			_spanFirst[TcI] = end > first ? first : 0;
+			_spanEnd[TcI] = end > first ? end : 0;
+			_spanOffset[TcI + 1] = _spanOffset[TcI] + (_spanEnd[TcI] - _spanFirst[TcI]);
+		}
+	}
+public:
+	BlockSparseMatrix(void)
+	{
+		_blockRows = _blockColumns = 0;
+		_rowStart.assign(1,0);
+		partition();
+	}
+/**
+BlockSparseMatrix constructor from block compressed sparse row arrays. Block column indices within each block row are expected to be in increasing order.
+@param blockRows the number of block rows
+@param blockColumns the number of block columns
+@param rowStart an array of blockRows + 1 offsets; the blocks of block row i are at [rowStart[i], rowStart[i + 1])
+@param columnIndex the block column index of each block
+@param blocks the value of each block
+*/
+	BlockSparseMatrix(int blockRows, int blockColumns, const std::vector<int> & rowStart, const std::vector<int> & columnIndex, const std::vector<ThreeMatrix> & blocks)
+	{
+		_blockRows = blockRows > 0 ? blockRows : 0;
+		_blockColumns = blockColumns > 0 ? blockColumns : 0;
+		if ((int)rowStart.size() == _blockRows + 1 && columnIndex.size() == blocks.size() && rowStart[_blockRows] == (int)blocks.size())
+		{
+			_rowStart = rowStart;
+			_columnIndex = columnIndex;
+			_blocks = blocks;
+		}
+		else
+			_rowStart.assign(_blockRows + 1,0);
+		partition();
+	}
+/**
+Get the number of block rows
+@returns the number of block rows
+*/
+	int blockRows(void) const {return _blockRows;}
+/**
+Get the number of block columns
+@returns the number of block columns
+*/
+	int blockColumns(void) const {return _blockColumns;}
+/**
+Get the number of scalar rows
+@returns three times the number of block rows
+*/
+	int rows(void) const {return _blockRows * 3;}
+/**
+Get the number of scalar columns
+@returns three times the number of block columns
+*/
+	int columns(void) const {return _blockColumns * 3;}
+/**
+Get the number of stored blocks
+@returns the number of stored blocks
+*/
+	int nonzeroBlocks(void) const {return (int)_blocks.size();}
+
+/**
+Retreive the block at the given block row and block column, zero indexed
+@param blockRow the zero indexed block row
+@param blockColumn the zero indexed block column
+@returns the block, or a zero ThreeMatrix if it is not stored or out of range
+*/
+	ThreeMatrix block(int blockRow, int blockColumn) const
+	{
+		if (blockRow >= 0 && blockRow < _blockRows && blockColumn >= 0 && blockColumn < _blockColumns)
+		{
+			std::vector<int>::const_iterator first = _columnIndex.begin() + _rowStart[blockRow];
+			std::vector<int>::const_iterator last = _columnIndex.begin() + _rowStart[blockRow + 1];
+			std::vector<int>::const_iterator found = std::lower_bound(first,last,blockColumn);
+			if (found != last && *found == blockColumn)
+				return _blocks[found - _columnIndex.begin()];
+		}
+		return ThreeMatrix();
+	}
+/**
+Get the diagonal blocks of the matrix
+@returns a vector containing the diagonal blocks, zero where a diagonal block is not stored
+*/
+	std::vector<ThreeMatrix> diagonalBlocks(void) const
+	{
+		int TcI;
+		int count = _blockRows < _blockColumns ? _blockRows : _blockColumns;
+		std::vector<ThreeMatrix> ret(count);
+		for (TcI = 0; TcI < count; TcI++)
+			ret[TcI] = block(TcI,TcI);
+		return ret;
+	}
+
+/**
+Perform a matrix multiplication with a vector of ThreeVectors, \f$\vec{y} = A \vec{x}\f$, into existing storage
+@param vector the vector by which the matrix is multiplied; must have blockColumns() elements
+@param result the vector that receives the product; resized to blockRows() elements
+@returns none
+*/
+	void multiply(const std::vector<ThreeVector> & vector, std::vector<ThreeVector> & result) const
+	{
+		if ((int)vector.size() != _blockColumns)
+			return;
+		LINALG_COUNT(BLOCK_SPARSE_MULTIPLY,18L * nonzeroBlocks(),52L * nonzeroBlocks() + 12L * _blockRows);
+		if ((int)result.size() != _blockRows)
+			result.resize(_blockRows);
+		ThreadPool::instance().run((int)_partition.size() - 1,[&](int part)
+		{
+			int TcI,TcK;
+			for (TcI = _partition[part]; TcI < _partition[part + 1]; TcI++)
+			{
+				ThreeVector sum;
+				for (TcK = _rowStart[TcI]; TcK < _rowStart[TcI + 1]; TcK++)
+					sum += _blocks[TcK] * vector[_columnIndex[TcK]];
+				result[TcI] = sum;
+			}
+		});
+	}
+/**
+Perform a matrix multiplication with a column vector whose elements are grouped in threes, \f$\vec{y} = A \vec{x}\f$, into existing storage. No memory is allocated if result already has the correct size.
+@param vector the Vector by which the matrix is multiplied; must have columns() elements
+@param result the Vector that receives the product; resized to rows() elements
+@returns none
+*/
+	void multiply(const Vector & vector, Vector & result) const
+	{
+		if (vector.size() != columns())
+			return;
+		LINALG_COUNT(BLOCK_SPARSE_MULTIPLY,18L * nonzeroBlocks(),52L * nonzeroBlocks() + 12L * _blockRows);
+		if (result.size() != rows())
+			result.resize(rows());
+		const float * x = vector.data();
+		float * y = result.data();
+		ThreadPool::instance().run((int)_partition.size() - 1,[&](int part)
+		{
+			int TcI,TcK;
+			for (TcI = _partition[part]; TcI < _partition[part + 1]; TcI++)
+			{
+				ThreeVector sum;
+				for (TcK = _rowStart[TcI]; TcK < _rowStart[TcI + 1]; TcK++)
+				{
+					const float * source = x + 3 * _columnIndex[TcK];
+					sum += _blocks[TcK] * ThreeVector(source[0],source[1],source[2]);
+				}
+				y[3 * TcI] = sum.getX();
+				y[3 * TcI + 1] = sum.getY();
+				y[3 * TcI + 2] = sum.getZ();
+			}
+		});
+	}
+/**
+Perform a matrix multiplication with a vector of ThreeVectors
+@param vector the vector by which the matrix is multiplied
+@returns a vector containing the product, or an empty vector if the sizes do not agree
+*/
+	std::vector<ThreeVector> operator *(const std::vector<ThreeVector> & vector) const
+	{
+		std::vector<ThreeVector> ret;
+		if ((int)vector.size() == _blockColumns)
+			multiply(vector,ret);
+		return ret;
+	}
+/**
+Perform a multiplication of the transpose of the matrix with a vector of ThreeVectors, \f$\vec{y} = A^T \vec{x}\f$. Each thread accumulates its share of the block rows into a private buffer that covers only the block columns those rows touch, and the buffers are then summed. When the buffers together would hold more vectors than the matrix has blocks and block columns, the product is accumulated directly on the calling thread instead.
+@param vector the vector by which the transposed matrix is multiplied; must have blockRows() elements
+@param result the vector that receives the product; resized to blockColumns() elements
+@returns none
+*/
+	void transposeMultiply(const std::vector<ThreeVector> & vector, std::vector<ThreeVector> & result) const
+	{
+		int parts = (int)_partition.size() - 1;
+		if ((int)vector.size() != _blockRows)
+			return;
+		long buffered = _spanOffset[parts];
+		bool serial = parts <= 1 || buffered > (long)_blocks.size() + _blockColumns;
+		LINALG_COUNT(BLOCK_SPARSE_MULTIPLY,18L * nonzeroBlocks() + (serial ? 0L : 3L * buffered),52L * nonzeroBlocks() + 12L * _blockColumns + (serial ? 0L : 24L * buffered));
+		result.assign(_blockColumns,ThreeVector());
+		if (serial)
+		{
+			int TcI,TcK;
+			for (TcI = 0; TcI < _blockRows; TcI++)
+			{
+				for (TcK = _rowStart[TcI]; TcK < _rowStart[TcI + 1]; TcK++)
+					result[_columnIndex[TcK]] += _blocks[TcK].transpose() * vector[TcI];
+			}
+			return;
+		}
+		static thread_local std::vector<ThreeVector> scratch;
+		scratch.assign((size_t)buffered,ThreeVector());
+		// thread_local variables are not captured by the lambdas, so the workers must be given the calling thread's buffer
+		ThreeVector * base = scratch.data();
+		ThreadPool & pool = ThreadPool::instance();
+		pool.run(parts,[&](int part)
+		{
+			int TcI,TcK;
+			ThreeVector * buffer = base + _spanOffset[part];
+			int offset = _spanFirst[part];
+			for (TcI = _partition[part]; TcI < _partition[part + 1]; TcI++)
+			{
+				for (TcK = _rowStart[TcI]; TcK < _rowStart[TcI + 1]; TcK++)
+					buffer[_columnIndex[TcK] - offset] += _blocks[TcK].transpose() * vector[TcI];
+			}
+		});
+		pool.parallelFor(0,_blockColumns,1024,[&](long first, long last)
+		{
+			long TcJ;
+			int TcP;
+			for (TcJ = first; TcJ < last; TcJ++)
+			{
+				ThreeVector sum;
+				for (TcP = 0; TcP < parts; TcP++)
+				{
+					if (TcJ >= _spanFirst[TcP] && TcJ < _spanEnd[TcP])
+						sum += base[_spanOffset[TcP] + TcJ - _spanFirst[TcP]];
+				}
+				result[TcJ] = sum;
+			}
+		});
+	}
+};
+
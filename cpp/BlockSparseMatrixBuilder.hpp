@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <BlockSparseMatrix.hpp>
+#include <TripletList.hpp>
+
+/**
+@brief Assembles a BlockSparseMatrix from (block row, block column, ThreeMatrix) triplets
+@details Triplets may be added in any order. Triplets that share a block row and block column are summed, as is usual when assembling finite element matrices. The triplets are kept in a TripletList, which buckets them by row with a counting sort, so that building is linear in the number of triplets apart from the sort of each row by column.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class BlockSparseMatrixBuilder
+{
+private:
+	TripletList<ThreeMatrix> _triplets;
+public:
+/**
+BlockSparseMatrixBuilder constructor
+@param blockRows the number of block rows of the matrix to build
+@param blockColumns the number of block columns of the matrix to build
+*/
+	BlockSparseMatrixBuilder(int blockRows, int blockColumns) : _triplets(blockRows,blockColumns)
+	{
+	}
+/**
+Reserve storage for a number of triplets
+@param count the expected number of triplets
+@returns none
+*/
+	void reserve(int count)
+	{
+		_triplets.reserve(count);
+	}
+/**
+Add a block to the block at the given block row and block column. Triplets outside of the matrix are ignored.
+@param row the zero indexed block row of the block
+@param column the zero indexed block column of the block
+@param value the block to add
+@returns none
+*/
+	void add(int row, int column, const ThreeMatrix & value)
+	{
+		_triplets.add(row,column,value);
+	}
+/**
+Remove all triplets
+@returns none
+*/
+	void clear(void)
+	{
+		_triplets.clear();
+	}
+/**
+Build the sparse matrix
+@returns a BlockSparseMatrix containing the sum of all triplets
+*/
+	BlockSparseMatrix build(void) const
+	{
+		std::vector<int> rowStart;
+		std::vector<int> columnIndex;
+		std::vector<ThreeMatrix> values;
+		_triplets.compress(rowStart,columnIndex,values);
+		return BlockSparseMatrix(_triplets.rows(),_triplets.columns(),rowStart,columnIndex,values);
+	}
+};
+
@@ -0,0 +1,272 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <Matrix.hpp>
+#include <TwoMatrix.hpp>
+#include <ThreeMatrix.hpp>
+
+/**
+@brief A reusable Cholesky factorization \f$A = L L^T\f$ of a symmetric positive definite Matrix
+@details Only the lower triangle of the matrix is referenced. The factorization is computed once by the constructor and may then be used to solve for any number of right hand sides. Large matrices are factored with a blocked right-looking algorithm whose trailing updates are performed with Gemm, restricted to the lower triangle. For 2x2 and 3x3 matrices, solutions, inverses and determinants are obtained from TwoMatrix and ThreeMatrix.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class CholeskyFactorization
+{
+private:
+	static const int BLOCK = 64;
+	int _size;
+	bool _positiveDefinite;
+	double _determinant;
+	Matrix _factor;
+	TwoMatrix _inverse2;
+	ThreeMatrix _inverse3;
+
+	bool factorDiagonal(int first, int last)
+	{
+		int TcI,TcJ,TcK;
+		float * a = _factor.data();
+		for (TcJ = first; TcJ < last; TcJ++)
+		{
+			float * rowJ = a + (size_t)TcJ * _size;
+			double diagonal = rowJ[TcJ];
+			for (TcK = first; TcK < TcJ; TcK++)
+				diagonal -= (double)rowJ[TcK] * rowJ[TcK];
+			if (!(diagonal > 0.0))
+				return false;
+			float root = std::sqrt(diagonal);
+			rowJ[TcJ] = root;
+			_determinant *= diagonal;
+			float invRoot = 1.0 / root;
+			for (TcI = TcJ + 1; TcI < last; TcI++)
+			{
+				float * rowI = a + (size_t)TcI * _size;
+				float sum = rowI[TcJ];
+				for (TcK = first; TcK < TcJ; TcK++)
+					sum -= rowI[TcK] * rowJ[TcK];
+				rowI[TcJ] = sum * invRoot;
+			}
+		}
+		return true;
+	}
+	bool factor(void)
+	{
+		int first,TcI,TcJ;
+		float * a = _factor.data();
+		for (first = 0; first < _size; first += BLOCK)
+		{
+			int last = first + BLOCK < _size ? first + BLOCK : _size;
+			if (!factorDiagonal(first,last))
+				return false;
+			if (last >= _size)
+				break;
+			// L21 = A21 L11^-T, split over the trailing rows
+			ThreadPool::instance().parallelFor(last,_size,32,[&](long rowFirst, long rowLast)
+			{
+				long TcR;
+				int TcC,TcK;
+				for (TcR = rowFirst; TcR < rowLast; TcR++)
+				{
+					float * row = a + TcR * _size;
+					for (TcC = first; TcC < last; TcC++)
+					{
+						const float * diagonalRow = a + (size_t)TcC * _size;
+						float sum = row[TcC];
+						for (TcK = first; TcK < TcC; TcK++)
+							sum -= row[TcK] * diagonalRow[TcK];
+						row[TcC] = sum / diagonalRow[TcC];
+					}
+				}
+			});
+			// A22 -= L21 L21^T, lower triangle only, one block row at a time
+			for (TcI = last; TcI < _size; TcI += BLOCK)
+			{
+				int rows = _size - TcI < BLOCK ? _size - TcI : BLOCK;
+				Gemm::multiply(rows,TcI + rows - last,last - first,-1.0f,a + (size_t)TcI * _size + first,_size,1,a + (size_t)last * _size + first,1,_size,1.0f,a + (size_t)TcI * _size + last,_size);
+			}
+		}
+		for (TcI = 0; TcI < _size; TcI++)
+			for (TcJ = TcI + 1; TcJ < _size; TcJ++)
+				a[(size_t)TcI * _size + TcJ] = 0.0;
+		return true;
+	}
+	void solveInPlace(float * x, int columns) const
+	{
+		const float * a = _factor.data();
+		ThreadPool::instance().parallelFor(0,columns,256,[&](long columnFirst, long columnLast)
+		{
+			int TcI,TcK;
+			long TcJ;
+			for (TcI = 0; TcI < _size; TcI++)
+			{
+				float * row = x + (size_t)TcI * columns;
+				for (TcK = 0; TcK < TcI; TcK++)
+				{
+					float factor = a[(size_t)TcI * _size + TcK];
+					const float * source = x + (size_t)TcK * columns;
+					for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+						row[TcJ] -= factor * source[TcJ];
+				}
+				float invDiagonal = 1.0 / a[(size_t)TcI * _size + TcI];
+				for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+					row[TcJ] *= invDiagonal;
+			}
+			for (TcI = _size - 1; TcI >= 0; TcI--)
+			{
+				float * row = x + (size_t)TcI * columns;
+				float invDiagonal = 1.0 / a[(size_t)TcI * _size + TcI];
+				for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+					row[TcJ] *= invDiagonal;
+				for (TcK = 0; TcK < TcI; TcK++)
+				{
+					float factor = a[(size_t)TcI * _size + TcK];
+					float * target = x + (size_t)TcK * columns;
+					for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+						target[TcJ] -= factor * row[TcJ];
+				}
+			}
+		});
+	}
+public:
+/**
+CholeskyFactorization constructor. Factors the matrix; a matrix that is not square is treated as not positive definite.
+@param matrix the symmetric matrix to factor
+*/
+	CholeskyFactorization(const Matrix & matrix)
+	{
+		int TcI,TcJ;
+		_size = matrix.rows();
+		_positiveDefinite = true;
+		_determinant = 1.0;
+		if (matrix.rows() != matrix.columns())
+		{
+			_size = 0;
+			_positiveDefinite = false;
+			_determinant = 0.0;
+			return;
+		}
+		LINALG_COUNT(CHOLESKY_FACTOR,(long)_size * _size * _size / 3 + _size,8L * _size * _size);
+		_factor = matrix;
+		_positiveDefinite = factor();
+		if (_positiveDefinite && _size == 2)
+		{
+			TwoMatrix small;
+			for (TcI = 0; TcI < 2; TcI++)
+				for (TcJ = 0; TcJ <= TcI; TcJ++)
+				{
+					small.setAt(TcI,TcJ,matrix.at(TcI,TcJ));
+					small.setAt(TcJ,TcI,matrix.at(TcI,TcJ));
+				}
+			_determinant = small.determinant();
+			_inverse2 = small.invert();
+		}
+		else if (_positiveDefinite && _size == 3)
+		{
+			ThreeMatrix small;
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ <= TcI; TcJ++)
+				{
+					small.setAt(TcI,TcJ,matrix.at(TcI,TcJ));
+					small.setAt(TcJ,TcI,matrix.at(TcI,TcJ));
+				}
+			_determinant = small.determinant();
+			_inverse3 = small.invert();
+		}
+		if (!_positiveDefinite)
+			_determinant = 0.0;
+	}
+/**
+Get the order of the factored matrix
+@returns the number of rows (and columns) of the matrix
+*/
+	int size(void) const {return _size;}
+/**
+Determine if the factored matrix is positive definite
+@returns true if the factorization succeeded; if false, solve and inverse return zeros
+*/
+	bool positiveDefinite(void) const {return _positiveDefinite;}
+/**
+Get the lower triangular factor L
+@returns A new Matrix containing L, with zeros above the diagonal
+*/
+	Matrix lower(void) const
+	{
+		if (!_positiveDefinite)
+			return Matrix(_size,_size);
+		return _factor;
+	}
+/**
+Get the determinant of the matrix
+@returns The determinant of the matrix, or zero if it is not positive definite
+*/
+	float determinant(void) const
+	{
+		return (float)_determinant;
+	}
+/**
+Solve for several right hand sides at once: \f$A X = B\f$. The right hand sides are processed together, with the columns split between threads.
+@param rhs a Matrix with one right hand side per column
+@returns the solutions, one per column; a zero Matrix if the matrix is not positive definite; an empty Matrix if the number of rows of rhs does not match
+*/
+	Matrix solve(const Matrix & rhs) const
+	{
+		int TcI,TcJ;
+		int columns = rhs.columns();
+		if (rhs.rows() != _size)
+			return Matrix();
+		Matrix ret(_size,columns);
+		if (!_positiveDefinite)
+			return ret;
+		LINALG_COUNT(CHOLESKY_SOLVE,2L * _size * _size * columns,4L * _size * _size + 8L * _size * columns);
+		if (_size == 2)
+		{
+			for (TcJ = 0; TcJ < columns; TcJ++)
+			{
+				TwoVector x = _inverse2 * TwoVector(rhs.at(0,TcJ),rhs.at(1,TcJ));
+				for (TcI = 0; TcI < 2; TcI++)
+					ret.setAt(TcI,TcJ,x[TcI]);
+			}
+		}
+		else if (_size == 3)
+		{
+			for (TcJ = 0; TcJ < columns; TcJ++)
+			{
+				ThreeVector x = _inverse3 * ThreeVector(rhs.at(0,TcJ),rhs.at(1,TcJ),rhs.at(2,TcJ));
+				for (TcI = 0; TcI < 3; TcI++)
+					ret.setAt(TcI,TcJ,x[TcI]);
+			}
+		}
+		else
+		{
+			ret = rhs;
+			solveInPlace(ret.data(),columns);
+		}
+		return ret;
+	}
+/**
+Solve \f$A \vec{x} = \vec{b}\f$
+@param rhs the right hand side
+@returns the solution; a zero Vector if the matrix is not positive definite; an empty Vector if the size of rhs does not match
+*/
+	Vector solve(const Vector & rhs) const
+	{
+		if (rhs.size() != _size)
+			return Vector();
+		Matrix x = solve(Matrix(_size,1,rhs.data()));
+		return Vector(_size,x.data());
+	}
+/**
+Get the inverse of the matrix
+@returns A new Matrix containing the multiplicitave inverse, or a zero Matrix if the matrix is not positive definite
+*/
+	Matrix inverse(void) const
+	{
+		Matrix identity(_size,_size);
+		identity.loadIdentity();
+		return solve(identity);
+	}
+};
+
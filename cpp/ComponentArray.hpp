@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+/**
+@brief The storage of one component of a structure of arrays: a contiguous array of floats that either owns its memory or refers, read only, to memory owned by something else
+@details An array that refers to other memory, such as a section of a mapped ArrayFile, is used by the kernels exactly as one that owns its memory, without the data being copied. Its first modification (any non-const access to its elements, or a resize) copies the data into memory of its own, so the memory it refers to is never written; until then, that memory must outlive it. Copies of a referring array refer to the same memory.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ComponentArray
+{
+private:
+	std::vector<float> _owned;
+	const float * _shared;
+	size_t _sharedSize;
+
+	// copies the memory referred to, if any, so that the array may be modified
+	void own(void)
+	{
+		if (_shared != nullptr)
+		{
+			_owned.assign(_shared,_shared + _sharedSize);
+			_shared = nullptr;
+			_sharedSize = 0;
+		}
+	}
+public:
+	ComponentArray(void)
+	{
+		_shared = nullptr;
+		_sharedSize = 0;
+	}
+/**
+Get the number of elements
+@returns the number of floats in the array
+*/
+	size_t size(void) const {return _shared != nullptr ? _sharedSize : _owned.size();}
+/**
+Change the number of elements, copying the memory referred to first if there is any
+@param size the new number of elements
+@param value the value of any new elements
+@returns none
+*/
+	void resize(size_t size, float value)
+	{
+		own();
+		_owned.resize(size,value);
+	}
+/**
+Refer to existing memory instead of owning the elements. Any elements the array owned are released.
+@param data the first of size floats, which must remain valid and unchanged while the array refers to them
+@param size the number of elements
+@returns none
+*/
+	void share(const float * data, size_t size)
+	{
+		std::vector<float>().swap(_owned);
+		_shared = size > 0 ? data : nullptr;
+		_sharedSize = size > 0 ? size : 0;
+	}
+/**
+Determine if the array refers to memory it does not own
+@returns true until the array is first modified after share()
+*/
+	bool shared(void) const {return _shared != nullptr;}
+/**
+Get direct access to the elements for writing, copying the memory referred to first if there is any
+@returns A pointer to the first element
+*/
+	float * data(void)
+	{
+		own();
+		return _owned.data();
+	}
+/**
+Get direct access to the elements
+@returns A pointer to the first element
+*/
+	const float * data(void) const {return _shared != nullptr ? _shared : _owned.data();}
+	float & operator[] (size_t idx)
+	{
+		own();
+		return _owned[idx];
+	}
+	float operator[] (size_t idx) const
+	{
+		return data()[idx];
+	}
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <cmath>
+#include <Vector.hpp>
+#include <VectorKernels.hpp>
+#include <SolverTelemetry.hpp>
+/**
+@brief A preconditioned conjugate gradient solver for symmetric positive definite systems
+@details The solver is matrix-free: the operator may be any type providing rows() and multiply(const Vector & x, Vector & y), such as SparseMatrix or BlockSparseMatrix, and the preconditioner any type providing apply(const Vector & r, Vector & z) returning \f$\vec{r}\bullet\vec{z}\f$, such as JacobiPreconditioner, BlockJacobiPreconditioner or IdentityPreconditioner. Work vectors are kept between solves, so that after the first solve of a given size no memory is allocated.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ConjugateGradient
+{
+private:
+	int _maxIterations;
+	float _tolerance;
+	Vector _residual;
+	Vector _preconditioned;
+	Vector _direction;
+	Vector _product;
+	SolverTelemetry _telemetry;
+public:
+/**
+ConjugateGradient constructor
+@param maxIterations the maximum number of iterations per solve
+@param tolerance the relative residual norm \f$\|\vec{r}\| / \|\vec{b}\|\f$ at which to stop
+*/
+	ConjugateGradient(int maxIterations = 1000, float tolerance = 1.0e-6)
+	{
+		_maxIterations = maxIterations;
+		_tolerance = tolerance;
+	}
+/**
+Get the residual and timing history of the last solve
+@returns the telemetry
+*/
+	const SolverTelemetry & telemetry(void) const {return _telemetry;}
+
+/**
+Solve \f$A \vec{x} = \vec{b}\f$
+@param op the operator A
+@param preconditioner the preconditioner
+@param rhs the right hand side b
+@param solution on input the initial guess; on output the solution. If the size does not match, the initial guess is zero.
+@returns true if the tolerance was reached
+*/
+	template <typename Operator, typename Preconditioner> bool solve(const Operator & op, const Preconditioner & preconditioner, const Vector & rhs, Vector & solution)
+	{
+		int TcI;
+		int size = op.rows();
+		if (rhs.size() != size)
+			return false;
+		if (solution.size() != size)
+		{
+			solution.resize(size);
+			solution.loadZero();
+		}
+		_residual.resize(size);
+		_preconditioned.resize(size);
+		_direction.resize(size);
+		_product.resize(size);
+		_telemetry.start(_maxIterations);
+
+		double rhsNorm = std::sqrt(VectorKernels::dot(rhs,rhs));
+		if (rhsNorm == 0.0)
+			rhsNorm = 1.0;
+		op.multiply(solution,_product);
+		double residualNorm = std::sqrt(VectorKernels::addScaledNorm(rhs,-1.0f,_product,_residual));
+		_telemetry.record(residualNorm / rhsNorm);
+		if (residualNorm / rhsNorm <= _tolerance)
+		{
+			_telemetry.finish(true);
+			return true;
+		}
+		double rz = preconditioner.apply(_residual,_preconditioned);
+		_direction = _preconditioned;
+		for (TcI = 0; TcI < _maxIterations; TcI++)
+		{
+			op.multiply(_direction,_product);
+			double pq = VectorKernels::dot(_direction,_product);
+			if (pq <= 0.0)
+				break;
+			float alpha = rz / pq;
+			residualNorm = std::sqrt(VectorKernels::stepNorm(alpha,_direction,_product,solution,_residual));
+			_telemetry.record(residualNorm / rhsNorm);
+			if (residualNorm / rhsNorm <= _tolerance)
+			{
+				_telemetry.finish(true);
+				return true;
+			}
+			double rzNew = preconditioner.apply(_residual,_preconditioned);
+			VectorKernels::scaleAdd(_preconditioned,rzNew / rz,_direction);
+			rz = rzNew;
+		}
+		_telemetry.finish(false);
+		return false;
+	}
+};
+
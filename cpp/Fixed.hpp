@@ -0,0 +1,274 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+/**
+@brief A Q16.16 fixed-point number: a 32 bit integer counting units of \f$2^{-16}\f$
+@details Every operation has an exactly defined integer result, so the same inputs give bit-identical results on every compiler, platform and optimization level, with or without SIMD or fused multiply-add, which float arithmetic does not guarantee; this is what a lockstep simulation, which replays the same inputs on every machine, needs. The range is \f$[-32768, 32768)\f$ with a resolution of \f$2^{-16} \approx 1.5 \times 10^{-5}\f$. Results that do not fit wrap around, as integers do, except for conversions from float, division by zero and vector lengths, which saturate.
+
+Products are formed exactly in 64 bits and rounded once to the nearest unit, with halves rounded up; sums of products, as in a dot product or a matrix product, are accumulated exactly and rounded once. Division rounds to the nearest unit, with halves rounded away from zero. The static helpers on raw values are the building blocks of the fixed-point vectors, matrices and batch kernels.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class Fixed
+{
+public:
+	static const int FRACTION_BITS = 16;
+	static const std::int32_t ONE = 1 << FRACTION_BITS;
+	static const std::int32_t MAXIMUM = 0x7FFFFFFF;
+	static const std::int32_t MINIMUM = -0x7FFFFFFF - 1;
+private:
+	std::int32_t _raw;
+public:
+	Fixed(void)
+	{
+		_raw = 0;
+	}
+/**
+Fixed constructor
+@param value an integer, which wraps if outside the range
+*/
+	explicit Fixed(int value)
+	{
+		_raw = (std::int32_t)((std::uint32_t)value << FRACTION_BITS);
+	}
+/**
+Create a number from its raw value
+@param raw the value in units of \f$2^{-16}\f$
+@returns the number
+*/
+	static Fixed fromRaw(std::int32_t raw)
+	{
+		Fixed ret;
+		ret._raw = raw;
+		return ret;
+	}
+/**
+Create a number from a float, rounded to the nearest unit with halves rounded up. The conversion is exact arithmetic on the float, so it gives the same result everywhere.
+@param value the float; values outside the range saturate and NaN becomes zero
+@returns the number
+*/
+	static Fixed fromFloat(float value)
+	{
+		return fromRaw(rawFromFloat(value));
+	}
+/**
+Get the raw value
+@returns the value in units of \f$2^{-16}\f$
+*/
+	std::int32_t raw(void) const {return _raw;}
+/**
+Convert to a float
+@returns the nearest float, for display or for use outside the deterministic part of a program
+*/
+	float toFloat(void) const {return (float)_raw * (1.0f / ONE);}
+
+	Fixed operator +(const Fixed & value) const {return fromRaw(add(_raw,value._raw));}
+	Fixed operator -(const Fixed & value) const {return fromRaw(add(_raw,negate(value._raw)));}
+	Fixed operator -(void) const {return fromRaw(negate(_raw));}
+	Fixed operator *(const Fixed & value) const {return fromRaw(round(product(_raw,value._raw)));}
+	Fixed operator /(const Fixed & value) const {return fromRaw(divide(product(_raw,ONE),value._raw));}
+	Fixed & operator +=(const Fixed & value) {return *this = *this + value;}
+	Fixed & operator -=(const Fixed & value) {return *this = *this - value;}
+	Fixed & operator *=(const Fixed & value) {return *this = *this * value;}
+	Fixed & operator /=(const Fixed & value) {return *this = *this / value;}
+	bool operator ==(const Fixed & value) const {return _raw == value._raw;}
+	bool operator !=(const Fixed & value) const {return _raw != value._raw;}
+	bool operator <(const Fixed & value) const {return _raw < value._raw;}
+	bool operator <=(const Fixed & value) const {return _raw <= value._raw;}
+	bool operator >(const Fixed & value) const {return _raw > value._raw;}
+	bool operator >=(const Fixed & value) const {return _raw >= value._raw;}
+/**
+Get the square root, rounded down to a unit
+@returns the square root, or zero for a negative number
+*/
+	Fixed sqrt(void) const
+	{
+		return fromRaw(_raw > 0 ? (std::int32_t)squareRoot((std::uint64_t)_raw << FRACTION_BITS) : 0);
+	}
+/**
+Get the absolute value
+@returns the absolute value; the most negative number wraps to itself
+*/
+	Fixed abs(void) const {return _raw < 0 ? -*this : *this;}
+
+/**
+Convert a float to a raw value, rounded to the nearest unit with halves rounded up. A float scaled by \f$2^{16}\f$ and offset by one half is exact in double precision, so the single rounding is the floor, and the result does not depend on how the arithmetic is contracted or vectorized or on the precision of intermediate results.
+@param value the float; values outside the range saturate and NaN becomes zero
+@returns the raw value
+*/
+	static std::int32_t rawFromFloat(float value)
+	{
+		double scaled = std::floor((double)value * ONE + 0.5);
+		scaled = scaled == scaled ? scaled : 0.0;
+		scaled = scaled < (double)MAXIMUM ? scaled : (double)MAXIMUM;
+		scaled = scaled > (double)MINIMUM ? scaled : (double)MINIMUM;
+		return (std::int32_t)scaled;
+	}
+/**
+Add two raw values, wrapping on overflow
+@param a the first value
+@param b the second value
+@returns the raw sum
+*/
+	static std::int32_t add(std::int32_t a, std::int32_t b)
+	{
+		return (std::int32_t)((std::uint32_t)a + (std::uint32_t)b);
+	}
+/**
+Negate a raw value, wrapping on overflow
+@param a the value
+@returns the raw negation
+*/
+	static std::int32_t negate(std::int32_t a)
+	{
+		return (std::int32_t)(0u - (std::uint32_t)a);
+	}
+/**
+Form the exact product of two raw values, in units of \f$2^{-32}\f$. Products may be added and subtracted as unsigned 64 bit integers, which wrap, before a single call to round.
+@param a the first value
+@param b the second value
+@returns the product, as the bits of a 64 bit two's complement integer
+*/
+	static std::uint64_t product(std::int32_t a, std::int32_t b)
+	{
+		return (std::uint64_t)((std::int64_t)a * (std::int64_t)b);
+	}
+/**
+Round a product or sum of products to a raw value, to the nearest unit with halves rounded up
+@param value the product, in units of \f$2^{-32}\f$
+@returns the raw value, wrapped to 32 bits
+*/
+	static std::int32_t round(std::uint64_t value)
+	{
+		return (std::int32_t)(std::uint32_t)((value + (1ULL << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+	}
+/**
+Divide a product by a raw value, rounding to the nearest unit with halves rounded away from zero
+@param numerator the dividend, in units of \f$2^{-32}\f$ as returned by product
+@param denominator the raw divisor
+@returns the raw quotient, wrapped to 32 bits, or the largest or smallest value if the divisor is zero
+*/
+	static std::int32_t divide(std::uint64_t numerator, std::int32_t denominator)
+	{
+		std::int64_t dividend = (std::int64_t)numerator;
+		if (denominator == 0)
+			return dividend >= 0 ? MAXIMUM : MINIMUM;
+		// the dividend is at most 2^62 in magnitude, so adding half the divisor cannot overflow
+		std::int64_t half = (denominator > 0 ? (std::int64_t)denominator : -(std::int64_t)denominator) / 2;
+		std::int64_t quotient = (dividend >= 0 ? dividend + half : dividend - half) / denominator;
+		return (std::int32_t)(std::uint32_t)(std::uint64_t)quotient;
+	}
+/**
+Form the exact sum of up to three products, which can exceed 64 bits, as a sign and a magnitude
+@param products the products, in units of \f$2^{-32}\f$ as returned by product
+@param count the number of products, at most three
+@param negative set to whether the sum is negative
+@returns the magnitude of the sum, in units of \f$2^{-32}\f$
+*/
+	static std::uint64_t sumMagnitude(const std::uint64_t * products, int count, bool & negative)
+	{
+		int TcI;
+		// each product is at most 2^62 in magnitude, so the sum of the quarters fits, and the remainders are carried into it
+		std::int64_t quarters = 0;
+		std::int64_t remainder = 0;
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			quarters += (std::int64_t)products[TcI] >> 2;
+			remainder += (std::int64_t)(products[TcI] & 3);
+		}
+		quarters += remainder >> 2;
+		remainder &= 3;
+		negative = quarters < 0;
+		if (negative)
+			return ((std::uint64_t)0 - (std::uint64_t)quarters) * 4 - (std::uint64_t)remainder;
+		return (std::uint64_t)quarters * 4 + (std::uint64_t)remainder;
+	}
+/**
+Divide a raw value by a sum of products given as a sign and a magnitude, rounding to the nearest unit with halves rounded away from zero; the dividend scaled by \f$2^{32}\f$ fits in 64 bits, so the quotient is formed exactly and rounded once
+@param numerator the raw dividend
+@param magnitude the magnitude of the divisor, in units of \f$2^{-32}\f$ as returned by sumMagnitude
+@param negative whether the divisor is negative
+@returns the raw quotient, saturated to the largest or smallest value if it is out of range or the divisor is zero
+*/
+	static std::int32_t divideBySum(std::int32_t numerator, std::uint64_t magnitude, bool negative)
+	{
+		bool sign = (numerator < 0) != negative;
+		std::uint64_t dividend = (numerator < 0 ? (std::uint64_t)0 - (std::uint64_t)(std::int64_t)numerator : (std::uint64_t)numerator) << 32;
+		if (magnitude == 0)
+			return numerator < 0 ? MINIMUM : MAXIMUM;
+		std::uint64_t quotient = dividend / magnitude;
+		std::uint64_t remainder = dividend % magnitude;
+		quotient += remainder >= magnitude - remainder ? 1 : 0;
+		if (sign)
+			return quotient > (std::uint64_t)MAXIMUM + 1 ? MINIMUM : (std::int32_t)(std::uint32_t)((std::uint64_t)0 - quotient);
+		return quotient > (std::uint64_t)MAXIMUM ? MAXIMUM : (std::int32_t)quotient;
+	}
+/**
+Compute the integer square root, the largest r with \f$r^2 \le n\f$. A double precision square root is within one of r for any n, whatever the rounding of the platform, and the two integer corrections that follow make the result exact, so it is the same everywhere; this is several times faster than finding r one bit at a time.
+@param value n
+@returns r
+*/
+	static std::uint32_t squareRoot(std::uint64_t value)
+	{
+		std::uint64_t root = (std::uint64_t)std::sqrt((double)value);
+		// clamping first keeps both squares below 2^64
+		root = root < 0xFFFFFFFFULL ? root : 0xFFFFFFFFULL;
+		root -= root * root > value ? 1 : 0;
+		root += root < 0xFFFFFFFFULL && (root + 1) * (root + 1) <= value ? 1 : 0;
+		return (std::uint32_t)root;
+	}
+/**
+Compute the length of a vector from the sum of the squares of its raw components
+@param squares the sum of squares, in units of \f$2^{-32}\f$; at most three squares, so it cannot overflow
+@returns the raw length, saturated to the largest value
+*/
+	static std::int32_t length(std::uint64_t squares)
+	{
+		std::uint32_t root = squareRoot(squares);
+		return root > (std::uint32_t)MAXIMUM ? MAXIMUM : (std::int32_t)root;
+	}
+/**
+Compute the length of a vector as length does, with only operations that AVX2 has, so that a loop of lengths vectorizes. The sum is converted to double in two 32 bit halves, since there is no SIMD conversion from 64 bit integers, and the root is estimated in double and corrected in integers as in squareRoot. Like every square root, it only vectorizes when the math functions are not required to set errno (-fno-math-errno). Without AVX2 the 64 bit comparisons are emulated at more cost than the vectorization saves, so this is length.
+@param squares the sum of squares, in units of \f$2^{-32}\f$; at most three squares
+@returns the raw length, saturated to the largest value; the same as length
+*/
+	static std::int32_t batchLength(std::uint64_t squares)
+	{
+#ifdef __AVX2__
+		// the halves convert exactly, and their sum is rounded once, as the conversion in squareRoot is
+		double value = (double)(std::uint32_t)(squares >> 32) * 4294967296.0 + (double)(std::uint32_t)squares;
+		std::uint64_t root = (std::uint32_t)std::sqrt(value);
+		root -= root * root > squares ? 1 : 0;
+		root += (root + 1) * (root + 1) <= squares ? 1 : 0;
+		return root > (std::uint64_t)MAXIMUM ? MAXIMUM : (std::int32_t)root;
+#else
+		return length(squares);
+#endif
+	}
+/**
+Divide a component of a vector by the length of the vector, as divide(product(component, ONE), length), with only operations that AVX2 has, so that a loop of them vectorizes. The quotient is estimated to within one with the reciprocal of the length, which is shared by the components of a vector, and corrected. Without AVX2 this is divide.
+@param component the raw component, at most twice the length in magnitude, as in a unit vector
+@param length the raw length; must be positive
+@param reciprocal 1.0 / length
+@returns the raw quotient, the same as divide
+*/
+	static std::int32_t batchUnitDivide(std::int32_t component, std::int32_t length, double reciprocal)
+	{
+#ifdef __AVX2__
+		// the dividend is below 2^49, and so are the products of the divisor and a quotient below 2^18, so the correction is exact in double, without 64 bit integer multiplication
+		double dividend = std::fabs((double)component) * ONE + (double)(length / 2);
+		double divisor = (double)length;
+		std::int32_t quotient = (std::int32_t)(dividend * reciprocal);
+		double product = (double)quotient * divisor;
+		quotient -= product > dividend ? 1 : 0;
+		quotient += product + divisor <= dividend ? 1 : 0;
+		return component < 0 ? negate(quotient) : quotient;
+#else
+		(void)reciprocal;
+		return divide(product(component,ONE),length);
+#endif
+	}
+};
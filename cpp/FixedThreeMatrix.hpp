@@ -0,0 +1,403 @@
+#pragma once
+#include <FixedThreeVector.hpp>
+#include <ThreeMatrix.hpp>
+/**
+@brief A 3x3 matrix of Q16.16 fixed-point elements, with the interface of ThreeMatrix
+@details Every operation gives bit-identical results everywhere; see Fixed. Each element of a product is a sum of exact products rounded once. The determinant and the inverse are built from cofactors, each rounded once. The inverse divides each cofactor by the determinant before the determinant is rounded, with one rounding per element, so that a small determinant does not lose precision; its error comes from the rounding of the cofactors and of the divisions. The determinant is within \f$(1 + |a_{00}| + |a_{01}| + |a_{02}|) / 2\f$ units of the exact one, and an element of the inverse within half a unit plus \f$(1 + m (1 + |a_{00}| + |a_{01}| + |a_{02}|)) / (2|\det A|)\f$ units, for m the largest element of the exact inverse. Rotations are loaded from a given cosine and sine, so that the caller decides how those are computed deterministically, for example from a table.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedThreeMatrix
+{
+private:
+	Fixed _data[3][3];
+
+	// the cofactor of an element: the signed determinant of the 2x2 minor left by removing its row and column, rounded once
+	Fixed cofactor(int row, int column) const
+	{
+		int r0 = row == 0 ? 1 : 0;
+		int r1 = row == 2 ? 1 : 2;
+		int c0 = column == 0 ? 1 : 0;
+		int c1 = column == 2 ? 1 : 2;
+		std::uint64_t minor = Fixed::product(_data[r0][c0].raw(),_data[r1][c1].raw()) - Fixed::product(_data[r0][c1].raw(),_data[r1][c0].raw());
+		Fixed ret = Fixed::fromRaw(Fixed::round(minor));
+		return ((row + column) & 1) != 0 ? -ret : ret;
+	}
+public:
+	FixedThreeMatrix(void)
+	{
+	}
+/**
+FixedThreeMatrix constructor
+@param matrix A ThreeMatrix, with each element rounded to the nearest unit
+*/
+	explicit FixedThreeMatrix(const ThreeMatrix & matrix)
+	{
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				_data[TcI][TcJ] = Fixed::fromFloat(matrix.at(TcI,TcJ));
+			}
+		}
+	}
+/**
+Convert to a ThreeMatrix
+@returns the nearest ThreeMatrix
+*/
+	ThreeMatrix toFloat(void) const
+	{
+		ThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret.setAt(TcI,TcJ,_data[TcI][TcJ].toFloat());
+			}
+		}
+		return ret;
+	}
+/**
+Retreive the value of the element at the given row and column, zero indexed
+@param row the zero indexed row from which to retrieve an element
+@param column the zero indexed column from which to retrieve an element
+@returns the value at the selected row and column, zero otherwise
+*/
+	Fixed at(int row, int column) const
+	{
+		if (row >= 0 && row < 3 && column >= 0 && column < 3)
+			return _data[row][column];
+		else
+			return Fixed();
+	}
+/**
+Set the value of the element at the given row and column, zero indexed
+@param row the zero indexed row from which to set an element
+@param column the zero indexed column from which to set an element
+@param value the value to insert into the matrix.
+*/
+	void setAt(int row, int column, const Fixed & value)
+	{
+		if (row >= 0 && row < 3 && column >= 0 && column < 3)
+			_data[row][column] = value;
+	}
+/**
+Set the values of the elements in the given column, zero indexed
+@param column the zero indexed column in which to set the elements
+@param value the values to insert into the matrix.
+*/
+	void setColumn(int column, const FixedThreeVector & value)
+	{
+		if (column >= 0 && column < 3)
+		{
+			_data[0][column] = value._x;
+			_data[1][column] = value._y;
+			_data[2][column] = value._z;
+		}
+	}
+/**
+Set the values of the elements in the given row, zero indexed
+@param row the zero indexed row in which to set the elements
+@param value the values to insert into the matrix.
+*/
+	void setRow(int row, const FixedThreeVector & value)
+	{
+		if (row >= 0 && row < 3)
+		{
+			_data[row][0] = value._x;
+			_data[row][1] = value._y;
+			_data[row][2] = value._z;
+		}
+	}
+/**
+Retrieve a row vector for a given row
+@param rowNum the zero indexed row from which to retrieve
+@returns If row is a valid index, then a FixedThreeVector containing the row data, otherwise the zero vector
+*/
+	FixedThreeVector row(int rowNum) const
+	{
+		if (rowNum >= 0 && rowNum < 3)
+			return FixedThreeVector(_data[rowNum][0],_data[rowNum][1],_data[rowNum][2]);
+		else
+			return FixedThreeVector();
+	}
+/**
+Retrieve a column vector for a given column
+@param columnNum the zero indexed column from which to retrieve
+@returns If column is a valid index, then a FixedThreeVector containing the column data, otherwise the zero vector
+*/
+	FixedThreeVector column(int columnNum) const
+	{
+		if (columnNum >= 0 && columnNum < 3)
+			return FixedThreeVector(_data[0][columnNum],_data[1][columnNum],_data[2][columnNum]);
+		else
+			return FixedThreeVector();
+	}
+
+/**
+Perform a matrix multiplication with a column vector, rounding each component once
+@param vector the FixedThreeVector by which the matrix is multiplied
+@returns the transformed vector
+*/
+	FixedThreeVector operator *(const FixedThreeVector & vector) const
+	{
+		Fixed result[3];
+		int TcI;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			result[TcI] = Fixed::fromRaw(Fixed::round(Fixed::product(_data[TcI][0].raw(),vector._x.raw()) + Fixed::product(_data[TcI][1].raw(),vector._y.raw()) + Fixed::product(_data[TcI][2].raw(),vector._z.raw())));
+		}
+		return FixedThreeVector(result[0],result[1],result[2]);
+	}
+/**
+Perform a scalar multiplication of the matrix
+@param scalar the factor by which the matrix is multiplied
+@returns a new FixedThreeMatrix containing the result of the multiplication
+*/
+	FixedThreeMatrix operator *(const Fixed & scalar) const
+	{
+		FixedThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcI][TcJ] * scalar;
+			}
+		}
+		return ret;
+	}
+/**
+Perform a matrix multiplication with a FixedThreeMatrix, rounding each element once
+@param matrix the FixedThreeMatrix by which the matrix is multiplied
+@returns a new FixedThreeMatrix containing the result of the multiplication
+*/
+	FixedThreeMatrix operator *(const FixedThreeMatrix & matrix) const
+	{
+		FixedThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret._data[TcI][TcJ] = Fixed::fromRaw(Fixed::round(Fixed::product(_data[TcI][0].raw(),matrix._data[0][TcJ].raw()) + Fixed::product(_data[TcI][1].raw(),matrix._data[1][TcJ].raw()) + Fixed::product(_data[TcI][2].raw(),matrix._data[2][TcJ].raw())));
+			}
+		}
+		return ret;
+	}
+/**
+Add two matrices
+@param matrix the FixedThreeMatrix to add to this matrix
+@returns a new FixedThreeMatrix containing the sum
+*/
+	FixedThreeMatrix operator +(const FixedThreeMatrix & matrix) const
+	{
+		FixedThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcI][TcJ] + matrix._data[TcI][TcJ];
+			}
+		}
+		return ret;
+	}
+/**
+Subtract one matrix from another
+@param matrix the FixedThreeMatrix to subtract from this matrix
+@returns a new FixedThreeMatrix containing the difference
+*/
+	FixedThreeMatrix operator -(const FixedThreeMatrix & matrix) const
+	{
+		FixedThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcI][TcJ] - matrix._data[TcI][TcJ];
+			}
+		}
+		return ret;
+	}
+/**
+Get the transpose of the matrix
+@returns a new FixedThreeMatrix containing the transpose
+*/
+	FixedThreeMatrix transpose(void) const
+	{
+		FixedThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcJ][TcI];
+			}
+		}
+		return ret;
+	}
+/**
+Get the additive inverse of the matrix
+@returns a new FixedThreeMatrix containing the additive inverse
+*/
+	FixedThreeMatrix operator -(void) const
+	{
+		FixedThreeMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				ret._data[TcI][TcJ] = -_data[TcI][TcJ];
+			}
+		}
+		return ret;
+	}
+	bool operator ==(const FixedThreeMatrix & matrix) const
+	{
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				if (_data[TcI][TcJ] != matrix._data[TcI][TcJ])
+					return false;
+			}
+		}
+		return true;
+	}
+	bool operator !=(const FixedThreeMatrix & matrix) const
+	{
+		return !(*this == matrix);
+	}
+/**
+Get the determinant of the matrix, expanded along the first row with rounded cofactors
+@returns The determinant of the matrix
+*/
+	Fixed determinant(void) const
+	{
+		return Fixed::fromRaw(Fixed::round(Fixed::product(_data[0][0].raw(),cofactor(0,0).raw()) + Fixed::product(_data[0][1].raw(),cofactor(0,1).raw()) + Fixed::product(_data[0][2].raw(),cofactor(0,2).raw())));
+	}
+/**
+Get the trace of the matrix
+@returns The trace of the matrix
+*/
+	Fixed trace(void) const
+	{
+		return _data[0][0] + _data[1][1] + _data[2][2];
+	}
+/**
+Get the inverse of the matrix, the transposed cofactors each divided by the exact sum of products that forms the determinant and rounded once
+@returns A new FixedThreeMatrix containing the multiplicative inverse, with elements outside the range saturated, or the zero matrix if that sum is zero
+*/
+	FixedThreeMatrix invert(void) const
+	{
+		FixedThreeMatrix ret;
+		Fixed cofactors[3][3];
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				cofactors[TcI][TcJ] = cofactor(TcI,TcJ);
+			}
+		}
+		std::uint64_t products[3];
+		bool negative;
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			products[TcJ] = Fixed::product(_data[0][TcJ].raw(),cofactors[0][TcJ].raw());
+		}
+		std::uint64_t det = Fixed::sumMagnitude(products,3,negative);
+		if (det != 0)
+		{
+			for (TcI = 0; TcI < 3; TcI++)
+			{
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					ret._data[TcI][TcJ] = Fixed::fromRaw(Fixed::divideBySum(cofactors[TcJ][TcI].raw(),det,negative));
+				}
+			}
+		}
+		return ret;
+	}
+/**
+Load the zero matrix
+@returns none
+*/
+	void loadZero(void)
+	{
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				_data[TcI][TcJ] = Fixed();
+			}
+		}
+	}
+/**
+Load the identity matrix
+@returns none
+*/
+	void loadIdentity(void)
+	{
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				_data[TcI][TcJ] = TcI == TcJ ? Fixed(1) : Fixed();
+			}
+		}
+	}
+/**
+Load a rotation matrix about the x axis
+@param cosine the cosine of the angle of rotation
+@param sine the sine of the angle of rotation
+@returns none
+*/
+	void loadRotationX(const Fixed & cosine, const Fixed & sine)
+	{
+		loadIdentity();
+		_data[1][1] = cosine;
+		_data[1][2] = -sine;
+		_data[2][1] = sine;
+		_data[2][2] = cosine;
+	}
+/**
+Load a rotation matrix about the y axis
+@param cosine the cosine of the angle of rotation
+@param sine the sine of the angle of rotation
+@returns none
+*/
+	void loadRotationY(const Fixed & cosine, const Fixed & sine)
+	{
+		loadIdentity();
+		_data[0][0] = cosine;
+		_data[0][2] = sine;
+		_data[2][0] = -sine;
+		_data[2][2] = cosine;
+	}
+/**
+Load a rotation matrix about the z axis
+@param cosine the cosine of the angle of rotation
+@param sine the sine of the angle of rotation
+@returns none
+*/
+	void loadRotationZ(const Fixed & cosine, const Fixed & sine)
+	{
+		loadIdentity();
+		_data[0][0] = cosine;
+		_data[0][1] = -sine;
+		_data[1][0] = sine;
+		_data[1][1] = cosine;
+	}
+};
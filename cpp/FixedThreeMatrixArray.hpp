@@ -0,0 +1,329 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <FixedThreeMatrix.hpp>
+#include <FixedThreeVectorArray.hpp>
+#include <ThreeMatrixArray.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of Q16.16 fixed-point 3x3 matrices stored as nine separate raw element arrays (structure of arrays)
+@details The bulk kernels compute exactly what FixedThreeMatrix computes for each matrix, bit for bit, including its rounded cofactors. Conversions, determinants, products and transforms are integer loops with 64 bit products, which the compiler vectorizes with integer SIMD instructions. The inverse is scalar, since it divides by the exact determinant and common SIMD instruction sets have no 64 bit integer division.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedThreeMatrixArray
+{
+private:
+	static const long GRAIN = 16384;
+	std::vector<std::int32_t> _data[3][3];
+
+	// the determinant of the 2x2 matrix with rows (a, b) and (c, d), rounded once, as the cofactors of FixedThreeMatrix
+	static std::int32_t minor(std::int32_t a, std::int32_t b, std::int32_t c, std::int32_t d)
+	{
+		return Fixed::round(Fixed::product(a,d) - Fixed::product(b,c));
+	}
+public:
+	FixedThreeMatrixArray(void)
+	{
+	}
+/**
+FixedThreeMatrixArray constructor
+@param size The number of matrices in the array; all matrices are initialized to zero
+*/
+	explicit FixedThreeMatrixArray(int size)
+	{
+		resize(size);
+	}
+/**
+Get the number of matrices in the array
+@returns The number of matrices
+*/
+	int size(void) const {return (int)_data[0][0].size();}
+/**
+Change the number of matrices in the array. New matrices are initialized to zero.
+@param size The new number of matrices
+@returns none
+*/
+	void resize(int size)
+	{
+		int TcI,TcJ;
+		if (size < 0)
+			size = 0;
+		for (TcI = 0; TcI < 3; TcI++)
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				_data[TcI][TcJ].resize(size,0);
+	}
+/**
+Get direct access to one raw element of every matrix, for example to hash or serialize the state
+@param row the zero indexed row of the element
+@param column the zero indexed column of the element
+@returns A pointer to the element of the first matrix, or null if row or column is out of range
+*/
+	std::int32_t * element(int row, int column)
+	{
+		if (row >= 0 && row < 3 && column >= 0 && column < 3)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+	const std::int32_t * element(int row, int column) const
+	{
+		if (row >= 0 && row < 3 && column >= 0 && column < 3)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+
+/**
+Retreive the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to retrieve
+@returns the matrix at the index, the zero matrix otherwise
+*/
+	FixedThreeMatrix at(int idx) const
+	{
+		int TcI,TcJ;
+		FixedThreeMatrix ret;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					ret.setAt(TcI,TcJ,Fixed::fromRaw(_data[TcI][TcJ][idx]));
+		}
+		return ret;
+	}
+/**
+Set the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const FixedThreeMatrix & value)
+	{
+		int TcI,TcJ;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					_data[TcI][TcJ][idx] = value.at(TcI,TcJ).raw();
+		}
+	}
+/**
+Load the array from float matrices, rounding each element to the nearest unit as Fixed::fromFloat
+@param matrices the float matrices
+@returns none
+*/
+	void load(const ThreeMatrixArray & matrices)
+	{
+		int TcJ;
+		LINALG_COUNT(FIXED_THREE_MATRIX_ARRAY,0,72L * matrices.size());
+		resize(matrices.size());
+		for (TcJ = 0; TcJ < 9; TcJ++)
+		{
+			const float * a = matrices.element(TcJ / 3,TcJ % 3);
+			std::int32_t * r = _data[TcJ / 3][TcJ % 3].data();
+			ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+			{
+				long TcI;
+#pragma omp simd
+				for (TcI = first; TcI < last; TcI++)
+					r[TcI] = Fixed::rawFromFloat(a[TcI]);
+			});
+		}
+	}
+/**
+Store the array into float matrices, for display or for use outside the deterministic part of a program
+@param matrices receives the nearest float matrices; resized to size()
+@returns none
+*/
+	void store(ThreeMatrixArray & matrices) const
+	{
+		int TcJ;
+		LINALG_COUNT(FIXED_THREE_MATRIX_ARRAY,0,72L * size());
+		matrices.resize(size());
+		for (TcJ = 0; TcJ < 9; TcJ++)
+		{
+			const std::int32_t * a = _data[TcJ / 3][TcJ % 3].data();
+			float * r = matrices.element(TcJ / 3,TcJ % 3);
+			ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+			{
+				long TcI;
+#pragma omp simd
+				for (TcI = first; TcI < last; TcI++)
+					r[TcI] = (float)a[TcI] * (1.0f / Fixed::ONE);
+			});
+		}
+	}
+
+/**
+Get the determinant of every matrix, as FixedThreeMatrix::determinant: expanded along the first row with rounded cofactors
+@param result receives the determinants; resized to size()
+@returns none
+*/
+	void determinant(std::vector<Fixed> & result) const
+	{
+		LINALG_COUNT(FIXED_THREE_MATRIX_ARRAY,14L * size(),40L * size());
+		result.resize(size());
+		const std::int32_t * m00 = _data[0][0].data();
+		const std::int32_t * m01 = _data[0][1].data();
+		const std::int32_t * m02 = _data[0][2].data();
+		const std::int32_t * m10 = _data[1][0].data();
+		const std::int32_t * m11 = _data[1][1].data();
+		const std::int32_t * m12 = _data[1][2].data();
+		const std::int32_t * m20 = _data[2][0].data();
+		const std::int32_t * m21 = _data[2][1].data();
+		const std::int32_t * m22 = _data[2][2].data();
+		Fixed * det = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t c0 = minor(m11[TcI],m12[TcI],m21[TcI],m22[TcI]);
+				std::int32_t c1 = Fixed::negate(minor(m10[TcI],m12[TcI],m20[TcI],m22[TcI]));
+				std::int32_t c2 = minor(m10[TcI],m11[TcI],m20[TcI],m21[TcI]);
+				det[TcI] = Fixed::fromRaw(Fixed::round(Fixed::product(m00[TcI],c0) + Fixed::product(m01[TcI],c1) + Fixed::product(m02[TcI],c2)));
+			}
+		});
+	}
+/**
+Get the inverse of every matrix, as FixedThreeMatrix::invert: the transposed cofactors are each divided by the exact sum of products that forms the determinant and rounded once, and the inverse of a matrix for which that sum is zero is the zero matrix
+@param result receives the inverses; resized to size(). May be this array.
+@returns the number of matrices for which that sum is zero
+*/
+	long invert(FixedThreeMatrixArray & result) const
+	{
+		int TcJ,TcK;
+		LINALG_COUNT(FIXED_THREE_MATRIX_ARRAY,45L * size(),72L * size());
+		result.resize(size());
+		const std::int32_t * m[3][3];
+		std::int32_t * r[3][3];
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				m[TcJ][TcK] = _data[TcJ][TcK].data();
+				r[TcJ][TcK] = result._data[TcJ][TcK].data();
+			}
+		}
+		return (long)ThreadPool::instance().parallelSum(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			int TcR,TcC;
+			long singular = 0;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t a00 = m[0][0][TcI], a01 = m[0][1][TcI], a02 = m[0][2][TcI];
+				std::int32_t a10 = m[1][0][TcI], a11 = m[1][1][TcI], a12 = m[1][2][TcI];
+				std::int32_t a20 = m[2][0][TcI], a21 = m[2][1][TcI], a22 = m[2][2][TcI];
+				std::int32_t cofactors[3][3] =
+				{
+					{minor(a11,a12,a21,a22),Fixed::negate(minor(a10,a12,a20,a22)),minor(a10,a11,a20,a21)},
+					{Fixed::negate(minor(a01,a02,a21,a22)),minor(a00,a02,a20,a22),Fixed::negate(minor(a00,a01,a20,a21))},
+					{minor(a01,a02,a11,a12),Fixed::negate(minor(a00,a02,a10,a12)),minor(a00,a01,a10,a11)}
+				};
+				std::uint64_t products[3] = {Fixed::product(a00,cofactors[0][0]),Fixed::product(a01,cofactors[0][1]),Fixed::product(a02,cofactors[0][2])};
+				bool negative;
+				std::uint64_t det = Fixed::sumMagnitude(products,3,negative);
+				for (TcR = 0; TcR < 3; TcR++)
+					for (TcC = 0; TcC < 3; TcC++)
+						r[TcR][TcC][TcI] = det != 0 ? Fixed::divideBySum(cofactors[TcC][TcR],det,negative) : 0;
+				singular += det == 0 ? 1 : 0;
+			}
+			return (double)singular;
+		});
+	}
+/**
+Load every matrix with the product of two others, \f$AB\f$, as FixedThreeMatrix::operator*. The result may be one of the inputs.
+@param a the first matrices
+@param b the second matrices; must have the same size as a
+@returns none
+*/
+	void loadProduct(const FixedThreeMatrixArray & a, const FixedThreeMatrixArray & b)
+	{
+		int TcJ,TcK;
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(FIXED_THREE_MATRIX_ARRAY,45L * a.size(),108L * a.size());
+		resize(a.size());
+		const std::int32_t * pa[3][3];
+		const std::int32_t * pb[3][3];
+		std::int32_t * pc[3][3];
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				pa[TcJ][TcK] = a._data[TcJ][TcK].data();
+				pb[TcJ][TcK] = b._data[TcJ][TcK].data();
+				pc[TcJ][TcK] = _data[TcJ][TcK].data();
+			}
+		}
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t a00 = pa[0][0][TcI], a01 = pa[0][1][TcI], a02 = pa[0][2][TcI];
+				std::int32_t a10 = pa[1][0][TcI], a11 = pa[1][1][TcI], a12 = pa[1][2][TcI];
+				std::int32_t a20 = pa[2][0][TcI], a21 = pa[2][1][TcI], a22 = pa[2][2][TcI];
+				std::int32_t b00 = pb[0][0][TcI], b01 = pb[0][1][TcI], b02 = pb[0][2][TcI];
+				std::int32_t b10 = pb[1][0][TcI], b11 = pb[1][1][TcI], b12 = pb[1][2][TcI];
+				std::int32_t b20 = pb[2][0][TcI], b21 = pb[2][1][TcI], b22 = pb[2][2][TcI];
+				pc[0][0][TcI] = Fixed::round(Fixed::product(a00,b00) + Fixed::product(a01,b10) + Fixed::product(a02,b20));
+				pc[0][1][TcI] = Fixed::round(Fixed::product(a00,b01) + Fixed::product(a01,b11) + Fixed::product(a02,b21));
+				pc[0][2][TcI] = Fixed::round(Fixed::product(a00,b02) + Fixed::product(a01,b12) + Fixed::product(a02,b22));
+				pc[1][0][TcI] = Fixed::round(Fixed::product(a10,b00) + Fixed::product(a11,b10) + Fixed::product(a12,b20));
+				pc[1][1][TcI] = Fixed::round(Fixed::product(a10,b01) + Fixed::product(a11,b11) + Fixed::product(a12,b21));
+				pc[1][2][TcI] = Fixed::round(Fixed::product(a10,b02) + Fixed::product(a11,b12) + Fixed::product(a12,b22));
+				pc[2][0][TcI] = Fixed::round(Fixed::product(a20,b00) + Fixed::product(a21,b10) + Fixed::product(a22,b20));
+				pc[2][1][TcI] = Fixed::round(Fixed::product(a20,b01) + Fixed::product(a21,b11) + Fixed::product(a22,b21));
+				pc[2][2][TcI] = Fixed::round(Fixed::product(a20,b02) + Fixed::product(a21,b12) + Fixed::product(a22,b22));
+			}
+		});
+	}
+/**
+Transform the corresponding vector of another array by every matrix, \f$A_i\vec{v}_i\f$, as FixedThreeMatrix::operator*
+@param vectors the vectors; must have the same size as this array
+@param result receives the transformed vectors; resized to size(). May be vectors.
+@returns none
+*/
+	void transform(const FixedThreeVectorArray & vectors, FixedThreeVectorArray & result) const
+	{
+		if (vectors.size() != size())
+			return;
+		LINALG_COUNT(FIXED_THREE_MATRIX_ARRAY,15L * size(),60L * size());
+		result.resize(size());
+		const std::int32_t * m00 = _data[0][0].data();
+		const std::int32_t * m01 = _data[0][1].data();
+		const std::int32_t * m02 = _data[0][2].data();
+		const std::int32_t * m10 = _data[1][0].data();
+		const std::int32_t * m11 = _data[1][1].data();
+		const std::int32_t * m12 = _data[1][2].data();
+		const std::int32_t * m20 = _data[2][0].data();
+		const std::int32_t * m21 = _data[2][1].data();
+		const std::int32_t * m22 = _data[2][2].data();
+		const std::int32_t * ax = vectors.x();
+		const std::int32_t * ay = vectors.y();
+		const std::int32_t * az = vectors.z();
+		std::int32_t * rx = result.x();
+		std::int32_t * ry = result.y();
+		std::int32_t * rz = result.z();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t vx = ax[TcI], vy = ay[TcI], vz = az[TcI];
+				rx[TcI] = Fixed::round(Fixed::product(m00[TcI],vx) + Fixed::product(m01[TcI],vy) + Fixed::product(m02[TcI],vz));
+				ry[TcI] = Fixed::round(Fixed::product(m10[TcI],vx) + Fixed::product(m11[TcI],vy) + Fixed::product(m12[TcI],vz));
+				rz[TcI] = Fixed::round(Fixed::product(m20[TcI],vx) + Fixed::product(m21[TcI],vy) + Fixed::product(m22[TcI],vz));
+			}
+		});
+	}
+};
@@ -0,0 +1,249 @@
+#pragma once
+#include <Fixed.hpp>
+#include <ThreeVector.hpp>
+/**
+@brief A 3-dimensional vector of Q16.16 fixed-point components, with the interface of ThreeVector
+@details Every operation gives bit-identical results everywhere; see Fixed. Dot and cross products accumulate the exact products and round once, so they are as accurate as the format allows, and the magnitude is an integer square root of the exact sum of squares, less than a unit below the exact length. A component of a unit vector is within half a unit plus one unit over the length of the exact one.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedThreeVector
+{
+friend class FixedThreeMatrix;
+private:
+	Fixed _x;
+	Fixed _y;
+	Fixed _z;
+public:
+	FixedThreeVector(void)
+	{
+	}
+/**
+FixedThreeVector constructor
+@param x The x component
+@param y The y component
+@param z The z component
+*/
+	FixedThreeVector(const Fixed & x, const Fixed & y, const Fixed & z)
+	{
+		_x = x;
+		_y = y;
+		_z = z;
+	}
+/**
+FixedThreeVector constructor
+@param vector A ThreeVector, with each component rounded to the nearest unit
+*/
+	explicit FixedThreeVector(const ThreeVector & vector)
+	{
+		_x = Fixed::fromFloat(vector.getX());
+		_y = Fixed::fromFloat(vector.getY());
+		_z = Fixed::fromFloat(vector.getZ());
+	}
+/**
+Convert to a ThreeVector
+@returns the nearest ThreeVector
+*/
+	ThreeVector toFloat(void) const
+	{
+		return ThreeVector(_x.toFloat(),_y.toFloat(),_z.toFloat());
+	}
+/**
+Get for the x component
+@returns The x component
+*/
+	Fixed getX(void) const {return _x;}
+/**
+Get for the y component
+@returns The y component
+*/
+	Fixed getY(void) const {return _y;}
+/**
+Get for the z component
+@returns The z component
+*/
+	Fixed getZ(void) const {return _z;}
+
+/**
+Set for the x component
+@param value The new value for the x component
+@returns none
+*/
+	void setX(const Fixed & value) {_x = value;}
+/**
+Set for the y component
+@param value The new value for the y component
+@returns none
+*/
+	void setY(const Fixed & value) {_y = value;}
+/**
+Set for the z component
+@param value The new value for the z component
+@returns none
+*/
+	void setZ(const Fixed & value) {_z = value;}
+
+/**
+Add one vector to another: \f$\vec{a} + \vec{b} = <a_x + b_x,a_y + b_y, a_z + b_z>\f$.
+@param vectB the vector to add to this vector.
+@returns a FixedThreeVector with the result of the addition.
+*/
+	FixedThreeVector operator +(const FixedThreeVector & vectB) const
+	{
+		return FixedThreeVector(_x + vectB._x,_y + vectB._y,_z + vectB._z);
+	}
+	FixedThreeVector & operator +=(const FixedThreeVector & vectB)
+	{
+		return *this = *this + vectB;
+	}
+/**
+Create the additive inverse of a vector: \f$-\vec{a} = <-a_x,-a_y,-a_z>\f$
+@returns a FixedThreeVector containing the additive inverse of this vector.
+*/
+	FixedThreeVector operator -(void) const
+	{
+		return FixedThreeVector(-_x,-_y,-_z);
+	}
+/**
+Subtract one vector from another: \f$\vec{a} - \vec{b} = <a_x - b_x,a_y - b_y, a_z - b_z>\f$.
+@param vectB the vector to subtract from this vector.
+@returns a FixedThreeVector with the result of the subtraction.
+*/
+	FixedThreeVector operator -(const FixedThreeVector & vectB) const
+	{
+		return FixedThreeVector(_x - vectB._x,_y - vectB._y,_z - vectB._z);
+	}
+	FixedThreeVector & operator -=(const FixedThreeVector & vectB)
+	{
+		return *this = *this - vectB;
+	}
+/**
+Scale the vector by a scalar factor: \f$s\vec{a} = <s x, s y, s z>\f$.
+@param scalar the factor by which to scale the vector
+@returns the scaled FixedThreeVector
+*/
+	FixedThreeVector operator *(const Fixed & scalar) const
+	{
+		return FixedThreeVector(_x * scalar,_y * scalar,_z * scalar);
+	}
+	FixedThreeVector & operator *=(const Fixed & scalar)
+	{
+		return *this = *this * scalar;
+	}
+/**
+Divide the vector by a scalar factor: \f$\dfrac{1}{s}\vec{a} = <\dfrac{x}{s}, \dfrac{y}{s}, \dfrac{z}{s}>\f$. Each component is divided and rounded separately rather than multiplied by a rounded reciprocal.
+@param scalar the factor by which to divide the vector
+@returns the scaled FixedThreeVector
+*/
+	FixedThreeVector operator /(const Fixed & scalar) const
+	{
+		return FixedThreeVector(_x / scalar,_y / scalar,_z / scalar);
+	}
+	FixedThreeVector & operator /=(const Fixed & scalar)
+	{
+		return *this = *this / scalar;
+	}
+/**
+Retrieve a scalar (dot) product for this vector: \f$\vec{a}\bullet\vec{b} = a_x b_x + a_y b_y + a_z b_z\f$, rounded once
+@returns the dot product
+*/
+	Fixed dot(const FixedThreeVector & vectB) const
+	{
+		return Fixed::fromRaw(Fixed::round(Fixed::product(_x.raw(),vectB._x.raw()) + Fixed::product(_y.raw(),vectB._y.raw()) + Fixed::product(_z.raw(),vectB._z.raw())));
+	}
+/**
+Retrieve a vector (cross) product for this vector: \f$\vec{a}\times\vec{b} = <a_yb_z - a_zb_y,a_zb_x - a_xb_z,a_xb_y - a_yb_x>\f$, with each component rounded once
+@returns the cross product as a FixedThreeVector
+*/
+	FixedThreeVector cross(const FixedThreeVector & vectB) const
+	{
+		return FixedThreeVector(Fixed::fromRaw(Fixed::round(Fixed::product(_y.raw(),vectB._z.raw()) - Fixed::product(_z.raw(),vectB._y.raw()))),
+							Fixed::fromRaw(Fixed::round(Fixed::product(_z.raw(),vectB._x.raw()) - Fixed::product(_x.raw(),vectB._z.raw()))),
+							Fixed::fromRaw(Fixed::round(Fixed::product(_x.raw(),vectB._y.raw()) - Fixed::product(_y.raw(),vectB._x.raw()))));
+	}
+/**
+Get the magnitude (length) of the vector, the integer square root of the exact sum of squares, rounded down to a unit
+@returns the magnitude of the vector \f$(\sqrt{x^2 + y^2 + z^2})\f$, saturated to the largest value
+*/
+	Fixed magnitude(void) const
+	{
+		return Fixed::fromRaw(Fixed::length(Fixed::product(_x.raw(),_x.raw()) + Fixed::product(_y.raw(),_y.raw()) + Fixed::product(_z.raw(),_z.raw())));
+	}
+/**
+Retrieve a unit vector for this vector
+@returns the unit vector \f$(\dfrac{1}{\sqrt{x^2 + y^2 + z^2}})<x,y,z>\f$, or the zero vector if the magnitude rounds to zero
+*/
+	FixedThreeVector unit(void) const
+	{
+		Fixed mag = magnitude();
+		if (mag.raw() == 0)
+			return FixedThreeVector();
+		return *this / mag;
+	}
+/**
+Load the vector with a zero vector
+@returns none
+*/
+	void loadZero(void)
+	{
+		_x = _y = _z = Fixed();
+	}
+/**
+Load the vector with a unit vector in the x direction
+@returns none
+*/
+	void loadUnitX(void)
+	{
+		_x = Fixed(1);
+		_y = _z = Fixed();
+	}
+/**
+Load the vector with a unit vector in the y direction
+@returns none
+*/
+	void loadUnitY(void)
+	{
+		_y = Fixed(1);
+		_x = _z = Fixed();
+	}
+/**
+Load the vector with a unit vector in the z direction
+@returns none
+*/
+	void loadUnitZ(void)
+	{
+		_z = Fixed(1);
+		_x = _y = Fixed();
+	}
+
+	bool operator ==(const FixedThreeVector & vectB) const
+	{
+		return _x == vectB._x && _y == vectB._y && _z == vectB._z;
+	}
+	bool operator !=(const FixedThreeVector & vectB) const
+	{
+		return !(*this == vectB);
+	}
+
+	Fixed operator[] (int idx) const
+	{
+		Fixed ret;
+		switch (idx)
+		{
+		case 0:
+		default:
+			ret = _x;
+			break;
+		case 1:
+			ret = _y;
+			break;
+		case 2:
+			ret = _z;
+			break;
+		}
+		return ret;
+	}
+};
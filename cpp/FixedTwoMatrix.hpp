@@ -0,0 +1,318 @@
+#pragma once
+#include <FixedTwoVector.hpp>
+#include <TwoMatrix.hpp>
+/**
+@brief A 2x2 matrix of Q16.16 fixed-point elements, with the interface of TwoMatrix
+@details Every operation gives bit-identical results everywhere; see Fixed. Each element of a product and the determinant are sums of exact products rounded once, and the inverse divides each element by the exact determinant, before it is rounded, with one rounding per element. Rotations are loaded from a given cosine and sine.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedTwoMatrix
+{
+private:
+	Fixed _data[2][2];
+public:
+	FixedTwoMatrix(void)
+	{
+	}
+/**
+FixedTwoMatrix constructor
+@param matrix A TwoMatrix, with each element rounded to the nearest unit
+*/
+	explicit FixedTwoMatrix(const TwoMatrix & matrix)
+	{
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				_data[TcI][TcJ] = Fixed::fromFloat(matrix.at(TcI,TcJ));
+			}
+		}
+	}
+/**
+Convert to a TwoMatrix
+@returns the nearest TwoMatrix
+*/
+	TwoMatrix toFloat(void) const
+	{
+		TwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret.setAt(TcI,TcJ,_data[TcI][TcJ].toFloat());
+			}
+		}
+		return ret;
+	}
+/**
+Retreive the value of the element at the given row and column, zero indexed
+@param row the zero indexed row from which to retrieve an element
+@param column the zero indexed column from which to retrieve an element
+@returns the value at the selected row and column, zero otherwise
+*/
+	Fixed at(int row, int column) const
+	{
+		if (row >= 0 && row < 2 && column >= 0 && column < 2)
+			return _data[row][column];
+		else
+			return Fixed();
+	}
+/**
+Set the value of the element at the given row and column, zero indexed
+@param row the zero indexed row from which to set an element
+@param column the zero indexed column from which to set an element
+@param value the value to insert into the matrix.
+*/
+	void setAt(int row, int column, const Fixed & value)
+	{
+		if (row >= 0 && row < 2 && column >= 0 && column < 2)
+			_data[row][column] = value;
+	}
+/**
+Set the values of the elements in the given column, zero indexed
+@param column the zero indexed column in which to set the elements
+@param value the values to insert into the matrix.
+*/
+	void setColumn(int column, const FixedTwoVector & value)
+	{
+		if (column >= 0 && column < 2)
+		{
+			_data[0][column] = value._x;
+			_data[1][column] = value._y;
+		}
+	}
+/**
+Set the values of the elements in the given row, zero indexed
+@param row the zero indexed row in which to set the elements
+@param value the values to insert into the matrix.
+*/
+	void setRow(int row, const FixedTwoVector & value)
+	{
+		if (row >= 0 && row < 2)
+		{
+			_data[row][0] = value._x;
+			_data[row][1] = value._y;
+		}
+	}
+/**
+Retrieve a row vector for a given row
+@param rowNum the zero indexed row from which to retrieve
+@returns If row is a valid index, then a FixedTwoVector containing the row data, otherwise the zero vector
+*/
+	FixedTwoVector row(int rowNum) const
+	{
+		if (rowNum >= 0 && rowNum < 2)
+			return FixedTwoVector(_data[rowNum][0],_data[rowNum][1]);
+		else
+			return FixedTwoVector();
+	}
+/**
+Retrieve a column vector for a given column
+@param columnNum the zero indexed column from which to retrieve
+@returns If column is a valid index, then a FixedTwoVector containing the column data, otherwise the zero vector
+*/
+	FixedTwoVector column(int columnNum) const
+	{
+		if (columnNum >= 0 && columnNum < 2)
+			return FixedTwoVector(_data[0][columnNum],_data[1][columnNum]);
+		else
+			return FixedTwoVector();
+	}
+
+/**
+Perform a matrix multiplication with a column vector, rounding each component once
+@param vector the FixedTwoVector by which the matrix is multiplied
+@returns the transformed vector
+*/
+	FixedTwoVector operator *(const FixedTwoVector & vector) const
+	{
+		return FixedTwoVector(Fixed::fromRaw(Fixed::round(Fixed::product(_data[0][0].raw(),vector._x.raw()) + Fixed::product(_data[0][1].raw(),vector._y.raw()))),
+							Fixed::fromRaw(Fixed::round(Fixed::product(_data[1][0].raw(),vector._x.raw()) + Fixed::product(_data[1][1].raw(),vector._y.raw()))));
+	}
+/**
+Perform a scalar multiplication of the matrix
+@param scalar the factor by which the matrix is multiplied
+@returns a new FixedTwoMatrix containing the result of the multiplication
+*/
+	FixedTwoMatrix operator *(const Fixed & scalar) const
+	{
+		FixedTwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcI][TcJ] * scalar;
+			}
+		}
+		return ret;
+	}
+/**
+Perform a matrix multiplication with a FixedTwoMatrix, rounding each element once
+@param matrix the FixedTwoMatrix by which the matrix is multiplied
+@returns a new FixedTwoMatrix containing the result of the multiplication
+*/
+	FixedTwoMatrix operator *(const FixedTwoMatrix & matrix) const
+	{
+		FixedTwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret._data[TcI][TcJ] = Fixed::fromRaw(Fixed::round(Fixed::product(_data[TcI][0].raw(),matrix._data[0][TcJ].raw()) + Fixed::product(_data[TcI][1].raw(),matrix._data[1][TcJ].raw())));
+			}
+		}
+		return ret;
+	}
+/**
+Add two matrices
+@param matrix the FixedTwoMatrix to add to this matrix
+@returns a new FixedTwoMatrix containing the sum
+*/
+	FixedTwoMatrix operator +(const FixedTwoMatrix & matrix) const
+	{
+		FixedTwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcI][TcJ] + matrix._data[TcI][TcJ];
+			}
+		}
+		return ret;
+	}
+/**
+Subtract one matrix from another
+@param matrix the FixedTwoMatrix to subtract from this matrix
+@returns a new FixedTwoMatrix containing the difference
+*/
+	FixedTwoMatrix operator -(const FixedTwoMatrix & matrix) const
+	{
+		FixedTwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcI][TcJ] - matrix._data[TcI][TcJ];
+			}
+		}
+		return ret;
+	}
+/**
+Get the transpose of the matrix
+@returns a new FixedTwoMatrix containing the transpose
+*/
+	FixedTwoMatrix transpose(void) const
+	{
+		FixedTwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret._data[TcI][TcJ] = _data[TcJ][TcI];
+			}
+		}
+		return ret;
+	}
+/**
+Get the additive inverse of the matrix
+@returns a new FixedTwoMatrix containing the additive inverse
+*/
+	FixedTwoMatrix operator -(void) const
+	{
+		FixedTwoMatrix ret;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 2; TcI++)
+		{
+			for (TcJ = 0; TcJ < 2; TcJ++)
+			{
+				ret._data[TcI][TcJ] = -_data[TcI][TcJ];
+			}
+		}
+		return ret;
+	}
+	bool operator ==(const FixedTwoMatrix & matrix) const
+	{
+		return _data[0][0] == matrix._data[0][0] && _data[0][1] == matrix._data[0][1] && _data[1][0] == matrix._data[1][0] && _data[1][1] == matrix._data[1][1];
+	}
+	bool operator !=(const FixedTwoMatrix & matrix) const
+	{
+		return !(*this == matrix);
+	}
+/**
+Get the determinant of the matrix, rounded once
+@returns The determinant of the matrix
+*/
+	Fixed determinant(void) const
+	{
+		return Fixed::fromRaw(Fixed::round(Fixed::product(_data[0][0].raw(),_data[1][1].raw()) - Fixed::product(_data[0][1].raw(),_data[1][0].raw())));
+	}
+/**
+Get the trace of the matrix
+@returns The trace of the matrix
+*/
+	Fixed trace(void) const
+	{
+		return _data[0][0] + _data[1][1];
+	}
+/**
+Get the inverse of the matrix, each element divided by the exact determinant and rounded once
+@returns A new FixedTwoMatrix containing the multiplicative inverse, with elements outside the range saturated, or the zero matrix if the matrix is singular
+*/
+	FixedTwoMatrix invert(void) const
+	{
+		FixedTwoMatrix ret;
+		std::uint64_t products[2] = {Fixed::product(_data[0][0].raw(),_data[1][1].raw()),(std::uint64_t)0 - Fixed::product(_data[0][1].raw(),_data[1][0].raw())};
+		bool negative;
+		std::uint64_t det = Fixed::sumMagnitude(products,2,negative);
+		if (det != 0)
+		{
+			// the off-diagonal elements are divided by the negated determinant, as negating them could wrap
+			ret._data[0][0] = Fixed::fromRaw(Fixed::divideBySum(_data[1][1].raw(),det,negative));
+			ret._data[0][1] = Fixed::fromRaw(Fixed::divideBySum(_data[0][1].raw(),det,!negative));
+			ret._data[1][0] = Fixed::fromRaw(Fixed::divideBySum(_data[1][0].raw(),det,!negative));
+			ret._data[1][1] = Fixed::fromRaw(Fixed::divideBySum(_data[0][0].raw(),det,negative));
+		}
+		return ret;
+	}
+/**
+Load the zero matrix
+@returns none
+*/
+	void loadZero(void)
+	{
+		_data[0][0] = _data[0][1] = _data[1][0] = _data[1][1] = Fixed();
+	}
+/**
+Load the identity matrix
+@returns none
+*/
+	void loadIdentity(void)
+	{
+		_data[0][0] = _data[1][1] = Fixed(1);
+		_data[0][1] = _data[1][0] = Fixed();
+	}
+/**
+Load a rotation matrix, which rotates a vector counterclockwise
+@param cosine the cosine of the angle of rotation
+@param sine the sine of the angle of rotation
+@returns none
+*/
+	void loadRotation(const Fixed & cosine, const Fixed & sine)
+	{
+		_data[0][0] = cosine;
+		_data[0][1] = -sine;
+		_data[1][0] = sine;
+		_data[1][1] = cosine;
+	}
+};
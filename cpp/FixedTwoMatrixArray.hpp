@@ -0,0 +1,285 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <FixedTwoMatrix.hpp>
+#include <FixedTwoVectorArray.hpp>
+#include <TwoMatrixArray.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of Q16.16 fixed-point 2x2 matrices stored as four separate raw element arrays (structure of arrays)
+@details The bulk kernels compute exactly what FixedTwoMatrix computes for each matrix, bit for bit. Conversions, determinants, products and transforms are integer loops with 64 bit products, which the compiler vectorizes with integer SIMD instructions. The inverse is scalar, since it divides by the exact determinant and common SIMD instruction sets have no 64 bit integer division.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedTwoMatrixArray
+{
+private:
+	static const long GRAIN = 16384;
+	std::vector<std::int32_t> _data[2][2];
+public:
+	FixedTwoMatrixArray(void)
+	{
+	}
+/**
+FixedTwoMatrixArray constructor
+@param size The number of matrices in the array; all matrices are initialized to zero
+*/
+	explicit FixedTwoMatrixArray(int size)
+	{
+		resize(size);
+	}
+/**
+Get the number of matrices in the array
+@returns The number of matrices
+*/
+	int size(void) const {return (int)_data[0][0].size();}
+/**
+Change the number of matrices in the array. New matrices are initialized to zero.
+@param size The new number of matrices
+@returns none
+*/
+	void resize(int size)
+	{
+		int TcI,TcJ;
+		if (size < 0)
+			size = 0;
+		for (TcI = 0; TcI < 2; TcI++)
+			for (TcJ = 0; TcJ < 2; TcJ++)
+				_data[TcI][TcJ].resize(size,0);
+	}
+/**
+Get direct access to one raw element of every matrix, for example to hash or serialize the state
+@param row the zero indexed row of the element
+@param column the zero indexed column of the element
+@returns A pointer to the element of the first matrix, or null if row or column is out of range
+*/
+	std::int32_t * element(int row, int column)
+	{
+		if (row >= 0 && row < 2 && column >= 0 && column < 2)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+	const std::int32_t * element(int row, int column) const
+	{
+		if (row >= 0 && row < 2 && column >= 0 && column < 2)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+
+/**
+Retreive the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to retrieve
+@returns the matrix at the index, the zero matrix otherwise
+*/
+	FixedTwoMatrix at(int idx) const
+	{
+		int TcI,TcJ;
+		FixedTwoMatrix ret;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 2; TcI++)
+				for (TcJ = 0; TcJ < 2; TcJ++)
+					ret.setAt(TcI,TcJ,Fixed::fromRaw(_data[TcI][TcJ][idx]));
+		}
+		return ret;
+	}
+/**
+Set the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const FixedTwoMatrix & value)
+	{
+		int TcI,TcJ;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 2; TcI++)
+				for (TcJ = 0; TcJ < 2; TcJ++)
+					_data[TcI][TcJ][idx] = value.at(TcI,TcJ).raw();
+		}
+	}
+/**
+Load the array from float matrices, rounding each element to the nearest unit as Fixed::fromFloat
+@param matrices the float matrices
+@returns none
+*/
+	void load(const TwoMatrixArray & matrices)
+	{
+		int TcJ;
+		LINALG_COUNT(FIXED_TWO_MATRIX_ARRAY,0,32L * matrices.size());
+		resize(matrices.size());
+		for (TcJ = 0; TcJ < 4; TcJ++)
+		{
+			const float * a = matrices.element(TcJ / 2,TcJ % 2);
+			std::int32_t * r = _data[TcJ / 2][TcJ % 2].data();
+			ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+			{
+				long TcI;
+#pragma omp simd
+				for (TcI = first; TcI < last; TcI++)
+					r[TcI] = Fixed::rawFromFloat(a[TcI]);
+			});
+		}
+	}
+/**
+Store the array into float matrices, for display or for use outside the deterministic part of a program
+@param matrices receives the nearest float matrices; resized to size()
+@returns none
+*/
+	void store(TwoMatrixArray & matrices) const
+	{
+		int TcJ;
+		LINALG_COUNT(FIXED_TWO_MATRIX_ARRAY,0,32L * size());
+		matrices.resize(size());
+		for (TcJ = 0; TcJ < 4; TcJ++)
+		{
+			const std::int32_t * a = _data[TcJ / 2][TcJ % 2].data();
+			float * r = matrices.element(TcJ / 2,TcJ % 2);
+			ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+			{
+				long TcI;
+#pragma omp simd
+				for (TcI = first; TcI < last; TcI++)
+					r[TcI] = (float)a[TcI] * (1.0f / Fixed::ONE);
+			});
+		}
+	}
+
+/**
+Get the determinant of every matrix, as FixedTwoMatrix::determinant
+@param result receives the determinants; resized to size()
+@returns none
+*/
+	void determinant(std::vector<Fixed> & result) const
+	{
+		LINALG_COUNT(FIXED_TWO_MATRIX_ARRAY,3L * size(),20L * size());
+		result.resize(size());
+		const std::int32_t * a = _data[0][0].data();
+		const std::int32_t * b = _data[0][1].data();
+		const std::int32_t * c = _data[1][0].data();
+		const std::int32_t * d = _data[1][1].data();
+		Fixed * det = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				det[TcI] = Fixed::fromRaw(Fixed::round(Fixed::product(a[TcI],d[TcI]) - Fixed::product(b[TcI],c[TcI])));
+		});
+	}
+/**
+Get the inverse of every matrix, as FixedTwoMatrix::invert: each element is divided by the exact determinant and rounded once, and the inverse of a matrix whose exact determinant is zero is the zero matrix
+@param result receives the inverses; resized to size(). May be this array.
+@returns the number of matrices whose exact determinant is zero
+*/
+	long invert(FixedTwoMatrixArray & result) const
+	{
+		LINALG_COUNT(FIXED_TWO_MATRIX_ARRAY,9L * size(),32L * size());
+		result.resize(size());
+		const std::int32_t * a = _data[0][0].data();
+		const std::int32_t * b = _data[0][1].data();
+		const std::int32_t * c = _data[1][0].data();
+		const std::int32_t * d = _data[1][1].data();
+		std::int32_t * ia = result._data[0][0].data();
+		std::int32_t * ib = result._data[0][1].data();
+		std::int32_t * ic = result._data[1][0].data();
+		std::int32_t * id = result._data[1][1].data();
+		return (long)ThreadPool::instance().parallelSum(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			long singular = 0;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t va = a[TcI], vb = b[TcI], vc = c[TcI], vd = d[TcI];
+				std::uint64_t products[2] = {Fixed::product(va,vd),(std::uint64_t)0 - Fixed::product(vb,vc)};
+				bool negative;
+				std::uint64_t det = Fixed::sumMagnitude(products,2,negative);
+				// the off-diagonal elements are divided by the negated determinant, as negating them could wrap
+				ia[TcI] = det != 0 ? Fixed::divideBySum(vd,det,negative) : 0;
+				ib[TcI] = det != 0 ? Fixed::divideBySum(vb,det,!negative) : 0;
+				ic[TcI] = det != 0 ? Fixed::divideBySum(vc,det,!negative) : 0;
+				id[TcI] = det != 0 ? Fixed::divideBySum(va,det,negative) : 0;
+				singular += det == 0 ? 1 : 0;
+			}
+			return (double)singular;
+		});
+	}
+/**
+Load every matrix with the product of two others, \f$AB\f$, as FixedTwoMatrix::operator*. The result may be one of the inputs.
+@param a the first matrices
+@param b the second matrices; must have the same size as a
+@returns none
+*/
+	void loadProduct(const FixedTwoMatrixArray & a, const FixedTwoMatrixArray & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(FIXED_TWO_MATRIX_ARRAY,12L * a.size(),48L * a.size());
+		resize(a.size());
+		const std::int32_t * a00 = a._data[0][0].data();
+		const std::int32_t * a01 = a._data[0][1].data();
+		const std::int32_t * a10 = a._data[1][0].data();
+		const std::int32_t * a11 = a._data[1][1].data();
+		const std::int32_t * b00 = b._data[0][0].data();
+		const std::int32_t * b01 = b._data[0][1].data();
+		const std::int32_t * b10 = b._data[1][0].data();
+		const std::int32_t * b11 = b._data[1][1].data();
+		std::int32_t * c00 = _data[0][0].data();
+		std::int32_t * c01 = _data[0][1].data();
+		std::int32_t * c10 = _data[1][0].data();
+		std::int32_t * c11 = _data[1][1].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t x00 = a00[TcI], x01 = a01[TcI], x10 = a10[TcI], x11 = a11[TcI];
+				std::int32_t y00 = b00[TcI], y01 = b01[TcI], y10 = b10[TcI], y11 = b11[TcI];
+				c00[TcI] = Fixed::round(Fixed::product(x00,y00) + Fixed::product(x01,y10));
+				c01[TcI] = Fixed::round(Fixed::product(x00,y01) + Fixed::product(x01,y11));
+				c10[TcI] = Fixed::round(Fixed::product(x10,y00) + Fixed::product(x11,y10));
+				c11[TcI] = Fixed::round(Fixed::product(x10,y01) + Fixed::product(x11,y11));
+			}
+		});
+	}
+/**
+Transform the corresponding vector of another array by every matrix, \f$A_i\vec{v}_i\f$, as FixedTwoMatrix::operator*
+@param vectors the vectors; must have the same size as this array
+@param result receives the transformed vectors; resized to size(). May be vectors.
+@returns none
+*/
+	void transform(const FixedTwoVectorArray & vectors, FixedTwoVectorArray & result) const
+	{
+		if (vectors.size() != size())
+			return;
+		LINALG_COUNT(FIXED_TWO_MATRIX_ARRAY,6L * size(),32L * size());
+		result.resize(size());
+		const std::int32_t * m00 = _data[0][0].data();
+		const std::int32_t * m01 = _data[0][1].data();
+		const std::int32_t * m10 = _data[1][0].data();
+		const std::int32_t * m11 = _data[1][1].data();
+		const std::int32_t * ax = vectors.x();
+		const std::int32_t * ay = vectors.y();
+		std::int32_t * rx = result.x();
+		std::int32_t * ry = result.y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t vx = ax[TcI], vy = ay[TcI];
+				rx[TcI] = Fixed::round(Fixed::product(m00[TcI],vx) + Fixed::product(m01[TcI],vy));
+				ry[TcI] = Fixed::round(Fixed::product(m10[TcI],vx) + Fixed::product(m11[TcI],vy));
+			}
+		});
+	}
+};
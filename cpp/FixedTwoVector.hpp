@@ -0,0 +1,220 @@
+#pragma once
+#include <Fixed.hpp>
+#include <TwoVector.hpp>
+/**
+@brief A 2-dimensional vector of Q16.16 fixed-point components, with the interface of TwoVector
+@details Every operation gives bit-identical results everywhere; see Fixed. Dot and cross products accumulate the exact products and round once, and the magnitude is an integer square root of the exact sum of squares.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedTwoVector
+{
+friend class FixedTwoMatrix;
+private:
+	Fixed _x;
+	Fixed _y;
+public:
+	FixedTwoVector(void)
+	{
+	}
+/**
+FixedTwoVector constructor
+@param x The x component
+@param y The y component
+*/
+	FixedTwoVector(const Fixed & x, const Fixed & y)
+	{
+		_x = x;
+		_y = y;
+	}
+/**
+FixedTwoVector constructor
+@param vector A TwoVector, with each component rounded to the nearest unit
+*/
+	explicit FixedTwoVector(const TwoVector & vector)
+	{
+		_x = Fixed::fromFloat(vector.getX());
+		_y = Fixed::fromFloat(vector.getY());
+	}
+/**
+Convert to a TwoVector
+@returns the nearest TwoVector
+*/
+	TwoVector toFloat(void) const
+	{
+		return TwoVector(_x.toFloat(),_y.toFloat());
+	}
+/**
+Get for the x component
+@returns The x component
+*/
+	Fixed getX(void) const {return _x;}
+/**
+Get for the y component
+@returns The y component
+*/
+	Fixed getY(void) const {return _y;}
+
+/**
+Set for the x component
+@param value The new value for the x component
+@returns none
+*/
+	void setX(const Fixed & value) {_x = value;}
+/**
+Set for the y component
+@param value The new value for the y component
+@returns none
+*/
+	void setY(const Fixed & value) {_y = value;}
+
+/**
+Add one vector to another: \f$\vec{a} + \vec{b} = <a_x + b_x,a_y + b_y>\f$.
+@param vectB the vector to add to this vector.
+@returns a FixedTwoVector with the result of the addition.
+*/
+	FixedTwoVector operator +(const FixedTwoVector & vectB) const
+	{
+		return FixedTwoVector(_x + vectB._x,_y + vectB._y);
+	}
+	FixedTwoVector & operator +=(const FixedTwoVector & vectB)
+	{
+		return *this = *this + vectB;
+	}
+/**
+Create the additive inverse of a vector: \f$-\vec{a} = <-a_x,-a_y>\f$
+@returns a FixedTwoVector containing the additive inverse of this vector.
+*/
+	FixedTwoVector operator -(void) const
+	{
+		return FixedTwoVector(-_x,-_y);
+	}
+/**
+Subtract one vector from another: \f$\vec{a} - \vec{b} = <a_x - b_x,a_y - b_y>\f$.
+@param vectB the vector to subtract from this vector.
+@returns a FixedTwoVector with the result of the subtraction.
+*/
+	FixedTwoVector operator -(const FixedTwoVector & vectB) const
+	{
+		return FixedTwoVector(_x - vectB._x,_y - vectB._y);
+	}
+	FixedTwoVector & operator -=(const FixedTwoVector & vectB)
+	{
+		return *this = *this - vectB;
+	}
+/**
+Scale the vector by a scalar factor: \f$s\vec{a} = <s x, s y>\f$.
+@param scalar the factor by which to scale the vector
+@returns the scaled FixedTwoVector
+*/
+	FixedTwoVector operator *(const Fixed & scalar) const
+	{
+		return FixedTwoVector(_x * scalar,_y * scalar);
+	}
+	FixedTwoVector & operator *=(const Fixed & scalar)
+	{
+		return *this = *this * scalar;
+	}
+/**
+Divide the vector by a scalar factor: \f$\dfrac{1}{s}\vec{a} = <\dfrac{x}{s}, \dfrac{y}{s}>\f$, dividing and rounding each component separately
+@param scalar the factor by which to divide the vector
+@returns the scaled FixedTwoVector
+*/
+	FixedTwoVector operator /(const Fixed & scalar) const
+	{
+		return FixedTwoVector(_x / scalar,_y / scalar);
+	}
+	FixedTwoVector & operator /=(const Fixed & scalar)
+	{
+		return *this = *this / scalar;
+	}
+/**
+Retrieve a scalar (dot) product for this vector: \f$\vec{a}\bullet\vec{b} = a_x b_x + a_y b_y\f$, rounded once
+@returns the dot product
+*/
+	Fixed dot(const FixedTwoVector & vectB) const
+	{
+		return Fixed::fromRaw(Fixed::round(Fixed::product(_x.raw(),vectB._x.raw()) + Fixed::product(_y.raw(),vectB._y.raw())));
+	}
+/**
+Retrieve a cross product for these vector: \f$\vec{a}\times\vec{b} = a_xb_y - a_yb_x\f$, rounded once
+@returns the cross product
+*/
+	Fixed cross(const FixedTwoVector & vectB) const
+	{
+		return Fixed::fromRaw(Fixed::round(Fixed::product(_x.raw(),vectB._y.raw()) - Fixed::product(_y.raw(),vectB._x.raw())));
+	}
+/**
+Get the magnitude (length) of the vector, the integer square root of the exact sum of squares, rounded down to a unit
+@returns the magnitude of the vector \f$(\sqrt{x^2 + y^2})\f$
+*/
+	Fixed magnitude(void) const
+	{
+		return Fixed::fromRaw(Fixed::length(Fixed::product(_x.raw(),_x.raw()) + Fixed::product(_y.raw(),_y.raw())));
+	}
+/**
+Retrieve a unit vector for this vector
+@returns the unit vector \f$(\dfrac{1}{\sqrt{x^2 + y^2}})<x,y>\f$, or the zero vector if the magnitude rounds to zero
+*/
+	FixedTwoVector unit(void) const
+	{
+		Fixed mag = magnitude();
+		if (mag.raw() == 0)
+			return FixedTwoVector();
+		return *this / mag;
+	}
+/**
+Load the vector with a zero vector
+@returns none
+*/
+	void loadZero(void)
+	{
+		_x = _y = Fixed();
+	}
+/**
+Load the vector with a unit vector in the x direction
+@returns none
+*/
+	void loadUnitX(void)
+	{
+		_x = Fixed(1);
+		_y = Fixed();
+	}
+/**
+Load the vector with a unit vector in the y direction
+@returns none
+*/
+	void loadUnitY(void)
+	{
+		_y = Fixed(1);
+		_x = Fixed();
+	}
+
+	bool operator ==(const FixedTwoVector & vectB) const
+	{
+		return _x == vectB._x && _y == vectB._y;
+	}
+	bool operator !=(const FixedTwoVector & vectB) const
+	{
+		return !(*this == vectB);
+	}
+
+	Fixed operator[] (int idx) const
+	{
+		Fixed ret;
+		switch (idx)
+		{
+		case 0:
+		default:
+			ret = _x;
+			break;
+		case 1:
+			ret = _y;
+			break;
+		}
+		return ret;
+	}
+};
@@ -0,0 +1,349 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <FixedTwoMatrix.hpp>
+#include <TwoVectorArray.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of Q16.16 fixed-point 2-dimensional vectors stored as separate raw x and y component arrays (structure of arrays)
+@details The bulk kernels compute exactly what FixedTwoVector and FixedTwoMatrix compute for each element, bit for bit, as FixedThreeVectorArray does for three dimensions. Conversions, sums, differences, dot and cross products and transforms are integer loops with 64 bit products, which the compiler vectorizes with integer SIMD instructions; magnitudes and normalization vectorize with AVX2, at the modest gain given there.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class FixedTwoVectorArray
+{
+private:
+	static const long GRAIN = 16384;
+	std::vector<std::int32_t> _x;
+	std::vector<std::int32_t> _y;
+public:
+	FixedTwoVectorArray(void)
+	{
+	}
+/**
+FixedTwoVectorArray constructor
+@param size The number of vectors in the array; all vectors are initialized to zero
+*/
+	explicit FixedTwoVectorArray(int size)
+	{
+		resize(size);
+	}
+/**
+Get the number of vectors in the array
+@returns The number of vectors
+*/
+	int size(void) const {return (int)_x.size();}
+/**
+Change the number of vectors in the array. New vectors are initialized to zero.
+@param size The new number of vectors
+@returns none
+*/
+	void resize(int size)
+	{
+		if (size < 0)
+			size = 0;
+		_x.resize(size,0);
+		_y.resize(size,0);
+	}
+/**
+Get direct access to the raw x components, for example to hash or serialize the state
+@returns A pointer to the x component of the first vector
+*/
+	std::int32_t * x(void) {return _x.data();}
+	const std::int32_t * x(void) const {return _x.data();}
+/**
+Get direct access to the raw y components
+@returns A pointer to the y component of the first vector
+*/
+	std::int32_t * y(void) {return _y.data();}
+	const std::int32_t * y(void) const {return _y.data();}
+
+/**
+Retreive the vector at the given index, zero indexed
+@param idx the zero indexed vector to retrieve
+@returns the vector at the index, the zero vector otherwise
+*/
+	FixedTwoVector at(int idx) const
+	{
+		if (idx >= 0 && idx < size())
+			return FixedTwoVector(Fixed::fromRaw(_x[idx]),Fixed::fromRaw(_y[idx]));
+		else
+			return FixedTwoVector();
+	}
+/**
+Set the vector at the given index, zero indexed
+@param idx the zero indexed vector to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const FixedTwoVector & value)
+	{
+		if (idx >= 0 && idx < size())
+		{
+			_x[idx] = value.getX().raw();
+			_y[idx] = value.getY().raw();
+		}
+	}
+/**
+Load the array from float vectors, rounding each component to the nearest unit as Fixed::fromFloat
+@param vectors the float vectors
+@returns none
+*/
+	void load(const TwoVectorArray & vectors)
+	{
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,0,16L * vectors.size());
+		resize(vectors.size());
+		const float * ax = vectors.x();
+		const float * ay = vectors.y();
+		std::int32_t * rx = x();
+		std::int32_t * ry = y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				rx[TcI] = Fixed::rawFromFloat(ax[TcI]);
+				ry[TcI] = Fixed::rawFromFloat(ay[TcI]);
+			}
+		});
+	}
+/**
+Store the array into float vectors, for display or for use outside the deterministic part of a program
+@param vectors receives the nearest float vectors; resized to size()
+@returns none
+*/
+	void store(TwoVectorArray & vectors) const
+	{
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,0,16L * size());
+		vectors.resize(size());
+		const std::int32_t * ax = x();
+		const std::int32_t * ay = y();
+		float * rx = vectors.x();
+		float * ry = vectors.y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				rx[TcI] = (float)ax[TcI] * (1.0f / Fixed::ONE);
+				ry[TcI] = (float)ay[TcI] * (1.0f / Fixed::ONE);
+			}
+		});
+	}
+
+/**
+Load every vector with the sum of two others, \f$\vec{a} + \vec{b}\f$, wrapping on overflow. The result may be one of the inputs.
+@param a the first vectors
+@param b the second vectors; must have the same size as a
+@returns none
+*/
+	void loadSum(const FixedTwoVectorArray & a, const FixedTwoVectorArray & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,2L * a.size(),24L * a.size());
+		resize(a.size());
+		const std::int32_t * ax = a.x();
+		const std::int32_t * ay = a.y();
+		const std::int32_t * bx = b.x();
+		const std::int32_t * by = b.y();
+		std::int32_t * rx = x();
+		std::int32_t * ry = y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				rx[TcI] = Fixed::add(ax[TcI],bx[TcI]);
+				ry[TcI] = Fixed::add(ay[TcI],by[TcI]);
+			}
+		});
+	}
+/**
+Load every vector with the difference of two others, \f$\vec{a} - \vec{b}\f$, wrapping on overflow. The result may be one of the inputs.
+@param a the first vectors
+@param b the second vectors; must have the same size as a
+@returns none
+*/
+	void loadDifference(const FixedTwoVectorArray & a, const FixedTwoVectorArray & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,2L * a.size(),24L * a.size());
+		resize(a.size());
+		const std::int32_t * ax = a.x();
+		const std::int32_t * ay = a.y();
+		const std::int32_t * bx = b.x();
+		const std::int32_t * by = b.y();
+		std::int32_t * rx = x();
+		std::int32_t * ry = y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				rx[TcI] = Fixed::add(ax[TcI],Fixed::negate(bx[TcI]));
+				ry[TcI] = Fixed::add(ay[TcI],Fixed::negate(by[TcI]));
+			}
+		});
+	}
+/**
+Add a multiple of other vectors to every vector, \f$\vec{v} \mathrel{+}= s\vec{a}\f$, with each product rounded as Fixed multiplication
+@param scalar the factor s
+@param a the vectors to add; must have the same size as this array. May be this array.
+@returns none
+*/
+	void addScaled(const Fixed & scalar, const FixedTwoVectorArray & a)
+	{
+		if (a.size() != size())
+			return;
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,4L * size(),24L * size());
+		std::int32_t s = scalar.raw();
+		const std::int32_t * ax = a.x();
+		const std::int32_t * ay = a.y();
+		std::int32_t * rx = x();
+		std::int32_t * ry = y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				rx[TcI] = Fixed::add(rx[TcI],Fixed::round(Fixed::product(s,ax[TcI])));
+				ry[TcI] = Fixed::add(ry[TcI],Fixed::round(Fixed::product(s,ay[TcI])));
+			}
+		});
+	}
+/**
+Compute the dot product of every vector with the corresponding vector of another array, as FixedTwoVector::dot
+@param vectors the other vectors; must have the same size as this array
+@param result receives the dot products; resized to size()
+@returns none
+*/
+	void dot(const FixedTwoVectorArray & vectors, std::vector<Fixed> & result) const
+	{
+		if (vectors.size() != size())
+			return;
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,3L * size(),20L * size());
+		result.resize(size());
+		const std::int32_t * ax = x();
+		const std::int32_t * ay = y();
+		const std::int32_t * bx = vectors.x();
+		const std::int32_t * by = vectors.y();
+		Fixed * r = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				r[TcI] = Fixed::fromRaw(Fixed::round(Fixed::product(ax[TcI],bx[TcI]) + Fixed::product(ay[TcI],by[TcI])));
+		});
+	}
+/**
+Compute the cross product of every vector with the corresponding vector of another array, \f$a_x b_y - a_y b_x\f$, as FixedTwoVector::cross
+@param vectors the other vectors; must have the same size as this array
+@param result receives the cross products; resized to size()
+@returns none
+*/
+	void cross(const FixedTwoVectorArray & vectors, std::vector<Fixed> & result) const
+	{
+		if (vectors.size() != size())
+			return;
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,3L * size(),20L * size());
+		result.resize(size());
+		const std::int32_t * ax = x();
+		const std::int32_t * ay = y();
+		const std::int32_t * bx = vectors.x();
+		const std::int32_t * by = vectors.y();
+		Fixed * r = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				r[TcI] = Fixed::fromRaw(Fixed::round(Fixed::product(ax[TcI],by[TcI]) - Fixed::product(ay[TcI],bx[TcI])));
+		});
+	}
+/**
+Compute the magnitude of every vector, as FixedTwoVector::magnitude
+@param result receives the magnitudes; resized to size()
+@returns none
+*/
+	void magnitude(std::vector<Fixed> & result) const
+	{
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,8L * size(),12L * size());
+		result.resize(size());
+		const std::int32_t * ax = x();
+		const std::int32_t * ay = y();
+		Fixed * r = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				r[TcI] = Fixed::fromRaw(Fixed::batchLength(Fixed::product(ax[TcI],ax[TcI]) + Fixed::product(ay[TcI],ay[TcI])));
+		});
+	}
+/**
+Scale every vector to unit length, as FixedTwoVector::unit; zero vectors are left unchanged
+@returns none
+*/
+	void normalize(void)
+	{
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,10L * size(),16L * size());
+		std::int32_t * rx = x();
+		std::int32_t * ry = y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t vx = rx[TcI], vy = ry[TcI];
+				std::int32_t mag = Fixed::batchLength(Fixed::product(vx,vx) + Fixed::product(vy,vy));
+				std::int32_t divisor = mag + (mag == 0 ? 1 : 0);
+				double reciprocal = 1.0 / divisor;
+				std::int32_t ux = Fixed::batchUnitDivide(vx,divisor,reciprocal);
+				std::int32_t uy = Fixed::batchUnitDivide(vy,divisor,reciprocal);
+				rx[TcI] = mag != 0 ? ux : vx;
+				ry[TcI] = mag != 0 ? uy : vy;
+			}
+		});
+	}
+/**
+Load every vector with the product of one matrix and the corresponding vector of another array, \f$M\vec{a}\f$, as FixedTwoMatrix::operator*. The result may be the input.
+@param matrix the matrix M
+@param vectors the vectors a
+@returns none
+*/
+	void loadTransform(const FixedTwoMatrix & matrix, const FixedTwoVectorArray & vectors)
+	{
+		LINALG_COUNT(FIXED_TWO_VECTOR_ARRAY,6L * vectors.size(),16L * vectors.size());
+		resize(vectors.size());
+		std::int32_t m00 = matrix.at(0,0).raw(), m01 = matrix.at(0,1).raw();
+		std::int32_t m10 = matrix.at(1,0).raw(), m11 = matrix.at(1,1).raw();
+		const std::int32_t * ax = vectors.x();
+		const std::int32_t * ay = vectors.y();
+		std::int32_t * rx = x();
+		std::int32_t * ry = y();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				std::int32_t vx = ax[TcI], vy = ay[TcI];
+				rx[TcI] = Fixed::round(Fixed::product(m00,vx) + Fixed::product(m01,vy));
+				ry[TcI] = Fixed::round(Fixed::product(m10,vx) + Fixed::product(m11,vy));
+			}
+		});
+	}
+};
@@ -0,0 +1,224 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ThreadPool.hpp>
+#ifdef __linux__
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+/**
+@brief CPU cycles, instructions, cache misses and branch misses of the whole process, read from the hardware performance counters
+@details On Linux the counters are opened with perf_event_open, as one group for each thread of the process (including the workers of the ThreadPool, which is started first), counting user mode only; start() and stop() bracket a region and value() gives the totals over all threads. When more events are open than the PMU has counters, for example while another program is profiling, the kernel shares the counters between the groups in turn; each count is then scaled by the time its group was enabled over the time it was counting, which estimates the full count, and a group that was never scheduled while enabled leaves its events unmeasured for that region, as measured() reports, rather than reading as zero. Any counter the kernel refuses, because perf_event_paranoid forbids it, the hardware lacks it or the process runs in a virtual machine without a PMU, is reported as unavailable and reads as zero, and the remaining counters still work. On other systems no counter is available. Threads created after the object are not counted.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class HardwareCounters
+{
+public:
+	static const int CYCLES = 0;
+	static const int INSTRUCTIONS = 1;
+	static const int CACHE_MISSES = 2;
+	static const int BRANCH_MISSES = 3;
+	static const int EVENTS = 4;
+private:
+	// the counters of one thread: the leader's descriptor and which events joined the group, in order
+	class Group
+	{
+	public:
+		int leader;
+		std::vector<int> descriptors;
+		std::vector<int> events;
+	};
+	std::vector<Group> _groups;
+	bool _available[EVENTS];
+	unsigned long long _values[EVENTS];
+	bool _measured[EVENTS];
+	std::string _error;
+
+#ifdef __linux__
+	static int openEvent(int event, int thread, int leader)
+	{
+		static const unsigned long long CONFIG[EVENTS] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_CACHE_MISSES,PERF_COUNT_HW_BRANCH_MISSES};
+		perf_event_attr attributes;
+		std::memset(&attributes,0,sizeof(attributes));
+		attributes.size = sizeof(attributes);
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.config = CONFIG[event];
+		attributes.disabled = leader < 0 ? 1 : 0;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		return (int)syscall(SYS_perf_event_open,&attributes,thread,-1,leader,0);
+	}
+	void openThread(int thread, bool usable[EVENTS])
+	{
+		int TcI;
+		Group group;
+		group.leader = -1;
+		for (TcI = 0; TcI < EVENTS; TcI++)
+		{
+			int descriptor = openEvent(TcI,thread,group.leader);
+			if (descriptor < 0)
+			{
+				usable[TcI] = false;
+				if (_error.empty())
+					_error = std::string("perf_event_open: ") + std::strerror(errno);
+				continue;
+			}
+			if (group.leader < 0)
+				group.leader = descriptor;
+			group.descriptors.push_back(descriptor);
+			group.events.push_back(TcI);
+		}
+		if (group.leader >= 0)
+			_groups.push_back(group);
+	}
+#endif
+public:
+/**
+HardwareCounters constructor. Opens the counters for every thread of the process.
+*/
+	HardwareCounters(void)
+	{
+		int TcI;
+		for (TcI = 0; TcI < EVENTS; TcI++)
+		{
+			_available[TcI] = false;
+			_values[TcI] = 0;
+			_measured[TcI] = false;
+		}
+#ifdef __linux__
+		bool usable[EVENTS] = {true,true,true,true};
+		ThreadPool::instance();
+		DIR * tasks = opendir("/proc/self/task");
+		if (tasks == nullptr)
+		{
+			_error = "cannot list /proc/self/task";
+			return;
+		}
+		struct dirent * entry;
+		while ((entry = readdir(tasks)) != nullptr)
+		{
+			if (entry->d_name[0] != '.')
+				openThread(std::atoi(entry->d_name),usable);
+		}
+		closedir(tasks);
+		// an event counts only if it could be opened on every thread
+		for (TcI = 0; TcI < EVENTS; TcI++)
+			_available[TcI] = usable[TcI] && !_groups.empty();
+#else
+		_error = "hardware counters are only supported on Linux";
+#endif
+	}
+	~HardwareCounters(void)
+	{
+#ifdef __linux__
+		for (auto & group : _groups)
+			for (int descriptor : group.descriptors)
+				close(descriptor);
+#endif
+	}
+	HardwareCounters(const HardwareCounters &) = delete;
+	HardwareCounters & operator =(const HardwareCounters &) = delete;
+
+/**
+Determine if a counter can be read
+@param event the counter: CYCLES, INSTRUCTIONS, CACHE_MISSES or BRANCH_MISSES
+@returns true if the counter was opened on every thread
+*/
+	bool available(int event) const
+	{
+		return event >= 0 && event < EVENTS && _available[event];
+	}
+/**
+Get the reason the first counter that could not be opened was refused
+@returns the error, or an empty string if every counter was opened
+*/
+	const std::string & error(void) const {return _error;}
+/**
+Reset the counters and start counting
+@returns none
+*/
+	void start(void)
+	{
+#ifdef __linux__
+		for (auto & group : _groups)
+		{
+			ioctl(group.leader,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+			ioctl(group.leader,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+		}
+#endif
+	}
+/**
+Stop counting and total the counts of every thread since start()
+@returns none
+*/
+	void stop(void)
+	{
+		int TcI;
+		for (TcI = 0; TcI < EVENTS; TcI++)
+		{
+			_values[TcI] = 0;
+			_measured[TcI] = _available[TcI];
+		}
+#ifdef __linux__
+		for (auto & group : _groups)
+			ioctl(group.leader,PERF_EVENT_IOC_DISABLE,PERF_IOC_FLAG_GROUP);
+		for (auto & group : _groups)
+		{
+			// the number of events, the times the group was enabled and counting, in nanoseconds, and the values of the events, in the order they joined
+			unsigned long long buffer[3 + EVENTS];
+			ssize_t bytes = read(group.leader,buffer,sizeof(buffer));
+			if (bytes < (ssize_t)(3 * sizeof(unsigned long long)))
+			{
+				for (int event : group.events)
+					_measured[event] = false;
+				continue;
+			}
+			unsigned long long enabled = buffer[1], running = buffer[2];
+			for (TcI = 0; TcI < (int)buffer[0] && TcI < (int)group.events.size(); TcI++)
+			{
+				// a thread that never ran is enabled and counting for no time and counts nothing
+				if (running == 0 && enabled > 0)
+					_measured[group.events[TcI]] = false;
+				else if (running < enabled)
+					_values[group.events[TcI]] += (unsigned long long)((double)buffer[3 + TcI] * ((double)enabled / (double)running) + 0.5);
+				else
+					_values[group.events[TcI]] += buffer[3 + TcI];
+			}
+		}
+#endif
+		for (TcI = 0; TcI < EVENTS; TcI++)
+		{
+			if (!_measured[TcI])
+				_values[TcI] = 0;
+		}
+	}
+/**
+Determine if a counter was measured between the last start() and stop()
+@param event the counter: CYCLES, INSTRUCTIONS, CACHE_MISSES or BRANCH_MISSES
+@returns true if the counter is available and counted on every thread that ran, for at least part of the time it was enabled
+*/
+	bool measured(int event) const
+	{
+		return available(event) && _measured[event];
+	}
+/**
+Get the count of an event between the last start() and stop()
+@param event the counter: CYCLES, INSTRUCTIONS, CACHE_MISSES or BRANCH_MISSES
+@returns the total over all threads, scaled up where the counters were shared, or 0 if the counter was not measured
+*/
+	unsigned long long value(int event) const
+	{
+		return measured(event) ? _values[event] : 0;
+	}
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <Vector.hpp>
+#include <ThreadPool.hpp>
+/**
+@brief The trivial preconditioner \f$M^{-1} = I\f$, for running the iterative solvers unpreconditioned
+@details Preconditioners provide apply(residual, result), which computes \f$\vec{z} = M^{-1}\vec{r}\f$ and returns \f$\vec{r}\bullet\vec{z}\f$ from the same pass over memory.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class IdentityPreconditioner
+{
+public:
+/**
+Apply the preconditioner, \f$\vec{z} = \vec{r}\f$
+@param residual the Vector to precondition
+@param result the Vector that receives the preconditioned residual; must have the same size as residual
+@returns \f$\vec{r}\bullet\vec{z}\f$
+*/
+	float apply(const Vector & residual, Vector & result) const
+	{
+		const float * r = residual.data();
+		float * z = result.data();
+		return (float)ThreadPool::instance().parallelSum(0,residual.size(),8192,[&](long first, long last)
+		{
+			long TcI;
+			float sum = 0.0;
+#pragma omp simd reduction(+:sum)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				z[TcI] = r[TcI];
+				sum += r[TcI] * r[TcI];
+			}
+			return (double)sum;
+		});
+	}
+};
+
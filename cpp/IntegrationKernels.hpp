@@ -0,0 +1,329 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <ThreeVector.hpp>
+#include <ThreeVectorArray.hpp>
+#include <ThreeMatrixArray.hpp>
+#include <SinCos.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief Fused, multithreaded time integration kernels for particles and rigid bodies stored as structures of arrays
+@details Each kernel reads every position, velocity and acceleration of a step once and writes the results once, so a step costs one pass over memory instead of the several temporaries and passes of a loop over ThreeVector::operator * and operator +=. Uniform gravity is added to every acceleration, and damping is applied as the exact decay \f$e^{-c\Delta t}\f$ of the velocity over the step, which stays stable for any step length. Each new position and velocity is within 3 ulp of the sum of the magnitudes of the terms it is computed from, and each element of an orientation within 4 ulp of the larger of one and the angle of the step, for angles whose squares do not overflow.
+
+semiImplicitEuler updates the velocity first and then moves the position with the new velocity; it is symplectic, so energy does not drift in long runs. Velocity Verlet is split into velocityVerletDrift, before the accelerations are evaluated at the new positions, and velocityVerletKick, after; when velocities are needed only at output times, the kick of one step and the drift of the next combine into a full kick followed by a drift, which is semiImplicitEuler with the velocities offset by half a step (leapfrog), so a second order step also needs only one pass. integrateOrientations advances the orientations of rigid bodies by their angular velocities with the exponential map.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class IntegrationKernels
+{
+private:
+	static const long GRAIN = 16384;
+
+	// v = (v + (acceleration(i) + g) dt) decay, x += v dt, in one pass
+	template <typename Acceleration> static void euler(ThreeVectorArray & positions, ThreeVectorArray & velocities, const Acceleration & acceleration, const ThreeVector & gravity, float damping, float dt)
+	{
+		float * px = positions.x();
+		float * py = positions.y();
+		float * pz = positions.z();
+		float * vx = velocities.x();
+		float * vy = velocities.y();
+		float * vz = velocities.z();
+		float gx = gravity.getX();
+		float gy = gravity.getY();
+		float gz = gravity.getZ();
+		float decay = std::exp(-damping * dt);
+		ThreadPool::instance().parallelFor(0,positions.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float ax,ay,az;
+				acceleration(TcI,ax,ay,az);
+				float ux = (vx[TcI] + (ax + gx) * dt) * decay;
+				float uy = (vy[TcI] + (ay + gy) * dt) * decay;
+				float uz = (vz[TcI] + (az + gz) * dt) * decay;
+				vx[TcI] = ux;
+				vy[TcI] = uy;
+				vz[TcI] = uz;
+				px[TcI] += ux * dt;
+				py[TcI] += uy * dt;
+				pz[TcI] += uz * dt;
+			}
+		});
+	}
+	// R = exp(w dt) R for angular velocities in the world frame, or R = R exp(w dt) in the body frame
+	template <bool BODY> static void rotate(ThreeMatrixArray & orientations, const ThreeVectorArray & angularVelocities, float dt)
+	{
+		const float * wx = angularVelocities.x();
+		const float * wy = angularVelocities.y();
+		const float * wz = angularVelocities.z();
+		float * m00 = orientations.element(0,0);
+		float * m01 = orientations.element(0,1);
+		float * m02 = orientations.element(0,2);
+		float * m10 = orientations.element(1,0);
+		float * m11 = orientations.element(1,1);
+		float * m12 = orientations.element(1,2);
+		float * m20 = orientations.element(2,0);
+		float * m21 = orientations.element(2,1);
+		float * m22 = orientations.element(2,2);
+		ThreadPool::instance().parallelFor(0,orientations.size(),GRAIN,[&](long first, long last)
+		{
+			const float SERIES_LIMIT = 1.0e-4f;
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float x = wx[TcI] * dt;
+				float y = wy[TcI] * dt;
+				float z = wz[TcI] * dt;
+				float angleSquared = x * x + y * y + z * z;
+				int useSeries = angleSquared < SERIES_LIMIT;
+				float safeSquared = useSeries ? 1.0f : angleSquared;
+				float angle = std::sqrt(safeSquared);
+				float halfSine,halfCosine;
+				SinCos::compute(0.5f * angle,halfSine,halfCosine);
+				float a = useSeries ? 1.0f - angleSquared / 6.0f * (1.0f - angleSquared / 20.0f) : 2.0f * halfSine * halfCosine / angle;
+				float b = useSeries ? 0.5f - angleSquared / 24.0f * (1.0f - angleSquared / 30.0f) : 2.0f * halfSine * halfSine / safeSquared;
+				float e00 = 1.0f + b * (x * x - angleSquared), e01 = b * x * y - a * z, e02 = b * x * z + a * y;
+				float e10 = b * y * x + a * z, e11 = 1.0f + b * (y * y - angleSquared), e12 = b * y * z - a * x;
+				float e20 = b * z * x - a * y, e21 = b * z * y + a * x, e22 = 1.0f + b * (z * z - angleSquared);
+				float r00 = m00[TcI], r01 = m01[TcI], r02 = m02[TcI];
+				float r10 = m10[TcI], r11 = m11[TcI], r12 = m12[TcI];
+				float r20 = m20[TcI], r21 = m21[TcI], r22 = m22[TcI];
+				if (BODY)
+				{
+					m00[TcI] = r00 * e00 + r01 * e10 + r02 * e20;
+					m01[TcI] = r00 * e01 + r01 * e11 + r02 * e21;
+					m02[TcI] = r00 * e02 + r01 * e12 + r02 * e22;
+					m10[TcI] = r10 * e00 + r11 * e10 + r12 * e20;
+					m11[TcI] = r10 * e01 + r11 * e11 + r12 * e21;
+					m12[TcI] = r10 * e02 + r11 * e12 + r12 * e22;
+					m20[TcI] = r20 * e00 + r21 * e10 + r22 * e20;
+					m21[TcI] = r20 * e01 + r21 * e11 + r22 * e21;
+					m22[TcI] = r20 * e02 + r21 * e12 + r22 * e22;
+				}
+				else
+				{
+					m00[TcI] = e00 * r00 + e01 * r10 + e02 * r20;
+					m01[TcI] = e00 * r01 + e01 * r11 + e02 * r21;
+					m02[TcI] = e00 * r02 + e01 * r12 + e02 * r22;
+					m10[TcI] = e10 * r00 + e11 * r10 + e12 * r20;
+					m11[TcI] = e10 * r01 + e11 * r11 + e12 * r21;
+					m12[TcI] = e10 * r02 + e11 * r12 + e12 * r22;
+					m20[TcI] = e20 * r00 + e21 * r10 + e22 * r20;
+					m21[TcI] = e20 * r01 + e21 * r11 + e22 * r21;
+					m22[TcI] = e20 * r02 + e21 * r12 + e22 * r22;
+				}
+			}
+		});
+	}
+public:
+/**
+Advance particles one step by semi-implicit (symplectic) Euler: \f$\vec{v} \mathrel{+}= \vec{a}\Delta t\f$, then \f$\vec{x} \mathrel{+}= \vec{v}\Delta t\f$
+@param positions the positions x, updated in place
+@param velocities the velocities v, updated in place; must have the same size as positions
+@param accelerations the accelerations a; must have the same size as positions
+@param dt the time step
+@returns none
+*/
+	static void semiImplicitEuler(ThreeVectorArray & positions, ThreeVectorArray & velocities, const ThreeVectorArray & accelerations, float dt)
+	{
+		semiImplicitEuler(positions,velocities,accelerations,ThreeVector(),0.0f,dt);
+	}
+/**
+Advance particles one step by semi-implicit Euler under accelerations, uniform gravity and damping: \f$\vec{v} = (\vec{v} + (\vec{a} + \vec{g})\Delta t)e^{-c\Delta t}\f$, then \f$\vec{x} \mathrel{+}= \vec{v}\Delta t\f$
+@param positions the positions x, updated in place
+@param velocities the velocities v, updated in place; must have the same size as positions
+@param accelerations the accelerations a; must have the same size as positions
+@param gravity the acceleration g added to every particle
+@param damping the damping rate c, per unit time; 0 for none
+@param dt the time step
+@returns none
+*/
+	static void semiImplicitEuler(ThreeVectorArray & positions, ThreeVectorArray & velocities, const ThreeVectorArray & accelerations, const ThreeVector & gravity, float damping, float dt)
+	{
+		if (velocities.size() != positions.size() || accelerations.size() != positions.size())
+			return;
+		LINALG_COUNT(INTEGRATE_PARTICLES,18L * positions.size(),60L * positions.size());
+		const float * ax = accelerations.x();
+		const float * ay = accelerations.y();
+		const float * az = accelerations.z();
+		euler(positions,velocities,[=](long idx, float & x, float & y, float & z)
+		{
+			x = ax[idx];
+			y = ay[idx];
+			z = az[idx];
+		},gravity,damping,dt);
+	}
+/**
+Advance particles one step by semi-implicit Euler under forces, uniform gravity and damping: \f$\vec{v} = (\vec{v} + (w\vec{f} + \vec{g})\Delta t)e^{-c\Delta t}\f$, then \f$\vec{x} \mathrel{+}= \vec{v}\Delta t\f$, where w is the inverse of the mass
+@param positions the positions x, updated in place
+@param velocities the velocities v, updated in place; must have the same size as positions
+@param forces the forces f; must have the same size as positions
+@param inverseMasses the inverse masses w, 0 for particles that forces do not move; must have the same size as positions
+@param gravity the acceleration g added to every particle
+@param damping the damping rate c, per unit time; 0 for none
+@param dt the time step
+@returns none
+*/
+	static void semiImplicitEuler(ThreeVectorArray & positions, ThreeVectorArray & velocities, const ThreeVectorArray & forces, const std::vector<float> & inverseMasses, const ThreeVector & gravity, float damping, float dt)
+	{
+		if (velocities.size() != positions.size() || forces.size() != positions.size() || (int)inverseMasses.size() != positions.size())
+			return;
+		LINALG_COUNT(INTEGRATE_PARTICLES,21L * positions.size(),64L * positions.size());
+		const float * fx = forces.x();
+		const float * fy = forces.y();
+		const float * fz = forces.z();
+		const float * w = inverseMasses.data();
+		euler(positions,velocities,[=](long idx, float & x, float & y, float & z)
+		{
+			x = fx[idx] * w[idx];
+			y = fy[idx] * w[idx];
+			z = fz[idx] * w[idx];
+		},gravity,damping,dt);
+	}
+/**
+Advance particles one step by semi-implicit Euler under uniform gravity and damping alone: \f$\vec{v} = (\vec{v} + \vec{g}\Delta t)e^{-c\Delta t}\f$, then \f$\vec{x} \mathrel{+}= \vec{v}\Delta t\f$
+@param positions the positions x, updated in place
+@param velocities the velocities v, updated in place; must have the same size as positions
+@param gravity the acceleration g of every particle
+@param damping the damping rate c, per unit time; 0 for none
+@param dt the time step
+@returns none
+*/
+	static void semiImplicitEuler(ThreeVectorArray & positions, ThreeVectorArray & velocities, const ThreeVector & gravity, float damping, float dt)
+	{
+		if (velocities.size() != positions.size())
+			return;
+		LINALG_COUNT(INTEGRATE_PARTICLES,15L * positions.size(),48L * positions.size());
+		euler(positions,velocities,[](long, float & x, float & y, float & z)
+		{
+			x = y = z = 0.0f;
+		},gravity,damping,dt);
+	}
+/**
+Apply uniform gravity and damping to velocities over a step, \f$\vec{v} = (\vec{v} + \vec{g}\Delta t)e^{-c\Delta t}\f$, without moving the particles
+@param velocities the velocities v, updated in place
+@param gravity the acceleration g of every particle
+@param damping the damping rate c, per unit time; 0 for none
+@param dt the time step
+@returns none
+*/
+	static void applyGravityAndDamping(ThreeVectorArray & velocities, const ThreeVector & gravity, float damping, float dt)
+	{
+		LINALG_COUNT(INTEGRATE_PARTICLES,6L * velocities.size(),24L * velocities.size());
+		float * vx = velocities.x();
+		float * vy = velocities.y();
+		float * vz = velocities.z();
+		float gx = gravity.getX() * dt;
+		float gy = gravity.getY() * dt;
+		float gz = gravity.getZ() * dt;
+		float decay = std::exp(-damping * dt);
+		ThreadPool::instance().parallelFor(0,velocities.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				vx[TcI] = (vx[TcI] + gx) * decay;
+				vy[TcI] = (vy[TcI] + gy) * decay;
+				vz[TcI] = (vz[TcI] + gz) * decay;
+			}
+		});
+	}
+/**
+Perform the first half of a velocity Verlet step: \f$\vec{v} \mathrel{+}= \frac{1}{2}\vec{a}\Delta t\f$, then \f$\vec{x} \mathrel{+}= \vec{v}\Delta t\f$. Evaluate the accelerations at the new positions and finish the step with velocityVerletKick.
+@param positions the positions x, updated in place
+@param velocities the velocities v, updated in place to the velocities at the middle of the step; must have the same size as positions
+@param accelerations the accelerations a at the start of the step; must have the same size as positions
+@param dt the time step
+@returns none
+*/
+	static void velocityVerletDrift(ThreeVectorArray & positions, ThreeVectorArray & velocities, const ThreeVectorArray & accelerations, float dt)
+	{
+		if (velocities.size() != positions.size() || accelerations.size() != positions.size())
+			return;
+		LINALG_COUNT(INTEGRATE_PARTICLES,12L * positions.size(),60L * positions.size());
+		float * px = positions.x();
+		float * py = positions.y();
+		float * pz = positions.z();
+		float * vx = velocities.x();
+		float * vy = velocities.y();
+		float * vz = velocities.z();
+		const float * ax = accelerations.x();
+		const float * ay = accelerations.y();
+		const float * az = accelerations.z();
+		float halfStep = 0.5f * dt;
+		ThreadPool::instance().parallelFor(0,positions.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float ux = vx[TcI] + ax[TcI] * halfStep;
+				float uy = vy[TcI] + ay[TcI] * halfStep;
+				float uz = vz[TcI] + az[TcI] * halfStep;
+				vx[TcI] = ux;
+				vy[TcI] = uy;
+				vz[TcI] = uz;
+				px[TcI] += ux * dt;
+				py[TcI] += uy * dt;
+				pz[TcI] += uz * dt;
+			}
+		});
+	}
+/**
+Perform the second half of a velocity Verlet step, \f$\vec{v} \mathrel{+}= \frac{1}{2}\vec{a}\Delta t\f$
+@param velocities the velocities v at the middle of the step, updated in place to those at the end
+@param accelerations the accelerations a at the end of the step; must have the same size as velocities
+@param dt the time step
+@returns none
+*/
+	static void velocityVerletKick(ThreeVectorArray & velocities, const ThreeVectorArray & accelerations, float dt)
+	{
+		if (accelerations.size() != velocities.size())
+			return;
+		LINALG_COUNT(INTEGRATE_PARTICLES,6L * velocities.size(),36L * velocities.size());
+		float * vx = velocities.x();
+		float * vy = velocities.y();
+		float * vz = velocities.z();
+		const float * ax = accelerations.x();
+		const float * ay = accelerations.y();
+		const float * az = accelerations.z();
+		float halfStep = 0.5f * dt;
+		ThreadPool::instance().parallelFor(0,velocities.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				vx[TcI] += ax[TcI] * halfStep;
+				vy[TcI] += ay[TcI] * halfStep;
+				vz[TcI] += az[TcI] * halfStep;
+			}
+		});
+	}
+/**
+Advance the orientations of rigid bodies one step by their angular velocities, \f$R = \exp([\vec{\omega}\Delta t]_\times)R\f$ for angular velocities in the world frame or \f$R = R\exp([\vec{\omega}\Delta t]_\times)\f$ in the body frame, with the exponential map of ThreeMatrixArray::loadExp computed in the same pass. Each update is an exact rotation, but rounding slowly moves the matrices away from orthogonality; call ThreeMatrixArray::orthonormalizeGramSchmidt with a tolerance every few hundred steps to correct them.
+@param orientations the orientations R, updated in place
+@param angularVelocities the angular velocities, in radians per unit time; must have the same size as orientations
+@param dt the time step
+@param bodyFrame true if the angular velocities are expressed in each body's own frame
+@returns none
+*/
+	static void integrateOrientations(ThreeMatrixArray & orientations, const ThreeVectorArray & angularVelocities, float dt, bool bodyFrame = false)
+	{
+		if (angularVelocities.size() != orientations.size())
+			return;
+		LINALG_COUNT(INTEGRATE_ORIENTATIONS,108L * orientations.size(),84L * orientations.size());
+		if (bodyFrame)
+			rotate<true>(orientations,angularVelocities,dt);
+		else
+			rotate<false>(orientations,angularVelocities,dt);
+	}
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <Vector.hpp>
+#include <SparseMatrix.hpp>
+#include <ThreadPool.hpp>
+/**
+@brief The Jacobi (diagonal) preconditioner \f$M^{-1} = D^{-1}\f$
+@details The reciprocal of the diagonal is computed once. Zero diagonal elements are treated as one.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class JacobiPreconditioner
+{
+private:
+	Vector _inverseDiagonal;
+public:
+/**
+JacobiPreconditioner constructor
+@param diagonal the diagonal of the matrix
+*/
+	JacobiPreconditioner(const Vector & diagonal)
+	{
+		int TcI;
+		_inverseDiagonal = diagonal;
+		for (TcI = 0; TcI < _inverseDiagonal.size(); TcI++)
+		{
+			if (_inverseDiagonal[TcI] != 0.0)
+				_inverseDiagonal[TcI] = 1.0 / _inverseDiagonal[TcI];
+			else
+				_inverseDiagonal[TcI] = 1.0;
+		}
+	}
+/**
+JacobiPreconditioner constructor
+@param matrix the matrix whose diagonal is used
+*/
+	JacobiPreconditioner(const SparseMatrix & matrix) : JacobiPreconditioner(matrix.diagonal())
+	{
+	}
+/**
+Apply the preconditioner, \f$\vec{z} = D^{-1}\vec{r}\f$
+@param residual the Vector to precondition
+@param result the Vector that receives the preconditioned residual; must have the same size as residual
+@returns \f$\vec{r}\bullet\vec{z}\f$
+*/
+	float apply(const Vector & residual, Vector & result) const
+	{
+		const float * r = residual.data();
+		const float * d = _inverseDiagonal.data();
+		float * z = result.data();
+		return (float)ThreadPool::instance().parallelSum(0,residual.size(),8192,[&](long first, long last)
+		{
+			long TcI;
+			float sum = 0.0;
+#pragma omp simd reduction(+:sum)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				z[TcI] = d[TcI] * r[TcI];
+				sum += r[TcI] * z[TcI];
+			}
+			return (double)sum;
+		});
+	}
+};
+
@@ -0,0 +1,299 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <LatencyHistogram.hpp>
+#include <HardwareCounters.hpp>
+#include <OperationCounters.hpp>
+#include <ThreeVectorTiles.hpp>
+#include <ThreeMatrixTiles.hpp>
+#include <TwoMatrixArray.hpp>
+#include <VectorKernels.hpp>
+/**
+@brief Per-call latency histograms and hardware counter totals for the bulk kernels
+@details Each call to measure() runs one kernel call between reads of the clock and of the HardwareCounters, and adds the latency to a histogram kept for that kernel's name, so the report shows the tail (p99, p99.9 and the maximum) and not only the mean. The counters cover every thread of the pool, so instructions per cycle (IPC) and bytes per cycle describe the whole parallel kernel. A kernel that moves many bytes per cycle at a low IPC is limited by memory bandwidth, and one with a high IPC and few bytes per cycle by arithmetic; cache misses per call show which level of the hierarchy the data came from. Where the counters are not available the report gives the latencies and bandwidth alone. A call during which the counters were not measured, because the PMU was shared and never scheduled them (see HardwareCounters), adds to the latencies but not to the counter totals, and the rates per call and per cycle are taken over the calls that were counted.
+
+The matrix-vector transforms, normalization, inverse and dot product reduction have ready-made entry points, which run the kernel under measure() with the bytes it reads and writes and record it under the kernel's own name, such as "ThreeVectorTiles::normalize"; other kernels are profiled by passing them to measure().
+
+Reading the counters costs a few system calls per thread, a few microseconds in all, which is included in the latency; profile calls on arrays large enough that this does not matter.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class KernelProfiler
+{
+private:
+	class Kernel
+	{
+	public:
+		std::string name;
+		LatencyHistogram latency;
+		double bytes;
+		// the calls whose counters were measured, and the bytes they moved
+		unsigned long long counted;
+		double countedBytes;
+		unsigned long long events[HardwareCounters::EVENTS];
+	};
+	std::vector<Kernel> _kernels;
+	HardwareCounters _counters;
+	bool _counted;
+
+	Kernel & find(const std::string & name)
+	{
+		int TcI;
+		for (auto & kernel : _kernels)
+		{
+			if (kernel.name == name)
+				return kernel;
+		}
+		_kernels.push_back(Kernel());
+		Kernel & kernel = _kernels.back();
+		kernel.name = name;
+		kernel.bytes = 0.0;
+		kernel.counted = 0;
+		kernel.countedBytes = 0.0;
+		for (TcI = 0; TcI < HardwareCounters::EVENTS; TcI++)
+			kernel.events[TcI] = 0;
+		return kernel;
+	}
+	const Kernel * find(const std::string & name) const
+	{
+		for (auto & kernel : _kernels)
+		{
+			if (kernel.name == name)
+				return &kernel;
+		}
+		return nullptr;
+	}
+public:
+/**
+KernelProfiler constructor. Opens the hardware counters for every thread of the process, so it should be created after any threads that run kernels.
+*/
+	KernelProfiler(void)
+	{
+		_counted = false;
+	}
+/**
+Run a kernel once and record its latency and counters
+@param name the name under which the call is recorded
+@param bytes the bytes the kernel reads and writes, used for the bandwidth and bytes per cycle; for example 40 per matrix for ThreeMatrixArray::loadRotationX, which reads an angle and writes a matrix
+@param kernel the function to run, called as kernel()
+@returns the latency in seconds
+*/
+	template <typename Body> double measure(const std::string & name, double bytes, const Body & kernel)
+	{
+		int TcI;
+		Kernel & record = find(name);
+		_counters.start();
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		kernel();
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		_counters.stop();
+		long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		record.latency.record((unsigned long long)(nanoseconds > 0 ? nanoseconds : 0));
+		record.bytes += bytes;
+		// a call is counted if every available counter was measured, and there is at least one
+		_counted = false;
+		for (TcI = 0; TcI < HardwareCounters::EVENTS; TcI++)
+		{
+			if (_counters.available(TcI) && !_counters.measured(TcI))
+				break;
+			_counted = _counted || _counters.available(TcI);
+		}
+		_counted = _counted && TcI == HardwareCounters::EVENTS;
+		if (_counted)
+		{
+			record.counted++;
+			record.countedBytes += bytes;
+			for (TcI = 0; TcI < HardwareCounters::EVENTS; TcI++)
+				record.events[TcI] += _counters.value(TcI);
+		}
+		return (double)nanoseconds * 1.0e-9;
+	}
+/**
+Run a kernel once and record its latency and counters, taking the bytes it moves from the OperationCounters. This is the nominal count of bytes of the library operations the kernel calls when LINALG_ENABLE_COUNTERS is defined, and zero otherwise.
+@param name the name under which the call is recorded
+@param kernel the function to run, called as kernel()
+@returns the latency in seconds
+*/
+	template <typename Body> double measure(const std::string & name, const Body & kernel)
+	{
+		OperationCounters::Snapshot before = OperationCounters::snapshot();
+		double seconds = measure(name,0.0,kernel);
+		double bytes = (double)(OperationCounters::snapshot() - before).totalBytes();
+		Kernel & record = find(name);
+		record.bytes += bytes;
+		if (_counted)
+			record.countedBytes += bytes;
+		return seconds;
+	}
+/**
+Transform every vector by the corresponding matrix, with ThreeMatrixTiles::transform, and record the call
+@param matrices the matrices
+@param vectors the vectors; must have the same size as matrices
+@param result receives the products; resized to match. May be vectors.
+@returns the latency in seconds
+*/
+	double transform(const ThreeMatrixTiles & matrices, const ThreeVectorTiles & vectors, ThreeVectorTiles & result)
+	{
+		return measure("ThreeMatrixTiles::transform",60.0 * matrices.size(),[&]() {matrices.transform(vectors,result);});
+	}
+/**
+Transform every vector by one matrix, with ThreeVectorTiles::loadTransform, and record the call
+@param matrix the matrix
+@param vectors the vectors
+@param result receives the products; resized to match. May be vectors.
+@returns the latency in seconds
+*/
+	double transform(const ThreeMatrix & matrix, const ThreeVectorTiles & vectors, ThreeVectorTiles & result)
+	{
+		return measure("ThreeVectorTiles::loadTransform",24.0 * vectors.size(),[&]() {result.loadTransform(matrix,vectors);});
+	}
+/**
+Scale every vector to unit length, with ThreeVectorTiles::normalize, and record the call
+@param vectors the vectors to normalize
+@returns the latency in seconds
+*/
+	double normalize(ThreeVectorTiles & vectors)
+	{
+		return measure("ThreeVectorTiles::normalize",24.0 * vectors.size(),[&]() {vectors.normalize();});
+	}
+/**
+Invert every matrix, with TwoMatrixArray::invert, and record the call
+@param matrices the matrices
+@param result receives the inverses; resized to match. May be matrices.
+@param singular receives 1 for each singular matrix and 0 otherwise; resized to match
+@param tolerance the largest determinant magnitude that is treated as singular
+@returns the number of singular matrices
+*/
+	long invert(const TwoMatrixArray & matrices, TwoMatrixArray & result, std::vector<unsigned char> & singular, float tolerance = 0.0f)
+	{
+		long ret = 0;
+		measure("TwoMatrixArray::invert",33.0 * matrices.size(),[&]() {ret = matrices.invert(result,singular,tolerance);});
+		return ret;
+	}
+/**
+Compute a dot product, with VectorKernels::dot, and record the call
+@param vectA the first vector
+@param vectB the second vector
+@returns the dot product
+*/
+	double dot(const Vector & vectA, const Vector & vectB)
+	{
+		double ret = 0.0;
+		measure("VectorKernels::dot",8.0 * vectA.size(),[&]() {ret = VectorKernels::dot(vectA,vectB);});
+		return ret;
+	}
+/**
+Get the latency histogram of a kernel
+@param name the name of the kernel
+@returns the histogram, or an empty histogram if no calls have been recorded under that name
+*/
+	LatencyHistogram latency(const std::string & name) const
+	{
+		const Kernel * kernel = find(name);
+		return kernel != nullptr ? kernel->latency : LatencyHistogram();
+	}
+/**
+Get the total of a hardware counter over every recorded call of a kernel
+@param name the name of the kernel
+@param event the counter: HardwareCounters::CYCLES, INSTRUCTIONS, CACHE_MISSES or BRANCH_MISSES
+@returns the total over the calls whose counters were measured, or 0 if the counter is not available or no calls have been recorded
+*/
+	unsigned long long total(const std::string & name, int event) const
+	{
+		const Kernel * kernel = find(name);
+		return kernel != nullptr && _counters.available(event) ? kernel->events[event] : 0;
+	}
+/**
+Get the instructions per cycle of a kernel
+@param name the name of the kernel
+@returns the instructions per cycle over every recorded call, or 0 if the counters are not available
+*/
+	double instructionsPerCycle(const std::string & name) const
+	{
+		unsigned long long cycles = total(name,HardwareCounters::CYCLES);
+		return cycles > 0 ? (double)total(name,HardwareCounters::INSTRUCTIONS) / (double)cycles : 0.0;
+	}
+/**
+Get the bytes moved per cycle by a kernel
+@param name the name of the kernel
+@returns the bytes per cycle, summed over threads, for the calls whose counters were measured, or 0 if the cycle counter is not available
+*/
+	double bytesPerCycle(const std::string & name) const
+	{
+		const Kernel * kernel = find(name);
+		unsigned long long cycles = total(name,HardwareCounters::CYCLES);
+		return kernel != nullptr && cycles > 0 ? kernel->countedBytes / (double)cycles : 0.0;
+	}
+/**
+Get the number of calls of a kernel whose hardware counters were measured
+@param name the name of the kernel
+@returns the number of calls, or 0 if no calls have been recorded
+*/
+	unsigned long long countedCalls(const std::string & name) const
+	{
+		const Kernel * kernel = find(name);
+		return kernel != nullptr ? kernel->counted : 0;
+	}
+/**
+Get the hardware counters used by the profiler, to check which are available
+@returns the counters
+*/
+	const HardwareCounters & counters(void) const {return _counters;}
+/**
+Remove every recorded call
+@returns none
+*/
+	void clear(void)
+	{
+		_kernels.clear();
+	}
+/**
+Format a report with one line per kernel: the number of calls, the mean, median, 99th and 99.9th percentile and largest latencies in microseconds, the bandwidth in GB/s, and, where the counters are available, the instructions per cycle, bytes per cycle and cache and branch misses per call
+@returns the report
+*/
+	std::string report(void) const
+	{
+		char line[256];
+		std::string ret;
+		bool hardware = _counters.available(HardwareCounters::CYCLES) && _counters.available(HardwareCounters::INSTRUCTIONS);
+		std::snprintf(line,sizeof(line),"%-32s %8s %10s %10s %10s %10s %10s %8s %6s %8s %12s %12s\n","kernel","calls","mean us","p50 us","p99 us","p99.9 us","max us","GB/s","IPC","B/cycle","cache miss","branch miss");
+		ret += line;
+		for (auto & kernel : _kernels)
+		{
+			const LatencyHistogram & latency = kernel.latency;
+			double calls = (double)latency.count();
+			double seconds = latency.mean() * calls * 1.0e-9;
+			int length = std::snprintf(line,sizeof(line),"%-32s %8llu %10.1f %10.1f %10.1f %10.1f %10.1f %8.2f",kernel.name.c_str(),latency.count(),latency.mean() * 1.0e-3,latency.percentile(50.0) * 1.0e-3,latency.percentile(99.0) * 1.0e-3,latency.percentile(99.9) * 1.0e-3,latency.maximum() * 1.0e-3,seconds > 0.0 ? kernel.bytes / seconds * 1.0e-9 : 0.0);
+			if (hardware && kernel.counted > 0 && length > 0 && length < (int)sizeof(line))
+			{
+				double cycles = (double)kernel.events[HardwareCounters::CYCLES];
+				double counted = (double)kernel.counted;
+				std::snprintf(line + length,sizeof(line) - length," %6.2f %8.3f",cycles > 0.0 ? kernel.events[HardwareCounters::INSTRUCTIONS] / cycles : 0.0,cycles > 0.0 ? kernel.countedBytes / cycles : 0.0);
+				ret += line;
+				if (_counters.available(HardwareCounters::CACHE_MISSES))
+					std::snprintf(line,sizeof(line)," %12.0f",kernel.events[HardwareCounters::CACHE_MISSES] / counted);
+				else
+					std::snprintf(line,sizeof(line)," %12s","-");
+				ret += line;
+				if (_counters.available(HardwareCounters::BRANCH_MISSES))
+					std::snprintf(line,sizeof(line)," %12.0f\n",kernel.events[HardwareCounters::BRANCH_MISSES] / counted);
+				else
+					std::snprintf(line,sizeof(line)," %12s\n","-");
+				ret += line;
+			}
+			else
+			{
+				ret += line;
+				ret += "      -        -            -            -\n";
+			}
+		}
+		if (!hardware)
+			ret += "hardware counters unavailable: " + (_counters.error().empty() ? std::string("cycles or instructions not supported") : _counters.error()) + "\n";
+		return ret;
+	}
+};
@@ -0,0 +1,282 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <Matrix.hpp>
+#include <TwoMatrix.hpp>
+#include <ThreeMatrix.hpp>
+
+/**
+@brief A reusable LU factorization with partial pivoting of a square Matrix
+@details The factorization is computed once by the constructor and may then be used to solve for any number of right hand sides. Large matrices are factored with a blocked right-looking algorithm whose trailing updates are performed with Gemm, so that most of the work runs multithreaded. 2x2 and 3x3 matrices are handled by TwoMatrix and ThreeMatrix.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class LUFactorization
+{
+private:
+	static const int BLOCK = 64;
+	int _size;
+	bool _singular;
+	double _determinant;
+	Matrix _lu;
+	std::vector<int> _pivots;
+	TwoMatrix _inverse2;
+	ThreeMatrix _inverse3;
+
+	void factorPanel(int first, int last)
+	{
+		int TcI,TcJ,TcK;
+		float * a = _lu.data();
+		for (TcJ = first; TcJ < last; TcJ++)
+		{
+			int pivot = TcJ;
+			float largest = std::fabs(a[(size_t)TcJ * _size + TcJ]);
+			for (TcI = TcJ + 1; TcI < _size; TcI++)
+			{
+				float value = std::fabs(a[(size_t)TcI * _size + TcJ]);
+				if (value > largest)
+				{
+					largest = value;
+					pivot = TcI;
+				}
+			}
+			if (pivot != TcJ)
+			{
+				float * rowA = a + (size_t)TcJ * _size;
+				float * rowB = a + (size_t)pivot * _size;
+				for (TcK = 0; TcK < _size; TcK++)
+				{
+					float temp = rowA[TcK];
+					rowA[TcK] = rowB[TcK];
+					rowB[TcK] = temp;
+				}
+				int tempPivot = _pivots[TcJ];
+				_pivots[TcJ] = _pivots[pivot];
+				_pivots[pivot] = tempPivot;
+				_determinant = -_determinant;
+			}
+			float diagonal = a[(size_t)TcJ * _size + TcJ];
+			_determinant *= diagonal;
+			if (diagonal == 0.0)
+			{
+				_singular = true;
+				continue;
+			}
+			float invDiagonal = 1.0 / diagonal;
+			const float * pivotRow = a + (size_t)TcJ * _size;
+			for (TcI = TcJ + 1; TcI < _size; TcI++)
+			{
+				float * row = a + (size_t)TcI * _size;
+				float factor = row[TcJ] * invDiagonal;
+				row[TcJ] = factor;
+				for (TcK = TcJ + 1; TcK < last; TcK++)
+					row[TcK] -= factor * pivotRow[TcK];
+			}
+		}
+	}
+	void factor(void)
+	{
+		int first;
+		float * a = _lu.data();
+		for (first = 0; first < _size; first += BLOCK)
+		{
+			int last = first + BLOCK < _size ? first + BLOCK : _size;
+			factorPanel(first,last);
+			if (last >= _size)
+				break;
+			// U12 = L11^-1 A12, split over the trailing columns
+			ThreadPool::instance().parallelFor(last,_size,64,[&](long columnFirst, long columnLast)
+			{
+				int TcI,TcK;
+				long TcJ;
+				for (TcI = first + 1; TcI < last; TcI++)
+				{
+					float * row = a + (size_t)TcI * _size;
+					for (TcK = first; TcK < TcI; TcK++)
+					{
+						float factor = row[TcK];
+						const float * source = a + (size_t)TcK * _size;
+						for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+							row[TcJ] -= factor * source[TcJ];
+					}
+				}
+			});
+			// A22 -= L21 U12
+			Gemm::multiply(_size - last,_size - last,last - first,-1.0f,a + (size_t)last * _size + first,_size,1,a + (size_t)first * _size + last,_size,1,1.0f,a + (size_t)last * _size + last,_size);
+		}
+	}
+	void solveInPlace(float * x, int columns) const
+	{
+		const float * a = _lu.data();
+		ThreadPool::instance().parallelFor(0,columns,256,[&](long columnFirst, long columnLast)
+		{
+			int TcI,TcK;
+			long TcJ;
+			for (TcI = 1; TcI < _size; TcI++)
+			{
+				float * row = x + (size_t)TcI * columns;
+				for (TcK = 0; TcK < TcI; TcK++)
+				{
+					float factor = a[(size_t)TcI * _size + TcK];
+					const float * source = x + (size_t)TcK * columns;
+					for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+						row[TcJ] -= factor * source[TcJ];
+				}
+			}
+			for (TcI = _size - 1; TcI >= 0; TcI--)
+			{
+				float * row = x + (size_t)TcI * columns;
+				for (TcK = TcI + 1; TcK < _size; TcK++)
+				{
+					float factor = a[(size_t)TcI * _size + TcK];
+					const float * source = x + (size_t)TcK * columns;
+					for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+						row[TcJ] -= factor * source[TcJ];
+				}
+				float invDiagonal = 1.0 / a[(size_t)TcI * _size + TcI];
+				for (TcJ = columnFirst; TcJ < columnLast; TcJ++)
+					row[TcJ] *= invDiagonal;
+			}
+		});
+	}
+public:
+/**
+LUFactorization constructor. Factors the matrix; a matrix that is not square is treated as singular.
+@param matrix the matrix to factor
+*/
+	LUFactorization(const Matrix & matrix)
+	{
+		int TcI,TcJ;
+		_size = matrix.rows();
+		_singular = false;
+		_determinant = 1.0;
+		if (matrix.rows() != matrix.columns())
+		{
+			_size = 0;
+			_singular = true;
+			_determinant = 0.0;
+			return;
+		}
+		LINALG_COUNT(LU_FACTOR,2L * _size * _size * _size / 3,8L * _size * _size);
+		if (_size == 2)
+		{
+			TwoMatrix small;
+			for (TcI = 0; TcI < 2; TcI++)
+				for (TcJ = 0; TcJ < 2; TcJ++)
+					small.setAt(TcI,TcJ,matrix.at(TcI,TcJ));
+			_determinant = small.determinant();
+			_singular = (_determinant == 0.0);
+			_inverse2 = small.invert();
+		}
+		else if (_size == 3)
+		{
+			ThreeMatrix small;
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					small.setAt(TcI,TcJ,matrix.at(TcI,TcJ));
+			_determinant = small.determinant();
+			_singular = (_determinant == 0.0);
+			_inverse3 = small.invert();
+		}
+		else
+		{
+			_lu = matrix;
+			_pivots.resize(_size);
+			for (TcI = 0; TcI < _size; TcI++)
+				_pivots[TcI] = TcI;
+			factor();
+			if (_singular)
+				_determinant = 0.0;
+		}
+	}
+/**
+Get the order of the factored matrix
+@returns the number of rows (and columns) of the matrix
+*/
+	int size(void) const {return _size;}
+/**
+Determine if the factored matrix is singular
+@returns true if a zero pivot was encountered, in which case solve and inverse return zeros
+*/
+	bool singular(void) const {return _singular;}
+/**
+Get the determinant of the matrix
+@returns The determinant of the matrix
+*/
+	float determinant(void) const
+	{
+		return (float)_determinant;
+	}
+/**
+Solve for several right hand sides at once: \f$A X = B\f$. The right hand sides are processed together, with the columns split between threads.
+@param rhs a Matrix with one right hand side per column
+@returns the solutions, one per column; a zero Matrix if the matrix is singular; an empty Matrix if the number of rows of rhs does not match
+*/
+	Matrix solve(const Matrix & rhs) const
+	{
+		int TcI,TcJ;
+		int columns = rhs.columns();
+		if (rhs.rows() != _size)
+			return Matrix();
+		Matrix ret(_size,columns);
+		if (_singular)
+			return ret;
+		LINALG_COUNT(LU_SOLVE,2L * _size * _size * columns,4L * _size * _size + 8L * _size * columns);
+		if (_size == 2)
+		{
+			for (TcJ = 0; TcJ < columns; TcJ++)
+			{
+				TwoVector x = _inverse2 * TwoVector(rhs.at(0,TcJ),rhs.at(1,TcJ));
+				for (TcI = 0; TcI < 2; TcI++)
+					ret.setAt(TcI,TcJ,x[TcI]);
+			}
+		}
+		else if (_size == 3)
+		{
+			for (TcJ = 0; TcJ < columns; TcJ++)
+			{
+				ThreeVector x = _inverse3 * ThreeVector(rhs.at(0,TcJ),rhs.at(1,TcJ),rhs.at(2,TcJ));
+				for (TcI = 0; TcI < 3; TcI++)
+					ret.setAt(TcI,TcJ,x[TcI]);
+			}
+		}
+		else
+		{
+			float * x = ret.data();
+			for (TcI = 0; TcI < _size; TcI++)
+			{
+				const float * source = rhs.data() + (size_t)_pivots[TcI] * columns;
+				for (TcJ = 0; TcJ < columns; TcJ++)
+					x[(size_t)TcI * columns + TcJ] = source[TcJ];
+			}
+			solveInPlace(x,columns);
+		}
+		return ret;
+	}
+/**
+Solve \f$A \vec{x} = \vec{b}\f$
+@param rhs the right hand side
+@returns the solution; a zero Vector if the matrix is singular; an empty Vector if the size of rhs does not match
+*/
+	Vector solve(const Vector & rhs) const
+	{
+		if (rhs.size() != _size)
+			return Vector();
+		Matrix x = solve(Matrix(_size,1,rhs.data()));
+		return Vector(_size,x.data());
+	}
+/**
+Get the inverse of the matrix
+@returns A new Matrix containing the multiplicitave inverse, or a zero Matrix if the matrix is singular
+*/
+	Matrix inverse(void) const
+	{
+		Matrix identity(_size,_size);
+		identity.loadIdentity();
+		return solve(identity);
+	}
+};
+
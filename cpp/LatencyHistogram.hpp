@@ -0,0 +1,140 @@
+#pragma once
+#include <vector>
+/**
+@brief A histogram of latencies, in nanoseconds, with logarithmically spaced buckets
+@details Each power of two is divided into 8 buckets, so any latency from 1 ns to centuries is recorded with a relative error of at most 12.5% in fixed storage, and recording a value takes a few instructions and never allocates. Percentiles are reported as the upper edge of the bucket that contains them, limited to the largest value recorded, so they are never underestimated.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class LatencyHistogram
+{
+private:
+	static const int SUB_BUCKETS = 8;
+	static const int BUCKETS = 62 * SUB_BUCKETS;
+	std::vector<unsigned long long> _buckets;
+	unsigned long long _count;
+	unsigned long long _minimum;
+	unsigned long long _maximum;
+	double _sum;
+
+	// the bucket holding a value: exact below 8, then 8 buckets for each power of two
+	static int bucket(unsigned long long value)
+	{
+		int exponent = 0;
+		if (value < SUB_BUCKETS)
+			return (int)value;
+		while ((value >> exponent) > 1)
+			exponent++;
+		return (exponent - 2) * SUB_BUCKETS + (int)((value >> (exponent - 3)) & (SUB_BUCKETS - 1));
+	}
+	// the largest value that falls in a bucket
+	static unsigned long long upperEdge(int index)
+	{
+		if (index < SUB_BUCKETS)
+			return (unsigned long long)index;
+		int exponent = index / SUB_BUCKETS + 2;
+		unsigned long long lower = (unsigned long long)(SUB_BUCKETS + index % SUB_BUCKETS) << (exponent - 3);
+		return lower + ((1ULL << (exponent - 3)) - 1);
+	}
+public:
+	LatencyHistogram(void)
+	{
+		clear();
+	}
+/**
+Record one latency
+@param nanoseconds the latency, in nanoseconds
+@returns none
+*/
+	void record(unsigned long long nanoseconds)
+	{
+		_buckets[bucket(nanoseconds)]++;
+		if (_count == 0 || nanoseconds < _minimum)
+			_minimum = nanoseconds;
+		if (nanoseconds > _maximum)
+			_maximum = nanoseconds;
+		_count++;
+		_sum += (double)nanoseconds;
+	}
+/**
+Add the latencies recorded by another histogram to this one
+@param histogram the histogram to add
+@returns none
+*/
+	void merge(const LatencyHistogram & histogram)
+	{
+		int TcI;
+		if (histogram._count == 0)
+			return;
+		for (TcI = 0; TcI < BUCKETS; TcI++)
+			_buckets[TcI] += histogram._buckets[TcI];
+		if (_count == 0 || histogram._minimum < _minimum)
+			_minimum = histogram._minimum;
+		if (histogram._maximum > _maximum)
+			_maximum = histogram._maximum;
+		_count += histogram._count;
+		_sum += histogram._sum;
+	}
+/**
+Remove all recorded latencies
+@returns none
+*/
+	void clear(void)
+	{
+		_buckets.assign(BUCKETS,0);
+		_count = 0;
+		_minimum = 0;
+		_maximum = 0;
+		_sum = 0.0;
+	}
+/**
+Get the number of latencies recorded
+@returns the number of latencies
+*/
+	unsigned long long count(void) const {return _count;}
+/**
+Get the smallest latency recorded
+@returns the smallest latency in nanoseconds, or 0 if none have been recorded
+*/
+	unsigned long long minimum(void) const {return _minimum;}
+/**
+Get the largest latency recorded
+@returns the largest latency in nanoseconds, or 0 if none have been recorded
+*/
+	unsigned long long maximum(void) const {return _maximum;}
+/**
+Get the mean latency
+@returns the exact mean of the recorded latencies in nanoseconds, or 0 if none have been recorded
+*/
+	double mean(void) const {return _count > 0 ? _sum / (double)_count : 0.0;}
+/**
+Get a percentile of the recorded latencies
+@param percent the percentile, from 0 to 100; for example 99.9 for the latency that 99.9% of calls do not exceed
+@returns the upper edge of the bucket containing the percentile, in nanoseconds, and no more than maximum(); 0 if no latencies have been recorded
+*/
+	unsigned long long percentile(double percent) const
+	{
+		int TcI;
+		if (_count == 0)
+			return 0;
+		if (percent < 0.0)
+			percent = 0.0;
+		if (percent > 100.0)
+			percent = 100.0;
+		// the rank of the percentile, counting from 1
+		unsigned long long rank = (unsigned long long)(percent / 100.0 * (double)_count + 0.5);
+		if (rank < 1)
+			rank = 1;
+		unsigned long long seen = 0;
+		for (TcI = 0; TcI < BUCKETS; TcI++)
+		{
+			seen += _buckets[TcI];
+			if (seen >= rank)
+				return upperEdge(TcI) < _maximum ? upperEdge(TcI) : _maximum;
+		}
+		return _maximum;
+	}
+};
@@ -0,0 +1,335 @@
+#pragma once
+#include <vector>
+#include <Vector.hpp>
+#include <Gemm.hpp>
+
+/**
+@brief A c++ implementation of a dynamically sized dense matrix
+@details The dynamically sized counterpart to ThreeMatrix. Elements are stored contiguously in row order. Matrix products are computed with Gemm, which is cache-blocked, packed and multithreaded.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class Matrix
+{
+private:
+	int _rows;
+	int _columns;
+	std::vector<float> _data;
+public:
+	Matrix(void)
+	{
+		_rows = _columns = 0;
+	}
+/**
+Matrix constructor. The matrix is initialized as a zero matrix.
+@param rows the number of rows
+@param columns the number of columns
+*/
+	Matrix(int rows, int columns)
+	{
+		_rows = rows > 0 ? rows : 0;
+		_columns = columns > 0 ? columns : 0;
+		_data.assign((size_t)_rows * _columns,0.0f);
+	}
+/**
+Matrix constructor
+@param rows the number of rows
+@param columns the number of columns
+@param initData an array of rows * columns values, assumed to be in row order. If null the matrix is initialized as a zero matrix.
+*/
+	Matrix(int rows, int columns, const float * initData) : Matrix(rows,columns)
+	{
+		if (initData != nullptr)
+			_data.assign(initData,initData + _data.size());
+	}
+/**
+Matrix constructor
+@param initData a vector of rows, each of which is a vector of values. The number of columns is given by the shortest row.
+*/
+	Matrix(const std::vector<std::vector<float>> &initData)
+	{
+		int TcI,TcJ;
+		_rows = (int)initData.size();
+		_columns = 0;
+		if (_rows > 0)
+		{
+			_columns = (int)initData[0].size();
+			for (TcI = 1; TcI < _rows; TcI++)
+			{
+				if ((int)initData[TcI].size() < _columns)
+					_columns = (int)initData[TcI].size();
+			}
+		}
+		_data.resize((size_t)_rows * _columns);
+		for (TcI = 0; TcI < _rows; TcI++)
+		{
+			for (TcJ = 0; TcJ < _columns; TcJ++)
+			{
+				_data[(size_t)TcI * _columns + TcJ] = initData[TcI][TcJ];
+			}
+		}
+	}
+/**
+Get the number of rows
+@returns the number of rows
+*/
+	int rows(void) const {return _rows;}
+/**
+Get the number of columns
+@returns the number of columns
+*/
+	int columns(void) const {return _columns;}
+/**
+Get direct access to the element storage, in row order
+@returns A pointer to the first element
+*/
+	float * data(void) {return _data.data();}
+	const float * data(void) const {return _data.data();}
+
+/**
+Retreive the value of the element at the given row and column, zero indexed
+@param row the zero indexed row from which to retrieve an element
+@param column the zero indexed column from which to retrieve an element
+@returns the value at the selected row and column, 0 otherwise
+*/
+	float at(int row, int column) const
+	{
+		if (row >= 0 && row < _rows && column >= 0 && column < _columns)
+			return _data[(size_t)row * _columns + column];
+		else
+			return 0.0;
+	}
+
+/**
+Set the value of the element at the given row and column, zero indexed
+@param row the zero indexed row from which to set an element
+@param column the zero indexed column from which to set an element
+@param value the value to insert into the matrix.
+*/
+	void setAt(int row, int column, float value)
+	{
+		if (row >= 0 && row < _rows && column >= 0 && column < _columns)
+			_data[(size_t)row * _columns + column] = value;
+	}
+
+/**
+Set the values of the elements int the given column, zero indexed
+@param column the zero indexed column from which to set the elements
+@param value the values to insert into the matrix; elements beyond the end of value are left unchanged.
+*/
+	void setColumn(int column, const Vector & value)
+	{
+		int TcI;
+		if (column >= 0 && column < _columns)
+		{
+			int count = value.size() < _rows ? value.size() : _rows;
+			for (TcI = 0; TcI < count; TcI++)
+				_data[(size_t)TcI * _columns + column] = value._data[TcI];
+		}
+	}
+/**
+Set the values of the elements int the given row, zero indexed
+@param row the zero indexed row from which to set an element
+@param value the values to insert into the matrix; elements beyond the end of value are left unchanged.
+*/
+	void setRow(int row, const Vector & value)
+	{
+		int TcI;
+		if (row >= 0 && row < _rows)
+		{
+			int count = value.size() < _columns ? value.size() : _columns;
+			for (TcI = 0; TcI < count; TcI++)
+				_data[(size_t)row * _columns + TcI] = value._data[TcI];
+		}
+	}
+
+/**
+Retrieve a row vector for a given row
+@param row the zero indexed row from which to retrieve
+@returns If row is a valid index, then a Vector containing the row data, otherwise an empty Vector
+*/
+	Vector row(int rowNum) const
+	{
+		if (rowNum >= 0 && rowNum < _rows)
+			return Vector(_columns,_data.data() + (size_t)rowNum * _columns);
+		else
+			return Vector();
+	}
+/**
+Retrieve a column vector for a given column
+@param column the zero indexed column from which to retrieve
+@returns If column is a valid index, then a Vector containing the column data, otherwise an empty Vector
+*/
+	Vector column(int columnNum) const
+	{
+		int TcI;
+		Vector ret;
+		if (columnNum >= 0 && columnNum < _columns)
+		{
+			ret.resize(_rows);
+			for (TcI = 0; TcI < _rows; TcI++)
+				ret._data[TcI] = _data[(size_t)TcI * _columns + columnNum];
+		}
+		return ret;
+	}
+
+/**
+Perform a matrix multiplication with a column vector
+@param vector the Vector by which the matrix is multiplied
+@returns a Vector containing the product, or an empty Vector if the sizes do not agree
+*/
+	Vector operator *(const Vector &vector) const
+	{
+		Vector ret;
+		if (vector.size() == _columns)
+		{
+			LINALG_COUNT(DENSE_MATRIX_TRANSFORM,2L * _rows * _columns,4L * ((long)_rows * _columns + _rows + _columns));
+			ret.resize(_rows);
+			ThreadPool::instance().parallelFor(0,_rows,64,[&](long first, long last)
+			{
+				long TcI;
+				int TcJ;
+				for (TcI = first; TcI < last; TcI++)
+				{
+					const float * rowData = _data.data() + TcI * _columns;
+					float sum = 0.0;
+					for (TcJ = 0; TcJ < _columns; TcJ++)
+						sum += rowData[TcJ] * vector._data[TcJ];
+					ret._data[TcI] = sum;
+				}
+			});
+		}
+		return ret;
+	}
+/**
+Perform a scalar multiplication of a matrix
+@param scalar the value by which the matrix is multiplied
+@returns a new Matrix containing the result of the multiplication
+*/
+	Matrix operator *(float scalar) const
+	{
+		LINALG_COUNT(DENSE_MATRIX_UPDATE,_data.size(),8L * _data.size());
+		Matrix ret(*this);
+		for (float & value : ret._data)
+			value *= scalar;
+		return ret;
+	}
+/**
+Perform a matrix multiplication with a Matrix
+@param matrix the Matrix by which the matrix is multiplied
+@returns a new Matrix containing the result of the multiplication, or an empty Matrix if the sizes do not agree
+*/
+	Matrix operator *(const Matrix &matrix) const
+	{
+		if (_columns != matrix._rows)
+			return Matrix();
+		Matrix ret(_rows,matrix._columns);
+		Gemm::multiply(_rows,matrix._columns,_columns,1.0f,_data.data(),_columns,1,matrix._data.data(),matrix._columns,1,0.0f,ret._data.data(),ret._columns);
+		return ret;
+	}
+/**
+Perform a matrix addition with a Matrix
+@param matrix the Matrix which the matrix is added
+@returns a new Matrix containing the result of the addition, or an empty Matrix if the sizes do not agree
+*/
+	Matrix operator +(const Matrix &matrix) const
+	{
+		size_t TcI;
+		if (_rows != matrix._rows || _columns != matrix._columns)
+			return Matrix();
+		LINALG_COUNT(DENSE_MATRIX_UPDATE,_data.size(),12L * _data.size());
+		Matrix ret(*this);
+		for (TcI = 0; TcI < _data.size(); TcI++)
+			ret._data[TcI] += matrix._data[TcI];
+		return ret;
+	}
+/**
+Perform a matrix subtraction with a Matrix
+@param matrix the Matrix which is to be subtracted from this matrix
+@returns a new Matrix containing the result of the subtraction, or an empty Matrix if the sizes do not agree
+*/
+	Matrix operator -(const Matrix &matrix) const
+	{
+		size_t TcI;
+		if (_rows != matrix._rows || _columns != matrix._columns)
+			return Matrix();
+		LINALG_COUNT(DENSE_MATRIX_UPDATE,_data.size(),12L * _data.size());
+		Matrix ret(*this);
+		for (TcI = 0; TcI < _data.size(); TcI++)
+			ret._data[TcI] -= matrix._data[TcI];
+		return ret;
+	}
+/**
+Get the additive inverse of a matrix
+@returns A new Matrix containing the result of the negation
+*/
+	Matrix operator- (void) const
+	{
+		return *this * -1.0f;
+	}
+/**
+Perform a matrix transpose. The transpose is performed in square tiles so that both the source and destination are traversed with good locality.
+@returns A new Matrix containing the result of the transposition
+*/
+	Matrix transpose(void) const
+	{
+		const int tile = 32;
+		LINALG_COUNT(DENSE_MATRIX_TRANSPOSE,0,8L * _data.size());
+		Matrix ret(_columns,_rows);
+		ThreadPool::instance().parallelFor(0,(_rows + tile - 1) / tile,4,[&](long first, long last)
+		{
+			int TcI,TcJ,TcK,TcL;
+			for (TcI = (int)first * tile; TcI < _rows && TcI < last * tile; TcI += tile)
+			{
+				int iEnd = TcI + tile < _rows ? TcI + tile : _rows;
+				for (TcJ = 0; TcJ < _columns; TcJ += tile)
+				{
+					int jEnd = TcJ + tile < _columns ? TcJ + tile : _columns;
+					for (TcK = TcI; TcK < iEnd; TcK++)
+					{
+						for (TcL = TcJ; TcL < jEnd; TcL++)
+						{
+							ret._data[(size_t)TcL * _rows + TcK] = _data[(size_t)TcK * _columns + TcL];
+						}
+					}
+				}
+			}
+		});
+		return ret;
+	}
+/**
+Get the trace of the matrix
+@returns The sum of the diagonal elements of the matrix
+*/
+	float trace(void) const
+	{
+		int TcI;
+		float sum = 0.0;
+		for (TcI = 0; TcI < _rows && TcI < _columns; TcI++)
+			sum += _data[(size_t)TcI * _columns + TcI];
+		return sum;
+	}
+/**
+Load the zero matrix
+@returns none
+*/
+	void loadZero(void)
+	{
+		_data.assign(_data.size(),0.0f);
+	}
+/**
+Load the identity matrix. For non-square matrices, ones are placed on the leading diagonal.
+@returns none
+*/
+	void loadIdentity(void)
+	{
+		int TcI;
+		loadZero();
+		for (TcI = 0; TcI < _rows && TcI < _columns; TcI++)
+			_data[(size_t)TcI * _columns + TcI] = 1.0;
+	}
+};
+
@@ -0,0 +1,468 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+/**
+@brief Opt-in counts of the calls, floating point operations and bytes moved by each vector and matrix operation
+@details Counting is compiled in only when LINALG_ENABLE_COUNTERS is defined before the first library header is included (or on the compiler command line). Otherwise LINALG_COUNT expands to nothing, so the instrumented operations compile to exactly the code they would without it, and snapshot() reports zeros.
+
+Each thread records into its own shard, which is written only by that thread, so counting takes no locks and causes no contention between threads; a snapshot adds the shards together. A shard is kept when its thread exits and is reused by the next new thread, so counts are never lost.
+
+The counts are nominal: each operation adds a fixed number of floating point operations and bytes per call or per element, with a square root, a division or a comparison counted as one operation and SinCos or ArcTangent as 20. The bytes are those the operation must read and write, not what reaches memory through the caches. An operation called from inside another counted operation on the same thread is not counted separately (ThreeVector::unit calls magnitude, for example), so the totals are not counted twice; bulk kernels count once for the whole array, on the calling thread. The ThreadPool runs each piece of a parallel loop at the counting depth of the thread that started the loop, so the operations a worker calls on behalf of a counted kernel (the ThreeMatrix and ThreeVector products in the BlockSparseMatrix inner loop, or the Gemm updates of a factorization) are not counted again. The determinants of LUFactorization and CholeskyFactorization are by-products of the factorization and are counted with it, and inverse is counted as a solve for the columns of the identity.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class OperationCounters
+{
+public:
+	enum Operation
+	{
+		VECTOR_DOT,
+		VECTOR_CROSS,
+		VECTOR_MAGNITUDE,
+		VECTOR_UNIT,
+		MATRIX_TRANSFORM,
+		MATRIX_PRODUCT,
+		MATRIX_DETERMINANT,
+		MATRIX_INVERT,
+		TWO_VECTOR_DOT,
+		TWO_VECTOR_CROSS,
+		TWO_VECTOR_MAGNITUDE,
+		TWO_VECTOR_UNIT,
+		TWO_MATRIX_TRANSFORM,
+		TWO_MATRIX_PRODUCT,
+		TWO_MATRIX_DETERMINANT,
+		TWO_MATRIX_INVERT,
+		QUATERNION_PRODUCT,
+		QUATERNION_UNIT,
+		QUATERNION_ROTATE,
+		QUATERNION_MATRIX,
+		QUATERNION_NLERP,
+		QUATERNION_SLERP,
+		VECTOR_ARRAY_LERP,
+		QUATERNION_ARRAY_NLERP,
+		QUATERNION_ARRAY_APPROXIMATE_SLERP,
+		QUATERNION_ARRAY_SLERP,
+		MATRIX_ARRAY_ROTATION,
+		MATRIX_ARRAY_EXP,
+		MATRIX_ARRAY_LOG,
+		MATRIX_ARRAY_ORTHOGONALITY_ERROR,
+		MATRIX_ARRAY_ORTHONORMALIZE,
+		MATRIX_ARRAY_SVD,
+		MATRIX_ARRAY_PRODUCT,
+		TWO_MATRIX_ARRAY_DETERMINANT,
+		TWO_MATRIX_ARRAY_INVERT,
+		TWO_MATRIX_ARRAY_SOLVE,
+		TWO_MATRIX_ARRAY_EIGEN,
+		TWO_MATRIX_ARRAY_ROTATION,
+		TWO_MATRIX_ARRAY_PRODUCT,
+		SINCOS_ARRAY,
+		KERNEL_DOT,
+		KERNEL_UPDATE,
+		GEMM,
+		DENSE_VECTOR_DOT,
+		DENSE_VECTOR_UPDATE,
+		DENSE_MATRIX_TRANSFORM,
+		DENSE_MATRIX_UPDATE,
+		DENSE_MATRIX_TRANSPOSE,
+		LU_FACTOR,
+		LU_SOLVE,
+		CHOLESKY_FACTOR,
+		CHOLESKY_SOLVE,
+		SPARSE_MULTIPLY,
+		BLOCK_SPARSE_MULTIPLY,
+		GEOMETRY_ORIENTATION,
+		GEOMETRY_POINT_IN_POLYGON,
+		GEOMETRY_SEGMENTS_INTERSECT,
+		GEOMETRY_POLYGON_AREA,
+		GEOMETRY_POLYGON_CENTROID,
+		GEOMETRY_CONVEX_HULL,
+		RAY_TRIANGLE_PACKET,
+		RAY_TRIANGLE_STREAM,
+		LAYOUT_TRANSPOSE,
+		VECTOR_TILES,
+		MATRIX_TILES,
+		INTEGRATE_PARTICLES,
+		INTEGRATE_ORIENTATIONS,
+		FIXED_VECTOR_ARRAY,
+		FIXED_TWO_VECTOR_ARRAY,
+		FIXED_TWO_MATRIX_ARRAY,
+		FIXED_THREE_MATRIX_ARRAY,
+		OPERATIONS
+	};
+#ifdef LINALG_ENABLE_COUNTERS
+	static constexpr bool ENABLED = true;
+#else
+	static constexpr bool ENABLED = false;
+#endif
+
+/**
+@brief The counts of every operation at one moment
+*/
+	class Snapshot
+	{
+	friend class OperationCounters;
+	private:
+		unsigned long long _calls[OPERATIONS];
+		unsigned long long _flops[OPERATIONS];
+		unsigned long long _bytes[OPERATIONS];
+	public:
+		Snapshot(void)
+		{
+			int TcI;
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+				_calls[TcI] = _flops[TcI] = _bytes[TcI] = 0;
+		}
+	/**
+	Get the number of calls of an operation
+	@param operation the operation
+	@returns the number of calls, or 0 if operation is out of range
+	*/
+		unsigned long long calls(int operation) const {return operation >= 0 && operation < OPERATIONS ? _calls[operation] : 0;}
+	/**
+	Get the floating point operations performed by an operation
+	@param operation the operation
+	@returns the number of floating point operations, or 0 if operation is out of range
+	*/
+		unsigned long long flops(int operation) const {return operation >= 0 && operation < OPERATIONS ? _flops[operation] : 0;}
+	/**
+	Get the bytes read and written by an operation
+	@param operation the operation
+	@returns the number of bytes, or 0 if operation is out of range
+	*/
+		unsigned long long bytes(int operation) const {return operation >= 0 && operation < OPERATIONS ? _bytes[operation] : 0;}
+	/**
+	Get the floating point operations performed by all operations
+	@returns the total number of floating point operations
+	*/
+		unsigned long long totalFlops(void) const
+		{
+			int TcI;
+			unsigned long long total = 0;
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+				total += _flops[TcI];
+			return total;
+		}
+	/**
+	Get the bytes read and written by all operations
+	@returns the total number of bytes
+	*/
+		unsigned long long totalBytes(void) const
+		{
+			int TcI;
+			unsigned long long total = 0;
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+				total += _bytes[TcI];
+			return total;
+		}
+	/**
+	Get the counts accumulated between an earlier snapshot and this one
+	@param earlier the earlier snapshot
+	@returns a Snapshot containing the difference
+	*/
+		Snapshot operator -(const Snapshot & earlier) const
+		{
+			int TcI;
+			Snapshot ret;
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+			{
+				ret._calls[TcI] = _calls[TcI] - earlier._calls[TcI];
+				ret._flops[TcI] = _flops[TcI] - earlier._flops[TcI];
+				ret._bytes[TcI] = _bytes[TcI] - earlier._bytes[TcI];
+			}
+			return ret;
+		}
+	/**
+	Format the counts as a table with one line per operation that was called, giving the calls, floating point operations, bytes, operations per call and operations per byte (the arithmetic intensity)
+	@returns the report
+	*/
+		std::string report(void) const
+		{
+			int TcI;
+			char line[160];
+			std::string ret;
+			std::snprintf(line,sizeof(line),"%-36s %14s %16s %16s %12s %10s\n","operation","calls","flops","bytes","flops/call","flops/byte");
+			ret += line;
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+			{
+				if (_calls[TcI] == 0)
+					continue;
+				std::snprintf(line,sizeof(line),"%-36s %14llu %16llu %16llu %12.1f %10.3f\n",name(TcI),_calls[TcI],_flops[TcI],_bytes[TcI],(double)_flops[TcI] / (double)_calls[TcI],_bytes[TcI] > 0 ? (double)_flops[TcI] / (double)_bytes[TcI] : 0.0);
+				ret += line;
+			}
+			std::snprintf(line,sizeof(line),"%-36s %14s %16llu %16llu\n","total","",totalFlops(),totalBytes());
+			ret += line;
+			return ret;
+		}
+	};
+
+/**
+@brief Records one call of an operation for the lifetime of the object, unless the thread is already inside a counted operation; used through LINALG_COUNT
+*/
+	class Scope
+	{
+	public:
+	/**
+	Scope constructor
+	@param operation the operation being called
+	@param flops the floating point operations it performs
+	@param bytes the bytes it reads and writes
+	*/
+		Scope(Operation operation, unsigned long long flops, unsigned long long bytes)
+		{
+			int & level = depth();
+			if (level == 0)
+				record(operation,flops,bytes);
+			level++;
+		}
+		~Scope(void)
+		{
+			depth()--;
+		}
+		Scope(const Scope &) = delete;
+		Scope & operator =(const Scope &) = delete;
+	};
+/**
+@brief Places the thread at the counting depth of another thread for the lifetime of the object, so that work done on behalf of a counted operation on that thread is not counted again; used by ThreadPool
+*/
+	class Inherit
+	{
+	private:
+		int _saved;
+	public:
+	/**
+	Inherit constructor
+	@param level the depth of the thread on whose behalf the work is done, from level()
+	*/
+		explicit Inherit(int level)
+		{
+			int & current = depth();
+			_saved = current;
+			current = level;
+		}
+		~Inherit(void)
+		{
+			depth() = _saved;
+		}
+		Inherit(const Inherit &) = delete;
+		Inherit & operator =(const Inherit &) = delete;
+	};
+private:
+	class alignas(64) Shard
+	{
+	public:
+		std::atomic<unsigned long long> values[OPERATIONS][3];
+		Shard(void)
+		{
+			int TcI,TcJ;
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					values[TcI][TcJ].store(0,std::memory_order_relaxed);
+		}
+	};
+	class Registry
+	{
+	public:
+		std::mutex mutex;
+		std::vector<Shard *> shards;
+		std::vector<Shard *> idle;
+		Snapshot baseline;
+	};
+	// returns the shard of the exiting thread to the registry for reuse
+	class Handle
+	{
+	public:
+		Shard * shard;
+		Handle(void)
+		{
+			Registry & reg = registry();
+			std::lock_guard<std::mutex> lock(reg.mutex);
+			if (reg.idle.empty())
+			{
+				shard = new Shard;
+				reg.shards.push_back(shard);
+			}
+			else
+			{
+				shard = reg.idle.back();
+				reg.idle.pop_back();
+			}
+		}
+		~Handle(void)
+		{
+			Registry & reg = registry();
+			std::lock_guard<std::mutex> lock(reg.mutex);
+			reg.idle.push_back(shard);
+		}
+	};
+
+	// the registry is never destroyed, so that threads exiting during static destruction can still return their shards
+	static Registry & registry(void)
+	{
+		static Registry * reg = new Registry;
+		return *reg;
+	}
+	static int & depth(void)
+	{
+		static thread_local int level = 0;
+		return level;
+	}
+	static void record(Operation operation, unsigned long long flops, unsigned long long bytes)
+	{
+		static thread_local Handle handle;
+		// only this thread writes the shard, so a plain load and store is enough and avoids a locked add
+		std::atomic<unsigned long long> * values = handle.shard->values[operation];
+		values[0].store(values[0].load(std::memory_order_relaxed) + 1,std::memory_order_relaxed);
+		values[1].store(values[1].load(std::memory_order_relaxed) + flops,std::memory_order_relaxed);
+		values[2].store(values[2].load(std::memory_order_relaxed) + bytes,std::memory_order_relaxed);
+	}
+	// the sum of every shard, including those of threads that have exited; the caller holds the registry mutex
+	static Snapshot total(Registry & reg)
+	{
+		int TcI;
+		Snapshot ret;
+		for (Shard * shard : reg.shards)
+		{
+			for (TcI = 0; TcI < OPERATIONS; TcI++)
+			{
+				ret._calls[TcI] += shard->values[TcI][0].load(std::memory_order_relaxed);
+				ret._flops[TcI] += shard->values[TcI][1].load(std::memory_order_relaxed);
+				ret._bytes[TcI] += shard->values[TcI][2].load(std::memory_order_relaxed);
+			}
+		}
+		return ret;
+	}
+public:
+/**
+Get the name of an operation, as used in reports
+@param operation the operation
+@returns the name, or "unknown" if operation is out of range
+*/
+	static const char * name(int operation)
+	{
+		static const char * const NAMES[OPERATIONS] =
+		{
+			"ThreeVector::dot",
+			"ThreeVector::cross",
+			"ThreeVector::magnitude",
+			"ThreeVector::unit",
+			"ThreeMatrix::operator*(ThreeVector)",
+			"ThreeMatrix::operator*(ThreeMatrix)",
+			"ThreeMatrix::determinant",
+			"ThreeMatrix::invert",
+			"TwoVector::dot",
+			"TwoVector::cross",
+			"TwoVector::magnitude",
+			"TwoVector::unit",
+			"TwoMatrix::operator*(TwoVector)",
+			"TwoMatrix::operator*(TwoMatrix)",
+			"TwoMatrix::determinant",
+			"TwoMatrix::invert",
+			"Quaternion::operator*(Quaternion)",
+			"Quaternion::unit",
+			"Quaternion::rotate",
+			"Quaternion::matrix",
+			"Quaternion::nlerp",
+			"Quaternion::slerp",
+			"ThreeVectorArray::lerp",
+			"QuaternionArray::nlerp",
+			"QuaternionArray::approximateSlerp",
+			"QuaternionArray::slerp",
+			"ThreeMatrixArray::rotation",
+			"ThreeMatrixArray::exp",
+			"ThreeMatrixArray::log",
+			"ThreeMatrixArray::orthogonalityError",
+			"ThreeMatrixArray::orthonormalize",
+			"ThreeMatrixArray::svd",
+			"ThreeMatrixArray::product",
+			"TwoMatrixArray::determinant",
+			"TwoMatrixArray::invert",
+			"TwoMatrixArray::solve",
+			"TwoMatrixArray::eigen",
+			"TwoMatrixArray::rotation",
+			"TwoMatrixArray::product",
+			"SinCos::array",
+			"VectorKernels::dot",
+			"VectorKernels::update",
+			"Gemm::multiply",
+			"Vector::dot",
+			"Vector::update",
+			"Matrix::operator*(Vector)",
+			"Matrix::update",
+			"Matrix::transpose",
+			"LUFactorization::factor",
+			"LUFactorization::solve",
+			"CholeskyFactorization::factor",
+			"CholeskyFactorization::solve",
+			"SparseMatrix::multiply",
+			"BlockSparseMatrix::multiply",
+			"TwoVectorGeometry::orientation",
+			"TwoVectorGeometry::pointInPolygon",
+			"TwoVectorGeometry::segmentsIntersect",
+			"TwoVectorGeometry::polygonArea",
+			"TwoVectorGeometry::polygonCentroid",
+			"TwoVectorGeometry::convexHull",
+			"RayTriangle::intersect(packet)",
+			"RayTriangle::intersectStream",
+			"Transpose::interleave",
+			"ThreeVectorTiles",
+			"ThreeMatrixTiles",
+			"IntegrationKernels::particles",
+			"IntegrationKernels::orientations",
+			"FixedThreeVectorArray",
+			"FixedTwoVectorArray",
+			"FixedTwoMatrixArray",
+			"FixedThreeMatrixArray"
+		};
+		return operation >= 0 && operation < OPERATIONS ? NAMES[operation] : "unknown";
+	}
+/**
+Get the number of counted operations the calling thread is inside, to be passed to Inherit by threads working on its behalf
+@returns the depth; always 0 unless LINALG_ENABLE_COUNTERS is defined
+*/
+	static int level(void)
+	{
+		return ENABLED ? depth() : 0;
+	}
+/**
+Get the counts accumulated by all threads since the program started or since the last reset(). Counts being recorded by other threads while the snapshot is taken may or may not be included.
+@returns the counts; all zero unless LINALG_ENABLE_COUNTERS is defined
+*/
+	static Snapshot snapshot(void)
+	{
+		if (!ENABLED)
+			return Snapshot();
+		Registry & reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		return total(reg) - reg.baseline;
+	}
+/**
+Restart the counts from zero. The shards themselves are not cleared, since only their own threads write them; later snapshots are taken relative to the counts at this moment.
+@returns none
+*/
+	static void reset(void)
+	{
+		if (!ENABLED)
+			return;
+		Registry & reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		reg.baseline = total(reg);
+	}
+};
+
+/**
+Count a call of an operation, in the function that performs it. This is the only use of OperationCounters in the instrumented code, and it expands to nothing unless LINALG_ENABLE_COUNTERS is defined, so none of its arguments are evaluated.
+@param operation the OperationCounters::Operation, without the class name
+@param flops the floating point operations performed by the call
+@param bytes the bytes read and written by the call
+*/
+#ifdef LINALG_ENABLE_COUNTERS
+#define LINALG_COUNT(operation,flops,bytes) OperationCounters::Scope linalgCounterScope(OperationCounters::operation,(unsigned long long)(flops),(unsigned long long)(bytes))
+#else
+#define LINALG_COUNT(operation,flops,bytes)
+#endif
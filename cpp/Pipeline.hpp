@@ -0,0 +1,174 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <SpscQueue.hpp>
+/**
+@brief An asynchronous pipeline of stages that pass a fixed set of reusable chunks from one to the next
+@details A source fills chunks (decoding input, for example), any number of stages process them in order (transforming and reducing), and a sink consumes them (writing output). Every stage runs on its own thread, and consecutive stages are joined by an SpscQueue, so all stages work at once on different chunks and the time to process a stream approaches that of the slowest stage rather than the sum of all of them. The sink hands each chunk back to the source for refilling, so the chunks' buffers are allocated once and reused; since there are only as many chunks as were requested, a stage that falls behind stops the stages before it from running ahead, which bounds the memory in use.
+
+Chunks pass through every stage in the order the source produced them. A stage that calls the bulk kernels shares the ThreadPool with the other stages; the pool runs one such kernel at a time, so the stages that benefit most from the pipeline are those that are bound by input and output or run on one thread.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+template <typename Chunk> class Pipeline
+{
+private:
+	std::vector<Chunk> _chunks;
+	std::vector<std::function<void(Chunk &)> > _stages;
+	// _queues[0] returns chunks from the sink to the source; _queues[i] feeds stage i, and the last feeds the sink. Each can hold every chunk and the end of the stream, so only the source waits for room.
+	std::vector<std::unique_ptr<SpscQueue<Chunk *> > > _queues;
+	std::vector<std::thread> _threads;
+	std::vector<double> _busy;
+	long _processed;
+
+	// runs one thread's work on each chunk until the end of the stream, a null chunk, arrives
+	template <typename Work> void loop(int index, const Work & work)
+	{
+		SpscQueue<Chunk *> & input = *_queues[index];
+		SpscQueue<Chunk *> & output = *_queues[(index + 1) % _queues.size()];
+		Chunk * chunk;
+		double busy = 0.0;
+		while ((chunk = input.pop()) != nullptr)
+		{
+			std::chrono::steady_clock::time_point began = std::chrono::steady_clock::now();
+			work(*chunk);
+			busy += std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+			output.push(chunk);
+		}
+		_busy[index] = busy;
+		if (index + 1 < (int)_queues.size())
+			output.push(nullptr);
+	}
+public:
+/**
+Pipeline constructor
+@param chunks the number of chunks; at least 2, and one more than the number of stages lets every stage work at once
+*/
+	explicit Pipeline(int chunks)
+	{
+		_chunks.resize(chunks < 2 ? 2 : chunks);
+		_processed = 0;
+	}
+	~Pipeline(void)
+	{
+		wait();
+	}
+	Pipeline(const Pipeline &) = delete;
+	Pipeline & operator =(const Pipeline &) = delete;
+
+/**
+Get direct access to a chunk, to size its buffers before the pipeline starts
+@param idx the zero indexed chunk
+@returns the chunk
+*/
+	Chunk & chunk(int idx) {return _chunks[idx];}
+/**
+Get the number of chunks
+@returns the number of chunks
+*/
+	int chunks(void) const {return (int)_chunks.size();}
+/**
+Add a stage, to run after the stages already added. Stages may not be added while the pipeline is running.
+@param stage a function called as stage(chunk) for each chunk, on the stage's own thread
+@returns none
+*/
+	void addStage(const std::function<void(Chunk &)> & stage)
+	{
+		if (_threads.empty())
+			_stages.push_back(stage);
+	}
+/**
+Start the pipeline and return at once. The source, every stage and the sink each start on their own thread; call wait() to wait for the end of the stream.
+@param source a function called as source(chunk) to fill each chunk, returning false, without filling the chunk, at the end of the stream
+@param sink a function called as sink(chunk) for each processed chunk, in the order the source filled them
+@returns none
+*/
+	void start(const std::function<bool(Chunk &)> & source, const std::function<void(Chunk &)> & sink)
+	{
+		int TcI;
+		if (!_threads.empty())
+			return;
+		int stages = (int)_stages.size();
+		_queues.clear();
+		for (TcI = 0; TcI < stages + 2; TcI++)
+			_queues.emplace_back(new SpscQueue<Chunk *>((int)_chunks.size() + 1));
+		_busy.assign(stages + 2,0.0);
+		_processed = 0;
+		for (TcI = 0; TcI < (int)_chunks.size(); TcI++)
+			_queues[0]->push(&_chunks[TcI]);
+		_threads.emplace_back([this,source]
+		{
+			SpscQueue<Chunk *> & empty = *_queues[0];
+			SpscQueue<Chunk *> & output = *_queues[1];
+			double busy = 0.0;
+			while (true)
+			{
+				Chunk * chunk = empty.pop();
+				std::chrono::steady_clock::time_point began = std::chrono::steady_clock::now();
+				bool more = source(*chunk);
+				busy += std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+				if (!more)
+					break;
+				output.push(chunk);
+			}
+			_busy[0] = busy;
+			output.push(nullptr);
+		});
+		for (TcI = 0; TcI < stages; TcI++)
+			_threads.emplace_back([this,TcI]{loop(TcI + 1,_stages[TcI]);});
+		_threads.emplace_back([this,sink,stages]
+		{
+			long processed = 0;
+			loop(stages + 1,[&](Chunk & chunk)
+			{
+				sink(chunk);
+				processed++;
+			});
+			_processed = processed;
+		});
+	}
+/**
+Wait for the pipeline to finish the stream. Returns at once if it is not running.
+@returns none
+*/
+	void wait(void)
+	{
+		for (auto & thread : _threads)
+			thread.join();
+		_threads.clear();
+	}
+/**
+Run the pipeline to the end of the stream, as start() followed by wait()
+@param source a function called as source(chunk) to fill each chunk, returning false at the end of the stream
+@param sink a function called as sink(chunk) for each processed chunk
+@returns none
+*/
+	void run(const std::function<bool(Chunk &)> & source, const std::function<void(Chunk &)> & sink)
+	{
+		start(source,sink);
+		wait();
+	}
+/**
+Get the number of chunks that reached the sink in the last run
+@returns the number of chunks; valid once wait() has returned
+*/
+	long processed(void) const {return _processed;}
+/**
+Get the time a step spent working on chunks in the last run, excluding the time it waited for the steps before and after it. The largest of these is the slowest step, which sets the rate of the whole pipeline.
+@param step 0 for the source, 1 to stages for the stages in the order added, and stages + 1 for the sink
+@returns the busy time in seconds, valid once wait() has returned, or 0 if step is out of range
+*/
+	double busySeconds(int step) const
+	{
+		if (step >= 0 && step < (int)_busy.size())
+			return _busy[step];
+		else
+			return 0.0;
+	}
+};
@@ -0,0 +1,356 @@
+#pragma once
+#include <cmath>
+#include <ThreeVector.hpp>
+#include <ThreeMatrix.hpp>
+/**
+@brief A c++ implementation of a quaternion, used to represent rotations
+@details The quaternion \f$w + x i + y j + z k\f$ is stored as its scalar part w and vector part <x,y,z>. A unit quaternion represents the rotation \f$\vec{v} \rightarrow q \vec{v} q^*\f$; q and -q represent the same rotation.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class Quaternion
+{
+private:
+	float _w;
+	float _x;
+	float _y;
+	float _z;
+public:
+	Quaternion(void)
+	{
+		loadIdentity();
+	}
+/**
+Quaternion constructor
+@param w The scalar part
+@param x The i component of the vector part
+@param y The j component of the vector part
+@param z The k component of the vector part
+*/
+	Quaternion(float w, float x, float y, float z)
+	{
+		_w = w;
+		_x = x;
+		_y = y;
+		_z = z;
+	}
+/**
+Quaternion constructor
+@param w The scalar part
+@param vector The vector part
+*/
+	Quaternion(float w, const ThreeVector & vector)
+	{
+		_w = w;
+		_x = vector.getX();
+		_y = vector.getY();
+		_z = vector.getZ();
+	}
+/**
+Get for the scalar part
+@returns The scalar part
+*/
+	float getW(void) const {return _w;}
+/**
+Get for the i component
+@returns The i component
+*/
+	float getX(void) const {return _x;}
+/**
+Get for the j component
+@returns The j component
+*/
+	float getY(void) const {return _y;}
+/**
+Get for the k component
+@returns The k component
+*/
+	float getZ(void) const {return _z;}
+/**
+Get for the vector part
+@returns The vector part as a ThreeVector
+*/
+	ThreeVector vector(void) const {return ThreeVector(_x,_y,_z);}
+
+/**
+Set for the scalar part
+@param value The new value for the scalar part
+@returns none
+*/
+	void setW(float value) {_w = value;}
+/**
+Set for the i component
+@param value The new value for the i component
+@returns none
+*/
+	void setX(float value) {_x = value;}
+/**
+Set for the j component
+@param value The new value for the j component
+@returns none
+*/
+	void setY(float value) {_y = value;}
+/**
+Set for the k component
+@param value The new value for the k component
+@returns none
+*/
+	void setZ(float value) {_z = value;}
+
+/**
+Add one quaternion to another
+@param quatB the quaternion to add to this quaternion
+@returns a Quaternion with the result of the addition
+*/
+	Quaternion operator +(const Quaternion & quatB) const
+	{
+		return Quaternion(_w + quatB._w,_x + quatB._x,_y + quatB._y,_z + quatB._z);
+	}
+/**
+Create the additive inverse of a quaternion, which represents the same rotation
+@returns a Quaternion containing the additive inverse of this quaternion
+*/
+	Quaternion operator -(void) const
+	{
+		return Quaternion(-_w,-_x,-_y,-_z);
+	}
+/**
+Subtract one quaternion from another
+@param quatB the quaternion to subtract from this quaternion
+@returns a Quaternion with the result of the subtraction
+*/
+	Quaternion operator -(const Quaternion & quatB) const
+	{
+		return Quaternion(_w - quatB._w,_x - quatB._x,_y - quatB._y,_z - quatB._z);
+	}
+/**
+Scale the quaternion by a scalar factor
+@param scalar the factor by which to scale the quaternion
+@returns the scaled Quaternion
+*/
+	Quaternion operator *(float scalar) const
+	{
+		return Quaternion(_w * scalar,_x * scalar,_y * scalar,_z * scalar);
+	}
+/**
+Perform a quaternion (Hamilton) product. For unit quaternions the product represents the rotation by quatB followed by the rotation by this quaternion.
+@param quatB the quaternion by which this quaternion is multiplied on the right
+@returns a Quaternion with the result of the multiplication
+*/
+	Quaternion operator *(const Quaternion & quatB) const
+	{
+		LINALG_COUNT(QUATERNION_PRODUCT,28,48);
+		return Quaternion(_w * quatB._w - _x * quatB._x - _y * quatB._y - _z * quatB._z,
+						_w * quatB._x + _x * quatB._w + _y * quatB._z - _z * quatB._y,
+						_w * quatB._y - _x * quatB._z + _y * quatB._w + _z * quatB._x,
+						_w * quatB._z + _x * quatB._y - _y * quatB._x + _z * quatB._w
+						);
+	}
+/**
+Retrieve the four dimensional scalar (dot) product of two quaternions
+@param quatB the other quaternion
+@returns the dot product
+*/
+	float dot(const Quaternion & quatB) const
+	{
+		return _w * quatB._w + _x * quatB._x + _y * quatB._y + _z * quatB._z;
+	}
+/**
+Get the conjugate of the quaternion, which for a unit quaternion is the inverse rotation
+@returns the conjugate \f$w - x i - y j - z k\f$
+*/
+	Quaternion conjugate(void) const
+	{
+		return Quaternion(_w,-_x,-_y,-_z);
+	}
+/**
+Get the magnitude (norm) of the quaternion
+@returns the magnitude of the quaternion \f$(\sqrt{w^2 + x^2 + y^2 + z^2})\f$
+*/
+	float magnitude(void) const
+	{
+		return std::sqrt(dot(*this));
+	}
+/**
+Retrieve a unit quaternion for this quaternion
+@returns the unit quaternion, or the zero quaternion if this quaternion is zero
+*/
+	Quaternion unit(void) const
+	{
+		LINALG_COUNT(QUATERNION_UNIT,13,32);
+		float mag = magnitude();
+		if (mag != 0.0)
+			mag = 1.0 / mag;
+		return *this * mag;
+	}
+/**
+Rotate a vector by this quaternion, which is assumed to be a unit quaternion: \f$\vec{v}' = \vec{v} + 2 w (\vec{q} \times \vec{v}) + 2 \vec{q} \times (\vec{q} \times \vec{v})\f$
+@param vector the vector to rotate
+@returns the rotated vector
+*/
+	ThreeVector rotate(const ThreeVector & vector) const
+	{
+		LINALG_COUNT(QUATERNION_ROTATE,30,44);
+		ThreeVector q(_x,_y,_z);
+		ThreeVector t = q.cross(vector) * 2.0f;
+		return vector + t * _w + q.cross(t);
+	}
+/**
+Get the rotation matrix for this quaternion, which is assumed to be a unit quaternion
+@returns A ThreeMatrix containing the rotation
+*/
+	ThreeMatrix matrix(void) const
+	{
+		LINALG_COUNT(QUATERNION_MATRIX,30,52);
+		ThreeMatrix ret;
+		ret.setAt(0,0,1.0f - 2.0f * (_y * _y + _z * _z));
+		ret.setAt(0,1,2.0f * (_x * _y - _w * _z));
+		ret.setAt(0,2,2.0f * (_x * _z + _w * _y));
+		ret.setAt(1,0,2.0f * (_x * _y + _w * _z));
+		ret.setAt(1,1,1.0f - 2.0f * (_x * _x + _z * _z));
+		ret.setAt(1,2,2.0f * (_y * _z - _w * _x));
+		ret.setAt(2,0,2.0f * (_x * _z - _w * _y));
+		ret.setAt(2,1,2.0f * (_y * _z + _w * _x));
+		ret.setAt(2,2,1.0f - 2.0f * (_x * _x + _y * _y));
+		return ret;
+	}
+/**
+Load the unit quaternion for a rotation matrix. The largest of w, x, y and z is found from the diagonal first and the others from it, which keeps the result accurate for every rotation. The scalar part of the result is non-negative.
+@param matrix the rotation matrix
+@returns none
+*/
+	void loadMatrix(const ThreeMatrix & matrix)
+	{
+		float m00 = matrix.at(0,0);
+		float m11 = matrix.at(1,1);
+		float m22 = matrix.at(2,2);
+		float trace = m00 + m11 + m22;
+		float scale;
+		if (trace >= m00 && trace >= m11 && trace >= m22)
+		{
+			_w = 0.5f * std::sqrt(1.0f + trace);
+			scale = 0.25f / _w;
+			_x = (matrix.at(2,1) - matrix.at(1,2)) * scale;
+			_y = (matrix.at(0,2) - matrix.at(2,0)) * scale;
+			_z = (matrix.at(1,0) - matrix.at(0,1)) * scale;
+		}
+		else if (m00 >= m11 && m00 >= m22)
+		{
+			_x = 0.5f * std::sqrt(1.0f + m00 - m11 - m22);
+			scale = 0.25f / _x;
+			_w = (matrix.at(2,1) - matrix.at(1,2)) * scale;
+			_y = (matrix.at(0,1) + matrix.at(1,0)) * scale;
+			_z = (matrix.at(0,2) + matrix.at(2,0)) * scale;
+		}
+		else if (m11 >= m22)
+		{
+			_y = 0.5f * std::sqrt(1.0f - m00 + m11 - m22);
+			scale = 0.25f / _y;
+			_w = (matrix.at(0,2) - matrix.at(2,0)) * scale;
+			_x = (matrix.at(0,1) + matrix.at(1,0)) * scale;
+			_z = (matrix.at(1,2) + matrix.at(2,1)) * scale;
+		}
+		else
+		{
+			_z = 0.5f * std::sqrt(1.0f - m00 - m11 + m22);
+			scale = 0.25f / _z;
+			_w = (matrix.at(1,0) - matrix.at(0,1)) * scale;
+			_x = (matrix.at(0,2) + matrix.at(2,0)) * scale;
+			_y = (matrix.at(1,2) + matrix.at(2,1)) * scale;
+		}
+		if (_w < 0.0f)
+			*this = -*this;
+	}
+/**
+Load the unit quaternion given by the exponential map of a rotation vector, \f$q = \cos\frac{\theta}{2} + \frac{\sin(\theta/2)}{\theta}\vec{\omega}\f$ with \f$\theta = |\vec{\omega}|\f$. This is the same rotation as ThreeMatrix::loadExp. For small angles the coefficient is computed from its Taylor series.
+@param rotation the rotation vector: the axis of rotation scaled by the angle of rotation, in radians
+@returns none
+*/
+	void loadExp(const ThreeVector & rotation)
+	{
+		const float SERIES_LIMIT = 1.0e-4f;
+		float x = rotation.getX();
+		float y = rotation.getY();
+		float z = rotation.getZ();
+		float angleSquared = x * x + y * y + z * z;
+		float scale;
+		if (angleSquared < SERIES_LIMIT)
+		{
+			scale = 0.5f - angleSquared / 48.0f * (1.0f - angleSquared / 80.0f);
+			_w = 1.0f - angleSquared / 8.0f * (1.0f - angleSquared / 48.0f);
+		}
+		else
+		{
+			float angle = std::sqrt(angleSquared);
+			scale = std::sin(0.5f * angle) / angle;
+			_w = std::cos(0.5f * angle);
+		}
+		_x = x * scale;
+		_y = y * scale;
+		_z = z * scale;
+	}
+/**
+Get the logarithm map of a unit quaternion, the inverse of loadExp. The shorter of the two equivalent rotations is returned, so q and -q give the same result; small angles use a series for \f$\theta / \sin(\theta/2)\f$.
+@returns the rotation vector: the axis of rotation scaled by the angle of rotation, in radians, in \f$[0, \pi]\f$
+*/
+	ThreeVector log(void) const
+	{
+		const float SERIES_LIMIT = 1.0e-2f;
+		float sine = std::sqrt(_x * _x + _y * _y + _z * _z);
+		float cosine = std::fabs(_w);
+		float scale;
+		if (sine < SERIES_LIMIT * cosine)
+		{
+			// 2 atan(t) / s with t = s / |w| is 2 (1 - t^2 / 3 + t^4 / 5) / |w|
+			float ratio = sine / cosine;
+			float ratioSquared = ratio * ratio;
+			scale = 2.0f * (1.0f - ratioSquared * (1.0f / 3.0f - ratioSquared * 0.2f)) / cosine;
+		}
+		else
+			scale = 2.0f * std::atan2(sine,cosine) / sine;
+		if (_w < 0.0f)
+			scale = -scale;
+		return ThreeVector(_x * scale,_y * scale,_z * scale);
+	}
+/**
+Interpolate between this quaternion and another by normalized linear interpolation, taking the shorter path. This is the cheapest interpolation, but the angular speed is not constant: for a rotation of 180 degrees the angle at the midpoint is correct and the largest error, about 0.142 radians, occurs near t = 0.24 and 0.76, where \f$1 / ((1 - t)^2 + t^2) = \pi / 2\f$.
+@param to the quaternion at t = 1
+@param t the interpolation parameter, from 0 to 1
+@returns the interpolated unit quaternion
+*/
+	Quaternion nlerp(const Quaternion & to, float t) const
+	{
+		LINALG_COUNT(QUATERNION_NLERP,34,52);
+		Quaternion end = dot(to) < 0.0f ? -to : to;
+		return (*this * (1.0f - t) + end * t).unit();
+	}
+/**
+Interpolate between this quaternion and another by spherical linear interpolation, taking the shorter path, so that the rotation proceeds about a fixed axis at a constant rate. Both quaternions are assumed to be unit quaternions. The angle between them is found from the chord lengths, which is accurate for all angles, and nearly equal quaternions are interpolated linearly.
+@param to the quaternion at t = 1
+@param t the interpolation parameter, from 0 to 1
+@returns the interpolated unit quaternion
+*/
+	Quaternion slerp(const Quaternion & to, float t) const
+	{
+		LINALG_COUNT(QUATERNION_SLERP,130,52);
+		const float LINEAR_LIMIT = 1.0e-4f;
+		Quaternion end = dot(to) < 0.0f ? -to : to;
+		float angle = 2.0f * std::atan2((*this - end).magnitude(),(*this + end).magnitude());
+		float sine = std::sin(angle);
+		if (sine < LINEAR_LIMIT)
+			return (*this * (1.0f - t) + end * t).unit();
+		return (*this * (std::sin((1.0f - t) * angle) / sine) + end * (std::sin(t * angle) / sine)).unit();
+	}
+/**
+Load the identity rotation \f$1 + 0 i + 0 j + 0 k\f$
+@returns none
+*/
+	void loadIdentity(void)
+	{
+		_w = 1.0;
+		_x = _y = _z = 0.0;
+	}
+};
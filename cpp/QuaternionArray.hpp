@@ -0,0 +1,307 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <Quaternion.hpp>
+#include <SinCos.hpp>
+#include <ArcTangent.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of quaternions stored as separate w, x, y and z component arrays (structure of arrays)
+@details The interpolation kernels process one quaternion per SIMD lane and split the work between threads. Three interpolations are offered, from cheapest to most accurate, with errors given as the largest error in the angle of the interpolated rotation for rotations of up to 90 and 180 degrees between the end points:
+- normalized linear interpolation (nlerp): 0.016 and 0.142 radians
+- approximate slerp, which is nlerp with the interpolation parameter corrected by a polynomial in t and the cosine of the angle (A. Kapoulkine, "Approximating slerp", 2015): \f$7 \times 10^{-5}\f$ and \f$8 \times 10^{-4}\f$ radians
+- spherical linear interpolation (slerp), with the sines and the angle computed by SinCos and ArcTangent: a few times \f$10^{-7}\f$ radians
+All three take the shorter path and return unit quaternions.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class QuaternionArray
+{
+private:
+	static const long GRAIN = 16384;
+	static const int NLERP = 0;
+	static const int APPROXIMATE_SLERP = 1;
+	static const int SLERP = 2;
+	std::vector<float> _w;
+	std::vector<float> _x;
+	std::vector<float> _y;
+	std::vector<float> _z;
+
+	// interpolates from a to b by the given method; b is negated if needed to take the shorter path
+	template <int METHOD> static void interpolate(float t, float aw, float ax, float ay, float az, float bw, float bx, float by, float bz, float & w, float & x, float & y, float & z)
+	{
+		const float LINEAR_LIMIT = 1.0e-4f;
+		float cosine = aw * bw + ax * bx + ay * by + az * bz;
+		float sign = cosine < 0.0f ? -1.0f : 1.0f;
+		bw *= sign;
+		bx *= sign;
+		by *= sign;
+		bz *= sign;
+		cosine = std::fabs(cosine);
+		float weightA = 1.0f - t;
+		float weightB = t;
+		if (METHOD == APPROXIMATE_SLERP)
+		{
+			float a = 1.0904f + cosine * (-3.2452f + cosine * (3.55645f - cosine * 1.43519f));
+			float b = 0.848013f + cosine * (-1.06021f + cosine * 0.215638f);
+			float offset = t - 0.5f;
+			weightB = t + t * offset * (t - 1.0f) * (a * offset * offset + b);
+			weightA = 1.0f - weightB;
+		}
+		if (METHOD == SLERP)
+		{
+			float dw = aw - bw;
+			float dx = ax - bx;
+			float dy = ay - by;
+			float dz = az - bz;
+			float sw = aw + bw;
+			float sx = ax + bx;
+			float sy = ay + by;
+			float sz = az + bz;
+			float angle = 2.0f * ArcTangent::compute(std::sqrt(dw * dw + dx * dx + dy * dy + dz * dz),std::sqrt(sw * sw + sx * sx + sy * sy + sz * sz));
+			float sine,unused,sineA,sineB;
+			SinCos::compute(angle,sine,unused);
+			SinCos::compute((1.0f - t) * angle,sineA,unused);
+			SinCos::compute(t * angle,sineB,unused);
+			int linear = sine < LINEAR_LIMIT;
+			float inverse = 1.0f / (linear ? 1.0f : sine);
+			weightA = linear ? weightA : sineA * inverse;
+			weightB = linear ? weightB : sineB * inverse;
+		}
+		w = weightA * aw + weightB * bw;
+		x = weightA * ax + weightB * bx;
+		y = weightA * ay + weightB * by;
+		z = weightA * az + weightB * bz;
+		float norm = w * w + x * x + y * y + z * z;
+		float scale = norm > 0.0f ? 1.0f / std::sqrt(norm > 0.0f ? norm : 1.0f) : 0.0f;
+		w *= scale;
+		x *= scale;
+		y *= scale;
+		z *= scale;
+	}
+	// interpolates every quaternion, with the parameter for index i given by parameter(i)
+	template <int METHOD, typename Parameter> void interpolateAll(const QuaternionArray & from, const QuaternionArray & to, const Parameter & parameter)
+	{
+		resize(from.size());
+		const float * aw = from.w();
+		const float * ax = from.x();
+		const float * ay = from.y();
+		const float * az = from.z();
+		const float * bw = to.w();
+		const float * bx = to.x();
+		const float * by = to.y();
+		const float * bz = to.z();
+		float * rw = w();
+		float * rx = x();
+		float * ry = y();
+		float * rz = z();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float qw,qx,qy,qz;
+				interpolate<METHOD>(parameter(TcI),aw[TcI],ax[TcI],ay[TcI],az[TcI],bw[TcI],bx[TcI],by[TcI],bz[TcI],qw,qx,qy,qz);
+				rw[TcI] = qw;
+				rx[TcI] = qx;
+				ry[TcI] = qy;
+				rz[TcI] = qz;
+			}
+		});
+	}
+public:
+	QuaternionArray(void)
+	{
+	}
+/**
+QuaternionArray constructor
+@param size The number of quaternions in the array; all quaternions are initialized to the identity
+*/
+	explicit QuaternionArray(int size)
+	{
+		resize(size);
+	}
+/**
+QuaternionArray constructor
+@param data An std::vector<Quaternion> with which to initialize the array
+*/
+	QuaternionArray(const std::vector<Quaternion> &data)
+	{
+		int TcI;
+		resize((int)data.size());
+		for (TcI = 0; TcI < size(); TcI++)
+			setAt(TcI,data[TcI]);
+	}
+/**
+Get the number of quaternions in the array
+@returns The number of quaternions
+*/
+	int size(void) const {return (int)_w.size();}
+/**
+Change the number of quaternions in the array. New quaternions are initialized to the identity.
+@param size The new number of quaternions
+@returns none
+*/
+	void resize(int size)
+	{
+		if (size < 0)
+			size = 0;
+		_w.resize(size,1.0f);
+		_x.resize(size,0.0f);
+		_y.resize(size,0.0f);
+		_z.resize(size,0.0f);
+	}
+/**
+Get direct access to the scalar parts
+@returns A pointer to the scalar part of the first quaternion
+*/
+	float * w(void) {return _w.data();}
+	const float * w(void) const {return _w.data();}
+/**
+Get direct access to the i components
+@returns A pointer to the i component of the first quaternion
+*/
+	float * x(void) {return _x.data();}
+	const float * x(void) const {return _x.data();}
+/**
+Get direct access to the j components
+@returns A pointer to the j component of the first quaternion
+*/
+	float * y(void) {return _y.data();}
+	const float * y(void) const {return _y.data();}
+/**
+Get direct access to the k components
+@returns A pointer to the k component of the first quaternion
+*/
+	float * z(void) {return _z.data();}
+	const float * z(void) const {return _z.data();}
+
+/**
+Retreive the quaternion at the given index, zero indexed
+@param idx the zero indexed quaternion to retrieve
+@returns the quaternion at the index, the identity otherwise
+*/
+	Quaternion at(int idx) const
+	{
+		if (idx >= 0 && idx < size())
+			return Quaternion(_w[idx],_x[idx],_y[idx],_z[idx]);
+		else
+			return Quaternion();
+	}
+/**
+Set the quaternion at the given index, zero indexed
+@param idx the zero indexed quaternion to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const Quaternion & value)
+	{
+		if (idx >= 0 && idx < size())
+		{
+			_w[idx] = value.getW();
+			_x[idx] = value.getX();
+			_y[idx] = value.getY();
+			_z[idx] = value.getZ();
+		}
+	}
+/**
+Convert the array to an array of Quaternions
+@returns an std::vector<Quaternion> containing the quaternions
+*/
+	std::vector<Quaternion> toVector(void) const
+	{
+		int TcI;
+		std::vector<Quaternion> ret(size());
+		for (TcI = 0; TcI < size(); TcI++)
+			ret[TcI] = at(TcI);
+		return ret;
+	}
+
+/**
+Load every quaternion with the normalized linear interpolation of two others, as Quaternion::nlerp
+@param from the quaternions at t = 0
+@param to the quaternions at t = 1; must have the same size as from
+@param t the interpolation parameter of each quaternion; must have the same size as from
+@returns none
+*/
+	void loadNlerp(const QuaternionArray & from, const QuaternionArray & to, const std::vector<float> & t)
+	{
+		const float * parameter = t.data();
+		if (to.size() == from.size() && (int)t.size() == from.size())
+		{
+			LINALG_COUNT(QUATERNION_ARRAY_NLERP,30L * from.size(),52L * from.size());
+			interpolateAll<NLERP>(from,to,[parameter](long idx){return parameter[idx];});
+		}
+	}
+/**
+Load every quaternion with the approximate spherical linear interpolation of two others. The error is given in the class description.
+@param from the quaternions at t = 0
+@param to the quaternions at t = 1; must have the same size as from
+@param t the interpolation parameter of each quaternion; must have the same size as from
+@returns none
+*/
+	void loadApproximateSlerp(const QuaternionArray & from, const QuaternionArray & to, const std::vector<float> & t)
+	{
+		const float * parameter = t.data();
+		if (to.size() == from.size() && (int)t.size() == from.size())
+		{
+			LINALG_COUNT(QUATERNION_ARRAY_APPROXIMATE_SLERP,45L * from.size(),52L * from.size());
+			interpolateAll<APPROXIMATE_SLERP>(from,to,[parameter](long idx){return parameter[idx];});
+		}
+	}
+/**
+Load every quaternion with the spherical linear interpolation of two others, as Quaternion::slerp
+@param from the quaternions at t = 0
+@param to the quaternions at t = 1; must have the same size as from
+@param t the interpolation parameter of each quaternion; must have the same size as from
+@returns none
+*/
+	void loadSlerp(const QuaternionArray & from, const QuaternionArray & to, const std::vector<float> & t)
+	{
+		const float * parameter = t.data();
+		if (to.size() == from.size() && (int)t.size() == from.size())
+		{
+			LINALG_COUNT(QUATERNION_ARRAY_SLERP,130L * from.size(),52L * from.size());
+			interpolateAll<SLERP>(from,to,[parameter](long idx){return parameter[idx];});
+		}
+	}
+/**
+Sample a set of animation tracks at a given time and load the result, in a single pass. Each track interpolates from one keyframe to the next, and the interpolation parameter of each track, \f$t = (time - start) / (end - start)\f$ clamped to [0, 1], is computed in the same loop as the interpolation rather than stored. A track whose end time equals its start time takes the end value once the time is reached.
+@param from the keyframe values at the start times
+@param to the keyframe values at the end times; must have the same size as from
+@param startTimes the time of the keyframe in from, for each track; must have the same size as from
+@param endTimes the time of the keyframe in to, for each track; must have the same size as from
+@param time the time at which to sample
+@param exact true to interpolate with slerp, false to use the approximate slerp
+@returns none
+*/
+	void loadSample(const QuaternionArray & from, const QuaternionArray & to, const std::vector<float> & startTimes, const std::vector<float> & endTimes, float time, bool exact = false)
+	{
+		const float * start = startTimes.data();
+		const float * end = endTimes.data();
+		auto parameter = [start,end,time](long idx)
+		{
+			float span = end[idx] - start[idx];
+			float t = span > 0.0f ? (time - start[idx]) / (span > 0.0f ? span : 1.0f) : (time >= end[idx] ? 1.0f : 0.0f);
+			t = t < 0.0f ? 0.0f : t;
+			return t > 1.0f ? 1.0f : t;
+		};
+		if (to.size() != from.size() || (int)startTimes.size() != from.size() || (int)endTimes.size() != from.size())
+			return;
+		if (exact)
+		{
+			LINALG_COUNT(QUATERNION_ARRAY_SLERP,135L * from.size(),60L * from.size());
+			interpolateAll<SLERP>(from,to,parameter);
+		}
+		else
+		{
+			LINALG_COUNT(QUATERNION_ARRAY_APPROXIMATE_SLERP,50L * from.size(),60L * from.size());
+			interpolateAll<APPROXIMATE_SLERP>(from,to,parameter);
+		}
+	}
+};
@@ -0,0 +1,336 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <ThreeVector.hpp>
+#include <ThreeVectorArray.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+
+/**
+@brief A packet of W rays in structure of arrays form
+@details W is normally 8 or 16, matching the width of AVX or AVX-512 registers.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+template <int W> class RayPacket
+{
+public:
+	float originX[W];
+	float originY[W];
+	float originZ[W];
+	float directionX[W];
+	float directionY[W];
+	float directionZ[W];
+/**
+Set one lane of the packet
+@param lane the zero indexed lane to set
+@param origin the origin of the ray
+@param direction the direction of the ray; need not be normalized
+@returns none
+*/
+	void setRay(int lane, const ThreeVector & origin, const ThreeVector & direction)
+	{
+		if (lane >= 0 && lane < W)
+		{
+			originX[lane] = origin.getX();
+			originY[lane] = origin.getY();
+			originZ[lane] = origin.getZ();
+			directionX[lane] = direction.getX();
+			directionY[lane] = direction.getY();
+			directionZ[lane] = direction.getZ();
+		}
+	}
+};
+
+/**
+@brief A packet of W triangles in structure of arrays form
+@details Each triangle is stored as its first vertex and the two edges leaving it, which is the form used by the Moller-Trumbore test.
+*/
+template <int W> class TrianglePacket
+{
+public:
+	float vertexX[W];
+	float vertexY[W];
+	float vertexZ[W];
+	float edge1X[W];
+	float edge1Y[W];
+	float edge1Z[W];
+	float edge2X[W];
+	float edge2Y[W];
+	float edge2Z[W];
+/**
+Set one lane of the packet
+@param lane the zero indexed lane to set
+@param vertex0 the first vertex of the triangle
+@param vertex1 the second vertex of the triangle
+@param vertex2 the third vertex of the triangle
+@returns none
+*/
+	void setTriangle(int lane, const ThreeVector & vertex0, const ThreeVector & vertex1, const ThreeVector & vertex2)
+	{
+		if (lane >= 0 && lane < W)
+		{
+			ThreeVector edge1 = vertex1 - vertex0;
+			ThreeVector edge2 = vertex2 - vertex0;
+			vertexX[lane] = vertex0.getX();
+			vertexY[lane] = vertex0.getY();
+			vertexZ[lane] = vertex0.getZ();
+			edge1X[lane] = edge1.getX();
+			edge1Y[lane] = edge1.getY();
+			edge1Z[lane] = edge1.getZ();
+			edge2X[lane] = edge2.getX();
+			edge2Y[lane] = edge2.getY();
+			edge2Z[lane] = edge2.getZ();
+		}
+	}
+/**
+Fill every lane with a degenerate triangle that is never hit, for padding partially filled packets
+@returns none
+*/
+	void loadEmpty(void)
+	{
+		int TcI;
+		for (TcI = 0; TcI < W; TcI++)
+		{
+			vertexX[TcI] = vertexY[TcI] = vertexZ[TcI] = 0.0;
+			edge1X[TcI] = edge1Y[TcI] = edge1Z[TcI] = 0.0;
+			edge2X[TcI] = edge2Y[TcI] = edge2Z[TcI] = 0.0;
+		}
+	}
+};
+
+/**
+@brief The result of a packet intersection test
+@details Bit i of mask is set if lane i hit. For lanes that hit, distance is the ray parameter t of the hit point (origin + t direction) and the barycentric coordinates of the hit point are (1 - u - v, u, v). The contents of lanes that missed are unspecified.
+*/
+template <int W> class HitPacket
+{
+public:
+	unsigned int mask;
+	float distance[W];
+	float u[W];
+	float v[W];
+};
+
+/**
+@brief Moller-Trumbore ray-triangle intersection, for single rays and for packets of rays or triangles
+@details The packet kernels evaluate all W lanes without branches, in loops that the compiler vectorizes, and report the hits as a bit mask. Ray packets share a triangle and triangle packets share a ray, covering both coherent primary rays and a single ray traversing a leaf full of triangles.
+
+The distance and the barycentric coordinates of a hit are each within 4 ulp of a size that grows with the distance of the origin from the triangle and with one over the determinant \f$\vec{e}_1 \cdot (\vec{d} \times \vec{e}_2)\f$; a hit closer to an edge than that error may be reported as a miss, or the reverse. A ray is counted as parallel to the triangle when the determinant is below a fixed \f$10^{-8}\f$, so triangles smaller than about \f$10^{-4}\f$, for a unit direction, are always missed; scale such scenes up.
+*/
+class RayTriangle
+{
+private:
+	static constexpr float EPSILON = 1.0e-8f;
+
+	template <typename Hit> static void rayKernel(long count, const float * originX, const float * originY, const float * originZ, const float * directionX, const float * directionY, const float * directionZ, const ThreeVector & vertex0, const ThreeVector & vertex1, const ThreeVector & vertex2, float tMin, float tMax, Hit * hit, float * distance, float * u, float * v)
+	{
+		long TcI;
+		ThreeVector edge1 = vertex1 - vertex0;
+		ThreeVector edge2 = vertex2 - vertex0;
+		const float e1x = edge1.getX(), e1y = edge1.getY(), e1z = edge1.getZ();
+		const float e2x = edge2.getX(), e2y = edge2.getY(), e2z = edge2.getZ();
+		const float v0x = vertex0.getX(), v0y = vertex0.getY(), v0z = vertex0.getZ();
+#pragma omp simd
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			float dx = directionX[TcI], dy = directionY[TcI], dz = directionZ[TcI];
+			float px = dy * e2z - dz * e2y;
+			float py = dz * e2x - dx * e2z;
+			float pz = dx * e2y - dy * e2x;
+			float det = e1x * px + e1y * py + e1z * pz;
+			float invDet = 1.0f / det;
+			float tx = originX[TcI] - v0x;
+			float ty = originY[TcI] - v0y;
+			float tz = originZ[TcI] - v0z;
+			float uu = (tx * px + ty * py + tz * pz) * invDet;
+			float qx = ty * e1z - tz * e1y;
+			float qy = tz * e1x - tx * e1z;
+			float qz = tx * e1y - ty * e1x;
+			float vv = (dx * qx + dy * qy + dz * qz) * invDet;
+			float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+			u[TcI] = uu;
+			v[TcI] = vv;
+			distance[TcI] = t;
+			hit[TcI] = (std::fabs(det) >= EPSILON) & (uu >= 0.0f) & (vv >= 0.0f) & (uu + vv <= 1.0f) & (t > tMin) & (t < tMax);
+		}
+	}
+public:
+/**
+Intersect one ray with one triangle, using ThreeVector. This is the scalar reference for the packet kernels.
+@param origin the origin of the ray
+@param direction the direction of the ray
+@param vertex0 the first vertex of the triangle
+@param vertex1 the second vertex of the triangle
+@param vertex2 the third vertex of the triangle
+@param tMin the smallest ray parameter that counts as a hit
+@param tMax the largest ray parameter that counts as a hit
+@param distance receives the ray parameter of the hit point
+@param u receives the barycentric coordinate of the hit point with respect to vertex1
+@param v receives the barycentric coordinate of the hit point with respect to vertex2
+@returns true if the ray hits the triangle between tMin and tMax
+*/
+	static bool intersect(const ThreeVector & origin, const ThreeVector & direction, const ThreeVector & vertex0, const ThreeVector & vertex1, const ThreeVector & vertex2, float tMin, float tMax, float & distance, float & u, float & v)
+	{
+		ThreeVector edge1 = vertex1 - vertex0;
+		ThreeVector edge2 = vertex2 - vertex0;
+		ThreeVector pvec = direction.cross(edge2);
+		float det = edge1.dot(pvec);
+		if (std::fabs(det) < EPSILON)
+			return false;
+		float invDet = 1.0 / det;
+		ThreeVector tvec = origin - vertex0;
+		u = tvec.dot(pvec) * invDet;
+		if (u < 0.0 || u > 1.0)
+			return false;
+		ThreeVector qvec = tvec.cross(edge1);
+		v = direction.dot(qvec) * invDet;
+		if (v < 0.0 || u + v > 1.0)
+			return false;
+		distance = edge2.dot(qvec) * invDet;
+		return distance > tMin && distance < tMax;
+	}
+/**
+Intersect a packet of W rays with one triangle
+@param rays the rays
+@param vertex0 the first vertex of the triangle
+@param vertex1 the second vertex of the triangle
+@param vertex2 the third vertex of the triangle
+@param tMin the smallest ray parameter that counts as a hit
+@param tMax the largest ray parameter that counts as a hit
+@param hits receives the hit mask, distances and barycentric coordinates
+@returns the hit mask
+*/
+	template <int W> static unsigned int intersect(const RayPacket<W> & rays, const ThreeVector & vertex0, const ThreeVector & vertex1, const ThreeVector & vertex2, float tMin, float tMax, HitPacket<W> & hits)
+	{
+		LINALG_COUNT(RAY_TRIANGLE_PACKET,40L * W,37L * W + 36);
+		int TcI;
+		int hit[W];
+		rayKernel(W,rays.originX,rays.originY,rays.originZ,rays.directionX,rays.directionY,rays.directionZ,vertex0,vertex1,vertex2,tMin,tMax,hit,hits.distance,hits.u,hits.v);
+		hits.mask = 0;
+		for (TcI = 0; TcI < W; TcI++)
+			hits.mask |= (unsigned int)hit[TcI] << TcI;
+		return hits.mask;
+	}
+/**
+Intersect one ray with a packet of W triangles
+@param origin the origin of the ray
+@param direction the direction of the ray
+@param triangles the triangles
+@param tMin the smallest ray parameter that counts as a hit
+@param tMax the largest ray parameter that counts as a hit
+@param hits receives the hit mask, distances and barycentric coordinates
+@returns the hit mask
+*/
+	template <int W> static unsigned int intersect(const ThreeVector & origin, const ThreeVector & direction, const TrianglePacket<W> & triangles, float tMin, float tMax, HitPacket<W> & hits)
+	{
+		LINALG_COUNT(RAY_TRIANGLE_PACKET,34L * W,48L * W + 24);
+		int TcI;
+		int hit[W];
+		const float ox = origin.getX(), oy = origin.getY(), oz = origin.getZ();
+		const float dx = direction.getX(), dy = direction.getY(), dz = direction.getZ();
+#pragma omp simd
+		for (TcI = 0; TcI < W; TcI++)
+		{
+			float e1x = triangles.edge1X[TcI], e1y = triangles.edge1Y[TcI], e1z = triangles.edge1Z[TcI];
+			float e2x = triangles.edge2X[TcI], e2y = triangles.edge2Y[TcI], e2z = triangles.edge2Z[TcI];
+			float px = dy * e2z - dz * e2y;
+			float py = dz * e2x - dx * e2z;
+			float pz = dx * e2y - dy * e2x;
+			float det = e1x * px + e1y * py + e1z * pz;
+			float invDet = 1.0f / det;
+			float tx = ox - triangles.vertexX[TcI];
+			float ty = oy - triangles.vertexY[TcI];
+			float tz = oz - triangles.vertexZ[TcI];
+			float u = (tx * px + ty * py + tz * pz) * invDet;
+			float qx = ty * e1z - tz * e1y;
+			float qy = tz * e1x - tx * e1z;
+			float qz = tx * e1y - ty * e1x;
+			float v = (dx * qx + dy * qy + dz * qz) * invDet;
+			float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+			hits.u[TcI] = u;
+			hits.v[TcI] = v;
+			hits.distance[TcI] = t;
+			hit[TcI] = (std::fabs(det) >= EPSILON) & (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (t > tMin) & (t < tMax);
+		}
+		hits.mask = 0;
+		for (TcI = 0; TcI < W; TcI++)
+			hits.mask |= (unsigned int)hit[TcI] << TcI;
+		return hits.mask;
+	}
+/**
+Intersect a stream of rays with one triangle. The stream is processed directly in its structure of arrays form, in runs of W rays split between threads.
+@param origins the origins of the rays
+@param directions the directions of the rays; must have the same size as origins
+@param vertex0 the first vertex of the triangle
+@param vertex1 the second vertex of the triangle
+@param vertex2 the third vertex of the triangle
+@param tMin the smallest ray parameter that counts as a hit
+@param tMax the largest ray parameter that counts as a hit
+@param hit receives 1 for each ray that hits and 0 otherwise; resized to the number of rays
+@param distance receives the ray parameter of each hit; resized to the number of rays
+@param u receives the barycentric coordinate of each hit with respect to vertex1; resized to the number of rays
+@param v receives the barycentric coordinate of each hit with respect to vertex2; resized to the number of rays
+@returns the number of rays that hit
+*/
+	template <int W> static long intersectStream(const ThreeVectorArray & origins, const ThreeVectorArray & directions, const ThreeVector & vertex0, const ThreeVector & vertex1, const ThreeVector & vertex2, float tMin, float tMax, std::vector<unsigned char> & hit, std::vector<float> & distance, std::vector<float> & u, std::vector<float> & v)
+	{
+		long count = origins.size() < directions.size() ? origins.size() : directions.size();
+		LINALG_COUNT(RAY_TRIANGLE_STREAM,40L * count,37L * count);
+		long packets = (count + W - 1) / W;
+		hit.resize(count);
+		distance.resize(count);
+		u.resize(count);
+		v.resize(count);
+		return (long)ThreadPool::instance().parallelSum(0,packets,256,[&](long first, long last)
+		{
+			long TcI;
+			long hits = 0;
+			long begin = first * W;
+			long end = last * W < count ? last * W : count;
+			rayKernel(end - begin,origins.x() + begin,origins.y() + begin,origins.z() + begin,directions.x() + begin,directions.y() + begin,directions.z() + begin,vertex0,vertex1,vertex2,tMin,tMax,hit.data() + begin,distance.data() + begin,u.data() + begin,v.data() + begin);
+			for (TcI = begin; TcI < end; TcI++)
+				hits += hit[TcI];
+			return (double)hits;
+		});
+	}
+/**
+Find the closest triangle hit by a ray among the triangles in a set of packets
+@param origin the origin of the ray
+@param direction the direction of the ray
+@param triangles the triangle packets; pad partially filled packets with TrianglePacket::loadEmpty
+@param tMin the smallest ray parameter that counts as a hit
+@param tMax the largest ray parameter that counts as a hit
+@param distance receives the ray parameter of the closest hit
+@param u receives the barycentric coordinate of the closest hit with respect to the second vertex
+@param v receives the barycentric coordinate of the closest hit with respect to the third vertex
+@returns the index of the closest triangle (packet * W + lane), or -1 if no triangle was hit
+*/
+	template <int W> static long closestHit(const ThreeVector & origin, const ThreeVector & direction, const std::vector<TrianglePacket<W> > & triangles, float tMin, float tMax, float & distance, float & u, float & v)
+	{
+		size_t TcP;
+		int TcI;
+		long ret = -1;
+		HitPacket<W> result = HitPacket<W>();
+		for (TcP = 0; TcP < triangles.size(); TcP++)
+		{
+			unsigned int mask = intersect(origin,direction,triangles[TcP],tMin,tMax,result);
+			for (TcI = 0; mask != 0; TcI++, mask >>= 1)
+			{
+				if ((mask & 1) && result.distance[TcI] < tMax)
+				{
+					tMax = result.distance[TcI];
+					u = result.u[TcI];
+					v = result.v[TcI];
+					ret = (long)TcP * W + TcI;
+				}
+			}
+		}
+		if (ret >= 0)
+			distance = tMax;
+		return ret;
+	}
+};
+
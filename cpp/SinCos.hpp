@@ -0,0 +1,71 @@
+#pragma once
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief A vectorizable single precision sine and cosine
+@details The angle is reduced to \f$r \in [-\pi/4, \pi/4]\f$ by subtracting the nearest multiple of \f$\pi/2\f$ in three parts (Cody-Waite), and minimax polynomials (from the Cephes library) give \f$\sin r\f$ and \f$\cos r\f$; the quadrant then selects and negates them. There are no branches or table lookups, so a loop of calls vectorizes. For \f$|x| \le 8192\f$ the error is at most 2 ulp of the result, or about \f$10^{-7}\f$ absolute where the result is near zero; the error grows beyond that because the reduction is not exact, and \f$|x| > 10^5\f$ should be reduced by the caller.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class SinCos
+{
+private:
+	static constexpr float TWO_OVER_PI = 0.636619772367581343f;
+	static constexpr float PI_OVER_2_A = 1.5703125f;
+	static constexpr float PI_OVER_2_B = 4.837512969970703125e-4f;
+	static constexpr float PI_OVER_2_C = 7.54978995489188216e-8f;
+	static constexpr float ROUNDING = 12582912.0f;
+public:
+/**
+Compute the sine and cosine of an angle
+@param angle the angle, in radians
+@param sine receives \f$\sin x\f$
+@param cosine receives \f$\cos x\f$
+@returns none
+*/
+	static void compute(float angle, float & sine, float & cosine)
+	{
+		// adding and removing 1.5 * 2^23 rounds to the nearest integer without a call to floor, which does not vectorize
+		float quadrant = (angle * TWO_OVER_PI + ROUNDING) - ROUNDING;
+		float r = ((angle - quadrant * PI_OVER_2_A) - quadrant * PI_OVER_2_B) - quadrant * PI_OVER_2_C;
+		float r2 = r * r;
+		float s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+		float c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+		int q = (int)quadrant;
+		float swapS = (q & 1) ? c : s;
+		float swapC = (q & 1) ? s : c;
+		sine = (q & 2) ? -swapS : swapS;
+		cosine = ((q + 1) & 2) ? -swapC : swapC;
+	}
+/**
+Compute the sines and cosines of an array of angles. The work is split between threads.
+@param count the number of angles
+@param angles the angles, in radians
+@param sines receives the sines; may not overlap angles
+@param cosines receives the cosines; may not overlap angles
+@returns none
+*/
+	static void compute(long count, const float * angles, float * sines, float * cosines)
+	{
+		LINALG_COUNT(SINCOS_ARRAY,20L * count,12L * count);
+		ThreadPool::instance().parallelFor(0,count,16384,[&](long first, long last)
+		{
+			long TcI;
+			const float * a = angles;
+			float * s = sines;
+			float * c = cosines;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float sine,cosine;
+				compute(a[TcI],sine,cosine);
+				s[TcI] = sine;
+				c[TcI] = cosine;
+			}
+		});
+	}
+};
+
@@ -0,0 +1,117 @@
+#pragma once
+#include <chrono>
+#include <vector>
+/**
+@brief Per-iteration residual and timing history of an iterative solver
+@details Storage for the history is reserved when a solve starts, so that recording an iteration does not allocate memory.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class SolverTelemetry
+{
+private:
+	std::vector<double> _residuals;
+	std::vector<double> _seconds;
+	std::chrono::steady_clock::time_point _start;
+	std::chrono::steady_clock::time_point _last;
+	bool _converged;
+public:
+	SolverTelemetry(void)
+	{
+		_converged = false;
+	}
+/**
+Clear the history and start the clock
+@param maxIterations the number of iterations for which to reserve storage
+@returns none
+*/
+	void start(int maxIterations)
+	{
+		_residuals.clear();
+		_seconds.clear();
+		_residuals.reserve(maxIterations + 1);
+		_seconds.reserve(maxIterations + 1);
+		_converged = false;
+		_start = _last = std::chrono::steady_clock::now();
+	}
+/**
+Record the end of an iteration
+@param residual the relative residual norm \f$\|\vec{r}\| / \|\vec{b}\|\f$ at the end of the iteration
+@returns none
+*/
+	void record(double residual)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		_residuals.push_back(residual);
+		_seconds.push_back(std::chrono::duration<double>(now - _last).count());
+		_last = now;
+	}
+/**
+Mark the solve as finished
+@param converged true if the residual reached the requested tolerance
+@returns none
+*/
+	void finish(bool converged)
+	{
+		_converged = converged;
+	}
+/**
+Get the number of iterations recorded. The first entry is the initial residual, so this is one more than the number of iterations performed.
+@returns the number of entries in the history
+*/
+	int entries(void) const {return (int)_residuals.size();}
+/**
+Get the number of iterations performed
+@returns the number of iterations
+*/
+	int iterations(void) const {return _residuals.empty() ? 0 : (int)_residuals.size() - 1;}
+/**
+Determine if the last solve converged
+@returns true if the residual reached the requested tolerance
+*/
+	bool converged(void) const {return _converged;}
+/**
+Get the relative residual norm recorded for an entry
+@param entry the zero indexed entry; entry 0 is the initial residual
+@returns the relative residual norm, or 0 if entry is out of range
+*/
+	double residual(int entry) const
+	{
+		if (entry >= 0 && entry < entries())
+			return _residuals[entry];
+		else
+			return 0.0;
+	}
+/**
+Get the wall clock time spent on an entry
+@param entry the zero indexed entry; entry 0 is the setup before the first iteration
+@returns the time in seconds, or 0 if entry is out of range
+*/
+	double seconds(int entry) const
+	{
+		if (entry >= 0 && entry < entries())
+			return _seconds[entry];
+		else
+			return 0.0;
+	}
+/**
+Get the final relative residual norm
+@returns the last recorded relative residual norm
+*/
+	double finalResidual(void) const
+	{
+		return _residuals.empty() ? 0.0 : _residuals.back();
+	}
+/**
+Get the wall clock time of the whole solve
+@returns the total time in seconds
+*/
+	double totalSeconds(void) const
+	{
+		return std::chrono::duration<double>(_last - _start).count();
+	}
+};
+
@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <Vector.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+
+/**
+@brief A c++ implementation of a sparse matrix in compressed sparse row (CSR) form
+@details Each row stores the column indices and values of its nonzero elements contiguously, in column order. Matrix-vector products are split between threads by row ranges that each hold about the same number of nonzero elements, so that a few dense rows do not leave the other threads idle. Use SparseMatrixBuilder to assemble a matrix from (row, column, value) triplets.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class SparseMatrix
+{
+private:
+	int _rows;
+	int _columns;
+	std::vector<int> _rowStart;
+	std::vector<int> _columnIndex;
+	std::vector<float> _values;
+	std::vector<int> _partition;
+	std::vector<int> _spanFirst;
+	std::vector<int> _spanEnd;
+	std::vector<long> _spanOffset;
+
+	void partition(void)
+	{
+		int TcI;
+		int parts = ThreadPool::instance().size();
+		long nonzeros = (long)_values.size();
+		_partition.resize(parts + 1);
+		_partition[0] = 0;
+		for (TcI = 1; TcI < parts; TcI++)
+		{
+			long target = nonzeros * TcI / parts;
+			_partition[TcI] = (int)(std::lower_bound(_rowStart.begin(),_rowStart.end(),(int)target) - _rowStart.begin());
+			if (_partition[TcI] > _rows)
+				_partition[TcI] = _rows;
+			if (_partition[TcI] < _partition[TcI - 1])
+				_partition[TcI] = _partition[TcI - 1];
+		}
+		_partition[parts] = _rows;
+		// the range of columns each part touches, and where its share of the scratch for transposeMultiply starts
+		_spanFirst.assign(parts,0);
+		_spanEnd.assign(parts,0);
+		_spanOffset.assign(parts + 1,0);
+		for (TcI = 0; TcI < parts; TcI++)
+		{
+			int first = _columns, end = 0;
+			int TcJ;
+			for (TcJ = _partition[TcI]; TcJ < _partition[TcI + 1]; TcJ++)
+			{
+				if (_rowStart[TcJ + 1] > _rowStart[TcJ])
+				{
+					first = std::min(first,_columnIndex[_rowStart[TcJ]]);
+					end = std::max(end,_columnIndex[_rowStart[TcJ + 1] - 1] + 1);
+				}
+			}
+			_spanFirst[TcI] = end > first ? first : 0;
+			_spanEnd[TcI] = end > first ? end : 0;
+			_spanOffset[TcI + 1] = _spanOffset[TcI] + (_spanEnd[TcI] - _spanFirst[TcI]);
+		}
+	}
+public:
+	SparseMatrix(void)
+	{
+		_rows = _columns = 0;
+		_rowStart.assign(1,0);
+		partition();
+	}
+/**
+SparseMatrix constructor from compressed sparse row arrays. Column indices within each row are expected to be in increasing order.
+@param rows the number of rows
+@param columns the number of columns
+@param rowStart an array of rows + 1 offsets; the nonzero elements of row i are at [rowStart[i], rowStart[i + 1])
+@param columnIndex the column index of each nonzero element
+@param values the value of each nonzero element
+*/
+	SparseMatrix(int rows, int columns, const std::vector<int> & rowStart, const std::vector<int> & columnIndex, const std::vector<float> & values)
+	{
+		_rows = rows > 0 ? rows : 0;
+		_columns = columns > 0 ? columns : 0;
+		if ((int)rowStart.size() == _rows + 1 && columnIndex.size() == values.size() && rowStart[_rows] == (int)values.size())
+		{
+			_rowStart = rowStart;
+			_columnIndex = columnIndex;
+			_values = values;
+		}
+		else
+			_rowStart.assign(_rows + 1,0);
+		partition();
+	}
+/**
+Get the number of rows
+@returns the number of rows
+*/
+	int rows(void) const {return _rows;}
+/**
+Get the number of columns
+@returns the number of columns
+*/
+	int columns(void) const {return _columns;}
+/**
+Get the number of stored (nonzero) elements
+@returns the number of stored elements
+*/
+	int nonzeros(void) const {return (int)_values.size();}
+/**
+Get the row offsets
+@returns the rows + 1 offsets into the column index and value arrays
+*/
+	const std::vector<int> & rowStart(void) const {return _rowStart;}
+/**
+Get the column indices of the stored elements
+@returns the column index of each stored element
+*/
+	const std::vector<int> & columnIndex(void) const {return _columnIndex;}
+/**
+Get the values of the stored elements
+@returns the value of each stored element
+*/
+	const std::vector<float> & values(void) const {return _values;}
+
+/**
+Retreive the value of the element at the given row and column, zero indexed. The row is searched for the column, so this is not intended for use in inner loops.
+@param row the zero indexed row from which to retrieve an element
+@param column the zero indexed column from which to retrieve an element
+@returns the value at the selected row and column, 0 if it is not stored or out of range
+*/
+	float at(int row, int column) const
+	{
+		if (row >= 0 && row < _rows && column >= 0 && column < _columns)
+		{
+			std::vector<int>::const_iterator first = _columnIndex.begin() + _rowStart[row];
+			std::vector<int>::const_iterator last = _columnIndex.begin() + _rowStart[row + 1];
+			std::vector<int>::const_iterator found = std::lower_bound(first,last,column);
+			if (found != last && *found == column)
+				return _values[found - _columnIndex.begin()];
+		}
+		return 0.0;
+	}
+/**
+Get the diagonal of the matrix
+@returns a Vector containing the diagonal elements
+*/
+	Vector diagonal(void) const
+	{
+		int TcI;
+		int count = _rows < _columns ? _rows : _columns;
+		Vector ret(count);
+		for (TcI = 0; TcI < count; TcI++)
+			ret[TcI] = at(TcI,TcI);
+		return ret;
+	}
+
+/**
+Perform a matrix multiplication with a column vector, \f$\vec{y} = A \vec{x}\f$, into existing storage. No memory is allocated if result already has the correct size.
+@param vector the Vector by which the matrix is multiplied; must have columns() elements
+@param result the Vector that receives the product; resized to rows() elements
+@returns none
+*/
+	void multiply(const Vector & vector, Vector & result) const
+	{
+		if (vector.size() != _columns)
+			return;
+		LINALG_COUNT(SPARSE_MULTIPLY,2L * nonzeros(),12L * nonzeros() + 8L * _rows);
+		if (result.size() != _rows)
+			result.resize(_rows);
+		const float * x = vector.data();
+		float * y = result.data();
+		ThreadPool::instance().run((int)_partition.size() - 1,[&](int part)
+		{
+			int TcI,TcK;
+			for (TcI = _partition[part]; TcI < _partition[part + 1]; TcI++)
+			{
+				float sum = 0.0;
+				int last = _rowStart[TcI + 1];
+#pragma omp simd reduction(+:sum)
+				for (TcK = _rowStart[TcI]; TcK < last; TcK++)
+					sum += _values[TcK] * x[_columnIndex[TcK]];
+				y[TcI] = sum;
+			}
+		});
+	}
+/**
+Perform a matrix multiplication with a column vector
+@param vector the Vector by which the matrix is multiplied
+@returns a Vector containing the product, or an empty Vector if the sizes do not agree
+*/
+	Vector operator *(const Vector & vector) const
+	{
+		Vector ret;
+		if (vector.size() == _columns)
+			multiply(vector,ret);
+		return ret;
+	}
+/**
+Perform a multiplication of the transpose of the matrix with a column vector, \f$\vec{y} = A^T \vec{x}\f$, into existing storage. Each thread accumulates its share of the rows into a private buffer that covers only the columns those rows touch, and the buffers are then summed. When the buffers together would be larger than the matrix itself, as for a matrix whose rows each span most of the columns, the product is accumulated directly on the calling thread instead.
+@param vector the Vector by which the transposed matrix is multiplied; must have rows() elements
+@param result the Vector that receives the product; resized to columns() elements
+@returns none
+*/
+	void transposeMultiply(const Vector & vector, Vector & result) const
+	{
+		int parts = (int)_partition.size() - 1;
+		if (vector.size() != _rows)
+			return;
+		long buffered = _spanOffset[parts];
+		bool serial = parts <= 1 || buffered > nonzeros() + (long)_columns;
+		LINALG_COUNT(SPARSE_MULTIPLY,2L * nonzeros() + (serial ? 0L : buffered),12L * nonzeros() + 8L * _rows + 4L * _columns + (serial ? 0L : 8L * buffered));
+		if (result.size() != _columns)
+			result.resize(_columns);
+		const float * x = vector.data();
+		float * y = result.data();
+		if (serial)
+		{
+			int TcI,TcK;
+			std::fill(y,y + _columns,0.0f);
+			for (TcI = 0; TcI < _rows; TcI++)
+			{
+				float xi = x[TcI];
+				for (TcK = _rowStart[TcI]; TcK < _rowStart[TcI + 1]; TcK++)
+					y[_columnIndex[TcK]] += _values[TcK] * xi;
+			}
+			return;
+		}
+		static thread_local std::vector<float> scratch;
+		scratch.assign((size_t)buffered,0.0f);
+		// thread_local variables are not captured by the lambdas, so the workers must be given the calling thread's buffer
+		float * base = scratch.data();
+		ThreadPool & pool = ThreadPool::instance();
+		pool.run(parts,[&](int part)
+		{
+			int TcI,TcK;
+			float * buffer = base + _spanOffset[part];
+			int offset = _spanFirst[part];
+			for (TcI = _partition[part]; TcI < _partition[part + 1]; TcI++)
+			{
+				float xi = x[TcI];
+				int last = _rowStart[TcI + 1];
+				for (TcK = _rowStart[TcI]; TcK < last; TcK++)
+					buffer[_columnIndex[TcK] - offset] += _values[TcK] * xi;
+			}
+		});
+		pool.parallelFor(0,_columns,4096,[&](long first, long last)
+		{
+			long TcJ;
+			int TcP;
+			for (TcJ = first; TcJ < last; TcJ++)
+			{
+				float sum = 0.0;
+				for (TcP = 0; TcP < parts; TcP++)
+				{
+					if (TcJ >= _spanFirst[TcP] && TcJ < _spanEnd[TcP])
+						sum += base[_spanOffset[TcP] + TcJ - _spanFirst[TcP]];
+				}
+				y[TcJ] = sum;
+			}
+		});
+	}
+/**
+Perform a multiplication of the transpose of the matrix with a column vector
+@param vector the Vector by which the transposed matrix is multiplied
+@returns a Vector containing the product, or an empty Vector if the sizes do not agree
+*/
+	Vector transposeMultiply(const Vector & vector) const
+	{
+		Vector ret;
+		if (vector.size() == _rows)
+			transposeMultiply(vector,ret);
+		return ret;
+	}
+};
+
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <SparseMatrix.hpp>
+#include <TripletList.hpp>
+
+/**
+@brief Assembles a SparseMatrix from (row, column, value) triplets
+@details Triplets may be added in any order. Triplets that share a row and column are summed, as is usual when assembling finite element matrices. The triplets are kept in a TripletList, which buckets them by row with a counting sort, so that building is linear in the number of triplets apart from the sort of each row by column.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class SparseMatrixBuilder
+{
+private:
+	TripletList<float> _triplets;
+public:
+/**
+SparseMatrixBuilder constructor
+@param rows the number of rows of the matrix to build
+@param columns the number of columns of the matrix to build
+*/
+	SparseMatrixBuilder(int rows, int columns) : _triplets(rows,columns)
+	{
+	}
+/**
+Reserve storage for a number of triplets
+@param count the expected number of triplets
+@returns none
+*/
+	void reserve(int count)
+	{
+		_triplets.reserve(count);
+	}
+/**
+Add a value to the element at the given row and column. Triplets outside of the matrix are ignored.
+@param row the zero indexed row of the element
+@param column the zero indexed column of the element
+@param value the value to add to the element
+@returns none
+*/
+	void add(int row, int column, float value)
+	{
+		_triplets.add(row,column,value);
+	}
+/**
+Remove all triplets
+@returns none
+*/
+	void clear(void)
+	{
+		_triplets.clear();
+	}
+/**
+Build the sparse matrix
+@returns a SparseMatrix containing the sum of all triplets
+*/
+	SparseMatrix build(void) const
+	{
+		std::vector<int> rowStart;
+		std::vector<int> columnIndex;
+		std::vector<float> values;
+		_triplets.compress(rowStart,columnIndex,values);
+		return SparseMatrix(_triplets.rows(),_triplets.columns(),rowStart,columnIndex,values);
+	}
+};
+
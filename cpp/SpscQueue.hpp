@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+/**
+@brief A bounded, lock-free queue for exactly one producer thread and one consumer thread
+@details The queue is a ring buffer whose capacity is rounded up to a power of two. The producer owns the tail and the consumer the head, each on its own cache line, and each keeps a private copy of the other's index that it refreshes only when the queue appears full or empty, so in steady state a push or pop touches no cache line written by the other thread. push() and pop() wait, spinning briefly and then yielding, which is how a full queue applies backpressure to the stage that feeds it.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+template <typename T> class SpscQueue
+{
+private:
+	static const int SPINS = 64;
+	std::vector<T> _slots;
+	unsigned long _mask;
+	alignas(64) std::atomic<unsigned long> _head;
+	unsigned long _cachedTail;
+	alignas(64) std::atomic<unsigned long> _tail;
+	unsigned long _cachedHead;
+
+	static void wait(int & spins)
+	{
+		if (spins < SPINS)
+			spins++;
+		else
+			std::this_thread::yield();
+	}
+public:
+/**
+SpscQueue constructor
+@param capacity the largest number of elements the queue holds; rounded up to a power of two, and at least 2
+*/
+	explicit SpscQueue(int capacity)
+	{
+		unsigned long size = 2;
+		while (size < (unsigned long)capacity)
+			size *= 2;
+		_slots.resize(size);
+		_mask = size - 1;
+		_head = 0;
+		_tail = 0;
+		_cachedHead = 0;
+		_cachedTail = 0;
+	}
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue & operator =(const SpscQueue &) = delete;
+
+/**
+Get the number of elements the queue can hold
+@returns the capacity
+*/
+	int capacity(void) const {return (int)_slots.size();}
+/**
+Add an element if there is room. Call only from the producer thread.
+@param value the element to add
+@returns true if the element was added, false if the queue is full
+*/
+	bool tryPush(const T & value)
+	{
+		unsigned long tail = _tail.load(std::memory_order_relaxed);
+		if (tail - _cachedHead > _mask)
+		{
+			_cachedHead = _head.load(std::memory_order_acquire);
+			if (tail - _cachedHead > _mask)
+				return false;
+		}
+		_slots[tail & _mask] = value;
+		_tail.store(tail + 1,std::memory_order_release);
+		return true;
+	}
+/**
+Remove the oldest element if there is one. Call only from the consumer thread.
+@param value receives the element
+@returns true if an element was removed, false if the queue is empty
+*/
+	bool tryPop(T & value)
+	{
+		unsigned long head = _head.load(std::memory_order_relaxed);
+		if (head == _cachedTail)
+		{
+			_cachedTail = _tail.load(std::memory_order_acquire);
+			if (head == _cachedTail)
+				return false;
+		}
+		value = _slots[head & _mask];
+		_head.store(head + 1,std::memory_order_release);
+		return true;
+	}
+/**
+Add an element, waiting while the queue is full. Call only from the producer thread.
+@param value the element to add
+@returns none
+*/
+	void push(const T & value)
+	{
+		int spins = 0;
+		while (!tryPush(value))
+			wait(spins);
+	}
+/**
+Remove the oldest element, waiting while the queue is empty. Call only from the consumer thread.
+@returns the element
+*/
+	T pop(void)
+	{
+		T value;
+		int spins = 0;
+		while (!tryPop(value))
+			wait(spins);
+		return value;
+	}
+};
@@ -0,0 +1,237 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <OperationCounters.hpp>
+/**
+@brief A persistent pool of worker threads used by the bulk kernels
+@details The pool is created on first use and sized to the hardware concurrency. Work is submitted as a range that is split into chunks; the calling thread participates in the work, and calls made from inside a worker run inline so that kernels may be nested safely. Workers run each chunk at the OperationCounters depth of the submitting thread, so that the work of a counted kernel is counted once.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ThreadPool
+{
+private:
+	std::vector<std::thread> _workers;
+	std::mutex _submitMutex;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	const void * _task;
+	void (*_invoke)(const void *, int);
+	std::atomic<int> _nextChunk;
+	int _numChunks;
+	int _active;
+	int _countLevel;
+	unsigned long _generation;
+	bool _stop;
+
+	static bool & insideWorker(void)
+	{
+		static thread_local bool inside = false;
+		return inside;
+	}
+
+	void runChunks(void)
+	{
+		int chunk;
+		while ((chunk = _nextChunk.fetch_add(1)) < _numChunks)
+			_invoke(_task,chunk);
+	}
+
+	void workerLoop(void)
+	{
+		unsigned long seen = 0;
+		insideWorker() = true;
+		while (true)
+		{
+			int level;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_wake.wait(lock,[&]{return _stop || _generation != seen;});
+				if (_stop)
+					return;
+				seen = _generation;
+				level = _countLevel;
+			}
+			{
+				// the chunks belong to the operation on the submitting thread, so they are counted (or not) as if run there
+				OperationCounters::Inherit inherit(level);
+				runChunks();
+			}
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_active--;
+				if (_active == 0)
+					_done.notify_one();
+			}
+		}
+	}
+
+	ThreadPool(void)
+	{
+		int TcI;
+		int count = (int)std::thread::hardware_concurrency();
+		_task = nullptr;
+		_invoke = nullptr;
+		_nextChunk = 0;
+		_numChunks = 0;
+		_active = 0;
+		_countLevel = 0;
+		_generation = 0;
+		_stop = false;
+		for (TcI = 1; TcI < count; TcI++)
+			_workers.emplace_back([this]{workerLoop();});
+	}
+public:
+	~ThreadPool(void)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_wake.notify_all();
+		for (auto & worker : _workers)
+			worker.join();
+	}
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool & operator =(const ThreadPool &) = delete;
+
+/**
+Get the process wide thread pool
+@returns the thread pool
+*/
+	static ThreadPool & instance(void)
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+/**
+Get the number of threads that participate in a parallel loop, including the calling thread
+@returns the number of threads
+*/
+	int size(void) const
+	{
+		return (int)_workers.size() + 1;
+	}
+/**
+Run a function over chunk indices [0, numChunks) using all threads in the pool. Returns once every chunk has been processed. No memory is allocated to submit the work.
+@param numChunks the number of chunks
+@param task the function to call for each chunk index
+@returns none
+*/
+	template <typename Task> void run(int numChunks, const Task & task)
+	{
+		int TcI;
+		if (numChunks <= 0)
+			return;
+		if (numChunks == 1 || _workers.empty() || insideWorker())
+		{
+			for (TcI = 0; TcI < numChunks; TcI++)
+				task(TcI);
+			return;
+		}
+		std::lock_guard<std::mutex> submit(_submitMutex);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_task = &task;
+			_invoke = [](const void * context, int chunk){(*(const Task *)context)(chunk);};
+			_numChunks = numChunks;
+			_nextChunk = 0;
+			_active = (int)_workers.size();
+			_countLevel = OperationCounters::level();
+			_generation++;
+		}
+		_wake.notify_all();
+		insideWorker() = true;
+		runChunks();
+		insideWorker() = false;
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock,[&]{return _active == 0;});
+		_task = nullptr;
+	}
+/**
+Run a function over the range [begin, end), split into contiguous pieces of at least grain elements
+@param begin the first index
+@param end one past the last index
+@param grain the minimum number of indices given to a single call; ranges smaller than this run on the calling thread
+@param body a function called as body(first, last) for each piece
+@returns none
+*/
+	template <typename Body> void parallelFor(long begin, long end, long grain, const Body & body)
+	{
+		long count = end - begin;
+		if (count <= 0)
+			return;
+		if (grain < 1)
+			grain = 1;
+		long chunks = count / grain;
+		long maxChunks = (long)size() * 4;
+		if (chunks > maxChunks)
+			chunks = maxChunks;
+		if (chunks <= 1)
+		{
+			body(begin,end);
+			return;
+		}
+		long step = (count + chunks - 1) / chunks;
+		run((int)chunks,[&](int chunk)
+		{
+			long first = begin + chunk * step;
+			long last = first + step;
+			if (last > end)
+				last = end;
+			if (first < last)
+				body(first,last);
+		});
+	}
+/**
+Compute a sum over the range [begin, end) in parallel. The range is split as for parallelFor, and the partial sums are added in a fixed order once all pieces are complete.
+@param begin the first index
+@param end one past the last index
+@param grain the minimum number of indices given to a single call
+@param body a function called as body(first, last) for each piece, returning the partial sum for that piece
+@returns the total of the partial sums
+*/
+	template <typename Body> double parallelSum(long begin, long end, long grain, const Body & body)
+	{
+		const long maxPartials = 256;
+		double partial[maxPartials];
+		long TcI;
+		long count = end - begin;
+		if (count <= 0)
+			return 0.0;
+		if (grain < 1)
+			grain = 1;
+		long chunks = count / grain;
+		long maxChunks = (long)size() * 4;
+		if (maxChunks > maxPartials)
+			maxChunks = maxPartials;
+		if (chunks > maxChunks)
+			chunks = maxChunks;
+		if (chunks <= 1)
+			return body(begin,end);
+		long step = (count + chunks - 1) / chunks;
+		for (TcI = 0; TcI < chunks; TcI++)
+			partial[TcI] = 0.0;
+		run((int)chunks,[&](int chunk)
+		{
+			long first = begin + chunk * step;
+			long last = first + step;
+			if (last > end)
+				last = end;
+			if (first < last)
+				partial[chunk] = body(first,last);
+		});
+		double sum = 0.0;
+		for (TcI = 0; TcI < chunks; TcI++)
+			sum += partial[TcI];
+		return sum;
+	}
+};
+
@@ -158,6 +158,7 @@ Perform a matrix multiplication with a column vector
 */
 	ThreeVector operator *(const ThreeVector &vector) const
 	{
+		LINALG_COUNT(MATRIX_TRANSFORM,15,60);
 		return ThreeVector(_data[0][0] * vector._x + _data[0][1] * vector._y + _data[0][2] * vector._z,
 						_data[1][0] * vector._x + _data[1][1] * vector._y + _data[1][2] * vector._z,
 						_data[2][0] * vector._x + _data[2][1] * vector._y + _data[2][2] * vector._z
@@ -189,6 +190,7 @@ Perform a matrix multiplication with a ThreeMatrix
 */
 	ThreeMatrix operator *(const ThreeMatrix &matrix) const
 	{
+		LINALG_COUNT(MATRIX_PRODUCT,45,108);
 		ThreeMatrix ret;
 
 		int TcI,TcJ;
@@ -279,6 +281,7 @@ Get the determinant of the matrix
 */
 	float determinant(void) const
 	{
+		LINALG_COUNT(MATRIX_DETERMINANT,14,40);
 		return _data[0][0] * (_data[1][1] * _data[2][2] - _data[1][2] * _data[2][1]) +
 				_data[0][1] * (_data[1][2] * _data[2][0] - _data[1][0] * _data[2][2]) +
 				_data[0][2] * (_data[1][0] * _data[2][1] - _data[1][1] * _data[2][0]);
@@ -298,6 +301,7 @@ Get the inverse of the matrix
 */
 	ThreeMatrix invert(void) const
 	{
+		LINALG_COUNT(MATRIX_INVERT,51,72);
 		ThreeMatrix ret;
 		float det = determinant();
 		if (det != 0.0)
@@ -348,4 +352,237 @@ Load the identity matrix
 			}
 		}
 	}
+/**
+Load a rotation matrix about the x axis, which rotates a vector counterclockwise when viewed from positive x
+@param angle the angle of rotation, in radians
+@returns none
+*/
+	void loadRotationX(float angle)
+	{
+		float c = std::cos(angle);
+		float s = std::sin(angle);
+		loadIdentity();
+		_data[1][1] = c;
+		_data[1][2] = -s;
+		_data[2][1] = s;
+		_data[2][2] = c;
+	}
+/**
+Load a rotation matrix about the y axis, which rotates a vector counterclockwise when viewed from positive y
+@param angle the angle of rotation, in radians
+@returns none
+*/
+	void loadRotationY(float angle)
+	{
+		float c = std::cos(angle);
+		float s = std::sin(angle);
+		loadIdentity();
+		_data[0][0] = c;
+		_data[0][2] = s;
+		_data[2][0] = -s;
+		_data[2][2] = c;
+	}
+/**
+Load a rotation matrix about the z axis, which rotates a vector counterclockwise when viewed from positive z
+@param angle the angle of rotation, in radians
+@returns none
+*/
+	void loadRotationZ(float angle)
+	{
+		float c = std::cos(angle);
+		float s = std::sin(angle);
+		loadIdentity();
+		_data[0][0] = c;
+		_data[0][1] = -s;
+		_data[1][0] = s;
+		_data[1][1] = c;
+	}
+/**
+Load a rotation matrix about an arbitrary axis, using Rodrigues' formula \f$R = I + \sin\theta K + (1 - \cos\theta) K^2\f$, where K is the cross product matrix of the unit axis
+@param axis the axis of rotation; it need not be a unit vector. A zero axis gives the identity matrix.
+@param angle the angle of rotation, in radians, counterclockwise when viewed from the tip of the axis
+@returns none
+*/
+	void loadRotation(const ThreeVector & axis, float angle)
+	{
+		ThreeVector direction = axis;
+		ThreeVector k = direction.unit();
+		float c = std::cos(angle);
+		float s = std::sin(angle);
+		float t = 1.0f - c;
+		// K^2 = k k^T - I for a unit k, and zero for a zero axis
+		float scale = k.dot(k);
+		_data[0][0] = 1.0f + t * (k._x * k._x - scale);
+		_data[0][1] = t * k._x * k._y - s * k._z;
+		_data[0][2] = t * k._x * k._z + s * k._y;
+		_data[1][0] = t * k._y * k._x + s * k._z;
+		_data[1][1] = 1.0f + t * (k._y * k._y - scale);
+		_data[1][2] = t * k._y * k._z - s * k._x;
+		_data[2][0] = t * k._z * k._x - s * k._y;
+		_data[2][1] = t * k._z * k._y + s * k._x;
+		_data[2][2] = 1.0f + t * (k._z * k._z - scale);
+	}
+/**
+Load a rotation matrix from Euler angles. The rotations are about the fixed x, y and z axes, applied in that order, so that \f$R = R_z(z) R_y(y) R_x(x)\f$.
+@param x the angle of rotation about the x axis, in radians
+@param y the angle of rotation about the y axis, in radians
+@param z the angle of rotation about the z axis, in radians
+@returns none
+*/
+	void loadEulerRotation(float x, float y, float z)
+	{
+		float cx = std::cos(x);
+		float sx = std::sin(x);
+		float cy = std::cos(y);
+		float sy = std::sin(y);
+		float cz = std::cos(z);
+		float sz = std::sin(z);
+		_data[0][0] = cz * cy;
+		_data[0][1] = cz * sy * sx - sz * cx;
+		_data[0][2] = cz * sy * cx + sz * sx;
+		_data[1][0] = sz * cy;
+		_data[1][1] = sz * sy * sx + cz * cx;
+		_data[1][2] = sz * sy * cx - cz * sx;
+		_data[2][0] = -sy;
+		_data[2][1] = cy * sx;
+		_data[2][2] = cy * cx;
+	}
+/**
+Load the rotation matrix given by the exponential map of a rotation vector, \f$R = e^{[\vec{\omega}]_\times} = I + \frac{\sin\theta}{\theta}[\vec{\omega}]_\times + \frac{1 - \cos\theta}{\theta^2}[\vec{\omega}]_\times^2\f$ with \f$\theta = |\vec{\omega}|\f$. For small angles the coefficients are computed from their Taylor series, so the result is accurate down to and including the zero vector.
+@param rotation the rotation vector: the axis of rotation scaled by the angle of rotation, in radians
+@returns none
+*/
+	void loadExp(const ThreeVector & rotation)
+	{
+		const float SERIES_LIMIT = 1.0e-4f;
+		float x = rotation._x;
+		float y = rotation._y;
+		float z = rotation._z;
+		float angleSquared = x * x + y * y + z * z;
+		float a,b;
+		if (angleSquared < SERIES_LIMIT)
+		{
+			a = 1.0f - angleSquared / 6.0f * (1.0f - angleSquared / 20.0f);
+			b = 0.5f - angleSquared / 24.0f * (1.0f - angleSquared / 30.0f);
+		}
+		else
+		{
+			float angle = std::sqrt(angleSquared);
+			float halfSine = std::sin(0.5f * angle);
+			a = std::sin(angle) / angle;
+			// 1 - cos(t) = 2 sin^2(t/2) avoids cancellation
+			b = 2.0f * halfSine * halfSine / angleSquared;
+		}
+		_data[0][0] = 1.0f + b * (x * x - angleSquared);
+		_data[0][1] = b * x * y - a * z;
+		_data[0][2] = b * x * z + a * y;
+		_data[1][0] = b * y * x + a * z;
+		_data[1][1] = 1.0f + b * (y * y - angleSquared);
+		_data[1][2] = b * y * z - a * x;
+		_data[2][0] = b * z * x - a * y;
+		_data[2][1] = b * z * y + a * x;
+		_data[2][2] = 1.0f + b * (z * z - angleSquared);
+	}
+/**
+Get the logarithm map of a rotation matrix, the inverse of loadExp. The angle is found from both its sine and its cosine, so it is accurate over the whole range; small angles use a series for \f$\theta / \sin\theta\f$, and angles near \f$\pi\f$, where the antisymmetric part of the matrix vanishes, recover the axis from the symmetric part instead. The matrix is assumed to be a rotation.
+@returns the rotation vector: the axis of rotation scaled by the angle of rotation, in radians, in \f$[0, \pi]\f$
+*/
+	ThreeVector log(void) const
+	{
+		const float SERIES_LIMIT = 1.0e-2f;
+		int TcI,TcJ;
+		float k[3];
+		float vx = _data[2][1] - _data[1][2];
+		float vy = _data[0][2] - _data[2][0];
+		float vz = _data[1][0] - _data[0][1];
+		float cosine = 0.5f * (trace() - 1.0f);
+		float sine = 0.5f * std::sqrt(vx * vx + vy * vy + vz * vz);
+		float angle = std::atan2(sine,cosine);
+		if (cosine >= 0.0f)
+		{
+			float scale;
+			if (sine < SERIES_LIMIT)
+			{
+				// theta / sin(theta) = asin(s) / s = 1 + s^2 / 6 + 3 s^4 / 40
+				float sineSquared = sine * sine;
+				scale = 0.5f * (1.0f + sineSquared * (1.0f / 6.0f + sineSquared * 0.075f));
+			}
+			else
+				scale = 0.5f * angle / sine;
+			return ThreeVector(vx * scale,vy * scale,vz * scale);
+		}
+		// R + R^T = 2 cos(theta) I + 2 (1 - cos(theta)) k k^T; the axis is taken from its largest diagonal element
+		float inverse = 1.0f / (1.0f - cosine);
+		TcI = 0;
+		if (_data[1][1] > _data[TcI][TcI])
+			TcI = 1;
+		if (_data[2][2] > _data[TcI][TcI])
+			TcI = 2;
+		k[TcI] = std::sqrt(std::fmax((_data[TcI][TcI] - cosine) * inverse,0.0f));
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			if (TcJ != TcI)
+				k[TcJ] = 0.5f * (_data[TcI][TcJ] + _data[TcJ][TcI]) * inverse / k[TcI];
+		}
+		// the antisymmetric part is 2 sin(theta) k, which fixes the sign of the axis
+		if (k[0] * vx + k[1] * vy + k[2] * vz < 0.0f)
+			angle = -angle;
+		return ThreeVector(k[0] * angle,k[1] * angle,k[2] * angle);
+	}
+/**
+Estimate how far the matrix is from orthonormal, as the largest element of \f$M^T M - I\f$. This takes six dot products, and for a small error \f$\epsilon\f$ the columns have lengths within about \f$\epsilon / 2\f$ of one and are within about \f$\epsilon\f$ radians of perpendicular.
+@returns the largest magnitude of the elements of \f$M^T M - I\f$
+*/
+	float orthogonalityError(void) const
+	{
+		ThreeVector c0 = column(0);
+		ThreeVector c1 = column(1);
+		ThreeVector c2 = column(2);
+		float error = std::fabs(c0.dot(c0) - 1.0f);
+		error = std::fmax(error,std::fabs(c1.dot(c1) - 1.0f));
+		error = std::fmax(error,std::fabs(c2.dot(c2) - 1.0f));
+		error = std::fmax(error,std::fabs(c0.dot(c1)));
+		error = std::fmax(error,std::fabs(c0.dot(c2)));
+		error = std::fmax(error,std::fabs(c1.dot(c2)));
+		return error;
+	}
+/**
+Get an orthonormal matrix by Gram-Schmidt orthogonalization of the columns. The first column keeps its direction, the second keeps the plane of the first two, and the third is their cross product, so the result is always a rotation. This is the cheaper method, but the correction is not shared evenly between the columns.
+@returns A new ThreeMatrix containing the orthonormalized matrix, or a copy of the matrix if either of the first two columns becomes zero
+*/
+	ThreeMatrix orthonormalizeGramSchmidt(void) const
+	{
+		ThreeMatrix ret = *this;
+		ThreeVector c0 = column(0);
+		ThreeVector c1 = column(1);
+		if (c0.dot(c0) == 0.0f)
+			return ret;
+		c0 = c0.unit();
+		c1 = c1 - c0 * c0.dot(c1);
+		if (c1.dot(c1) == 0.0f)
+			return ret;
+		c1 = c1.unit();
+		ret.setColumn(0,c0);
+		ret.setColumn(1,c1);
+		ret.setColumn(2,c0.cross(c1));
+		return ret;
+	}
+/**
+Get the orthonormal matrix nearest to this one (the orthogonal factor of its polar decomposition) by the Newton iteration \f$X_{k+1} = \frac{1}{2}(X_k + X_k^{-T})\f$, which converges quadratically and treats all columns alike. A matrix with a negative determinant converges to an orthonormal matrix with determinant -1.
+@param tolerance the iteration stops once orthogonalityError() is at or below this value
+@param maxIterations the largest number of iterations; a matrix that has drifted slightly needs two or three
+@returns A new ThreeMatrix containing the orthonormalized matrix; iteration stops early if the matrix is singular
+*/
+	ThreeMatrix orthonormalizePolar(float tolerance = 1.0e-6f, int maxIterations = 8) const
+	{
+		int TcI;
+		ThreeMatrix ret = *this;
+		for (TcI = 0; TcI < maxIterations && ret.orthogonalityError() > tolerance; TcI++)
+		{
+			if (ret.determinant() == 0.0f)
+				break;
+			ret = (ret + ret.invert().transpose()) * 0.5f;
+		}
+		return ret;
+	}
 };
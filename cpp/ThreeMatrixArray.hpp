@@ -0,0 +1,839 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <ComponentArray.hpp>
+#include <ThreeMatrix.hpp>
+#include <ThreeVectorArray.hpp>
+#include <SinCos.hpp>
+#include <ArcTangent.hpp>
+#include <ThreeMatrixSVD.hpp>
+#include <ThreadPool.hpp>
+#include <Transpose.hpp>
+#include <OperationCounters.hpp>
+
+/**
+@brief An array of 3x3 matrices stored as nine separate element arrays (structure of arrays)
+@details Element (row, column) of every matrix is stored in its own contiguous array, so that the kernels process one matrix per SIMD lane. The kernels are branch free, and the work is split between threads. Kernels that take a square root only vectorize when the math functions are not required to set errno (-fno-math-errno), since otherwise the compiler must keep a call for negative arguments.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ThreeMatrixArray
+{
+private:
+	static const long GRAIN = 16384;
+	static const long TILE = 256;
+	static const int PACKET = 16;
+	ComponentArray _data[3][3];
+
+	// rotation in the plane of axes a and b, with b following a in the order x, y, z
+	void loadAxisRotation(const std::vector<float> & angles, int a, int b)
+	{
+		LINALG_COUNT(MATRIX_ARRAY_ROTATION,22L * angles.size(),40L * angles.size());
+		int TcJ,TcK;
+		resize((int)angles.size());
+		for (TcJ = 0; TcJ < 3; TcJ++)
+			for (TcK = 0; TcK < 3; TcK++)
+				if (TcJ != a && TcJ != b && TcJ == TcK)
+					std::fill(_data[TcJ][TcK].data(),_data[TcJ][TcK].data() + size(),1.0f);
+				else if (!((TcJ == a || TcJ == b) && (TcK == a || TcK == b)))
+					std::fill(_data[TcJ][TcK].data(),_data[TcJ][TcK].data() + size(),0.0f);
+		const float * theta = angles.data();
+		float * aa = _data[a][a].data();
+		float * ab = _data[a][b].data();
+		float * ba = _data[b][a].data();
+		float * bb = _data[b][b].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float s,c;
+				SinCos::compute(theta[TcI],s,c);
+				aa[TcI] = c;
+				ab[TcI] = -s;
+				ba[TcI] = s;
+				bb[TcI] = c;
+			}
+		});
+	}
+	// the largest element of M^T M - I, from the columns of M
+	static float columnError(float m00, float m01, float m02, float m10, float m11, float m12, float m20, float m21, float m22)
+	{
+		float d00 = std::fabs(m00 * m00 + m10 * m10 + m20 * m20 - 1.0f);
+		float d11 = std::fabs(m01 * m01 + m11 * m11 + m21 * m21 - 1.0f);
+		float d22 = std::fabs(m02 * m02 + m12 * m12 + m22 * m22 - 1.0f);
+		float d01 = std::fabs(m00 * m01 + m10 * m11 + m20 * m21);
+		float d02 = std::fabs(m00 * m02 + m10 * m12 + m20 * m22);
+		float d12 = std::fabs(m01 * m02 + m11 * m12 + m21 * m22);
+		float error = d00 > d11 ? d00 : d11;
+		error = error > d22 ? error : d22;
+		error = error > d01 ? error : d01;
+		error = error > d02 ? error : d02;
+		return error > d12 ? error : d12;
+	}
+	// runs kernel(first, last) on each tile of TILE matrices that holds at least one matrix with an error above tolerance; the kernel must leave the other matrices unchanged
+	template <typename Kernel> long correctTiles(float tolerance, const Kernel & kernel)
+	{
+		const float * m00 = _data[0][0].data();
+		const float * m01 = _data[0][1].data();
+		const float * m02 = _data[0][2].data();
+		const float * m10 = _data[1][0].data();
+		const float * m11 = _data[1][1].data();
+		const float * m12 = _data[1][2].data();
+		const float * m20 = _data[2][0].data();
+		const float * m21 = _data[2][1].data();
+		const float * m22 = _data[2][2].data();
+		return (long)ThreadPool::instance().parallelSum(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI,TcJ;
+			long corrected = 0;
+			for (TcI = first; TcI < last; TcI += TILE)
+			{
+				long end = TcI + TILE < last ? TcI + TILE : last;
+				int count = 0;
+#pragma omp simd reduction(+:count)
+				for (TcJ = TcI; TcJ < end; TcJ++)
+					count += columnError(m00[TcJ],m01[TcJ],m02[TcJ],m10[TcJ],m11[TcJ],m12[TcJ],m20[TcJ],m21[TcJ],m22[TcJ]) > tolerance;
+				if (count > 0)
+					kernel(TcI,end);
+				corrected += count;
+			}
+			return (double)corrected;
+		});
+	}
+	// decomposes the matrices PACKET at a time with ThreeMatrixSVD, calling store(first, count, u, sigma, v) for the count matrices of each packet starting at index first
+	template <typename Store> void decomposePackets(const Store & store) const
+	{
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			int TcJ,TcK;
+			float a[3][3][PACKET];
+			float u[3][3][PACKET];
+			float sigma[3][PACKET];
+			float v[3][3][PACKET];
+			for (TcI = first; TcI < last; TcI += PACKET)
+			{
+				int count = last - TcI < PACKET ? (int)(last - TcI) : PACKET;
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					for (TcK = 0; TcK < 3; TcK++)
+					{
+						const float * source = _data[TcJ][TcK].data() + TcI;
+						std::copy(source,source + count,a[TcJ][TcK]);
+						std::fill(a[TcJ][TcK] + count,a[TcJ][TcK] + PACKET,0.0f);
+					}
+				}
+				ThreeMatrixSVD::compute<PACKET>(a,u,sigma,v);
+				store(TcI,count,u,sigma,v);
+			}
+		});
+	}
+	// computes op(A) op(B) for every matrix, where op transposes its matrix when the flag is set, and stores it in this array or adds it to this array. Every element is loaded before any is stored, so this array may be a or b.
+	template <bool TRANSPOSE_A, bool TRANSPOSE_B, bool ACCUMULATE> void product(const ThreeMatrixArray & a, const ThreeMatrixArray & b)
+	{
+		int TcJ,TcK;
+		const float * pa[3][3];
+		const float * pb[3][3];
+		float * pc[3][3];
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				pa[TcJ][TcK] = TRANSPOSE_A ? a._data[TcK][TcJ].data() : a._data[TcJ][TcK].data();
+				pb[TcJ][TcK] = TRANSPOSE_B ? b._data[TcK][TcJ].data() : b._data[TcJ][TcK].data();
+				pc[TcJ][TcK] = _data[TcJ][TcK].data();
+			}
+		}
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float a00 = pa[0][0][TcI], a01 = pa[0][1][TcI], a02 = pa[0][2][TcI];
+				float a10 = pa[1][0][TcI], a11 = pa[1][1][TcI], a12 = pa[1][2][TcI];
+				float a20 = pa[2][0][TcI], a21 = pa[2][1][TcI], a22 = pa[2][2][TcI];
+				float b00 = pb[0][0][TcI], b01 = pb[0][1][TcI], b02 = pb[0][2][TcI];
+				float b10 = pb[1][0][TcI], b11 = pb[1][1][TcI], b12 = pb[1][2][TcI];
+				float b20 = pb[2][0][TcI], b21 = pb[2][1][TcI], b22 = pb[2][2][TcI];
+				float c00 = a00 * b00 + a01 * b10 + a02 * b20;
+				float c01 = a00 * b01 + a01 * b11 + a02 * b21;
+				float c02 = a00 * b02 + a01 * b12 + a02 * b22;
+				float c10 = a10 * b00 + a11 * b10 + a12 * b20;
+				float c11 = a10 * b01 + a11 * b11 + a12 * b21;
+				float c12 = a10 * b02 + a11 * b12 + a12 * b22;
+				float c20 = a20 * b00 + a21 * b10 + a22 * b20;
+				float c21 = a20 * b01 + a21 * b11 + a22 * b21;
+				float c22 = a20 * b02 + a21 * b12 + a22 * b22;
+				pc[0][0][TcI] = ACCUMULATE ? pc[0][0][TcI] + c00 : c00;
+				pc[0][1][TcI] = ACCUMULATE ? pc[0][1][TcI] + c01 : c01;
+				pc[0][2][TcI] = ACCUMULATE ? pc[0][2][TcI] + c02 : c02;
+				pc[1][0][TcI] = ACCUMULATE ? pc[1][0][TcI] + c10 : c10;
+				pc[1][1][TcI] = ACCUMULATE ? pc[1][1][TcI] + c11 : c11;
+				pc[1][2][TcI] = ACCUMULATE ? pc[1][2][TcI] + c12 : c12;
+				pc[2][0][TcI] = ACCUMULATE ? pc[2][0][TcI] + c20 : c20;
+				pc[2][1][TcI] = ACCUMULATE ? pc[2][1][TcI] + c21 : c21;
+				pc[2][2][TcI] = ACCUMULATE ? pc[2][2][TcI] + c22 : c22;
+			}
+		});
+	}
+	// selects the instance of product for the transposition flags
+	template <bool ACCUMULATE> void product(const ThreeMatrixArray & a, const ThreeMatrixArray & b, bool transposeA, bool transposeB)
+	{
+		if (transposeA)
+		{
+			if (transposeB)
+				product<true,true,ACCUMULATE>(a,b);
+			else
+				product<true,false,ACCUMULATE>(a,b);
+		}
+		else
+		{
+			if (transposeB)
+				product<false,true,ACCUMULATE>(a,b);
+			else
+				product<false,false,ACCUMULATE>(a,b);
+		}
+	}
+public:
+	ThreeMatrixArray(void)
+	{
+	}
+/**
+ThreeMatrixArray constructor
+@param size The number of matrices in the array; all matrices are initialized to zero
+*/
+	explicit ThreeMatrixArray(int size)
+	{
+		resize(size);
+	}
+/**
+ThreeMatrixArray constructor
+@param data An std::vector<ThreeMatrix> with which to initialize the array
+*/
+	ThreeMatrixArray(const std::vector<ThreeMatrix> &data)
+	{
+		int TcI;
+		resize((int)data.size());
+		for (TcI = 0; TcI < size(); TcI++)
+			setAt(TcI,data[TcI]);
+	}
+/**
+Get the number of matrices in the array
+@returns The number of matrices
+*/
+	int size(void) const {return (int)_data[0][0].size();}
+/**
+Change the number of matrices in the array. New matrices are initialized to zero.
+@param size The new number of matrices
+@returns none
+*/
+	void resize(int size)
+	{
+		int TcI,TcJ;
+		if (size < 0)
+			size = 0;
+		for (TcI = 0; TcI < 3; TcI++)
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				_data[TcI][TcJ].resize(size,0.0f);
+	}
+/**
+Make the array refer to existing element arrays, such as a section of a mapped ArrayFile, instead of copying them. They are never written: the first change to an element of the array, including a call to the non-const element(), copies that element's array. Until then they must remain valid.
+@param elements the elements: elements[3 * row + column] points to size floats
+@param size the number of matrices
+@returns none
+*/
+	void share(const float * const elements[9], int size)
+	{
+		int TcI;
+		if (size < 0)
+			size = 0;
+		for (TcI = 0; TcI < 9; TcI++)
+			_data[TcI / 3][TcI % 3].share(elements[TcI],size);
+	}
+/**
+Get direct access to one element of every matrix
+@param row the zero indexed row of the element
+@param column the zero indexed column of the element
+@returns A pointer to the element of the first matrix, or null if row or column is out of range
+*/
+	float * element(int row, int column)
+	{
+		if (row >= 0 && row < 3 && column >= 0 && column < 3)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+	const float * element(int row, int column) const
+	{
+		if (row >= 0 && row < 3 && column >= 0 && column < 3)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+
+/**
+Retreive the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to retrieve
+@returns the matrix at the index, the zero matrix otherwise
+*/
+	ThreeMatrix at(int idx) const
+	{
+		int TcI,TcJ;
+		ThreeMatrix ret;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					ret.setAt(TcI,TcJ,_data[TcI][TcJ][idx]);
+		}
+		return ret;
+	}
+/**
+Set the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const ThreeMatrix & value)
+	{
+		int TcI,TcJ;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					_data[TcI][TcJ][idx] = value.at(TcI,TcJ);
+		}
+	}
+/**
+Load the array from interleaved matrices, nine floats each in row major order, as taken by ThreeMatrix(float *). The array is resized to count.
+@param data the interleaved elements, 9 * count floats
+@param count the number of matrices
+@returns none
+*/
+	void loadInterleaved(const float * data, int count)
+	{
+		int TcI;
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * count);
+		resize(count);
+		float * elements[9];
+		for (TcI = 0; TcI < 9; TcI++)
+			elements[TcI] = _data[TcI / 3][TcI % 3].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			int TcJ;
+			float * range[9];
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				range[TcJ] = elements[TcJ] + first;
+			Transpose::deinterleave9(data + 9 * first,range,last - first);
+		});
+	}
+/**
+Store the array as interleaved matrices, nine floats each in row major order
+@param data receives the interleaved elements; must have room for 9 * size() floats
+@returns none
+*/
+	void storeInterleaved(float * data) const
+	{
+		int TcI;
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * size());
+		const float * elements[9];
+		for (TcI = 0; TcI < 9; TcI++)
+			elements[TcI] = _data[TcI / 3][TcI % 3].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			int TcJ;
+			const float * range[9];
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				range[TcJ] = elements[TcJ] + first;
+			Transpose::interleave9(range,data + 9 * first,last - first);
+		});
+	}
+
+/**
+Load every matrix with a rotation about the x axis, as ThreeMatrix::loadRotationX. The sines and cosines are computed with SinCos.
+@param angles the angles of rotation, in radians; the array is resized to match
+@returns none
+*/
+	void loadRotationX(const std::vector<float> & angles)
+	{
+		loadAxisRotation(angles,1,2);
+	}
+/**
+Load every matrix with a rotation about the y axis, as ThreeMatrix::loadRotationY. The sines and cosines are computed with SinCos.
+@param angles the angles of rotation, in radians; the array is resized to match
+@returns none
+*/
+	void loadRotationY(const std::vector<float> & angles)
+	{
+		loadAxisRotation(angles,2,0);
+	}
+/**
+Load every matrix with a rotation about the z axis, as ThreeMatrix::loadRotationZ. The sines and cosines are computed with SinCos.
+@param angles the angles of rotation, in radians; the array is resized to match
+@returns none
+*/
+	void loadRotationZ(const std::vector<float> & angles)
+	{
+		loadAxisRotation(angles,0,1);
+	}
+/**
+Load every matrix with a rotation about an arbitrary axis, as ThreeMatrix::loadRotation. The sines and cosines are computed with SinCos.
+@param axes the axes of rotation; they need not be unit vectors, and a zero axis gives the identity matrix. Must have the same size as angles.
+@param angles the angles of rotation, in radians; the array is resized to match
+@returns none
+*/
+	void loadRotation(const ThreeVectorArray & axes, const std::vector<float> & angles)
+	{
+		if (axes.size() != (int)angles.size())
+			return;
+		LINALG_COUNT(MATRIX_ARRAY_ROTATION,60L * angles.size(),52L * angles.size());
+		resize((int)angles.size());
+		const float * ax = axes.x();
+		const float * ay = axes.y();
+		const float * az = axes.z();
+		const float * theta = angles.data();
+		float * m00 = _data[0][0].data();
+		float * m01 = _data[0][1].data();
+		float * m02 = _data[0][2].data();
+		float * m10 = _data[1][0].data();
+		float * m11 = _data[1][1].data();
+		float * m12 = _data[1][2].data();
+		float * m20 = _data[2][0].data();
+		float * m21 = _data[2][1].data();
+		float * m22 = _data[2][2].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float s,c;
+				SinCos::compute(theta[TcI],s,c);
+				float norm = ax[TcI] * ax[TcI] + ay[TcI] * ay[TcI] + az[TcI] * az[TcI];
+				float scale = norm > 0.0f ? 1.0f : 0.0f;
+				float invNorm = norm > 0.0f ? 1.0f / std::sqrt(norm) : 0.0f;
+				float kx = ax[TcI] * invNorm;
+				float ky = ay[TcI] * invNorm;
+				float kz = az[TcI] * invNorm;
+				float t = 1.0f - c;
+				m00[TcI] = 1.0f + t * (kx * kx - scale);
+				m01[TcI] = t * kx * ky - s * kz;
+				m02[TcI] = t * kx * kz + s * ky;
+				m10[TcI] = t * ky * kx + s * kz;
+				m11[TcI] = 1.0f + t * (ky * ky - scale);
+				m12[TcI] = t * ky * kz - s * kx;
+				m20[TcI] = t * kz * kx - s * ky;
+				m21[TcI] = t * kz * ky + s * kx;
+				m22[TcI] = 1.0f + t * (kz * kz - scale);
+			}
+		});
+	}
+/**
+Load every matrix with a rotation from Euler angles, as ThreeMatrix::loadEulerRotation, so that \f$R = R_z(z) R_y(y) R_x(x)\f$. The sines and cosines are computed with SinCos.
+@param angles the angles of rotation about the x, y and z axes, in radians; the array is resized to match
+@returns none
+*/
+	void loadEulerRotation(const ThreeVectorArray & angles)
+	{
+		LINALG_COUNT(MATRIX_ARRAY_ROTATION,80L * angles.size(),48L * angles.size());
+		resize(angles.size());
+		const float * x = angles.x();
+		const float * y = angles.y();
+		const float * z = angles.z();
+		float * m00 = _data[0][0].data();
+		float * m01 = _data[0][1].data();
+		float * m02 = _data[0][2].data();
+		float * m10 = _data[1][0].data();
+		float * m11 = _data[1][1].data();
+		float * m12 = _data[1][2].data();
+		float * m20 = _data[2][0].data();
+		float * m21 = _data[2][1].data();
+		float * m22 = _data[2][2].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float sx,cx,sy,cy,sz,cz;
+				SinCos::compute(x[TcI],sx,cx);
+				SinCos::compute(y[TcI],sy,cy);
+				SinCos::compute(z[TcI],sz,cz);
+				m00[TcI] = cz * cy;
+				m01[TcI] = cz * sy * sx - sz * cx;
+				m02[TcI] = cz * sy * cx + sz * sx;
+				m10[TcI] = sz * cy;
+				m11[TcI] = sz * sy * sx + cz * cx;
+				m12[TcI] = sz * sy * cx - cz * sx;
+				m20[TcI] = -sy;
+				m21[TcI] = cy * sx;
+				m22[TcI] = cy * cx;
+			}
+		});
+	}
+/**
+Load every matrix with the exponential map of a rotation vector, as ThreeMatrix::loadExp. Small angles use the same series; the sines and cosines are computed with SinCos. Each element is within 4 ulp of the larger of one and the angle.
+@param rotations the rotation vectors; the array is resized to match
+@returns none
+*/
+	void loadExp(const ThreeVectorArray & rotations)
+	{
+		LINALG_COUNT(MATRIX_ARRAY_EXP,60L * rotations.size(),48L * rotations.size());
+		resize(rotations.size());
+		const float * rx = rotations.x();
+		const float * ry = rotations.y();
+		const float * rz = rotations.z();
+		float * m00 = _data[0][0].data();
+		float * m01 = _data[0][1].data();
+		float * m02 = _data[0][2].data();
+		float * m10 = _data[1][0].data();
+		float * m11 = _data[1][1].data();
+		float * m12 = _data[1][2].data();
+		float * m20 = _data[2][0].data();
+		float * m21 = _data[2][1].data();
+		float * m22 = _data[2][2].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			const float SERIES_LIMIT = 1.0e-4f;
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float x = rx[TcI];
+				float y = ry[TcI];
+				float z = rz[TcI];
+				float angleSquared = x * x + y * y + z * z;
+				int useSeries = angleSquared < SERIES_LIMIT;
+				float safeSquared = useSeries ? 1.0f : angleSquared;
+				float angle = std::sqrt(safeSquared);
+				float halfSine,halfCosine;
+				SinCos::compute(0.5f * angle,halfSine,halfCosine);
+				float a = useSeries ? 1.0f - angleSquared / 6.0f * (1.0f - angleSquared / 20.0f) : 2.0f * halfSine * halfCosine / angle;
+				float b = useSeries ? 0.5f - angleSquared / 24.0f * (1.0f - angleSquared / 30.0f) : 2.0f * halfSine * halfSine / safeSquared;
+				m00[TcI] = 1.0f + b * (x * x - angleSquared);
+				m01[TcI] = b * x * y - a * z;
+				m02[TcI] = b * x * z + a * y;
+				m10[TcI] = b * y * x + a * z;
+				m11[TcI] = 1.0f + b * (y * y - angleSquared);
+				m12[TcI] = b * y * z - a * x;
+				m20[TcI] = b * z * x - a * y;
+				m21[TcI] = b * z * y + a * x;
+				m22[TcI] = 1.0f + b * (z * z - angleSquared);
+			}
+		});
+	}
+/**
+Get the logarithm map of every matrix, as ThreeMatrix::log. Both the small angle series and the recovery of the axis near \f$\pi\f$ are evaluated for every matrix and the result selected, so the kernel has no branches; the angle is computed with ArcTangent. The angle is reduced to \f$[-\pi, \pi]\f$, and each component is within 6 ulp of the reduced angle.
+@param result receives the rotation vectors; resized to size()
+@returns none
+*/
+	void log(ThreeVectorArray & result) const
+	{
+		LINALG_COUNT(MATRIX_ARRAY_LOG,70L * size(),48L * size());
+		result.resize(size());
+		const float * m00 = _data[0][0].data();
+		const float * m01 = _data[0][1].data();
+		const float * m02 = _data[0][2].data();
+		const float * m10 = _data[1][0].data();
+		const float * m11 = _data[1][1].data();
+		const float * m12 = _data[1][2].data();
+		const float * m20 = _data[2][0].data();
+		const float * m21 = _data[2][1].data();
+		const float * m22 = _data[2][2].data();
+		float * rx = result.x();
+		float * ry = result.y();
+		float * rz = result.z();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			const float SERIES_LIMIT = 1.0e-2f;
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float vx = m21[TcI] - m12[TcI];
+				float vy = m02[TcI] - m20[TcI];
+				float vz = m10[TcI] - m01[TcI];
+				float cosine = 0.5f * (m00[TcI] + m11[TcI] + m22[TcI] - 1.0f);
+				float sine = 0.5f * std::sqrt(vx * vx + vy * vy + vz * vz);
+				float angle = ArcTangent::compute(sine,cosine);
+				float sineSquared = sine * sine;
+				int useSeries = sine < SERIES_LIMIT;
+				float scale = useSeries ? 0.5f * (1.0f + sineSquared * (1.0f / 6.0f + sineSquared * 0.075f)) : 0.5f * angle / (useSeries ? 1.0f : sine);
+				// near pi the axis comes from the symmetric part, using its largest diagonal element
+				int nearPi = cosine < 0.0f;
+				float inverse = 1.0f / (nearPi ? 1.0f - cosine : 1.0f);
+				int use1 = m11[TcI] > m00[TcI];
+				float diagonal = use1 ? m11[TcI] : m00[TcI];
+				int use2 = m22[TcI] > diagonal;
+				diagonal = use2 ? m22[TcI] : diagonal;
+				use1 = use1 & !use2;
+				int use0 = !use1 & !use2;
+				float squared = (diagonal - cosine) * inverse;
+				float large = std::sqrt(squared > 0.0f ? squared : 0.0f);
+				float ratio = large > 0.0f ? 0.5f * inverse / (large > 0.0f ? large : 1.0f) : 0.0f;
+				float s01 = (m01[TcI] + m10[TcI]) * ratio;
+				float s02 = (m02[TcI] + m20[TcI]) * ratio;
+				float s12 = (m12[TcI] + m21[TcI]) * ratio;
+				float kx = use0 ? large : (use1 ? s01 : s02);
+				float ky = use1 ? large : (use0 ? s01 : s12);
+				float kz = use2 ? large : (use0 ? s02 : s12);
+				float signedAngle = kx * vx + ky * vy + kz * vz < 0.0f ? -angle : angle;
+				rx[TcI] = nearPi ? kx * signedAngle : vx * scale;
+				ry[TcI] = nearPi ? ky * signedAngle : vy * scale;
+				rz[TcI] = nearPi ? kz * signedAngle : vz * scale;
+			}
+		});
+	}
+/**
+Estimate how far every matrix is from orthonormal, as ThreeMatrix::orthogonalityError
+@param result receives the largest magnitude of the elements of \f$M^T M - I\f$ for each matrix; resized to size()
+@returns none
+*/
+	void orthogonalityError(std::vector<float> & result) const
+	{
+		LINALG_COUNT(MATRIX_ARRAY_ORTHOGONALITY_ERROR,35L * size(),40L * size());
+		result.resize(size());
+		const float * m00 = _data[0][0].data();
+		const float * m01 = _data[0][1].data();
+		const float * m02 = _data[0][2].data();
+		const float * m10 = _data[1][0].data();
+		const float * m11 = _data[1][1].data();
+		const float * m12 = _data[1][2].data();
+		const float * m20 = _data[2][0].data();
+		const float * m21 = _data[2][1].data();
+		const float * m22 = _data[2][2].data();
+		float * error = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				error[TcI] = columnError(m00[TcI],m01[TcI],m02[TcI],m10[TcI],m11[TcI],m12[TcI],m20[TcI],m21[TcI],m22[TcI]);
+		});
+	}
+/**
+Orthonormalize, in place, every matrix whose orthogonalityError is above tolerance, by Gram-Schmidt orthogonalization of the columns as ThreeMatrix::orthonormalizeGramSchmidt. The error is checked for a tile of matrices at a time, and a tile in which every matrix is within tolerance is skipped. Each element of the result is within 4 ulp of the exact Gram-Schmidt result divided by the sine of the angle between the first two columns.
+@param tolerance the largest error that is left uncorrected
+@returns the number of matrices with an error above tolerance
+*/
+	long orthonormalizeGramSchmidt(float tolerance = 0.0f)
+	{
+		LINALG_COUNT(MATRIX_ARRAY_ORTHONORMALIZE,65L * size(),72L * size());
+		float * m00 = _data[0][0].data();
+		float * m01 = _data[0][1].data();
+		float * m02 = _data[0][2].data();
+		float * m10 = _data[1][0].data();
+		float * m11 = _data[1][1].data();
+		float * m12 = _data[1][2].data();
+		float * m20 = _data[2][0].data();
+		float * m21 = _data[2][1].data();
+		float * m22 = _data[2][2].data();
+		return correctTiles(tolerance,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float a00 = m00[TcI];
+				float a01 = m01[TcI];
+				float a02 = m02[TcI];
+				float a10 = m10[TcI];
+				float a11 = m11[TcI];
+				float a12 = m12[TcI];
+				float a20 = m20[TcI];
+				float a21 = m21[TcI];
+				float a22 = m22[TcI];
+				float norm = a00 * a00 + a10 * a10 + a20 * a20;
+				int valid = norm > 0.0f;
+				float scale = 1.0f / std::sqrt(valid ? norm : 1.0f);
+				float ax = a00 * scale;
+				float ay = a10 * scale;
+				float az = a20 * scale;
+				float projection = ax * a01 + ay * a11 + az * a21;
+				float bx = a01 - projection * ax;
+				float by = a11 - projection * ay;
+				float bz = a21 - projection * az;
+				norm = bx * bx + by * by + bz * bz;
+				valid &= norm > 0.0f;
+				scale = 1.0f / std::sqrt(norm > 0.0f ? norm : 1.0f);
+				int correct = valid & (columnError(a00,a01,a02,a10,a11,a12,a20,a21,a22) > tolerance);
+				bx *= scale;
+				by *= scale;
+				bz *= scale;
+				m00[TcI] = correct ? ax : a00;
+				m10[TcI] = correct ? ay : a10;
+				m20[TcI] = correct ? az : a20;
+				m01[TcI] = correct ? bx : a01;
+				m11[TcI] = correct ? by : a11;
+				m21[TcI] = correct ? bz : a21;
+				m02[TcI] = correct ? ay * bz - az * by : a02;
+				m12[TcI] = correct ? az * bx - ax * bz : a12;
+				m22[TcI] = correct ? ax * by - ay * bx : a22;
+			}
+		});
+	}
+/**
+Orthonormalize, in place, every matrix whose orthogonalityError is above tolerance, by a fixed number of the Newton iterations used by ThreeMatrix::orthonormalizePolar. The error is checked for a tile of matrices at a time, and a tile in which every matrix is within tolerance is skipped. Singular matrices are left unchanged.
+@param tolerance the largest error that is left uncorrected
+@param iterations the number of Newton iterations; the error is roughly squared by each, so the default three give the nearest rotation to within 4 ulp for matrices whose elements have drifted by up to about \f$2^{-8}\f$, but not for those that have drifted by \f$2^{-6}\f$ or more, and no number of iterations converges for a nearly rank deficient matrix
+@returns the number of matrices with an error above tolerance
+*/
+	long orthonormalizePolar(float tolerance = 0.0f, int iterations = 3)
+	{
+		LINALG_COUNT(MATRIX_ARRAY_ORTHONORMALIZE,(35L + 50L * iterations) * size(),(36L + 72L * iterations) * size());
+		float * m00 = _data[0][0].data();
+		float * m01 = _data[0][1].data();
+		float * m02 = _data[0][2].data();
+		float * m10 = _data[1][0].data();
+		float * m11 = _data[1][1].data();
+		float * m12 = _data[1][2].data();
+		float * m20 = _data[2][0].data();
+		float * m21 = _data[2][1].data();
+		float * m22 = _data[2][2].data();
+		return correctTiles(tolerance,[&](long first, long last)
+		{
+			long TcI;
+			int TcJ;
+			unsigned char correct[TILE];
+			unsigned char * flag = correct - first;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				flag[TcI] = columnError(m00[TcI],m01[TcI],m02[TcI],m10[TcI],m11[TcI],m12[TcI],m20[TcI],m21[TcI],m22[TcI]) > tolerance;
+			for (TcJ = 0; TcJ < iterations; TcJ++)
+			{
+#pragma omp simd
+				for (TcI = first; TcI < last; TcI++)
+				{
+					float a00 = m00[TcI];
+					float a01 = m01[TcI];
+					float a02 = m02[TcI];
+					float a10 = m10[TcI];
+					float a11 = m11[TcI];
+					float a12 = m12[TcI];
+					float a20 = m20[TcI];
+					float a21 = m21[TcI];
+					float a22 = m22[TcI];
+					// the cofactor matrix is det(A) A^{-T}
+					float c00 = a11 * a22 - a12 * a21;
+					float c01 = a12 * a20 - a10 * a22;
+					float c02 = a10 * a21 - a11 * a20;
+					float c10 = a02 * a21 - a01 * a22;
+					float c11 = a00 * a22 - a02 * a20;
+					float c12 = a01 * a20 - a00 * a21;
+					float c20 = a01 * a12 - a02 * a11;
+					float c21 = a02 * a10 - a00 * a12;
+					float c22 = a00 * a11 - a01 * a10;
+					float det = a00 * c00 + a01 * c01 + a02 * c02;
+					int update = flag[TcI] & (det != 0.0f);
+					float half = 0.5f / (update ? det : 1.0f);
+					flag[TcI] = (unsigned char)update;
+					m00[TcI] = update ? 0.5f * a00 + half * c00 : a00;
+					m01[TcI] = update ? 0.5f * a01 + half * c01 : a01;
+					m02[TcI] = update ? 0.5f * a02 + half * c02 : a02;
+					m10[TcI] = update ? 0.5f * a10 + half * c10 : a10;
+					m11[TcI] = update ? 0.5f * a11 + half * c11 : a11;
+					m12[TcI] = update ? 0.5f * a12 + half * c12 : a12;
+					m20[TcI] = update ? 0.5f * a20 + half * c20 : a20;
+					m21[TcI] = update ? 0.5f * a21 + half * c21 : a21;
+					m22[TcI] = update ? 0.5f * a22 + half * c22 : a22;
+				}
+			}
+		});
+	}
+/**
+Load every matrix with the product of the corresponding matrices of two arrays, \f$C_i = op(A_i) op(B_i)\f$, where op is either the matrix or its transpose. This computes the same products as ThreeMatrix::operator * for many pairs at once, one pair per SIMD lane.
+@param a the left factors; must have the same size as b. May be this array.
+@param b the right factors. May be this array.
+@param transposeA true to use the transpose of each left factor
+@param transposeB true to use the transpose of each right factor
+@returns none
+*/
+	void loadProduct(const ThreeMatrixArray & a, const ThreeMatrixArray & b, bool transposeA = false, bool transposeB = false)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(MATRIX_ARRAY_PRODUCT,45L * a.size(),108L * a.size());
+		resize(a.size());
+		product<false>(a,b,transposeA,transposeB);
+	}
+/**
+Add the product of the corresponding matrices of two arrays to every matrix, \f$C_i \mathrel{+}= op(A_i) op(B_i)\f$, where op is either the matrix or its transpose
+@param a the left factors; must have the same size as b and as this array. May be this array.
+@param b the right factors. May be this array.
+@param transposeA true to use the transpose of each left factor
+@param transposeB true to use the transpose of each right factor
+@returns none
+*/
+	void addProduct(const ThreeMatrixArray & a, const ThreeMatrixArray & b, bool transposeA = false, bool transposeB = false)
+	{
+		if (a.size() != b.size() || a.size() != size())
+			return;
+		LINALG_COUNT(MATRIX_ARRAY_PRODUCT,54L * a.size(),144L * a.size());
+		product<true>(a,b,transposeA,transposeB);
+	}
+/**
+Compute the singular value decomposition \f$A = U \Sigma V^T\f$ of every matrix, with the same fixed-iteration kernel and conventions as ThreeMatrixSVD, applied to packets of matrices: U and V are rotations, and the sign of the determinant is carried by \f$\sigma_3\f$
+@param u receives the left singular vectors; resized to size()
+@param sigma receives the singular values, \f$\sigma_1 \ge \sigma_2 \ge |\sigma_3|\f$, in x, y and z; resized to size()
+@param v receives the right singular vectors; resized to size()
+@returns none
+*/
+	void singularValueDecomposition(ThreeMatrixArray & u, ThreeVectorArray & sigma, ThreeMatrixArray & v) const
+	{
+		LINALG_COUNT(MATRIX_ARRAY_SVD,800L * size(),84L * size());
+		u.resize(size());
+		v.resize(size());
+		sigma.resize(size());
+		float * sigmaOut[3] = {sigma.x(),sigma.y(),sigma.z()};
+		decomposePackets([&](long first, int count, float left[3][3][PACKET], float values[3][PACKET], float right[3][3][PACKET])
+		{
+			int TcJ,TcK;
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				for (TcK = 0; TcK < 3; TcK++)
+				{
+					std::copy(left[TcJ][TcK],left[TcJ][TcK] + count,u._data[TcJ][TcK].data() + first);
+					std::copy(right[TcJ][TcK],right[TcJ][TcK] + count,v._data[TcJ][TcK].data() + first);
+				}
+				std::copy(values[TcJ],values[TcJ] + count,sigmaOut[TcJ] + first);
+			}
+		});
+	}
+/**
+Compute the polar decomposition \f$A = R S\f$ of every matrix, as ThreeMatrixSVD::rotation and ThreeMatrixSVD::stretch. R is the rotation nearest to A, even when A is a reflection or is rank deficient.
+@param rotation receives the rotations \f$R = U V^T\f$; resized to size()
+@param stretch receives the symmetric factors \f$S = V \Sigma V^T\f$; resized to size()
+@returns none
+*/
+	void polarDecomposition(ThreeMatrixArray & rotation, ThreeMatrixArray & stretch) const
+	{
+		LINALG_COUNT(MATRIX_ARRAY_SVD,920L * size(),108L * size());
+		rotation.resize(size());
+		stretch.resize(size());
+		decomposePackets([&](long first, int count, float left[3][3][PACKET], float values[3][PACKET], float right[3][3][PACKET])
+		{
+			int TcI,TcJ,TcK;
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				for (TcK = 0; TcK < 3; TcK++)
+				{
+					float * r = rotation._data[TcJ][TcK].data() + first;
+					float * s = stretch._data[TcJ][TcK].data() + first;
+#pragma omp simd
+					for (TcI = 0; TcI < count; TcI++)
+					{
+						r[TcI] = left[TcJ][0][TcI] * right[TcK][0][TcI] + left[TcJ][1][TcI] * right[TcK][1][TcI] + left[TcJ][2][TcI] * right[TcK][2][TcI];
+						s[TcI] = right[TcJ][0][TcI] * values[0][TcI] * right[TcK][0][TcI] + right[TcJ][1][TcI] * values[1][TcI] * right[TcK][1][TcI] + right[TcJ][2][TcI] * values[2][TcI] * right[TcK][2][TcI];
+					}
+				}
+			}
+		});
+	}
+};
@@ -0,0 +1,258 @@
+#pragma once
+#include <cmath>
+#include <ThreeVector.hpp>
+#include <ThreeMatrix.hpp>
+
+/**
+@brief The singular value decomposition \f$A = U \Sigma V^T\f$ and polar decomposition \f$A = R S\f$ of a ThreeMatrix
+@details The decomposition follows McAdams et al., "Computing the Singular Value Decomposition of 3x3 matrices with minimal branching and elementary floating point operations" (2011). A fixed number of cyclic Jacobi sweeps diagonalizes \f$A^T A\f$ to give V; the columns of \f$A V\f$ are sorted by decreasing length, and a QR factorization of \f$A V\f$ by Givens rotations gives U and the singular values, which are therefore taken from A itself rather than from the square roots of the eigenvalues. Every step is written with selects rather than branches and operates on a packet of matrices, so the same code decomposes one matrix here and 16 at a time in the batched kernels of ThreeMatrixArray.
+
+U and V are always rotations (determinant +1). The singular values are ordered \f$\sigma_1 \ge \sigma_2 \ge |\sigma_3|\f$, and a reflection in A is carried by the sign of \f$\sigma_3\f$, which has the sign of the determinant. A rank deficient matrix has trailing singular values near zero, and U and V remain rotations; a zero matrix gives identity U and V. The rotation of the polar decomposition, \f$R = U V^T\f$, is therefore the rotation nearest to A, as required by the Kabsch algorithm, and \f$S = V \Sigma V^T\f$ is symmetric.
+
+The singular values, and the elements of \f$U \Sigma V^T\f$, are within about 16 ulp of \f$\sigma_1\f$ of the exact ones when the singular values are well separated. Since V comes from \f$A^T A\f$, whose rounding error is about \f$\sigma_1^2\f$ times the unit roundoff, the singular vectors of two singular values whose squares differ by less than that are mixed; the columns of \f$A V\f$ are then not orthogonal, and the product \f$U \Sigma V^T\f$ differs from A by up to a few times \f$\sigma_1 2^{-12}\f$, or 2048 ulp of \f$\sigma_1\f$. Nearly singular matrices and matrices with rows of very different size often reach this.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ThreeMatrixSVD
+{
+private:
+	static const int SWEEPS = 4;
+	ThreeMatrix _u;
+	ThreeMatrix _v;
+	ThreeVector _sigma;
+
+	// Jacobi rotation in the (p, q) plane that zeroes s[p][q] of the symmetric s, with r the remaining index; the rotation is accumulated into the columns of v
+	template <int W> static void jacobi(float s[3][3][W], float v[3][3][W], int p, int q, int r)
+	{
+		int TcI,TcJ;
+#pragma omp simd
+		for (TcI = 0; TcI < W; TcI++)
+		{
+			float offDiagonal = s[p][q][TcI];
+			int active = offDiagonal != 0.0f;
+			// an inactive lane divides by one and gets t = 0; written as arithmetic rather than selects, since a compiler may otherwise move the division and square roots of the active lanes into a branch, which does not vectorize
+			float theta = (s[q][q][TcI] - s[p][p][TcI]) / (2.0f * (offDiagonal + (float)(1 - active)));
+			float t = (float)(active * (theta >= 0.0f ? 1 : -1)) / (std::fabs(theta) + std::sqrt(1.0f + theta * theta));
+			float c = 1.0f / std::sqrt(1.0f + t * t);
+			float sn = t * c;
+			float sp = s[r][p][TcI];
+			float sq = s[r][q][TcI];
+			s[p][p][TcI] -= t * offDiagonal;
+			s[q][q][TcI] += t * offDiagonal;
+			s[p][q][TcI] = s[q][p][TcI] = 0.0f;
+			s[r][p][TcI] = s[p][r][TcI] = c * sp - sn * sq;
+			s[r][q][TcI] = s[q][r][TcI] = sn * sp + c * sq;
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				float vp = v[TcJ][p][TcI];
+				float vq = v[TcJ][q][TcI];
+				v[TcJ][p][TcI] = c * vp - sn * vq;
+				v[TcJ][q][TcI] = sn * vp + c * vq;
+			}
+		}
+	}
+	// copy b, v and length to sortedB, sortedV and sortedLength, swapping columns i and j when column j of b is longer and negating the new column j to keep v a rotation. The columns are copied rather than swapped in place, since a compiler may turn a swap in place into a conditional store, which does not vectorize.
+	template <int W> static void sortColumns(const float b[3][3][W], const float v[3][3][W], const float length[3][W], float sortedB[3][3][W], float sortedV[3][3][W], float sortedLength[3][W], int i, int j)
+	{
+		int TcI,TcJ;
+		int k = 3 - i - j;
+#pragma omp simd
+		for (TcI = 0; TcI < W; TcI++)
+		{
+			int swap = length[i][TcI] < length[j][TcI];
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				float bi = b[TcJ][i][TcI];
+				float bj = b[TcJ][j][TcI];
+				float vi = v[TcJ][i][TcI];
+				float vj = v[TcJ][j][TcI];
+				sortedB[TcJ][i][TcI] = swap ? bj : bi;
+				sortedB[TcJ][j][TcI] = swap ? -bi : bj;
+				sortedB[TcJ][k][TcI] = b[TcJ][k][TcI];
+				sortedV[TcJ][i][TcI] = swap ? vj : vi;
+				sortedV[TcJ][j][TcI] = swap ? -vi : vj;
+				sortedV[TcJ][k][TcI] = v[TcJ][k][TcI];
+			}
+			float li = length[i][TcI];
+			float lj = length[j][TcI];
+			sortedLength[i][TcI] = swap ? lj : li;
+			sortedLength[j][TcI] = swap ? li : lj;
+			sortedLength[k][TcI] = length[k][TcI];
+		}
+	}
+	// Givens rotation of rows i and j of b that zeroes b[j][i], accumulated into the columns of u
+	template <int W> static void givens(float b[3][3][W], float u[3][3][W], int i, int j)
+	{
+		int TcI,TcJ;
+#pragma omp simd
+		for (TcI = 0; TcI < W; TcI++)
+		{
+			float x = b[i][i][TcI];
+			float y = b[j][i][TcI];
+			float norm = x * x + y * y;
+			int active = norm > 0.0f;
+			// x and y are zero in an inactive lane, which gets c = 1 and s = 0, as in jacobi without selects
+			float inverse = 1.0f / std::sqrt(norm + (float)(1 - active));
+			float c = (x + (float)(1 - active)) * inverse;
+			float s = y * inverse;
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				float bi = b[i][TcJ][TcI];
+				float bj = b[j][TcJ][TcI];
+				b[i][TcJ][TcI] = c * bi + s * bj;
+				b[j][TcJ][TcI] = c * bj - s * bi;
+				float ui = u[TcJ][i][TcI];
+				float uj = u[TcJ][j][TcI];
+				u[TcJ][i][TcI] = c * ui + s * uj;
+				u[TcJ][j][TcI] = c * uj - s * ui;
+			}
+		}
+	}
+public:
+/**
+Compute the decomposition of a packet of W matrices, stored element by element with the matrices in the last index. This is the kernel used by the constructor (with W = 1) and by the batched decompositions in ThreeMatrixArray; every step is a loop over the W matrices with no branches, so a packet of 8 or 16 matrices is processed with vector instructions.
+@param a the matrices, as a[row][column][matrix]
+@param u receives the left singular vectors, as the columns of rotations
+@param sigma receives the singular values, \f$\sigma_1 \ge \sigma_2 \ge |\sigma_3|\f$, as sigma[index][matrix]
+@param v receives the right singular vectors, as the columns of rotations
+@returns none
+*/
+	template <int W> static void compute(const float a[3][3][W], float u[3][3][W], float sigma[3][W], float v[3][3][W])
+	{
+		int TcI,TcJ,TcK;
+		float s[3][3][W];
+		float b[3][3][W];
+		float length[3][W];
+		// the columns are sorted back and forth between these and b, v and length; the Jacobi rotations are accumulated in v2 so that the last sort leaves them in v
+		float b2[3][3][W];
+		float v2[3][3][W];
+		float length2[3][W];
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+#pragma omp simd
+				for (TcI = 0; TcI < W; TcI++)
+				{
+					s[TcJ][TcK][TcI] = a[0][TcJ][TcI] * a[0][TcK][TcI] + a[1][TcJ][TcI] * a[1][TcK][TcI] + a[2][TcJ][TcI] * a[2][TcK][TcI];
+					v2[TcJ][TcK][TcI] = TcJ == TcK ? 1.0f : 0.0f;
+					u[TcJ][TcK][TcI] = TcJ == TcK ? 1.0f : 0.0f;
+				}
+			}
+		}
+		for (TcK = 0; TcK < SWEEPS; TcK++)
+		{
+			jacobi<W>(s,v2,0,1,2);
+			jacobi<W>(s,v2,0,2,1);
+			jacobi<W>(s,v2,1,2,0);
+		}
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+#pragma omp simd
+				for (TcI = 0; TcI < W; TcI++)
+					b[TcJ][TcK][TcI] = a[TcJ][0][TcI] * v2[0][TcK][TcI] + a[TcJ][1][TcI] * v2[1][TcK][TcI] + a[TcJ][2][TcI] * v2[2][TcK][TcI];
+			}
+		}
+		for (TcK = 0; TcK < 3; TcK++)
+		{
+#pragma omp simd
+			for (TcI = 0; TcI < W; TcI++)
+				length[TcK][TcI] = b[0][TcK][TcI] * b[0][TcK][TcI] + b[1][TcK][TcI] * b[1][TcK][TcI] + b[2][TcK][TcI] * b[2][TcK][TcI];
+		}
+		sortColumns<W>(b,v2,length,b2,v,length2,0,1);
+		sortColumns<W>(b2,v,length2,b,v2,length,0,2);
+		sortColumns<W>(b,v2,length,b2,v,length2,1,2);
+		givens<W>(b2,u,0,1);
+		givens<W>(b2,u,0,2);
+		givens<W>(b2,u,1,2);
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+#pragma omp simd
+			for (TcI = 0; TcI < W; TcI++)
+				sigma[TcJ][TcI] = b2[TcJ][TcJ][TcI];
+		}
+	}
+/**
+ThreeMatrixSVD constructor. Computes the decomposition.
+@param matrix the matrix to decompose
+*/
+	ThreeMatrixSVD(const ThreeMatrix & matrix)
+	{
+		int TcI,TcJ;
+		float a[3][3][1];
+		float u[3][3][1];
+		float sigma[3][1];
+		float v[3][3][1];
+		for (TcI = 0; TcI < 3; TcI++)
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				a[TcI][TcJ][0] = matrix.at(TcI,TcJ);
+		compute<1>(a,u,sigma,v);
+		for (TcI = 0; TcI < 3; TcI++)
+		{
+			for (TcJ = 0; TcJ < 3; TcJ++)
+			{
+				_u.setAt(TcI,TcJ,u[TcI][TcJ][0]);
+				_v.setAt(TcI,TcJ,v[TcI][TcJ][0]);
+			}
+		}
+		_sigma = ThreeVector(sigma[0][0],sigma[1][0],sigma[2][0]);
+	}
+/**
+Get the left singular vectors
+@returns the rotation U, whose columns are the left singular vectors
+*/
+	const ThreeMatrix & u(void) const {return _u;}
+/**
+Get the right singular vectors
+@returns the rotation V, whose columns are the right singular vectors
+*/
+	const ThreeMatrix & v(void) const {return _v;}
+/**
+Get the singular values
+@returns the singular values \f$<\sigma_1, \sigma_2, \sigma_3>\f$, with \f$\sigma_1 \ge \sigma_2 \ge |\sigma_3|\f$; \f$\sigma_3\f$ has the sign of the determinant
+*/
+	const ThreeVector & singularValues(void) const {return _sigma;}
+/**
+Get the diagonal matrix of singular values
+@returns \f$\Sigma\f$
+*/
+	ThreeMatrix sigma(void) const
+	{
+		ThreeMatrix ret;
+		ret.setAt(0,0,_sigma.getX());
+		ret.setAt(1,1,_sigma.getY());
+		ret.setAt(2,2,_sigma.getZ());
+		return ret;
+	}
+/**
+Get the numerical rank of the matrix
+@param tolerance the largest singular value magnitude that is treated as zero, relative to \f$\sigma_1\f$
+@returns the number of singular values whose magnitude is greater than tolerance times \f$\sigma_1\f$
+*/
+	int rank(float tolerance = 1.0e-6f) const
+	{
+		float limit = tolerance * _sigma.getX();
+		return (_sigma.getX() > limit ? 1 : 0) + (_sigma.getY() > limit ? 1 : 0) + (std::fabs(_sigma.getZ()) > limit ? 1 : 0);
+	}
+/**
+Get the rotation of the polar decomposition \f$A = R S\f$, which is the rotation nearest to A
+@returns \f$R = U V^T\f$
+*/
+	ThreeMatrix rotation(void) const
+	{
+		return _u * _v.transpose();
+	}
+/**
+Get the symmetric factor of the polar decomposition \f$A = R S\f$. It is positive semidefinite unless A is a reflection, in which case it has one negative eigenvalue.
+@returns \f$S = V \Sigma V^T\f$
+*/
+	ThreeMatrix stretch(void) const
+	{
+		return _v * sigma() * _v.transpose();
+	}
+};
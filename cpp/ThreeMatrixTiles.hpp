@@ -0,0 +1,346 @@
+#pragma once
+#include <vector>
+#include <ThreeMatrix.hpp>
+#include <ThreeMatrixArray.hpp>
+#include <ThreeVectorTiles.hpp>
+#include <Transpose.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of 3x3 matrices stored in tiles of WIDTH matrices, each tile holding its nine elements in turn (array of structures of arrays)
+@details Element (row, column) of the matrices of a tile is a contiguous, aligned run of WIDTH floats, so the kernels process a tile with one instruction per element, and every element of a matrix lies within one 288 byte tile. The tile width matches ThreeVectorTiles, so tile i of a ThreeMatrixTiles and tile i of a ThreeVectorTiles hold the same indices and can be combined tile by tile. The last tile is padded with zero matrices, which the kernels process along with the rest and which are never returned.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ThreeMatrixTiles
+{
+public:
+	static const int WIDTH = ThreeVectorTiles::WIDTH;
+	class Tile
+	{
+	public:
+		alignas(32) float data[3][3][WIDTH];
+	};
+private:
+	static const long GRAIN = 16384 / WIDTH;
+	std::vector<Tile> _tiles;
+	int _size;
+
+	// calls body(tile, count) for every tile, in parallel, with the number of matrices of the tile in use
+	template <typename Body> void forEachTile(const Body & body) const
+	{
+		int total = _size;
+		ThreadPool::instance().parallelFor(0,tiles(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				long remaining = total - TcI * WIDTH;
+				body(TcI,remaining < WIDTH ? remaining : (long)WIDTH);
+			}
+		});
+	}
+public:
+	ThreeMatrixTiles(void)
+	{
+		_size = 0;
+	}
+/**
+ThreeMatrixTiles constructor
+@param size The number of matrices; all matrices are initialized to zero
+*/
+	explicit ThreeMatrixTiles(int size)
+	{
+		_size = 0;
+		resize(size);
+	}
+/**
+Get the number of matrices
+@returns The number of matrices
+*/
+	int size(void) const {return _size;}
+/**
+Get the number of tiles, the last of which may be partly padding
+@returns The number of tiles
+*/
+	int tiles(void) const {return (int)_tiles.size();}
+/**
+Change the number of matrices. New matrices are initialized to zero, including those that take the place of padding, as are the padding matrices of the last tile.
+@param size The new number of matrices
+@returns none
+*/
+	void resize(int size)
+	{
+		int TcI,TcJ,TcK;
+		if (size < 0)
+			size = 0;
+		Tile zero;
+		for (TcI = 0; TcI < 3; TcI++)
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				for (TcK = 0; TcK < WIDTH; TcK++)
+					zero.data[TcI][TcJ][TcK] = 0.0f;
+		// the kernels write the padding of the last tile, so it is cleared before growing exposes it
+		if (size > _size && _size % WIDTH != 0)
+		{
+			Tile & last = _tiles.back();
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					for (TcK = _size % WIDTH; TcK < WIDTH; TcK++)
+						last.data[TcI][TcJ][TcK] = 0.0f;
+		}
+		_tiles.resize((size + WIDTH - 1) / WIDTH,zero);
+		_size = size;
+		if (size % WIDTH != 0)
+		{
+			Tile & last = _tiles.back();
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					for (TcK = size % WIDTH; TcK < WIDTH; TcK++)
+						last.data[TcI][TcJ][TcK] = 0.0f;
+		}
+	}
+/**
+Get direct access to a tile
+@param idx the zero indexed tile
+@returns A pointer to the tile, or null if idx is out of range
+*/
+	Tile * tile(int idx)
+	{
+		if (idx >= 0 && idx < tiles())
+			return &_tiles[idx];
+		else
+			return nullptr;
+	}
+	const Tile * tile(int idx) const
+	{
+		if (idx >= 0 && idx < tiles())
+			return &_tiles[idx];
+		else
+			return nullptr;
+	}
+
+/**
+Retreive the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to retrieve
+@returns the matrix at the index, the zero matrix otherwise
+*/
+	ThreeMatrix at(int idx) const
+	{
+		int TcI,TcJ;
+		ThreeMatrix ret;
+		if (idx >= 0 && idx < size())
+		{
+			const Tile & tile = _tiles[idx / WIDTH];
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					ret.setAt(TcI,TcJ,tile.data[TcI][TcJ][idx % WIDTH]);
+		}
+		return ret;
+	}
+/**
+Set the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to set
+@param value the value to insert
+@returns none
+*/
+	void setAt(int idx, const ThreeMatrix & value)
+	{
+		int TcI,TcJ;
+		if (idx >= 0 && idx < size())
+		{
+			Tile & tile = _tiles[idx / WIDTH];
+			for (TcI = 0; TcI < 3; TcI++)
+				for (TcJ = 0; TcJ < 3; TcJ++)
+					tile.data[TcI][TcJ][idx % WIDTH] = value.at(TcI,TcJ);
+		}
+	}
+
+/**
+Load the matrices from interleaved matrices, nine floats each in row major order as taken by ThreeMatrix(float *), resizing to count
+@param data the interleaved elements, 9 * count floats
+@param count the number of matrices
+@returns none
+*/
+	void loadInterleaved(const float * data, int count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * count);
+		resize(count);
+		Tile * target = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			int TcJ;
+			float * elements[9];
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				elements[TcJ] = target[idx].data[TcJ / 3][TcJ % 3];
+			Transpose::deinterleave9(data + 9 * WIDTH * idx,elements,used);
+		});
+	}
+/**
+Store the matrices as interleaved matrices, nine floats each in row major order
+@param data receives the interleaved elements; must have room for 9 * size() floats
+@returns none
+*/
+	void storeInterleaved(float * data) const
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * size());
+		const Tile * source = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			int TcJ;
+			const float * elements[9];
+			for (TcJ = 0; TcJ < 9; TcJ++)
+				elements[TcJ] = source[idx].data[TcJ / 3][TcJ % 3];
+			Transpose::interleave9(elements,data + 9 * WIDTH * idx,used);
+		});
+	}
+/**
+Load the matrices from a ThreeMatrixArray, resizing to match
+@param matrices the matrices
+@returns none
+*/
+	void load(const ThreeMatrixArray & matrices)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * matrices.size());
+		resize(matrices.size());
+		Tile * target = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			int TcI,TcJ;
+			long TcK;
+			long offset = idx * WIDTH;
+			for (TcI = 0; TcI < 3; TcI++)
+			{
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					const float * element = matrices.element(TcI,TcJ) + offset;
+#pragma omp simd
+					for (TcK = 0; TcK < used; TcK++)
+						target[idx].data[TcI][TcJ][TcK] = element[TcK];
+				}
+			}
+		});
+	}
+/**
+Store the matrices in a ThreeMatrixArray, which is resized to match
+@param matrices receives the matrices
+@returns none
+*/
+	void store(ThreeMatrixArray & matrices) const
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * size());
+		matrices.resize(size());
+		const Tile * source = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			int TcI,TcJ;
+			long TcK;
+			long offset = idx * WIDTH;
+			for (TcI = 0; TcI < 3; TcI++)
+			{
+				for (TcJ = 0; TcJ < 3; TcJ++)
+				{
+					float * element = matrices.element(TcI,TcJ) + offset;
+#pragma omp simd
+					for (TcK = 0; TcK < used; TcK++)
+						element[TcK] = source[idx].data[TcI][TcJ][TcK];
+				}
+			}
+		});
+	}
+
+/**
+Load every matrix with the product of the corresponding matrices of two others, \f$C_i = A_i B_i\f$, as ThreeMatrix::operator *. The result may be one of the inputs.
+@param a the left factors
+@param b the right factors; must have the same size as a
+@returns none
+*/
+	void loadProduct(const ThreeMatrixTiles & a, const ThreeMatrixTiles & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(MATRIX_TILES,45L * a.size(),108L * a.size());
+		resize(a.size());
+		const Tile * ta = a._tiles.data();
+		const Tile * tb = b._tiles.data();
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+			const float (* x)[3][WIDTH] = ta[idx].data;
+			const float (* y)[3][WIDTH] = tb[idx].data;
+			float (* r)[3][WIDTH] = tr[idx].data;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				float a00 = x[0][0][TcJ], a01 = x[0][1][TcJ], a02 = x[0][2][TcJ];
+				float a10 = x[1][0][TcJ], a11 = x[1][1][TcJ], a12 = x[1][2][TcJ];
+				float a20 = x[2][0][TcJ], a21 = x[2][1][TcJ], a22 = x[2][2][TcJ];
+				float b00 = y[0][0][TcJ], b01 = y[0][1][TcJ], b02 = y[0][2][TcJ];
+				float b10 = y[1][0][TcJ], b11 = y[1][1][TcJ], b12 = y[1][2][TcJ];
+				float b20 = y[2][0][TcJ], b21 = y[2][1][TcJ], b22 = y[2][2][TcJ];
+				r[0][0][TcJ] = a00 * b00 + a01 * b10 + a02 * b20;
+				r[0][1][TcJ] = a00 * b01 + a01 * b11 + a02 * b21;
+				r[0][2][TcJ] = a00 * b02 + a01 * b12 + a02 * b22;
+				r[1][0][TcJ] = a10 * b00 + a11 * b10 + a12 * b20;
+				r[1][1][TcJ] = a10 * b01 + a11 * b11 + a12 * b21;
+				r[1][2][TcJ] = a10 * b02 + a11 * b12 + a12 * b22;
+				r[2][0][TcJ] = a20 * b00 + a21 * b10 + a22 * b20;
+				r[2][1][TcJ] = a20 * b01 + a21 * b11 + a22 * b21;
+				r[2][2][TcJ] = a20 * b02 + a21 * b12 + a22 * b22;
+			}
+		});
+	}
+/**
+Compute the product of every matrix with the corresponding vector, \f$M_i\vec{v}_i\f$, as ThreeMatrix::operator *(const ThreeVector &)
+@param vectors the vectors; must have the same size as this array
+@param result receives the products; resized to match. May be vectors.
+@returns none
+*/
+	void transform(const ThreeVectorTiles & vectors, ThreeVectorTiles & result) const
+	{
+		if (vectors.size() != size())
+			return;
+		LINALG_COUNT(MATRIX_TILES,15L * size(),60L * size());
+		result.resize(size());
+		const Tile * tm = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+			const float (* m)[3][WIDTH] = tm[idx].data;
+			const ThreeVectorTiles::Tile & v = *vectors.tile((int)idx);
+			ThreeVectorTiles::Tile & r = *result.tile((int)idx);
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				float vx = v.x[TcJ], vy = v.y[TcJ], vz = v.z[TcJ];
+				r.x[TcJ] = m[0][0][TcJ] * vx + m[0][1][TcJ] * vy + m[0][2][TcJ] * vz;
+				r.y[TcJ] = m[1][0][TcJ] * vx + m[1][1][TcJ] * vy + m[1][2][TcJ] * vz;
+				r.z[TcJ] = m[2][0][TcJ] * vx + m[2][1][TcJ] * vy + m[2][2][TcJ] * vz;
+			}
+		});
+	}
+/**
+Compute the determinant of every matrix, as ThreeMatrix::determinant
+@param result receives the determinants; resized to size()
+@returns none
+*/
+	void determinant(std::vector<float> & result) const
+	{
+		LINALG_COUNT(MATRIX_TILES,17L * size(),40L * size());
+		result.resize(size());
+		const Tile * tm = _tiles.data();
+		float * d = result.data();
+		forEachTile([&](long idx, long used)
+		{
+			long TcJ;
+			long offset = idx * WIDTH;
+			const float (* m)[3][WIDTH] = tm[idx].data;
+#pragma omp simd
+			for (TcJ = 0; TcJ < used; TcJ++)
+				d[offset + TcJ] = m[0][0][TcJ] * (m[1][1][TcJ] * m[2][2][TcJ] - m[1][2][TcJ] * m[2][1][TcJ]) - m[0][1][TcJ] * (m[1][0][TcJ] * m[2][2][TcJ] - m[1][2][TcJ] * m[2][0][TcJ]) + m[0][2][TcJ] * (m[1][0][TcJ] * m[2][1][TcJ] - m[1][1][TcJ] * m[2][0][TcJ]);
+		});
+	}
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include <cmath>
+#include <vector>
+#include <OperationCounters.hpp>
 /** 
 @brief A c++ implementation of a 3-dimensional vector
 @details 
@@ -166,6 +168,7 @@ Retrieve a scalar (dot) product for this vector: \f$\vec{a}\bullet\vec{b} = a_x
 */
 	float dot(const ThreeVector &vectB) const
 	{
+		LINALG_COUNT(VECTOR_DOT,5,28);
 		return _x * vectB._x + _y * vectB._y + _z * vectB._z;
 	}
 /** 
@@ -174,6 +177,7 @@ Retrieve a vector (cross) product for this vector: \f$\vec{a}\times\vec{b} = <a_
 */
 	ThreeVector cross(const ThreeVector & vectB) const
 	{
+		LINALG_COUNT(VECTOR_CROSS,9,36);
 		return ThreeVector(_y * vectB._z - _z * vectB._y, _z * vectB._x - _x * vectB._z, _x * vectB._y - _y * vectB._x);
 	}
 /** 
@@ -182,6 +186,7 @@ Get the magnitude (length) of the vector
 */
 	float magnitude(void)
 	{
+		LINALG_COUNT(VECTOR_MAGNITUDE,6,16);
 		return std::sqrt(dot(*this));
 	}
 	
@@ -191,6 +196,7 @@ Retrieve a unit vector for this vector
 */
 	ThreeVector unit(void)
 	{
+		LINALG_COUNT(VECTOR_UNIT,10,24);
 		float mag = magnitude();
 		if (mag != 0.0)
 			mag = 1.0 / mag;
@@ -0,0 +1,256 @@
+#pragma once
+#include <vector>
+#include <ComponentArray.hpp>
+#include <ThreeVector.hpp>
+#include <ThreadPool.hpp>
+#include <Transpose.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of 3-dimensional vectors stored as separate x, y and z component arrays (structure of arrays)
+@details This is the layout used by the bulk kernels: consecutive elements of each component are contiguous, so that a loop over the array can process several vectors per instruction.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ThreeVectorArray
+{
+private:
+	static const long GRAIN = 16384;
+	ComponentArray _x;
+	ComponentArray _y;
+	ComponentArray _z;
+
+	// linearly interpolates every vector, with the parameter for index i given by parameter(i)
+	template <typename Parameter> void interpolateAll(const ThreeVectorArray & from, const ThreeVectorArray & to, const Parameter & parameter)
+	{
+		resize(from.size());
+		const float * ax = from.x();
+		const float * ay = from.y();
+		const float * az = from.z();
+		const float * bx = to.x();
+		const float * by = to.y();
+		const float * bz = to.z();
+		float * rx = x();
+		float * ry = y();
+		float * rz = z();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float t = parameter(TcI);
+				rx[TcI] = ax[TcI] + t * (bx[TcI] - ax[TcI]);
+				ry[TcI] = ay[TcI] + t * (by[TcI] - ay[TcI]);
+				rz[TcI] = az[TcI] + t * (bz[TcI] - az[TcI]);
+			}
+		});
+	}
+public:
+	ThreeVectorArray(void)
+	{
+	}
+/**
+ThreeVectorArray constructor
+@param size The number of vectors in the array; all vectors are initialized to zero
+*/
+	explicit ThreeVectorArray(int size)
+	{
+		resize(size);
+	}
+/**
+ThreeVectorArray constructor
+@param data An std::vector<ThreeVector> with which to initialize the array
+*/
+	ThreeVectorArray(const std::vector<ThreeVector> &data)
+	{
+		int TcI;
+		resize((int)data.size());
+		for (TcI = 0; TcI < size(); TcI++)
+			setAt(TcI,data[TcI]);
+	}
+/**
+Get the number of vectors in the array
+@returns The number of vectors
+*/
+	int size(void) const {return (int)_x.size();}
+/**
+Change the number of vectors in the array. New vectors are initialized to zero.
+@param size The new number of vectors
+@returns none
+*/
+	void resize(int size)
+	{
+		if (size < 0)
+			size = 0;
+		_x.resize(size,0.0f);
+		_y.resize(size,0.0f);
+		_z.resize(size,0.0f);
+	}
+/**
+Make the array refer to existing component arrays, such as a section of a mapped ArrayFile, instead of copying them. They are never written: the first change to the array, including a call to a non-const accessor such as x(), copies them. Until then they must remain valid.
+@param x the x components; size floats
+@param y the y components; size floats
+@param z the z components; size floats
+@param size the number of vectors
+@returns none
+*/
+	void share(const float * x, const float * y, const float * z, int size)
+	{
+		if (size < 0)
+			size = 0;
+		_x.share(x,size);
+		_y.share(y,size);
+		_z.share(z,size);
+	}
+/**
+Get direct access to the x components
+@returns A pointer to the x component of the first vector
+*/
+	float * x(void) {return _x.data();}
+	const float * x(void) const {return _x.data();}
+/**
+Get direct access to the y components
+@returns A pointer to the y component of the first vector
+*/
+	float * y(void) {return _y.data();}
+	const float * y(void) const {return _y.data();}
+/**
+Get direct access to the z components
+@returns A pointer to the z component of the first vector
+*/
+	float * z(void) {return _z.data();}
+	const float * z(void) const {return _z.data();}
+
+/**
+Retreive the vector at the given index, zero indexed
+@param idx the zero indexed vector to retrieve
+@returns the vector at the index, the zero vector otherwise
+*/
+	ThreeVector at(int idx) const
+	{
+		if (idx >= 0 && idx < size())
+			return ThreeVector(_x[idx],_y[idx],_z[idx]);
+		else
+			return ThreeVector();
+	}
+/**
+Set the vector at the given index, zero indexed
+@param idx the zero indexed vector to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const ThreeVector & value)
+	{
+		if (idx >= 0 && idx < size())
+		{
+			_x[idx] = value.getX();
+			_y[idx] = value.getY();
+			_z[idx] = value.getZ();
+		}
+	}
+/**
+Convert the array to an array of ThreeVectors
+@returns an std::vector<ThreeVector> containing the vectors
+*/
+	std::vector<ThreeVector> toVector(void) const
+	{
+		int TcI;
+		std::vector<ThreeVector> ret(size());
+		for (TcI = 0; TcI < size(); TcI++)
+			ret[TcI] = at(TcI);
+		return ret;
+	}
+/**
+Load the array from interleaved vectors, xyzxyz..., as stored by an array of ThreeVectors or a vertex buffer. The array is resized to count.
+@param data the interleaved components, 3 * count floats
+@param count the number of vectors
+@returns none
+*/
+	void loadInterleaved(const float * data, int count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * count);
+		resize(count);
+		float * rx = x();
+		float * ry = y();
+		float * rz = z();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			Transpose::deinterleave3(data + 3 * first,rx + first,ry + first,rz + first,last - first);
+		});
+	}
+/**
+Store the array as interleaved vectors, xyzxyz...
+@param data receives the interleaved components; must have room for 3 * size() floats
+@returns none
+*/
+	void storeInterleaved(float * data) const
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * size());
+		const float * ax = x();
+		const float * ay = y();
+		const float * az = z();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			Transpose::interleave3(ax + first,ay + first,az + first,data + 3 * first,last - first);
+		});
+	}
+/**
+Load every vector with the linear interpolation of two others, \f$\vec{a} + t(\vec{b} - \vec{a})\f$. The result may be one of the inputs.
+@param from the vectors at t = 0
+@param to the vectors at t = 1; must have the same size as from
+@param t the interpolation parameter of each vector; must have the same size as from
+@returns none
+*/
+	void loadLerp(const ThreeVectorArray & from, const ThreeVectorArray & to, const std::vector<float> & t)
+	{
+		const float * parameter = t.data();
+		if (to.size() == from.size() && (int)t.size() == from.size())
+		{
+			LINALG_COUNT(VECTOR_ARRAY_LERP,9L * from.size(),40L * from.size());
+			interpolateAll(from,to,[parameter](long idx){return parameter[idx];});
+		}
+	}
+/**
+Load every vector with the linear interpolation of two others, using the same parameter for all. The result may be one of the inputs.
+@param from the vectors at t = 0
+@param to the vectors at t = 1; must have the same size as from
+@param t the interpolation parameter
+@returns none
+*/
+	void loadLerp(const ThreeVectorArray & from, const ThreeVectorArray & to, float t)
+	{
+		if (to.size() == from.size())
+		{
+			LINALG_COUNT(VECTOR_ARRAY_LERP,9L * from.size(),36L * from.size());
+			interpolateAll(from,to,[t](long){return t;});
+		}
+	}
+/**
+Sample a set of animation tracks at a given time and load the result, in a single pass. Each track interpolates linearly from one keyframe to the next, and the interpolation parameter of each track, \f$t = (time - start) / (end - start)\f$ clamped to [0, 1], is computed in the same loop as the interpolation rather than stored. A track whose end time equals its start time takes the end value once the time is reached.
+@param from the keyframe values at the start times
+@param to the keyframe values at the end times; must have the same size as from
+@param startTimes the time of the keyframe in from, for each track; must have the same size as from
+@param endTimes the time of the keyframe in to, for each track; must have the same size as from
+@param time the time at which to sample
+@returns none
+*/
+	void loadSample(const ThreeVectorArray & from, const ThreeVectorArray & to, const std::vector<float> & startTimes, const std::vector<float> & endTimes, float time)
+	{
+		const float * start = startTimes.data();
+		const float * end = endTimes.data();
+		if (to.size() != from.size() || (int)startTimes.size() != from.size() || (int)endTimes.size() != from.size())
+			return;
+		LINALG_COUNT(VECTOR_ARRAY_LERP,15L * from.size(),44L * from.size());
+		interpolateAll(from,to,[start,end,time](long idx)
+		{
+			float span = end[idx] - start[idx];
+			float t = span > 0.0f ? (time - start[idx]) / (span > 0.0f ? span : 1.0f) : (time >= end[idx] ? 1.0f : 0.0f);
+			t = t < 0.0f ? 0.0f : t;
+			return t > 1.0f ? 1.0f : t;
+		});
+	}
+};
+
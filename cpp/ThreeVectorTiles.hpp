@@ -0,0 +1,422 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <ThreeVector.hpp>
+#include <ThreeMatrix.hpp>
+#include <ThreeVectorArray.hpp>
+#include <Transpose.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief An array of 3-dimensional vectors stored in tiles of WIDTH vectors, each tile holding its x, y and z components in turn (array of structures of arrays)
+@details Within a tile each component is a contiguous, aligned run of WIDTH floats, one SIMD register wide for AVX, so the kernels process a tile with one instruction per component; across tiles the three components of a vector lie within 96 bytes, so a kernel touches one region of memory instead of three separate streams, and a tile can be handed to a pipeline stage or a thread on its own. The last tile is padded with zero vectors, which the kernels process along with the rest and which are never returned.
+
+Data can be converted to and from interleaved vectors (loadInterleaved, storeInterleaved) and the ThreeVectorArray layout, and kept in tiles from end to end by the kernels here and in ThreeMatrixTiles.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class ThreeVectorTiles
+{
+public:
+	static const int WIDTH = 8;
+	class Tile
+	{
+	public:
+		alignas(32) float x[WIDTH];
+		float y[WIDTH];
+		float z[WIDTH];
+	};
+private:
+	static const long GRAIN = 16384 / WIDTH;
+	std::vector<Tile> _tiles;
+	int _size;
+
+	// calls body(tile, count) for every tile, in parallel, with the number of vectors of the tile in use
+	template <typename Body> void forEachTile(const Body & body) const
+	{
+		int total = _size;
+		ThreadPool::instance().parallelFor(0,tiles(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				long remaining = total - TcI * WIDTH;
+				body(TcI,remaining < WIDTH ? remaining : (long)WIDTH);
+			}
+		});
+	}
+public:
+	ThreeVectorTiles(void)
+	{
+		_size = 0;
+	}
+/**
+ThreeVectorTiles constructor
+@param size The number of vectors; all vectors are initialized to zero
+*/
+	explicit ThreeVectorTiles(int size)
+	{
+		_size = 0;
+		resize(size);
+	}
+/**
+Get the number of vectors
+@returns The number of vectors
+*/
+	int size(void) const {return _size;}
+/**
+Get the number of tiles, the last of which may be partly padding
+@returns The number of tiles
+*/
+	int tiles(void) const {return (int)_tiles.size();}
+/**
+Change the number of vectors. New vectors are initialized to zero, including those that take the place of padding, as are the padding vectors of the last tile.
+@param size The new number of vectors
+@returns none
+*/
+	void resize(int size)
+	{
+		int TcI;
+		if (size < 0)
+			size = 0;
+		Tile zero;
+		for (TcI = 0; TcI < WIDTH; TcI++)
+			zero.x[TcI] = zero.y[TcI] = zero.z[TcI] = 0.0f;
+		// the kernels write the padding of the last tile, so it is cleared before growing exposes it
+		if (size > _size && _size % WIDTH != 0)
+		{
+			Tile & last = _tiles.back();
+			for (TcI = _size % WIDTH; TcI < WIDTH; TcI++)
+				last.x[TcI] = last.y[TcI] = last.z[TcI] = 0.0f;
+		}
+		_tiles.resize((size + WIDTH - 1) / WIDTH,zero);
+		_size = size;
+		if (size % WIDTH != 0)
+		{
+			Tile & last = _tiles.back();
+			for (TcI = size % WIDTH; TcI < WIDTH; TcI++)
+				last.x[TcI] = last.y[TcI] = last.z[TcI] = 0.0f;
+		}
+	}
+/**
+Get direct access to a tile
+@param idx the zero indexed tile
+@returns A pointer to the tile, or null if idx is out of range
+*/
+	Tile * tile(int idx)
+	{
+		if (idx >= 0 && idx < tiles())
+			return &_tiles[idx];
+		else
+			return nullptr;
+	}
+	const Tile * tile(int idx) const
+	{
+		if (idx >= 0 && idx < tiles())
+			return &_tiles[idx];
+		else
+			return nullptr;
+	}
+
+/**
+Retreive the vector at the given index, zero indexed
+@param idx the zero indexed vector to retrieve
+@returns the vector at the index, the zero vector otherwise
+*/
+	ThreeVector at(int idx) const
+	{
+		if (idx >= 0 && idx < size())
+		{
+			const Tile & tile = _tiles[idx / WIDTH];
+			return ThreeVector(tile.x[idx % WIDTH],tile.y[idx % WIDTH],tile.z[idx % WIDTH]);
+		}
+		else
+			return ThreeVector();
+	}
+/**
+Set the vector at the given index, zero indexed
+@param idx the zero indexed vector to set
+@param value the value to insert
+@returns none
+*/
+	void setAt(int idx, const ThreeVector & value)
+	{
+		if (idx >= 0 && idx < size())
+		{
+			Tile & tile = _tiles[idx / WIDTH];
+			tile.x[idx % WIDTH] = value.getX();
+			tile.y[idx % WIDTH] = value.getY();
+			tile.z[idx % WIDTH] = value.getZ();
+		}
+	}
+
+/**
+Load the vectors from interleaved vectors, xyzxyz..., resizing to count
+@param data the interleaved components, 3 * count floats
+@param count the number of vectors
+@returns none
+*/
+	void loadInterleaved(const float * data, int count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * count);
+		resize(count);
+		Tile * target = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			Transpose::deinterleave3(data + 3 * WIDTH * idx,target[idx].x,target[idx].y,target[idx].z,used);
+		});
+	}
+/**
+Store the vectors as interleaved vectors, xyzxyz...
+@param data receives the interleaved components; must have room for 3 * size() floats
+@returns none
+*/
+	void storeInterleaved(float * data) const
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * size());
+		const Tile * source = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			Transpose::interleave3(source[idx].x,source[idx].y,source[idx].z,data + 3 * WIDTH * idx,used);
+		});
+	}
+/**
+Load the vectors from a ThreeVectorArray, resizing to match
+@param vectors the vectors
+@returns none
+*/
+	void load(const ThreeVectorArray & vectors)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * vectors.size());
+		resize(vectors.size());
+		const float * ax = vectors.x();
+		const float * ay = vectors.y();
+		const float * az = vectors.z();
+		Tile * target = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			long TcJ;
+			long offset = idx * WIDTH;
+#pragma omp simd
+			for (TcJ = 0; TcJ < used; TcJ++)
+			{
+				target[idx].x[TcJ] = ax[offset + TcJ];
+				target[idx].y[TcJ] = ay[offset + TcJ];
+				target[idx].z[TcJ] = az[offset + TcJ];
+			}
+		});
+	}
+/**
+Store the vectors in a ThreeVectorArray, which is resized to match
+@param vectors receives the vectors
+@returns none
+*/
+	void store(ThreeVectorArray & vectors) const
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * size());
+		vectors.resize(size());
+		float * rx = vectors.x();
+		float * ry = vectors.y();
+		float * rz = vectors.z();
+		const Tile * source = _tiles.data();
+		forEachTile([&](long idx, long used)
+		{
+			long TcJ;
+			long offset = idx * WIDTH;
+#pragma omp simd
+			for (TcJ = 0; TcJ < used; TcJ++)
+			{
+				rx[offset + TcJ] = source[idx].x[TcJ];
+				ry[offset + TcJ] = source[idx].y[TcJ];
+				rz[offset + TcJ] = source[idx].z[TcJ];
+			}
+		});
+	}
+
+/**
+Load every vector with the sum of two others, \f$\vec{a} + \vec{b}\f$. The result may be one of the inputs.
+@param a the first vectors
+@param b the second vectors; must have the same size as a
+@returns none
+*/
+	void loadSum(const ThreeVectorTiles & a, const ThreeVectorTiles & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(VECTOR_TILES,3L * a.size(),36L * a.size());
+		resize(a.size());
+		const Tile * ta = a._tiles.data();
+		const Tile * tb = b._tiles.data();
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				tr[idx].x[TcJ] = ta[idx].x[TcJ] + tb[idx].x[TcJ];
+				tr[idx].y[TcJ] = ta[idx].y[TcJ] + tb[idx].y[TcJ];
+				tr[idx].z[TcJ] = ta[idx].z[TcJ] + tb[idx].z[TcJ];
+			}
+		});
+	}
+/**
+Load every vector with the difference of two others, \f$\vec{a} - \vec{b}\f$. The result may be one of the inputs.
+@param a the first vectors
+@param b the second vectors; must have the same size as a
+@returns none
+*/
+	void loadDifference(const ThreeVectorTiles & a, const ThreeVectorTiles & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(VECTOR_TILES,3L * a.size(),36L * a.size());
+		resize(a.size());
+		const Tile * ta = a._tiles.data();
+		const Tile * tb = b._tiles.data();
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				tr[idx].x[TcJ] = ta[idx].x[TcJ] - tb[idx].x[TcJ];
+				tr[idx].y[TcJ] = ta[idx].y[TcJ] - tb[idx].y[TcJ];
+				tr[idx].z[TcJ] = ta[idx].z[TcJ] - tb[idx].z[TcJ];
+			}
+		});
+	}
+/**
+Add a multiple of other vectors to every vector, \f$\vec{v} \mathrel{+}= s\vec{a}\f$
+@param scalar the factor s
+@param a the vectors to add; must have the same size as this array. May be this array.
+@returns none
+*/
+	void addScaled(float scalar, const ThreeVectorTiles & a)
+	{
+		if (a.size() != size())
+			return;
+		LINALG_COUNT(VECTOR_TILES,6L * size(),36L * size());
+		const Tile * ta = a._tiles.data();
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				tr[idx].x[TcJ] += scalar * ta[idx].x[TcJ];
+				tr[idx].y[TcJ] += scalar * ta[idx].y[TcJ];
+				tr[idx].z[TcJ] += scalar * ta[idx].z[TcJ];
+			}
+		});
+	}
+/**
+Load every vector with the cross product of two others, \f$\vec{a}\times\vec{b}\f$, as ThreeVector::cross. The result may be one of the inputs.
+@param a the first vectors
+@param b the second vectors; must have the same size as a
+@returns none
+*/
+	void loadCross(const ThreeVectorTiles & a, const ThreeVectorTiles & b)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(VECTOR_TILES,9L * a.size(),36L * a.size());
+		resize(a.size());
+		const Tile * ta = a._tiles.data();
+		const Tile * tb = b._tiles.data();
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				float ax = ta[idx].x[TcJ], ay = ta[idx].y[TcJ], az = ta[idx].z[TcJ];
+				float bx = tb[idx].x[TcJ], by = tb[idx].y[TcJ], bz = tb[idx].z[TcJ];
+				tr[idx].x[TcJ] = ay * bz - az * by;
+				tr[idx].y[TcJ] = az * bx - ax * bz;
+				tr[idx].z[TcJ] = ax * by - ay * bx;
+			}
+		});
+	}
+/**
+Compute the dot product of every vector with the corresponding vector of another array, as ThreeVector::dot
+@param vectors the other vectors; must have the same size as this array
+@param result receives the dot products; resized to size()
+@returns none
+*/
+	void dot(const ThreeVectorTiles & vectors, std::vector<float> & result) const
+	{
+		if (vectors.size() != size())
+			return;
+		LINALG_COUNT(VECTOR_TILES,5L * size(),28L * size());
+		result.resize(size());
+		const Tile * ta = _tiles.data();
+		const Tile * tb = vectors._tiles.data();
+		float * r = result.data();
+		forEachTile([&](long idx, long used)
+		{
+			long TcJ;
+			long offset = idx * WIDTH;
+#pragma omp simd
+			for (TcJ = 0; TcJ < used; TcJ++)
+				r[offset + TcJ] = ta[idx].x[TcJ] * tb[idx].x[TcJ] + ta[idx].y[TcJ] * tb[idx].y[TcJ] + ta[idx].z[TcJ] * tb[idx].z[TcJ];
+		});
+	}
+/**
+Scale every vector to unit length, as ThreeVector::unit; zero vectors are left unchanged
+@returns none
+*/
+	void normalize(void)
+	{
+		LINALG_COUNT(VECTOR_TILES,10L * size(),24L * size());
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				float vx = tr[idx].x[TcJ], vy = tr[idx].y[TcJ], vz = tr[idx].z[TcJ];
+				float squared = vx * vx + vy * vy + vz * vz;
+				float scale = squared > 0.0f ? 1.0f / std::sqrt(squared) : 1.0f;
+				tr[idx].x[TcJ] = vx * scale;
+				tr[idx].y[TcJ] = vy * scale;
+				tr[idx].z[TcJ] = vz * scale;
+			}
+		});
+	}
+/**
+Load every vector with the product of one matrix and the corresponding vector of another array, \f$M\vec{a}\f$. The result may be the input.
+@param matrix the matrix M
+@param vectors the vectors a
+@returns none
+*/
+	void loadTransform(const ThreeMatrix & matrix, const ThreeVectorTiles & vectors)
+	{
+		LINALG_COUNT(VECTOR_TILES,15L * vectors.size(),24L * vectors.size());
+		resize(vectors.size());
+		float m00 = matrix.at(0,0), m01 = matrix.at(0,1), m02 = matrix.at(0,2);
+		float m10 = matrix.at(1,0), m11 = matrix.at(1,1), m12 = matrix.at(1,2);
+		float m20 = matrix.at(2,0), m21 = matrix.at(2,1), m22 = matrix.at(2,2);
+		const Tile * ta = vectors._tiles.data();
+		Tile * tr = _tiles.data();
+		forEachTile([&](long idx, long)
+		{
+			int TcJ;
+#pragma omp simd
+			for (TcJ = 0; TcJ < WIDTH; TcJ++)
+			{
+				float vx = ta[idx].x[TcJ], vy = ta[idx].y[TcJ], vz = ta[idx].z[TcJ];
+				tr[idx].x[TcJ] = m00 * vx + m01 * vy + m02 * vz;
+				tr[idx].y[TcJ] = m10 * vx + m11 * vy + m12 * vz;
+				tr[idx].z[TcJ] = m20 * vx + m21 * vy + m22 * vz;
+			}
+		});
+	}
+};
@@ -0,0 +1,182 @@
+#pragma once
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include <OperationCounters.hpp>
+/**
+@brief Conversions between interleaved (array of structures) and separate component (structure of arrays) layouts
+@details Interleaved data, xyzxyz... for vectors or nine floats per matrix in row major order as taken by ThreeMatrix(float *), is the layout most data arrives in, but the bulk kernels need each component contiguous. Converting one element at a time with scalar loads and stores costs more than most of the kernels that follow it. Where SSE is available these kernels convert four elements at a time with shuffles: three loads and six shuffles turn four vectors into four x, four y and four z components, and an in-register 4x4 transpose does the same for matrices. Elsewhere, or for the last few elements, a plain loop is used, which the compiler may vectorize in the same way.
+
+Each call runs on the calling thread, so that the array classes can convert whole tiles or ranges of a large array in parallel with the ThreadPool.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class Transpose
+{
+public:
+/**
+Split interleaved vectors, xyzxyz..., into separate component arrays
+@param data the interleaved vectors, 3 * count floats
+@param x receives the x components; count floats
+@param y receives the y components; count floats
+@param z receives the z components; count floats
+@param count the number of vectors
+@returns none
+*/
+	static void deinterleave3(const float * data, float * x, float * y, float * z, long count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * count);
+		long TcI = 0;
+		long TcJ;
+#ifdef __SSE__
+		for (; TcI + 4 <= count; TcI += 4)
+		{
+			// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+			__m128 a = _mm_loadu_ps(data + 3 * TcI);
+			__m128 b = _mm_loadu_ps(data + 3 * TcI + 4);
+			__m128 c = _mm_loadu_ps(data + 3 * TcI + 8);
+			__m128 xHigh = _mm_shuffle_ps(b,c,_MM_SHUFFLE(1,1,2,2));
+			__m128 yLow = _mm_shuffle_ps(a,b,_MM_SHUFFLE(0,0,1,1));
+			__m128 yHigh = _mm_shuffle_ps(b,c,_MM_SHUFFLE(2,2,3,3));
+			__m128 zLow = _mm_shuffle_ps(a,b,_MM_SHUFFLE(1,1,2,2));
+			__m128 zHigh = _mm_shuffle_ps(c,c,_MM_SHUFFLE(3,3,0,0));
+			_mm_storeu_ps(x + TcI,_mm_shuffle_ps(a,xHigh,_MM_SHUFFLE(2,0,3,0)));
+			_mm_storeu_ps(y + TcI,_mm_shuffle_ps(yLow,yHigh,_MM_SHUFFLE(2,0,2,0)));
+			_mm_storeu_ps(z + TcI,_mm_shuffle_ps(zLow,zHigh,_MM_SHUFFLE(2,0,2,0)));
+		}
+#endif
+#pragma omp simd
+		for (TcJ = TcI; TcJ < count; TcJ++)
+		{
+			x[TcJ] = data[3 * TcJ];
+			y[TcJ] = data[3 * TcJ + 1];
+			z[TcJ] = data[3 * TcJ + 2];
+		}
+	}
+/**
+Merge separate component arrays into interleaved vectors, xyzxyz...
+@param x the x components; count floats
+@param y the y components; count floats
+@param z the z components; count floats
+@param data receives the interleaved vectors, 3 * count floats
+@param count the number of vectors
+@returns none
+*/
+	static void interleave3(const float * x, const float * y, const float * z, float * data, long count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,24L * count);
+		long TcI = 0;
+		long TcJ;
+#ifdef __SSE__
+		for (; TcI + 4 <= count; TcI += 4)
+		{
+			__m128 vx = _mm_loadu_ps(x + TcI);
+			__m128 vy = _mm_loadu_ps(y + TcI);
+			__m128 vz = _mm_loadu_ps(z + TcI);
+			__m128 xy0 = _mm_shuffle_ps(vx,vy,_MM_SHUFFLE(0,0,0,0));
+			__m128 zx0 = _mm_shuffle_ps(vz,vx,_MM_SHUFFLE(1,1,0,0));
+			__m128 yz1 = _mm_shuffle_ps(vy,vz,_MM_SHUFFLE(1,1,1,1));
+			__m128 xy2 = _mm_shuffle_ps(vx,vy,_MM_SHUFFLE(2,2,2,2));
+			__m128 zx2 = _mm_shuffle_ps(vz,vx,_MM_SHUFFLE(3,3,2,2));
+			__m128 yz3 = _mm_shuffle_ps(vy,vz,_MM_SHUFFLE(3,3,3,3));
+			_mm_storeu_ps(data + 3 * TcI,_mm_shuffle_ps(xy0,zx0,_MM_SHUFFLE(2,0,2,0)));
+			_mm_storeu_ps(data + 3 * TcI + 4,_mm_shuffle_ps(yz1,xy2,_MM_SHUFFLE(2,0,2,0)));
+			_mm_storeu_ps(data + 3 * TcI + 8,_mm_shuffle_ps(zx2,yz3,_MM_SHUFFLE(2,0,2,0)));
+		}
+#endif
+#pragma omp simd
+		for (TcJ = TcI; TcJ < count; TcJ++)
+		{
+			data[3 * TcJ] = x[TcJ];
+			data[3 * TcJ + 1] = y[TcJ];
+			data[3 * TcJ + 2] = z[TcJ];
+		}
+	}
+/**
+Split interleaved 3x3 matrices, nine floats each in row major order, into separate element arrays
+@param data the interleaved matrices, 9 * count floats
+@param elements receives the elements: elements[3 * row + column] points to count floats
+@param count the number of matrices
+@returns none
+*/
+	static void deinterleave9(const float * data, float * const elements[9], long count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * count);
+		long TcI = 0;
+		int TcJ;
+#ifdef __SSE__
+		for (; TcI + 4 <= count; TcI += 4)
+		{
+			const float * source = data + 9 * TcI;
+			// elements 0 to 3 and then 4 to 7 of the four matrices are each a 4x4 transpose; element 8 is gathered
+			for (TcJ = 0; TcJ < 8; TcJ += 4)
+			{
+				__m128 row0 = _mm_loadu_ps(source + TcJ);
+				__m128 row1 = _mm_loadu_ps(source + 9 + TcJ);
+				__m128 row2 = _mm_loadu_ps(source + 18 + TcJ);
+				__m128 row3 = _mm_loadu_ps(source + 27 + TcJ);
+				_MM_TRANSPOSE4_PS(row0,row1,row2,row3);
+				_mm_storeu_ps(elements[TcJ] + TcI,row0);
+				_mm_storeu_ps(elements[TcJ + 1] + TcI,row1);
+				_mm_storeu_ps(elements[TcJ + 2] + TcI,row2);
+				_mm_storeu_ps(elements[TcJ + 3] + TcI,row3);
+			}
+			_mm_storeu_ps(elements[8] + TcI,_mm_set_ps(source[35],source[26],source[17],source[8]));
+		}
+#endif
+		for (TcJ = 0; TcJ < 9; TcJ++)
+		{
+			float * element = elements[TcJ];
+			long TcK;
+#pragma omp simd
+			for (TcK = TcI; TcK < count; TcK++)
+				element[TcK] = data[9 * TcK + TcJ];
+		}
+	}
+/**
+Merge separate element arrays into interleaved 3x3 matrices, nine floats each in row major order
+@param elements the elements: elements[3 * row + column] points to count floats
+@param data receives the interleaved matrices, 9 * count floats
+@param count the number of matrices
+@returns none
+*/
+	static void interleave9(const float * const elements[9], float * data, long count)
+	{
+		LINALG_COUNT(LAYOUT_TRANSPOSE,0,72L * count);
+		long TcI = 0;
+		int TcJ;
+#ifdef __SSE__
+		for (; TcI + 4 <= count; TcI += 4)
+		{
+			float * target = data + 9 * TcI;
+			for (TcJ = 0; TcJ < 8; TcJ += 4)
+			{
+				__m128 row0 = _mm_loadu_ps(elements[TcJ] + TcI);
+				__m128 row1 = _mm_loadu_ps(elements[TcJ + 1] + TcI);
+				__m128 row2 = _mm_loadu_ps(elements[TcJ + 2] + TcI);
+				__m128 row3 = _mm_loadu_ps(elements[TcJ + 3] + TcI);
+				_MM_TRANSPOSE4_PS(row0,row1,row2,row3);
+				_mm_storeu_ps(target + TcJ,row0);
+				_mm_storeu_ps(target + 9 + TcJ,row1);
+				_mm_storeu_ps(target + 18 + TcJ,row2);
+				_mm_storeu_ps(target + 27 + TcJ,row3);
+			}
+			target[8] = elements[8][TcI];
+			target[17] = elements[8][TcI + 1];
+			target[26] = elements[8][TcI + 2];
+			target[35] = elements[8][TcI + 3];
+		}
+#endif
+		for (TcJ = 0; TcJ < 9; TcJ++)
+		{
+			const float * element = elements[TcJ];
+			long TcK;
+#pragma omp simd
+			for (TcK = TcI; TcK < count; TcK++)
+				data[9 * TcK + TcJ] = element[TcK];
+		}
+	}
+};
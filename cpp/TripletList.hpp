@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+/**
+@brief A list of (row, column, value) triplets that compresses into compressed sparse row (CSR) arrays
+@details This is the assembly shared by SparseMatrixBuilder and BlockSparseMatrixBuilder; T is the element type, float or ThreeMatrix, and must support a + b. Triplets may be added in any order. Triplets that share a row and column are summed, as is usual when assembling finite element matrices. The triplets are bucketed by row with a counting sort, so that compressing is linear in the number of triplets apart from the sort of each row by column.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+template <typename T> class TripletList
+{
+private:
+	int _rows;
+	int _columns;
+	std::vector<int> _tripletRow;
+	std::vector<int> _tripletColumn;
+	std::vector<T> _tripletValue;
+public:
+/**
+TripletList constructor
+@param rows the number of rows of the matrix
+@param columns the number of columns of the matrix
+*/
+	TripletList(int rows, int columns)
+	{
+		_rows = rows > 0 ? rows : 0;
+		_columns = columns > 0 ? columns : 0;
+	}
+/**
+Get the number of rows of the matrix
+@returns the number of rows
+*/
+	int rows(void) const {return _rows;}
+/**
+Get the number of columns of the matrix
+@returns the number of columns
+*/
+	int columns(void) const {return _columns;}
+/**
+Reserve storage for a number of triplets
+@param count the expected number of triplets
+@returns none
+*/
+	void reserve(int count)
+	{
+		_tripletRow.reserve(count);
+		_tripletColumn.reserve(count);
+		_tripletValue.reserve(count);
+	}
+/**
+Add a value to the element at the given row and column. Triplets outside of the matrix are ignored.
+@param row the zero indexed row of the element
+@param column the zero indexed column of the element
+@param value the value to add to the element
+@returns none
+*/
+	void add(int row, int column, const T & value)
+	{
+		if (row >= 0 && row < _rows && column >= 0 && column < _columns)
+		{
+			_tripletRow.push_back(row);
+			_tripletColumn.push_back(column);
+			_tripletValue.push_back(value);
+		}
+	}
+/**
+Remove all triplets
+@returns none
+*/
+	void clear(void)
+	{
+		_tripletRow.clear();
+		_tripletColumn.clear();
+		_tripletValue.clear();
+	}
+/**
+Sort the triplets by row and column, sum those that share a row and column, and store the result in CSR form
+@param rowStart receives the index in columnIndex and values of the first element of each row, followed by the number of elements; rows() + 1 entries
+@param columnIndex receives the column of each element, in increasing order within each row
+@param values receives the value of each element
+@returns none
+*/
+	void compress(std::vector<int> & rowStart, std::vector<int> & columnIndex, std::vector<T> & values) const
+	{
+		size_t TcI;
+		int TcJ,TcK;
+		size_t count = _tripletValue.size();
+		std::vector<int> bucketStart(_rows + 1,0);
+		for (TcI = 0; TcI < count; TcI++)
+			bucketStart[_tripletRow[TcI] + 1]++;
+		for (TcJ = 0; TcJ < _rows; TcJ++)
+			bucketStart[TcJ + 1] += bucketStart[TcJ];
+
+		std::vector<int> next(bucketStart.begin(),bucketStart.end() - 1);
+		std::vector<std::pair<int,T> > entries(count);
+		for (TcI = 0; TcI < count; TcI++)
+			entries[next[_tripletRow[TcI]]++] = std::make_pair(_tripletColumn[TcI],_tripletValue[TcI]);
+
+		rowStart.assign(_rows + 1,0);
+		columnIndex.clear();
+		values.clear();
+		columnIndex.reserve(count);
+		values.reserve(count);
+		for (TcJ = 0; TcJ < _rows; TcJ++)
+		{
+			std::sort(entries.begin() + bucketStart[TcJ],entries.begin() + bucketStart[TcJ + 1],[](const std::pair<int,T> & a, const std::pair<int,T> & b){return a.first < b.first;});
+			for (TcK = bucketStart[TcJ]; TcK < bucketStart[TcJ + 1]; TcK++)
+			{
+				if (TcK > bucketStart[TcJ] && entries[TcK].first == columnIndex.back())
+					values.back() = values.back() + entries[TcK].second;
+				else
+				{
+					columnIndex.push_back(entries[TcK].first);
+					values.push_back(entries[TcK].second);
+				}
+			}
+			rowStart[TcJ + 1] = (int)values.size();
+		}
+	}
+};
@@ -156,6 +156,7 @@ Perform a matrix multiplication with a column vector
 */
 	TwoVector operator *(const TwoVector &vector) const
 	{
+		LINALG_COUNT(TWO_MATRIX_TRANSFORM,6,32);
 		return TwoVector(_data[0][0] * vector._x + _data[0][1] * vector._y,
 						_data[1][0] * vector._x + _data[1][1] * vector._y
 						);
@@ -186,6 +187,7 @@ Perform a matrix multiplication with a TwoMatrix
 */
 	TwoMatrix operator *(const TwoMatrix &matrix) const
 	{
+		LINALG_COUNT(TWO_MATRIX_PRODUCT,12,48);
 		TwoMatrix ret;
 
 		int TcI,TcJ;
@@ -276,6 +278,7 @@ Get the determinant of the matrix
 */
 	float determinant(void) const
 	{
+		LINALG_COUNT(TWO_MATRIX_DETERMINANT,3,20);
 		return _data[0][0] * _data[1][1] - _data[0][1] * _data[1][0];
 	}
 	
@@ -293,6 +296,7 @@ Get the inverse of the matrix
 */
 	TwoMatrix invert(void) const
 	{
+		LINALG_COUNT(TWO_MATRIX_INVERT,9,32);
 		TwoMatrix ret;
 		float det = determinant();
 		if (det != 0.0)
@@ -338,4 +342,18 @@ Load the identity matrix
 			}
 		}
 	}
+/**
+Load a rotation matrix, which rotates a vector counterclockwise by the given angle
+@param angle the angle of rotation, in radians
+@returns none
+*/
+	void loadRotation(float angle)
+	{
+		float c = std::cos(angle);
+		float s = std::sin(angle);
+		_data[0][0] = c;
+		_data[0][1] = -s;
+		_data[1][0] = s;
+		_data[1][1] = c;
+	}
 };
@@ -0,0 +1,469 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <ComponentArray.hpp>
+#include <TwoMatrix.hpp>
+#include <TwoVectorArray.hpp>
+#include <SinCos.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+
+/**
+@brief An array of 2x2 matrices stored as four separate element arrays (structure of arrays)
+@details Element (row, column) of every matrix is stored in its own contiguous array, so that the kernels process one matrix per SIMD lane. The kernels are branch free: conditions such as a singular matrix are handled with per-lane selects and reported in a mask instead of with branches, and the work is split between threads. Products and determinants are within 2 ulp of the sum of the magnitudes of their terms. The inverse and the solution of a system, by Cramer's rule, are within 6 ulp of their largest element times the condition number k, while k is well below \f$2^{21}\f$, and the eigenvalues of a symmetric matrix are within 3 ulp of the larger eigenvalue, unless the squares of its elements underflow; AccuracyHarness measures these bounds.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class TwoMatrixArray
+{
+private:
+	static const long GRAIN = 16384;
+	ComponentArray _data[2][2];
+
+	// computes op(A) op(B) for every matrix, where op transposes its matrix when the flag is set, and stores it in this array or adds it to this array. Every element is loaded before any is stored, so this array may be a or b.
+	template <bool TRANSPOSE_A, bool TRANSPOSE_B, bool ACCUMULATE> void product(const TwoMatrixArray & a, const TwoMatrixArray & b)
+	{
+		const float * a00 = a._data[0][0].data();
+		const float * a01 = TRANSPOSE_A ? a._data[1][0].data() : a._data[0][1].data();
+		const float * a10 = TRANSPOSE_A ? a._data[0][1].data() : a._data[1][0].data();
+		const float * a11 = a._data[1][1].data();
+		const float * b00 = b._data[0][0].data();
+		const float * b01 = TRANSPOSE_B ? b._data[1][0].data() : b._data[0][1].data();
+		const float * b10 = TRANSPOSE_B ? b._data[0][1].data() : b._data[1][0].data();
+		const float * b11 = b._data[1][1].data();
+		float * c00 = _data[0][0].data();
+		float * c01 = _data[0][1].data();
+		float * c10 = _data[1][0].data();
+		float * c11 = _data[1][1].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float x00 = a00[TcI], x01 = a01[TcI], x10 = a10[TcI], x11 = a11[TcI];
+				float y00 = b00[TcI], y01 = b01[TcI], y10 = b10[TcI], y11 = b11[TcI];
+				float p00 = x00 * y00 + x01 * y10;
+				float p01 = x00 * y01 + x01 * y11;
+				float p10 = x10 * y00 + x11 * y10;
+				float p11 = x10 * y01 + x11 * y11;
+				c00[TcI] = ACCUMULATE ? c00[TcI] + p00 : p00;
+				c01[TcI] = ACCUMULATE ? c01[TcI] + p01 : p01;
+				c10[TcI] = ACCUMULATE ? c10[TcI] + p10 : p10;
+				c11[TcI] = ACCUMULATE ? c11[TcI] + p11 : p11;
+			}
+		});
+	}
+	// selects the instance of product for the transposition flags
+	template <bool ACCUMULATE> void product(const TwoMatrixArray & a, const TwoMatrixArray & b, bool transposeA, bool transposeB)
+	{
+		if (transposeA)
+		{
+			if (transposeB)
+				product<true,true,ACCUMULATE>(a,b);
+			else
+				product<true,false,ACCUMULATE>(a,b);
+		}
+		else
+		{
+			if (transposeB)
+				product<false,true,ACCUMULATE>(a,b);
+			else
+				product<false,false,ACCUMULATE>(a,b);
+		}
+	}
+public:
+	TwoMatrixArray(void)
+	{
+	}
+/**
+TwoMatrixArray constructor
+@param size The number of matrices in the array; all matrices are initialized to zero
+*/
+	explicit TwoMatrixArray(int size)
+	{
+		resize(size);
+	}
+/**
+TwoMatrixArray constructor
+@param data An std::vector<TwoMatrix> with which to initialize the array
+*/
+	TwoMatrixArray(const std::vector<TwoMatrix> &data)
+	{
+		int TcI;
+		resize((int)data.size());
+		for (TcI = 0; TcI < size(); TcI++)
+			setAt(TcI,data[TcI]);
+	}
+/**
+Get the number of matrices in the array
+@returns The number of matrices
+*/
+	int size(void) const {return (int)_data[0][0].size();}
+/**
+Change the number of matrices in the array. New matrices are initialized to zero.
+@param size The new number of matrices
+@returns none
+*/
+	void resize(int size)
+	{
+		int TcI,TcJ;
+		if (size < 0)
+			size = 0;
+		for (TcI = 0; TcI < 2; TcI++)
+			for (TcJ = 0; TcJ < 2; TcJ++)
+				_data[TcI][TcJ].resize(size,0.0f);
+	}
+/**
+Make the array refer to existing element arrays, such as a section of a mapped ArrayFile, instead of copying them. They are never written: the first change to an element of the array, including a call to the non-const element(), copies that element's array. Until then they must remain valid.
+@param elements the elements: elements[2 * row + column] points to size floats
+@param size the number of matrices
+@returns none
+*/
+	void share(const float * const elements[4], int size)
+	{
+		int TcI;
+		if (size < 0)
+			size = 0;
+		for (TcI = 0; TcI < 4; TcI++)
+			_data[TcI / 2][TcI % 2].share(elements[TcI],size);
+	}
+/**
+Get direct access to one element of every matrix
+@param row the zero indexed row of the element
+@param column the zero indexed column of the element
+@returns A pointer to the element of the first matrix, or null if row or column is out of range
+*/
+	float * element(int row, int column)
+	{
+		if (row >= 0 && row < 2 && column >= 0 && column < 2)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+	const float * element(int row, int column) const
+	{
+		if (row >= 0 && row < 2 && column >= 0 && column < 2)
+			return _data[row][column].data();
+		else
+			return nullptr;
+	}
+
+/**
+Retreive the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to retrieve
+@returns the matrix at the index, the zero matrix otherwise
+*/
+	TwoMatrix at(int idx) const
+	{
+		int TcI,TcJ;
+		TwoMatrix ret;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 2; TcI++)
+				for (TcJ = 0; TcJ < 2; TcJ++)
+					ret.setAt(TcI,TcJ,_data[TcI][TcJ][idx]);
+		}
+		return ret;
+	}
+/**
+Set the matrix at the given index, zero indexed
+@param idx the zero indexed matrix to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const TwoMatrix & value)
+	{
+		int TcI,TcJ;
+		if (idx >= 0 && idx < size())
+		{
+			for (TcI = 0; TcI < 2; TcI++)
+				for (TcJ = 0; TcJ < 2; TcJ++)
+					_data[TcI][TcJ][idx] = value.at(TcI,TcJ);
+		}
+	}
+
+/**
+Get the determinant of every matrix
+@param result receives the determinants; resized to size()
+@returns none
+*/
+	void determinant(std::vector<float> & result) const
+	{
+		LINALG_COUNT(TWO_MATRIX_ARRAY_DETERMINANT,3L * size(),20L * size());
+		result.resize(size());
+		const float * a = _data[0][0].data();
+		const float * b = _data[0][1].data();
+		const float * c = _data[1][0].data();
+		const float * d = _data[1][1].data();
+		float * det = result.data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				det[TcI] = a[TcI] * d[TcI] - b[TcI] * c[TcI];
+		});
+	}
+/**
+Get the inverse of every matrix. As with TwoMatrix::invert, the inverse of a singular matrix is the zero matrix.
+@param result receives the inverses; resized to size(). May be this array.
+@param singular receives 1 for each matrix whose determinant has magnitude less than or equal to tolerance, and 0 otherwise; resized to size()
+@param tolerance the largest determinant magnitude that is treated as singular
+@returns the number of singular matrices
+*/
+	long invert(TwoMatrixArray & result, std::vector<unsigned char> & singular, float tolerance = 0.0) const
+	{
+		LINALG_COUNT(TWO_MATRIX_ARRAY_INVERT,9L * size(),33L * size());
+		long count = size();
+		result.resize(size());
+		singular.resize(size());
+		const float * a = _data[0][0].data();
+		const float * b = _data[0][1].data();
+		const float * c = _data[1][0].data();
+		const float * d = _data[1][1].data();
+		float * ia = result._data[0][0].data();
+		float * ib = result._data[0][1].data();
+		float * ic = result._data[1][0].data();
+		float * id = result._data[1][1].data();
+		unsigned char * mask = singular.data();
+		return (long)ThreadPool::instance().parallelSum(0,count,GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			int singularCount = 0;
+#pragma omp simd reduction(+:singularCount)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float det = a[TcI] * d[TcI] - b[TcI] * c[TcI];
+				int isSingular = std::fabs(det) <= tolerance;
+				float invDet = isSingular ? 0.0f : 1.0f / det;
+				float na = d[TcI] * invDet;
+				float nb = -b[TcI] * invDet;
+				float nc = -c[TcI] * invDet;
+				float nd = a[TcI] * invDet;
+				ia[TcI] = na;
+				ib[TcI] = nb;
+				ic[TcI] = nc;
+				id[TcI] = nd;
+				mask[TcI] = (unsigned char)isSingular;
+				singularCount += isSingular;
+			}
+			return (double)singularCount;
+		});
+	}
+/**
+Solve \f$A_i \vec{x}_i = \vec{b}_i\f$ for every matrix, by Cramer's rule. The solution for a singular matrix is the zero vector.
+@param rhs the right hand sides; must have size() elements
+@param result receives the solutions; resized to size(). May be rhs.
+@param singular receives 1 for each matrix whose determinant has magnitude less than or equal to tolerance, and 0 otherwise; resized to size()
+@param tolerance the largest determinant magnitude that is treated as singular
+@returns the number of singular matrices
+*/
+	long solve(const TwoVectorArray & rhs, TwoVectorArray & result, std::vector<unsigned char> & singular, float tolerance = 0.0) const
+	{
+		long count = size();
+		if (rhs.size() != size())
+			return 0;
+		LINALG_COUNT(TWO_MATRIX_ARRAY_SOLVE,12L * size(),33L * size());
+		result.resize(size());
+		singular.resize(size());
+		const float * a = _data[0][0].data();
+		const float * b = _data[0][1].data();
+		const float * c = _data[1][0].data();
+		const float * d = _data[1][1].data();
+		const float * rx = rhs.x();
+		const float * ry = rhs.y();
+		float * x = result.x();
+		float * y = result.y();
+		unsigned char * mask = singular.data();
+		return (long)ThreadPool::instance().parallelSum(0,count,GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			int singularCount = 0;
+#pragma omp simd reduction(+:singularCount)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float det = a[TcI] * d[TcI] - b[TcI] * c[TcI];
+				int isSingular = std::fabs(det) <= tolerance;
+				float invDet = isSingular ? 0.0f : 1.0f / det;
+				float sx = (d[TcI] * rx[TcI] - b[TcI] * ry[TcI]) * invDet;
+				float sy = (a[TcI] * ry[TcI] - c[TcI] * rx[TcI]) * invDet;
+				x[TcI] = sx;
+				y[TcI] = sy;
+				mask[TcI] = (unsigned char)isSingular;
+				singularCount += isSingular;
+			}
+			return (double)singularCount;
+		});
+	}
+/**
+Get the eigenvalues of every matrix in closed form. With \f$m = \frac{1}{2}\mathrm{tr} A\f$ and \f$\Delta = \frac{1}{4}(a - d)^2 + b c\f$, the eigenvalues are \f$m \pm \sqrt{\Delta}\f$. The larger magnitude eigenvalue is computed directly and the other as \f$\det A / \lambda_1\f$, which avoids cancellation. When \f$\Delta < 0\f$ the eigenvalues are the complex pair \f$m \pm i\sqrt{-\Delta}\f$.
+@param values receives the real parts of the eigenvalues, the larger magnitude in x; resized to size()
+@param imaginary receives the imaginary part of the first eigenvalue (the second is its conjugate), zero for real eigenvalues; resized to size()
+@returns the number of matrices with complex eigenvalues
+*/
+	long eigenvalues(TwoVectorArray & values, std::vector<float> & imaginary) const
+	{
+		LINALG_COUNT(TWO_MATRIX_ARRAY_EIGEN,16L * size(),28L * size());
+		long count = size();
+		values.resize(size());
+		imaginary.resize(size());
+		const float * a = _data[0][0].data();
+		const float * b = _data[0][1].data();
+		const float * c = _data[1][0].data();
+		const float * d = _data[1][1].data();
+		float * l1 = values.x();
+		float * l2 = values.y();
+		float * im = imaginary.data();
+		return (long)ThreadPool::instance().parallelSum(0,count,GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			int complexCount = 0;
+#pragma omp simd reduction(+:complexCount)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float mid = 0.5f * (a[TcI] + d[TcI]);
+				float half = 0.5f * (a[TcI] - d[TcI]);
+				float disc = half * half + b[TcI] * c[TcI];
+				float det = a[TcI] * d[TcI] - b[TcI] * c[TcI];
+				int isComplex = disc < 0.0f;
+				float root = std::sqrt(std::fabs(disc));
+				float large = mid + std::copysign(root,mid);
+				float small = large != 0.0f ? det / large : 0.0f;
+				l1[TcI] = isComplex ? mid : large;
+				l2[TcI] = isComplex ? mid : small;
+				im[TcI] = isComplex ? root : 0.0f;
+				complexCount += isComplex;
+			}
+			return (double)complexCount;
+		});
+	}
+/**
+Get the unit eigenvectors of every matrix, for the eigenvalues in the order given by eigenvalues(). For a matrix with complex eigenvalues both vectors are zero. For a multiple of the identity the vectors are the x and y unit vectors.
+@param first receives the eigenvector of the larger magnitude eigenvalue; resized to size()
+@param second receives the eigenvector of the smaller magnitude eigenvalue; resized to size()
+@param complex receives 1 for each matrix with complex eigenvalues and 0 otherwise; resized to size()
+@returns the number of matrices with complex eigenvalues
+*/
+	long eigenvectors(TwoVectorArray & first, TwoVectorArray & second, std::vector<unsigned char> & complex) const
+	{
+		LINALG_COUNT(TWO_MATRIX_ARRAY_EIGEN,34L * size(),33L * size());
+		long count = size();
+		first.resize(size());
+		second.resize(size());
+		complex.resize(size());
+		const float * a = _data[0][0].data();
+		const float * b = _data[0][1].data();
+		const float * c = _data[1][0].data();
+		const float * d = _data[1][1].data();
+		float * v1x = first.x();
+		float * v1y = first.y();
+		float * v2x = second.x();
+		float * v2y = second.y();
+		unsigned char * mask = complex.data();
+		return (long)ThreadPool::instance().parallelSum(0,count,GRAIN,[&](long begin, long end)
+		{
+			long TcI;
+			int complexCount = 0;
+#pragma omp simd reduction(+:complexCount)
+			for (TcI = begin; TcI < end; TcI++)
+			{
+				float mid = 0.5f * (a[TcI] + d[TcI]);
+				float half = 0.5f * (a[TcI] - d[TcI]);
+				float disc = half * half + b[TcI] * c[TcI];
+				float det = a[TcI] * d[TcI] - b[TcI] * c[TcI];
+				int isComplex = disc < 0.0f;
+				float root = std::sqrt(std::fabs(disc));
+				float large = mid + std::copysign(root,mid);
+				float small = large != 0.0f ? det / large : 0.0f;
+				// (A - l I) v = 0 is solved from whichever row has the larger off-diagonal element
+				int useRow = std::fabs(b[TcI]) >= std::fabs(c[TcI]);
+				float x1 = useRow ? b[TcI] : large - d[TcI];
+				float y1 = useRow ? large - a[TcI] : c[TcI];
+				float x2 = useRow ? b[TcI] : small - d[TcI];
+				float y2 = useRow ? small - a[TcI] : c[TcI];
+				int diagonal = (b[TcI] == 0.0f) & (c[TcI] == 0.0f);
+				int firstIsX = std::fabs(a[TcI]) >= std::fabs(d[TcI]);
+				x1 = diagonal ? (firstIsX ? 1.0f : 0.0f) : x1;
+				y1 = diagonal ? (firstIsX ? 0.0f : 1.0f) : y1;
+				x2 = diagonal ? (firstIsX ? 0.0f : 1.0f) : x2;
+				y2 = diagonal ? (firstIsX ? 1.0f : 0.0f) : y2;
+				float n1 = x1 * x1 + y1 * y1;
+				float n2 = x2 * x2 + y2 * y2;
+				float s1 = (isComplex | (n1 == 0.0f)) ? 0.0f : 1.0f / std::sqrt(n1);
+				float s2 = (isComplex | (n2 == 0.0f)) ? 0.0f : 1.0f / std::sqrt(n2);
+				v1x[TcI] = x1 * s1;
+				v1y[TcI] = y1 * s1;
+				v2x[TcI] = x2 * s2;
+				v2y[TcI] = y2 * s2;
+				mask[TcI] = (unsigned char)isComplex;
+				complexCount += isComplex;
+			}
+			return (double)complexCount;
+		});
+	}
+/**
+Load every matrix with the product of the corresponding matrices of two arrays, \f$C_i = op(A_i) op(B_i)\f$, where op is either the matrix or its transpose. This computes the same products as TwoMatrix::operator * for many pairs at once, one pair per SIMD lane.
+@param a the left factors; must have the same size as b. May be this array.
+@param b the right factors. May be this array.
+@param transposeA true to use the transpose of each left factor
+@param transposeB true to use the transpose of each right factor
+@returns none
+*/
+	void loadProduct(const TwoMatrixArray & a, const TwoMatrixArray & b, bool transposeA = false, bool transposeB = false)
+	{
+		if (a.size() != b.size())
+			return;
+		LINALG_COUNT(TWO_MATRIX_ARRAY_PRODUCT,12L * a.size(),48L * a.size());
+		resize(a.size());
+		product<false>(a,b,transposeA,transposeB);
+	}
+/**
+Add the product of the corresponding matrices of two arrays to every matrix, \f$C_i \mathrel{+}= op(A_i) op(B_i)\f$, where op is either the matrix or its transpose
+@param a the left factors; must have the same size as b and as this array. May be this array.
+@param b the right factors. May be this array.
+@param transposeA true to use the transpose of each left factor
+@param transposeB true to use the transpose of each right factor
+@returns none
+*/
+	void addProduct(const TwoMatrixArray & a, const TwoMatrixArray & b, bool transposeA = false, bool transposeB = false)
+	{
+		if (a.size() != b.size() || a.size() != size())
+			return;
+		LINALG_COUNT(TWO_MATRIX_ARRAY_PRODUCT,16L * a.size(),64L * a.size());
+		product<true>(a,b,transposeA,transposeB);
+	}
+/**
+Load every matrix with a rotation, as TwoMatrix::loadRotation. The sines and cosines are computed with SinCos.
+@param angles the angles of rotation, in radians; the array is resized to match
+@returns none
+*/
+	void loadRotation(const std::vector<float> & angles)
+	{
+		LINALG_COUNT(TWO_MATRIX_ARRAY_ROTATION,20L * angles.size(),20L * angles.size());
+		resize((int)angles.size());
+		const float * theta = angles.data();
+		float * a = _data[0][0].data();
+		float * b = _data[0][1].data();
+		float * c = _data[1][0].data();
+		float * d = _data[1][1].data();
+		ThreadPool::instance().parallelFor(0,size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float sine,cosine;
+				SinCos::compute(theta[TcI],sine,cosine);
+				a[TcI] = cosine;
+				b[TcI] = -sine;
+				c[TcI] = sine;
+				d[TcI] = cosine;
+			}
+		});
+	}
+};
+
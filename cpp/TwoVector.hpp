@@ -1,5 +1,7 @@
 #pragma once
 #include <cmath>
+#include <vector>
+#include <OperationCounters.hpp>
 /** 
 @brief A c++ implementation of a 2-dimensional vector
 @details 
@@ -149,6 +151,7 @@ Retrieve a scalar (dot) product for this vector: \f$\vec{a}\bullet\vec{b} = a_x
 */
 	float dot(const TwoVector &vectB) const
 	{
+		LINALG_COUNT(TWO_VECTOR_DOT,3,20);
 		return _x * vectB._x + _y * vectB._y;
 	}
 /** 
@@ -157,6 +160,7 @@ Retrieve a cross product for these vector: \f$\vec{a}\times\vec{b} = a_xb_y - a_
 */
 	float cross(const TwoVector & vectB) const
 	{
+		LINALG_COUNT(TWO_VECTOR_CROSS,3,20);
 		return _x * vectB._y - _y * vectB._x;
 	}
 /** 
@@ -165,6 +169,7 @@ Get the magnitude (length) of the vector
 */
 	float magnitude(void)
 	{
+		LINALG_COUNT(TWO_VECTOR_MAGNITUDE,4,12);
 		return std::sqrt(dot(*this));
 	}
 	
@@ -174,6 +179,7 @@ Retrieve a unit vector for this vector
 */
 	TwoVector unit(void)
 	{
+		LINALG_COUNT(TWO_VECTOR_UNIT,7,16);
 		float mag = magnitude();
 		if (mag != 0.0)
 			mag = 1.0 / mag;
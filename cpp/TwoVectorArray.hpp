@@ -0,0 +1,125 @@
+#pragma once
+#include <vector>
+#include <ComponentArray.hpp>
+#include <TwoVector.hpp>
+/**
+@brief An array of 2-dimensional vectors stored as separate x and y component arrays (structure of arrays)
+@details This is the layout used by the bulk kernels: consecutive elements of each component are contiguous, so that a loop over the array can process several vectors per instruction.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class TwoVectorArray
+{
+private:
+	ComponentArray _x;
+	ComponentArray _y;
+public:
+	TwoVectorArray(void)
+	{
+	}
+/**
+TwoVectorArray constructor
+@param size The number of vectors in the array; all vectors are initialized to zero
+*/
+	explicit TwoVectorArray(int size)
+	{
+		resize(size);
+	}
+/**
+TwoVectorArray constructor
+@param data An std::vector<TwoVector> with which to initialize the array
+*/
+	TwoVectorArray(const std::vector<TwoVector> &data)
+	{
+		int TcI;
+		resize((int)data.size());
+		for (TcI = 0; TcI < size(); TcI++)
+			setAt(TcI,data[TcI]);
+	}
+/**
+Get the number of vectors in the array
+@returns The number of vectors
+*/
+	int size(void) const {return (int)_x.size();}
+/**
+Change the number of vectors in the array. New vectors are initialized to zero.
+@param size The new number of vectors
+@returns none
+*/
+	void resize(int size)
+	{
+		if (size < 0)
+			size = 0;
+		_x.resize(size,0.0f);
+		_y.resize(size,0.0f);
+	}
+/**
+Make the array refer to existing component arrays, such as a section of a mapped ArrayFile, instead of copying them. They are never written: the first change to the array, including a call to a non-const accessor such as x(), copies them. Until then they must remain valid.
+@param x the x components; size floats
+@param y the y components; size floats
+@param size the number of vectors
+@returns none
+*/
+	void share(const float * x, const float * y, int size)
+	{
+		if (size < 0)
+			size = 0;
+		_x.share(x,size);
+		_y.share(y,size);
+	}
+/**
+Get direct access to the x components
+@returns A pointer to the x component of the first vector
+*/
+	float * x(void) {return _x.data();}
+	const float * x(void) const {return _x.data();}
+/**
+Get direct access to the y components
+@returns A pointer to the y component of the first vector
+*/
+	float * y(void) {return _y.data();}
+	const float * y(void) const {return _y.data();}
+
+/**
+Retreive the vector at the given index, zero indexed
+@param idx the zero indexed vector to retrieve
+@returns the vector at the index, the zero vector otherwise
+*/
+	TwoVector at(int idx) const
+	{
+		if (idx >= 0 && idx < size())
+			return TwoVector(_x[idx],_y[idx]);
+		else
+			return TwoVector();
+	}
+/**
+Set the vector at the given index, zero indexed
+@param idx the zero indexed vector to set
+@param value the value to insert into the array
+@returns none
+*/
+	void setAt(int idx, const TwoVector & value)
+	{
+		if (idx >= 0 && idx < size())
+		{
+			_x[idx] = value.getX();
+			_y[idx] = value.getY();
+		}
+	}
+/**
+Convert the array to an array of TwoVectors
+@returns an std::vector<TwoVector> containing the vectors
+*/
+	std::vector<TwoVector> toVector(void) const
+	{
+		int TcI;
+		std::vector<TwoVector> ret(size());
+		for (TcI = 0; TcI < size(); TcI++)
+			ret[TcI] = at(TcI);
+		return ret;
+	}
+};
+
@@ -0,0 +1,433 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <TwoVector.hpp>
+#include <TwoVectorArray.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+
+/**
+@brief Batched 2-d geometry kernels on TwoVectorArray: orientation, polygon area and centroid, point in polygon, segment intersection and convex hull
+@details Orientation tests use a filtered predicate. The determinant is first evaluated in double precision together with a bound on its rounding error, which settles the sign for all but nearly collinear points; those are then re-evaluated exactly. Because the inputs are floats, each term of the expanded determinant is an exact double product, and the exact sign is obtained by summing the six products as a floating point expansion. The batched kernels run the filter over whole arrays in vectorizable loops and only fall back for the lanes that need it.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class TwoVectorGeometry
+{
+private:
+	// (3 + 16 epsilon) epsilon for double precision; see Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates"
+	static constexpr double ORIENTATION_BOUND = 3.3306690738754716e-16;
+	static const signed char UNCERTAIN = 2;
+
+	static void twoSum(double a, double b, double & sum, double & error)
+	{
+		sum = a + b;
+		double bVirtual = sum - a;
+		double aVirtual = sum - bVirtual;
+		error = (a - aVirtual) + (b - bVirtual);
+	}
+	static double filteredDeterminant(double ax, double ay, double bx, double by, double cx, double cy, double & bound)
+	{
+		double left = (ax - cx) * (by - cy);
+		double right = (ay - cy) * (bx - cx);
+		bound = ORIENTATION_BOUND * (std::fabs(left) + std::fabs(right));
+		return left - right;
+	}
+	// whether c, known to lie on the line through a and b, lies within the bounding box of the segment from a to b
+	static bool onSegment(const TwoVector & a, const TwoVector & b, const TwoVector & c)
+	{
+		return std::min(a.getX(),b.getX()) <= c.getX() && c.getX() <= std::max(a.getX(),b.getX()) && std::min(a.getY(),b.getY()) <= c.getY() && c.getY() <= std::max(a.getY(),b.getY());
+	}
+/*
+The exact sign of (a - c) x (b - c) for float coordinates. The determinant expands to six products of floats, each of which is exact in double precision; they are accumulated into a nonoverlapping expansion, whose sign is the sign of its largest component.
+*/
+	static int exactOrientation(float ax, float ay, float bx, float by, float cx, float cy)
+	{
+		double terms[6] = {(double)ax * by, -(double)ax * cy, -(double)cx * by, -(double)ay * bx, (double)ay * cx, (double)cy * bx};
+		double expansion[6];
+		int length = 0;
+		int TcI,TcJ;
+		for (TcI = 0; TcI < 6; TcI++)
+		{
+			double carry = terms[TcI];
+			int next = 0;
+			for (TcJ = 0; TcJ < length; TcJ++)
+			{
+				double sum,error;
+				twoSum(carry,expansion[TcJ],sum,error);
+				carry = sum;
+				if (error != 0.0)
+					expansion[next++] = error;
+			}
+			if (carry != 0.0)
+				expansion[next++] = carry;
+			length = next;
+		}
+		if (length == 0)
+			return 0;
+		return expansion[length - 1] > 0.0 ? 1 : -1;
+	}
+	// sums three quantities over [begin, end) in one pass, as ThreadPool::parallelSum: body(first, last, sums) adds a piece into sums, and the partial sums are added in a fixed order
+	template <typename Body> static void sumThree(long begin, long end, long grain, const Body & body, double sums[3])
+	{
+		const long maxPartials = 256;
+		double partial[maxPartials][3];
+		long TcI;
+		int TcJ;
+		ThreadPool & pool = ThreadPool::instance();
+		long count = end - begin;
+		sums[0] = sums[1] = sums[2] = 0.0;
+		if (count <= 0)
+			return;
+		long chunks = count / grain;
+		long maxChunks = (long)pool.size() * 4;
+		if (maxChunks > maxPartials)
+			maxChunks = maxPartials;
+		if (chunks > maxChunks)
+			chunks = maxChunks;
+		if (chunks <= 1)
+		{
+			body(begin,end,sums);
+			return;
+		}
+		long step = (count + chunks - 1) / chunks;
+		for (TcI = 0; TcI < chunks; TcI++)
+			partial[TcI][0] = partial[TcI][1] = partial[TcI][2] = 0.0;
+		pool.run((int)chunks,[&](int chunk)
+		{
+			long first = begin + chunk * step;
+			long last = first + step < end ? first + step : end;
+			if (first < last)
+				body(first,last,partial[chunk]);
+		});
+		for (TcI = 0; TcI < chunks; TcI++)
+			for (TcJ = 0; TcJ < 3; TcJ++)
+				sums[TcJ] += partial[TcI][TcJ];
+	}
+	static void resolve(const float * ax, const float * ay, const float * bx, const float * by, const float * cx, const float * cy, long stepA, long stepB, long count, signed char * result)
+	{
+		long TcI;
+		for (TcI = 0; TcI < count; TcI++)
+		{
+			if (result[TcI] == UNCERTAIN)
+				result[TcI] = (signed char)exactOrientation(ax[TcI * stepA],ay[TcI * stepA],bx[TcI * stepB],by[TcI * stepB],cx[TcI],cy[TcI]);
+		}
+	}
+	static void monotoneChain(std::vector<TwoVector> & points, std::vector<TwoVector> & hull)
+	{
+		size_t TcI;
+		std::sort(points.begin(),points.end(),[](const TwoVector & a, const TwoVector & b){return a.getX() < b.getX() || (a.getX() == b.getX() && a.getY() < b.getY());});
+		points.erase(std::unique(points.begin(),points.end(),[](const TwoVector & a, const TwoVector & b){return a.getX() == b.getX() && a.getY() == b.getY();}),points.end());
+		hull.clear();
+		if (points.size() < 3)
+		{
+			hull = points;
+			return;
+		}
+		hull.resize(2 * points.size());
+		size_t count = 0;
+		for (TcI = 0; TcI < points.size(); TcI++)
+		{
+			while (count >= 2 && orientation(hull[count - 2],hull[count - 1],points[TcI]) <= 0)
+				count--;
+			hull[count++] = points[TcI];
+		}
+		size_t lower = count + 1;
+		for (TcI = points.size() - 1; TcI > 0; TcI--)
+		{
+			while (count >= lower && orientation(hull[count - 2],hull[count - 1],points[TcI - 1]) <= 0)
+				count--;
+			hull[count++] = points[TcI - 1];
+		}
+		hull.resize(count - 1);
+	}
+public:
+/**
+Determine the orientation of three points: the sign of \f$(\vec{b} - \vec{a})\times(\vec{c} - \vec{a})\f$. The result is exact.
+@param a the first point
+@param b the second point
+@param c the third point
+@returns 1 if the points are in counterclockwise order, -1 if clockwise and 0 if they are collinear
+*/
+	static int orientation(const TwoVector & a, const TwoVector & b, const TwoVector & c)
+	{
+		double bound;
+		double det = filteredDeterminant(a.getX(),a.getY(),b.getX(),b.getY(),c.getX(),c.getY(),bound);
+		if (det > bound)
+			return 1;
+		if (det < -bound)
+			return -1;
+		return exactOrientation(a.getX(),a.getY(),b.getX(),b.getY(),c.getX(),c.getY());
+	}
+/**
+Determine the orientation of many triples of points, as orientation(a[i], b[i], c[i]). The work is split between threads.
+@param a the first points
+@param b the second points
+@param c the third points
+@param result receives the orientation of each triple; resized to the size of the smallest array
+@returns none
+*/
+	static void orientation(const TwoVectorArray & a, const TwoVectorArray & b, const TwoVectorArray & c, std::vector<signed char> & result)
+	{
+		long count = std::min(std::min(a.size(),b.size()),c.size());
+		LINALG_COUNT(GEOMETRY_ORIENTATION,10L * count,25L * count);
+		result.resize(count);
+		ThreadPool::instance().parallelFor(0,count,16384,[&](long first, long last)
+		{
+			long TcI;
+			const float * ax = a.x(); const float * ay = a.y();
+			const float * bx = b.x(); const float * by = b.y();
+			const float * cx = c.x(); const float * cy = c.y();
+			signed char * out = result.data();
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				double bound;
+				double det = filteredDeterminant(ax[TcI],ay[TcI],bx[TcI],by[TcI],cx[TcI],cy[TcI],bound);
+				out[TcI] = det > bound ? 1 : (det < -bound ? -1 : UNCERTAIN);
+			}
+			resolve(ax + first,ay + first,bx + first,by + first,cx + first,cy + first,1,1,last - first,out + first);
+		});
+	}
+/**
+Determine the side of the directed line from a to b on which each of many points lies, as orientation(a, b, points[i])
+@param a the first point on the line
+@param b the second point on the line
+@param points the points to test
+@param result receives 1 for points to the left of the line, -1 for points to the right and 0 for points on the line; resized to the number of points
+@returns none
+*/
+	static void orientation(const TwoVector & a, const TwoVector & b, const TwoVectorArray & points, std::vector<signed char> & result)
+	{
+		long count = points.size();
+		LINALG_COUNT(GEOMETRY_ORIENTATION,10L * count,9L * count);
+		result.resize(count);
+		const float ax = a.getX(), ay = a.getY(), bx = b.getX(), by = b.getY();
+		ThreadPool::instance().parallelFor(0,count,16384,[&](long first, long last)
+		{
+			long TcI;
+			const float * cx = points.x();
+			const float * cy = points.y();
+			signed char * out = result.data();
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+			{
+				double bound;
+				double det = filteredDeterminant(ax,ay,bx,by,cx[TcI],cy[TcI],bound);
+				out[TcI] = det > bound ? 1 : (det < -bound ? -1 : UNCERTAIN);
+			}
+			resolve(&ax,&ay,&bx,&by,cx + first,cy + first,0,0,last - first,out + first);
+		});
+	}
+/**
+Compute the signed area of a simple polygon with the shoelace formula. The sum is accumulated in double precision, relative to the first vertex to limit cancellation.
+@param polygon the vertices of the polygon, in order; the last vertex is joined to the first
+@returns the area; positive if the vertices are in counterclockwise order
+*/
+	static double polygonArea(const TwoVectorArray & polygon)
+	{
+		long count = polygon.size();
+		if (count < 3)
+			return 0.0;
+		LINALG_COUNT(GEOMETRY_POLYGON_AREA,8L * count,8L * count);
+		const float * x = polygon.x();
+		const float * y = polygon.y();
+		const double x0 = x[0], y0 = y[0];
+		double twiceArea = ThreadPool::instance().parallelSum(1,count - 1,65536,[&](long first, long last)
+		{
+			long TcI;
+			double sum = 0.0;
+#pragma omp simd reduction(+:sum)
+			for (TcI = first; TcI < last; TcI++)
+				sum += (x[TcI] - x0) * (y[TcI + 1] - y0) - (x[TcI + 1] - x0) * (y[TcI] - y0);
+			return sum;
+		});
+		return 0.5 * twiceArea;
+	}
+/**
+Compute the centroid of the area of a simple polygon
+@param polygon the vertices of the polygon, in order; the last vertex is joined to the first
+@returns the centroid; the mean of the vertices if the polygon has zero area
+*/
+	static TwoVector polygonCentroid(const TwoVectorArray & polygon)
+	{
+		long TcI;
+		long count = polygon.size();
+		if (count == 0)
+			return TwoVector();
+		LINALG_COUNT(GEOMETRY_POLYGON_CENTROID,14L * count,8L * count);
+		const float * x = polygon.x();
+		const float * y = polygon.y();
+		const double x0 = x[0], y0 = y[0];
+		double sums[3];
+		// accumulate 2A, 6A cx and 6A cy relative to the first vertex, in one pass over the edges
+		sumThree(1,count - 1,65536,[&](long first, long last, double partial[3])
+		{
+			long TcJ;
+			double area = 0.0, cx = 0.0, cy = 0.0;
+#pragma omp simd reduction(+:area,cx,cy)
+			for (TcJ = first; TcJ < last; TcJ++)
+			{
+				double xa = x[TcJ] - x0, ya = y[TcJ] - y0;
+				double xb = x[TcJ + 1] - x0, yb = y[TcJ + 1] - y0;
+				double term = xa * yb - xb * ya;
+				area += term;
+				cx += (xa + xb) * term;
+				cy += (ya + yb) * term;
+			}
+			partial[0] = area;
+			partial[1] = cx;
+			partial[2] = cy;
+		},sums);
+		if (sums[0] == 0.0)
+		{
+			double meanX = 0.0, meanY = 0.0;
+			for (TcI = 0; TcI < count; TcI++)
+			{
+				meanX += x[TcI];
+				meanY += y[TcI];
+			}
+			return TwoVector(meanX / count,meanY / count);
+		}
+		return TwoVector(x0 + sums[1] / (3.0 * sums[0]),y0 + sums[2] / (3.0 * sums[0]));
+	}
+/**
+Determine which of many points lie inside a polygon, using the crossing number (even-odd) rule. The points are split between threads, and the loop over the edges of the polygon is branch free.
+@param polygon the vertices of the polygon, in order; the last vertex is joined to the first
+@param points the points to test
+@param inside receives 1 for each point inside the polygon and 0 otherwise; resized to the number of points
+@returns none
+*/
+	static void pointInPolygon(const TwoVectorArray & polygon, const TwoVectorArray & points, std::vector<unsigned char> & inside)
+	{
+		LINALG_COUNT(GEOMETRY_POINT_IN_POLYGON,8L * points.size() * polygon.size(),9L * points.size() + 8L * polygon.size());
+		long count = points.size();
+		int edges = polygon.size();
+		inside.resize(count);
+		if (edges < 3)
+		{
+			std::fill(inside.begin(),inside.end(),0);
+			return;
+		}
+		const float * vx = polygon.x();
+		const float * vy = polygon.y();
+		ThreadPool::instance().parallelFor(0,count,256,[&](long first, long last)
+		{
+			long TcI;
+			int TcJ;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				const float px = points.x()[TcI];
+				const float py = points.y()[TcI];
+				int crossings = 0;
+#pragma omp simd reduction(^:crossings)
+				for (TcJ = 0; TcJ < edges; TcJ++)
+				{
+					int previous = TcJ == 0 ? edges - 1 : TcJ - 1;
+					float xa = vx[previous], ya = vy[previous];
+					float xb = vx[TcJ], yb = vy[TcJ];
+					int straddles = (ya > py) != (yb > py);
+					float xCross = xa + (py - ya) * (xb - xa) / (yb - ya);
+					crossings ^= straddles & (px < xCross);
+				}
+				inside[TcI] = (unsigned char)crossings;
+			}
+		});
+	}
+/**
+Determine if two closed segments intersect. The result is exact, including for touching and collinear segments.
+@param p1 the first end of the first segment
+@param p2 the second end of the first segment
+@param q1 the first end of the second segment
+@param q2 the second end of the second segment
+@returns true if the segments share at least one point
+*/
+	static bool segmentsIntersect(const TwoVector & p1, const TwoVector & p2, const TwoVector & q1, const TwoVector & q2)
+	{
+		int o1 = orientation(p1,p2,q1);
+		int o2 = orientation(p1,p2,q2);
+		int o3 = orientation(q1,q2,p1);
+		int o4 = orientation(q1,q2,p2);
+		if (o1 == 0 && o2 == 0 && o3 == 0 && o4 == 0)
+		{
+			// all four points on one line: the projections onto both axes must overlap
+			return std::max(std::min(p1.getX(),p2.getX()),std::min(q1.getX(),q2.getX())) <= std::min(std::max(p1.getX(),p2.getX()),std::max(q1.getX(),q2.getX())) &&
+				std::max(std::min(p1.getY(),p2.getY()),std::min(q1.getY(),q2.getY())) <= std::min(std::max(p1.getY(),p2.getY()),std::max(q1.getY(),q2.getY()));
+		}
+		if (o1 != o2 && o3 != o4)
+			return true;
+		// otherwise the segments can only meet at an endpoint that lies on the other segment; this also covers segments that are single points
+		return (o1 == 0 && onSegment(p1,p2,q1)) || (o2 == 0 && onSegment(p1,p2,q2)) || (o3 == 0 && onSegment(q1,q2,p1)) || (o4 == 0 && onSegment(q1,q2,p2));
+	}
+/**
+Determine if many pairs of segments intersect, as segmentsIntersect(p1[i], p2[i], q1[i], q2[i]). The four orientations of each pair are computed with the filtered batch kernel, and pairs with a zero orientation are decided by the scalar test.
+@param p1 the first ends of the first segments
+@param p2 the second ends of the first segments
+@param q1 the first ends of the second segments
+@param q2 the second ends of the second segments
+@param result receives 1 for each intersecting pair and 0 otherwise; resized to the size of the smallest array
+@returns none
+*/
+	static void segmentsIntersect(const TwoVectorArray & p1, const TwoVectorArray & p2, const TwoVectorArray & q1, const TwoVectorArray & q2, std::vector<unsigned char> & result)
+	{
+		long count = std::min(std::min(p1.size(),p2.size()),std::min(q1.size(),q2.size()));
+		LINALG_COUNT(GEOMETRY_SEGMENTS_INTERSECT,43L * count,45L * count);
+		std::vector<signed char> o1, o2, o3, o4;
+		orientation(p1,p2,q1,o1);
+		orientation(p1,p2,q2,o2);
+		orientation(q1,q2,p1,o3);
+		orientation(q1,q2,p2,o4);
+		result.resize(count);
+		ThreadPool::instance().parallelFor(0,count,16384,[&](long first, long last)
+		{
+			long TcI;
+			for (TcI = first; TcI < last; TcI++)
+			{
+				if (o1[TcI] == 0 || o2[TcI] == 0 || o3[TcI] == 0 || o4[TcI] == 0)
+					result[TcI] = segmentsIntersect(p1.at(TcI),p2.at(TcI),q1.at(TcI),q2.at(TcI));
+				else
+					result[TcI] = (o1[TcI] != o2[TcI]) & (o3[TcI] != o4[TcI]);
+			}
+		});
+	}
+/**
+Compute the convex hull of a set of points. The points are split between threads, the hull of each share is found with Andrew's monotone chain, and the hull of the combined share hulls is then found the same way. Collinear points on the hull boundary are omitted.
+@param points the points
+@returns the vertices of the hull in counterclockwise order, starting from the point with the smallest x (and then y) coordinate
+*/
+	static TwoVectorArray convexHull(const TwoVectorArray & points)
+	{
+		int TcI;
+		long count = points.size();
+		LINALG_COUNT(GEOMETRY_CONVEX_HULL,20L * count,16L * count);
+		ThreadPool & pool = ThreadPool::instance();
+		int parts = count >= 65536 ? pool.size() : 1;
+		std::vector<std::vector<TwoVector> > partHulls(parts);
+		long step = (count + parts - 1) / parts;
+		pool.run(parts,[&](int part)
+		{
+			long TcJ;
+			long first = part * step;
+			long last = first + step < count ? first + step : count;
+			std::vector<TwoVector> share;
+			share.reserve(last > first ? last - first : 0);
+			for (TcJ = first; TcJ < last; TcJ++)
+				share.push_back(TwoVector(points.x()[TcJ],points.y()[TcJ]));
+			monotoneChain(share,partHulls[part]);
+		});
+		std::vector<TwoVector> combined;
+		std::vector<TwoVector> hull;
+		for (TcI = 0; TcI < parts; TcI++)
+			combined.insert(combined.end(),partHulls[TcI].begin(),partHulls[TcI].end());
+		monotoneChain(combined,hull);
+		TwoVectorArray ret((int)hull.size());
+		for (TcI = 0; TcI < (int)hull.size(); TcI++)
+			ret.setAt(TcI,hull[TcI]);
+		return ret;
+	}
+};
+
@@ -0,0 +1,229 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <OperationCounters.hpp>
+/**
+@brief A c++ implementation of a dynamically sized dense vector
+@details The dynamically sized counterpart to ThreeVector, for use with Matrix and the factorization and solver classes. Elements are stored contiguously.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class Vector
+{
+friend class Matrix;
+private:
+	std::vector<float> _data;
+public:
+	Vector(void)
+	{
+	}
+/**
+Vector constructor
+@param size The number of elements in the vector; all elements are initialized to zero
+*/
+	explicit Vector(int size)
+	{
+		if (size > 0)
+			_data.assign(size,0.0f);
+	}
+/**
+Vector constructor
+@param size The number of elements in the vector
+@param data An array of length size or greater with which to initialize the vector
+*/
+	Vector(int size, const float * data)
+	{
+		if (size > 0 && data != nullptr)
+			_data.assign(data,data + size);
+	}
+/**
+Vector constructor
+@param data An std::vector<float> with which to initialize the vector
+*/
+	Vector(const std::vector<float> &data) : _data(data)
+	{
+	}
+/**
+Get the number of elements in the vector
+@returns The number of elements
+*/
+	int size(void) const {return (int)_data.size();}
+/**
+Change the number of elements in the vector. New elements are initialized to zero.
+@param size The new number of elements
+@returns none
+*/
+	void resize(int size)
+	{
+		_data.resize(size > 0 ? size : 0,0.0f);
+	}
+/**
+Get direct access to the element storage
+@returns A pointer to the first element
+*/
+	float * data(void) {return _data.data();}
+	const float * data(void) const {return _data.data();}
+
+/**
+Retreive the value of the element at the given index, zero indexed
+@param idx the zero indexed element to retrieve
+@returns the value at the index, 0 otherwise
+*/
+	float at(int idx) const
+	{
+		if (idx >= 0 && idx < size())
+			return _data[idx];
+		else
+			return 0.0;
+	}
+/**
+Set the value of the element at the given index, zero indexed
+@param idx the zero indexed element to set
+@param value the value to insert into the vector
+@returns none
+*/
+	void setAt(int idx, float value)
+	{
+		if (idx >= 0 && idx < size())
+			_data[idx] = value;
+	}
+	float operator[] (int idx) const
+	{
+		return _data[idx];
+	}
+	float & operator[] (int idx)
+	{
+		return _data[idx];
+	}
+
+/**
+Add one vector to another. The result has the size of the smaller vector.
+@param vectB the vector to add to this vector.
+@returns a Vector with the result of the addition.
+*/
+	Vector operator +(const Vector & vectB) const
+	{
+		Vector ret(*this);
+		ret += vectB;
+		return ret;
+	}
+	Vector & operator +=(const Vector & vectB)
+	{
+		int TcI;
+		int count = size() < vectB.size() ? size() : vectB.size();
+		LINALG_COUNT(DENSE_VECTOR_UPDATE,count,12L * count);
+		_data.resize(count);
+		for (TcI = 0; TcI < count; TcI++)
+			_data[TcI] += vectB._data[TcI];
+		return *this;
+	}
+/**
+Create the additive inverse of a vector
+@returns a Vector containing the additive inverse of this vector.
+*/
+	Vector operator -(void) const
+	{
+		return *this * -1.0f;
+	}
+/**
+Subtract one vector from another. The result has the size of the smaller vector.
+@param vectB the vector to subtract from this vector.
+@returns a Vector with the result of the subtraction.
+*/
+	Vector operator -(const Vector & vectB) const
+	{
+		Vector ret(*this);
+		ret -= vectB;
+		return ret;
+	}
+	Vector & operator -=(const Vector & vectB)
+	{
+		int TcI;
+		int count = size() < vectB.size() ? size() : vectB.size();
+		LINALG_COUNT(DENSE_VECTOR_UPDATE,count,12L * count);
+		_data.resize(count);
+		for (TcI = 0; TcI < count; TcI++)
+			_data[TcI] -= vectB._data[TcI];
+		return *this;
+	}
+/**
+Scale the vector by a scalar factor
+@param scalar the factor by which to scale the vector
+@returns the scaled Vector
+*/
+	Vector operator *(float scalar) const
+	{
+		Vector ret(*this);
+		ret *= scalar;
+		return ret;
+	}
+	Vector & operator *=(float scalar)
+	{
+		int TcI;
+		int count = size();
+		LINALG_COUNT(DENSE_VECTOR_UPDATE,count,8L * count);
+		for (TcI = 0; TcI < count; TcI++)
+			_data[TcI] *= scalar;
+		return *this;
+	}
+/**
+Divide the vector by a scalar factor
+@param scalar the factor by which to divide the vector
+@returns the scaled Vector
+*/
+	Vector operator /(float scalar) const
+	{
+		return *this * (1.0 / scalar);
+	}
+	Vector & operator /=(float scalar)
+	{
+		return ((*this) *= (1.0 / scalar));
+	}
+/**
+Retrieve a scalar (dot) product for this vector: \f$\vec{a}\bullet\vec{b} = \sum_i a_i b_i\f$. Only the elements common to both vectors are used.
+@returns the dot product
+*/
+	float dot(const Vector &vectB) const
+	{
+		int TcI;
+		int count = size() < vectB.size() ? size() : vectB.size();
+		LINALG_COUNT(DENSE_VECTOR_DOT,2L * count,8L * count);
+		float sum = 0.0;
+		for (TcI = 0; TcI < count; TcI++)
+			sum += _data[TcI] * vectB._data[TcI];
+		return sum;
+	}
+/**
+Get the magnitude (length) of the vector
+@returns the magnitude of the vector \f$(\sqrt{\sum_i a_i^2})\f$
+*/
+	float magnitude(void) const
+	{
+		LINALG_COUNT(DENSE_VECTOR_DOT,2L * size() + 1,4L * size());
+		return std::sqrt(dot(*this));
+	}
+/**
+Retrieve a unit vector for this vector
+@returns the unit vector; the zero vector if this vector has zero length
+*/
+	Vector unit(void) const
+	{
+		LINALG_COUNT(DENSE_VECTOR_UPDATE,3L * size() + 2,8L * size());
+		float mag = magnitude();
+		if (mag != 0.0)
+			mag = 1.0 / mag;
+		return *this * mag;
+	}
+/**
+Load the vector with a zero vector
+@returns none
+*/
+	void loadZero(void)
+	{
+		_data.assign(_data.size(),0.0f);
+	}
+};
+
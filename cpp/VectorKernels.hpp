@@ -0,0 +1,247 @@
+#pragma once
+#include <Vector.hpp>
+#include <ThreadPool.hpp>
+#include <OperationCounters.hpp>
+/**
+@brief Fused, multithreaded Vector update kernels for the iterative solvers
+@details Each kernel performs a vector update and the dot products that depend on it in a single pass over memory, so that the solvers are limited by one read of each operand per step rather than one per operation. None of the kernels allocate memory; all vectors must already have the same size.
+@author Brian W. Mulligan
+@version 1.0.0
+@date October 2026
+@copyright MIT License
+*/
+
+class VectorKernels
+{
+private:
+	static const long GRAIN = 8192;
+
+	template <typename Body> static void sumPair(long count, const Body & body, double & sumA, double & sumB)
+	{
+		const long maxPartials = 256;
+		double partialA[maxPartials];
+		double partialB[maxPartials];
+		long TcI;
+		ThreadPool & pool = ThreadPool::instance();
+		long chunks = count / GRAIN;
+		long maxChunks = (long)pool.size() * 4;
+		if (maxChunks > maxPartials)
+			maxChunks = maxPartials;
+		if (chunks > maxChunks)
+			chunks = maxChunks;
+		if (chunks < 1)
+			chunks = 1;
+		long step = (count + chunks - 1) / chunks;
+		for (TcI = 0; TcI < chunks; TcI++)
+			partialA[TcI] = partialB[TcI] = 0.0;
+		pool.run((int)chunks,[&](int chunk)
+		{
+			long first = chunk * step;
+			long last = first + step < count ? first + step : count;
+			if (first < last)
+				body(first,last,partialA[chunk],partialB[chunk]);
+		});
+		sumA = sumB = 0.0;
+		for (TcI = 0; TcI < chunks; TcI++)
+		{
+			sumA += partialA[TcI];
+			sumB += partialB[TcI];
+		}
+	}
+public:
+/**
+Compute a dot product, \f$\vec{a}\bullet\vec{b}\f$
+@param vectA the first vector
+@param vectB the second vector
+@returns the dot product
+*/
+	static double dot(const Vector & vectA, const Vector & vectB)
+	{
+		LINALG_COUNT(KERNEL_DOT,2L * vectA.size(),8L * vectA.size());
+		const float * a = vectA.data();
+		const float * b = vectB.data();
+		return ThreadPool::instance().parallelSum(0,vectA.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			float sum = 0.0;
+#pragma omp simd reduction(+:sum)
+			for (TcI = first; TcI < last; TcI++)
+				sum += a[TcI] * b[TcI];
+			return (double)sum;
+		});
+	}
+/**
+Compute \f$\vec{y} = \vec{a} + s\vec{b}\f$ and return \f$\vec{y}\bullet\vec{y}\f$. result may be the same Vector as vectA.
+@param vectA the vector a
+@param scalar the factor s
+@param vectB the vector b
+@param result the vector y
+@returns the squared norm of the result
+*/
+	static double addScaledNorm(const Vector & vectA, float scalar, const Vector & vectB, Vector & result)
+	{
+		LINALG_COUNT(KERNEL_UPDATE,4L * vectA.size(),12L * vectA.size());
+		const float * a = vectA.data();
+		const float * b = vectB.data();
+		float * y = result.data();
+		return ThreadPool::instance().parallelSum(0,vectA.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			float sum = 0.0;
+#pragma omp simd reduction(+:sum)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				float value = a[TcI] + scalar * b[TcI];
+				y[TcI] = value;
+				sum += value * value;
+			}
+			return (double)sum;
+		});
+	}
+/**
+Perform the conjugate gradient step \f$\vec{x} \mathrel{+}= \alpha\vec{p}\f$, \f$\vec{r} \mathrel{-}= \alpha\vec{q}\f$ and return \f$\vec{r}\bullet\vec{r}\f$
+@param alpha the step length
+@param direction the search direction p
+@param product the product q of the operator with the search direction
+@param solution the solution x, updated in place
+@param residual the residual r, updated in place
+@returns the squared norm of the updated residual
+*/
+	static double stepNorm(float alpha, const Vector & direction, const Vector & product, Vector & solution, Vector & residual)
+	{
+		LINALG_COUNT(KERNEL_UPDATE,6L * solution.size(),24L * solution.size());
+		const float * p = direction.data();
+		const float * q = product.data();
+		float * x = solution.data();
+		float * r = residual.data();
+		return ThreadPool::instance().parallelSum(0,solution.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+			float sum = 0.0;
+#pragma omp simd reduction(+:sum)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				x[TcI] += alpha * p[TcI];
+				float value = r[TcI] - alpha * q[TcI];
+				r[TcI] = value;
+				sum += value * value;
+			}
+			return (double)sum;
+		});
+	}
+/**
+Compute \f$\vec{p} = \vec{z} + \beta\vec{p}\f$
+@param vectZ the vector z
+@param beta the factor applied to p
+@param direction the vector p, updated in place
+@returns none
+*/
+	static void scaleAdd(const Vector & vectZ, float beta, Vector & direction)
+	{
+		LINALG_COUNT(KERNEL_UPDATE,2L * direction.size(),12L * direction.size());
+		const float * z = vectZ.data();
+		float * p = direction.data();
+		ThreadPool::instance().parallelFor(0,direction.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				p[TcI] = z[TcI] + beta * p[TcI];
+		});
+	}
+/**
+Compute the BiCGSTAB search direction \f$\vec{p} = \vec{r} + \beta(\vec{p} - \omega\vec{v})\f$
+@param residual the residual r
+@param beta the factor beta
+@param omega the factor omega
+@param vectV the vector v
+@param direction the vector p, updated in place
+@returns none
+*/
+	static void bicgDirection(const Vector & residual, float beta, float omega, const Vector & vectV, Vector & direction)
+	{
+		LINALG_COUNT(KERNEL_UPDATE,4L * direction.size(),16L * direction.size());
+		const float * r = residual.data();
+		const float * v = vectV.data();
+		float * p = direction.data();
+		ThreadPool::instance().parallelFor(0,direction.size(),GRAIN,[&](long first, long last)
+		{
+			long TcI;
+#pragma omp simd
+			for (TcI = first; TcI < last; TcI++)
+				p[TcI] = r[TcI] + beta * (p[TcI] - omega * v[TcI]);
+		});
+	}
+/**
+Compute \f$\vec{a}\bullet\vec{b}\f$ and \f$\vec{a}\bullet\vec{a}\f$ in one pass
+@param vectA the vector a
+@param vectB the vector b
+@param dotAB receives \f$\vec{a}\bullet\vec{b}\f$
+@param dotAA receives \f$\vec{a}\bullet\vec{a}\f$
+@returns none
+*/
+	static void dotPair(const Vector & vectA, const Vector & vectB, double & dotAB, double & dotAA)
+	{
+		LINALG_COUNT(KERNEL_DOT,4L * vectA.size(),8L * vectA.size());
+		const float * a = vectA.data();
+		const float * b = vectB.data();
+		sumPair(vectA.size(),[&](long first, long last, double & sumAB, double & sumAA)
+		{
+			long TcI;
+			float ab = 0.0;
+			float aa = 0.0;
+#pragma omp simd reduction(+:ab,aa)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				ab += a[TcI] * b[TcI];
+				aa += a[TcI] * a[TcI];
+			}
+			sumAB = ab;
+			sumAA = aa;
+		},dotAB,dotAA);
+	}
+/**
+Perform the final BiCGSTAB update of an iteration: \f$\vec{x} \mathrel{+}= \alpha\hat{p} + \omega\hat{s}\f$, \f$\vec{r} = \vec{s} - \omega\vec{t}\f$, returning \f$\vec{r}\bullet\vec{r}\f$ and \f$\hat{r}_0\bullet\vec{r}\f$
+@param alpha the factor alpha
+@param directionHat the preconditioned search direction
+@param omega the factor omega
+@param vectSHat the preconditioned intermediate residual
+@param vectS the intermediate residual s
+@param vectT the vector t
+@param shadow the shadow residual
+@param solution the solution x, updated in place
+@param residual receives the new residual r
+@param residualNorm receives \f$\vec{r}\bullet\vec{r}\f$
+@param shadowDot receives \f$\hat{r}_0\bullet\vec{r}\f$
+@returns none
+*/
+	static void bicgUpdate(float alpha, const Vector & directionHat, float omega, const Vector & vectSHat, const Vector & vectS, const Vector & vectT, const Vector & shadow, Vector & solution, Vector & residual, double & residualNorm, double & shadowDot)
+	{
+		LINALG_COUNT(KERNEL_UPDATE,10L * solution.size(),36L * solution.size());
+		const float * ph = directionHat.data();
+		const float * sh = vectSHat.data();
+		const float * s = vectS.data();
+		const float * t = vectT.data();
+		const float * r0 = shadow.data();
+		float * x = solution.data();
+		float * r = residual.data();
+		sumPair(solution.size(),[&](long first, long last, double & sumRR, double & sumR0R)
+		{
+			long TcI;
+			float rr = 0.0;
+			float r0r = 0.0;
+#pragma omp simd reduction(+:rr,r0r)
+			for (TcI = first; TcI < last; TcI++)
+			{
+				x[TcI] += alpha * ph[TcI] + omega * sh[TcI];
+				float value = s[TcI] - omega * t[TcI];
+				r[TcI] = value;
+				rr += value * value;
+				r0r += r0[TcI] * value;
+			}
+			sumRR = rr;
+			sumR0R = r0r;
+		},residualNorm,shadowDot);
+	}
+};
+
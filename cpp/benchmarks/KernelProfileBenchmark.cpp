@@ -0,0 +1,49 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <AccuracyHarness.hpp>
+#include <KernelProfiler.hpp>
+
+/**
+Profile the matrix-vector transforms, normalization, inverse and dot product reduction with the entry points of KernelProfiler, and print the latency percentiles, bandwidth and, where the hardware counters are available, the instructions and bytes per cycle of each. Every kernel is called 200 times on \f$2^{20}\f$ elements, which come from memory and are split between the threads of the pool.
+
+A kernel near the bandwidth of the machine with few instructions per cycle is limited by memory, so packing its data more tightly would speed it up and more arithmetic would not.
+@returns zero
+*/
+int main(void)
+{
+	const int COUNT = 1 << 20;
+	const int CALLS = 200;
+	int TcI;
+	AccuracyHarness harness(1,1);
+	ThreeVectorArray vectorArray;
+	ThreeMatrixArray matrixArray;
+	TwoMatrixArray twoMatrices,inverses;
+	std::vector<float> a,b;
+	std::vector<unsigned char> singular;
+	harness.generate(vectorArray,COUNT,AccuracyHarness::UNIFORM);
+	harness.generate(matrixArray,COUNT,AccuracyHarness::UNIFORM);
+	harness.generate(twoMatrices,COUNT,AccuracyHarness::UNIFORM);
+	harness.generate(a,COUNT,AccuracyHarness::UNIFORM);
+	harness.generate(b,COUNT,AccuracyHarness::UNIFORM);
+	ThreeVectorTiles vectors,result;
+	ThreeMatrixTiles matrices;
+	vectors.load(vectorArray);
+	matrices.load(matrixArray);
+	Vector vectA(a),vectB(b);
+	ThreeMatrix rotation = matrixArray.at(0);
+	KernelProfiler profiler;
+	double sum = 0.0;
+	for (TcI = 0; TcI < CALLS; TcI++)
+	{
+		profiler.transform(matrices,vectors,result);
+		profiler.transform(rotation,vectors,result);
+		profiler.normalize(result);
+		profiler.invert(twoMatrices,inverses,singular);
+		sum += profiler.dot(vectA,vectB);
+	}
+	std::printf("%s",profiler.report().c_str());
+	// the sum keeps the dot products from being optimized away
+	std::printf("%d calls of each kernel on %d elements, dot product total %g\n",CALLS,COUNT,sum);
+	return 0;
+}
@@ -0,0 +1,202 @@
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <AccuracyHarness.hpp>
+#include <RayTriangle.hpp>
+
+// the exact Moller-Trumbore test in long double, for the float origin, direction and vertices; fills result with the distance and the barycentric coordinates, or NaN for a miss
+static void exactHit(const ThreeVector & origin, const ThreeVector & direction, const ThreeVector & vertex0, const ThreeVector & vertex1, const ThreeVector & vertex2, long double result[3])
+{
+	int TcI;
+	long double o[3],d[3],e1[3],e2[3],p[3],t[3],q[3];
+	for (TcI = 0; TcI < 3; TcI++)
+	{
+		o[TcI] = origin[TcI];
+		d[TcI] = direction[TcI];
+		e1[TcI] = (long double)vertex1[TcI] - vertex0[TcI];
+		e2[TcI] = (long double)vertex2[TcI] - vertex0[TcI];
+		t[TcI] = o[TcI] - vertex0[TcI];
+	}
+	for (TcI = 0; TcI < 3; TcI++)
+	{
+		p[TcI] = d[(TcI + 1) % 3] * e2[(TcI + 2) % 3] - d[(TcI + 2) % 3] * e2[(TcI + 1) % 3];
+		q[TcI] = t[(TcI + 1) % 3] * e1[(TcI + 2) % 3] - t[(TcI + 2) % 3] * e1[(TcI + 1) % 3];
+	}
+	long double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+	long double u = (t[0] * p[0] + t[1] * p[1] + t[2] * p[2]) / det;
+	long double v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+	long double distance = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+	bool hit = det != 0.0L && u >= 0.0L && v >= 0.0L && u + v <= 1.0L && distance > 0.0L;
+	result[0] = hit ? distance : std::numeric_limits<long double>::quiet_NaN();
+	result[1] = hit ? u : std::numeric_limits<long double>::quiet_NaN();
+	result[2] = hit ? v : std::numeric_limits<long double>::quiet_NaN();
+}
+
+/**
+Compare the throughput and accuracy of the Moller-Trumbore test computed one ray and one triangle at a time by RayTriangle::intersect, on ThreeVector, and by the packet kernels, in structure of arrays form, with W of 8 and 16.
+
+Rays against one triangle: 16384 rays, each aimed at a point of the plane of a unit triangle chosen at random inside it or outside it, away from its edges, so that about half hit and every kernel agrees on which. The rays are tested one at a time, in prebuilt RayPacket, one ray per SIMD lane, and as a stream by RayTriangle::intersectStream, which reads the ThreeVectorArray of the rays directly and splits the packets between the threads of the pool once there are more than 256 of them.
+
+One ray against many triangles: each of 64 rays finds the closest of 1024 random triangles stacked in front of it, one triangle at a time and with RayTriangle::closestHit over TrianglePacket, one triangle per lane.
+
+The distances and barycentric coordinates are measured in ulp of the larger of the exact result and the size of the scene, which is one; a miss is NaN and must be a miss in the exact test as well.
+@returns zero
+*/
+int main(void)
+{
+	const int RAYS = 16384;
+	const int PROBES = 64;
+	const int TRIANGLES = 1024;
+	const float MISS = std::numeric_limits<float>::quiet_NaN();
+	int TcI,TcJ;
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<float> uniform(-1.0f,1.0f);
+	AccuracyHarness harness(1,100);
+	ThreeVector vertex0(0.0f,0.0f,0.0f),vertex1(1.0f,0.0f,0.0f),vertex2(0.0f,1.0f,0.0f);
+
+	std::vector<ThreeVector> origins(RAYS),directions(RAYS);
+	ThreeVectorArray originArray(RAYS),directionArray(RAYS);
+	std::vector<RayPacket<8> > rays8(RAYS / 8);
+	std::vector<RayPacket<16> > rays16(RAYS / 16);
+	std::vector<HitPacket<8> > hits8(RAYS / 8);
+	std::vector<HitPacket<16> > hits16(RAYS / 16);
+	std::vector<long double> exact(3L * RAYS);
+	for (TcI = 0; TcI < RAYS; TcI++)
+	{
+		float u,v;
+		// keep the target a tenth of the triangle from every edge, inside or outside
+		do
+		{
+			u = 0.75f * uniform(generator) + 0.5f;
+			v = 0.75f * uniform(generator) + 0.5f;
+		}
+		while ((u > -0.1f && u < 0.1f) || (v > -0.1f && v < 0.1f) || (u + v > 0.9f && u + v < 1.1f));
+		origins[TcI] = ThreeVector(uniform(generator),uniform(generator),1.5f + 0.5f * uniform(generator));
+		directions[TcI] = ThreeVector(u,v,0.0f) - origins[TcI];
+		originArray.setAt(TcI,origins[TcI]);
+		directionArray.setAt(TcI,directions[TcI]);
+		rays8[TcI / 8].setRay(TcI % 8,origins[TcI],directions[TcI]);
+		rays16[TcI / 16].setRay(TcI % 16,origins[TcI],directions[TcI]);
+		exactHit(origins[TcI],directions[TcI],vertex0,vertex1,vertex2,&exact[3L * TcI]);
+	}
+	auto expected = [&](long idx, int component) {return AccuracyHarness::Expected(exact[3L * idx + component],1.0L);};
+
+	std::vector<unsigned char> hit(RAYS);
+	std::vector<float> distance(RAYS),u(RAYS),v(RAYS);
+	auto stream = [&](long idx, int component)
+	{
+		const std::vector<float> & result = component == 0 ? distance : (component == 1 ? u : v);
+		return hit[idx] ? result[idx] : MISS;
+	};
+	double scalar = harness.measure("RayTriangle::intersect, rays against one triangle",RAYS,3,[&]()
+	{
+		int TcK;
+		for (TcK = 0; TcK < RAYS; TcK++)
+			hit[TcK] = RayTriangle::intersect(origins[TcK],directions[TcK],vertex0,vertex1,vertex2,0.0f,1.0e30f,distance[TcK],u[TcK],v[TcK]);
+	},stream,expected).elementsPerSecond;
+	double packet8 = harness.measure("RayTriangle::intersect<8>, RayPacket",RAYS,3,[&]()
+	{
+		size_t TcK;
+		for (TcK = 0; TcK < rays8.size(); TcK++)
+			RayTriangle::intersect(rays8[TcK],vertex0,vertex1,vertex2,0.0f,1.0e30f,hits8[TcK]);
+	},[&](long idx, int component)
+	{
+		const HitPacket<8> & result = hits8[idx / 8];
+		const float * value = component == 0 ? result.distance : (component == 1 ? result.u : result.v);
+		return (result.mask >> (idx % 8)) & 1 ? value[idx % 8] : MISS;
+	},expected).elementsPerSecond;
+	double packet16 = harness.measure("RayTriangle::intersect<16>, RayPacket",RAYS,3,[&]()
+	{
+		size_t TcK;
+		for (TcK = 0; TcK < rays16.size(); TcK++)
+			RayTriangle::intersect(rays16[TcK],vertex0,vertex1,vertex2,0.0f,1.0e30f,hits16[TcK]);
+	},[&](long idx, int component)
+	{
+		const HitPacket<16> & result = hits16[idx / 16];
+		const float * value = component == 0 ? result.distance : (component == 1 ? result.u : result.v);
+		return (result.mask >> (idx % 16)) & 1 ? value[idx % 16] : MISS;
+	},expected).elementsPerSecond;
+	double stream8 = harness.measure("RayTriangle::intersectStream<8>",RAYS,3,[&]() {RayTriangle::intersectStream<8>(originArray,directionArray,vertex0,vertex1,vertex2,0.0f,1.0e30f,hit,distance,u,v);},stream,expected).elementsPerSecond;
+	double stream16 = harness.measure("RayTriangle::intersectStream<16>",RAYS,3,[&]() {RayTriangle::intersectStream<16>(originArray,directionArray,vertex0,vertex1,vertex2,0.0f,1.0e30f,hit,distance,u,v);},stream,expected).elementsPerSecond;
+
+	// the triangles lie across the rays at depths from 1 to 5, tilted by up to a tenth, so that each ray passes through many of them
+	std::vector<ThreeVector> probeOrigins(PROBES),probeDirections(PROBES),corners(3 * TRIANGLES);
+	std::vector<TrianglePacket<8> > triangles8(TRIANGLES / 8);
+	std::vector<TrianglePacket<16> > triangles16(TRIANGLES / 16);
+	std::vector<long double> closest(3L * PROBES);
+	for (TcI = 0; TcI < PROBES; TcI++)
+	{
+		probeOrigins[TcI] = ThreeVector(0.5f * uniform(generator),0.5f * uniform(generator),0.0f);
+		probeDirections[TcI] = ThreeVector(0.1f * uniform(generator),0.1f * uniform(generator),-1.0f);
+	}
+	for (TcI = 0; TcI < TRIANGLES; TcI++)
+	{
+		float depth = -3.0f + 2.0f * uniform(generator);
+		for (TcJ = 0; TcJ < 3; TcJ++)
+			corners[3 * TcI + TcJ] = ThreeVector(1.5f * uniform(generator),1.5f * uniform(generator),depth + 0.1f * uniform(generator));
+		triangles8[TcI / 8].setTriangle(TcI % 8,corners[3 * TcI],corners[3 * TcI + 1],corners[3 * TcI + 2]);
+		triangles16[TcI / 16].setTriangle(TcI % 16,corners[3 * TcI],corners[3 * TcI + 1],corners[3 * TcI + 2]);
+	}
+	for (TcI = 0; TcI < PROBES; TcI++)
+	{
+		closest[3L * TcI] = closest[3L * TcI + 1] = closest[3L * TcI + 2] = std::numeric_limits<long double>::quiet_NaN();
+		for (TcJ = 0; TcJ < TRIANGLES; TcJ++)
+		{
+			long double result[3];
+			exactHit(probeOrigins[TcI],probeDirections[TcI],corners[3 * TcJ],corners[3 * TcJ + 1],corners[3 * TcJ + 2],result);
+			if (!std::isnan(result[0]) && !(result[0] >= closest[3L * TcI]))
+			{
+				closest[3L * TcI] = result[0];
+				closest[3L * TcI + 1] = result[1];
+				closest[3L * TcI + 2] = result[2];
+			}
+		}
+	}
+	std::vector<long> nearest(PROBES);
+	std::vector<float> nearestDistance(PROBES),nearestU(PROBES),nearestV(PROBES);
+	auto closestValue = [&](long idx, int component)
+	{
+		const std::vector<float> & result = component == 0 ? nearestDistance : (component == 1 ? nearestU : nearestV);
+		return nearest[idx] >= 0 ? result[idx] : MISS;
+	};
+	auto closestExpected = [&](long idx, int component) {return AccuracyHarness::Expected(closest[3L * idx + component],1.0L);};
+	double scalarClosest = harness.measure("RayTriangle::intersect, closest of 1024 triangles",(long)PROBES * TRIANGLES,3,[&]()
+	{
+		int TcK,TcL;
+		for (TcK = 0; TcK < PROBES; TcK++)
+		{
+			float tMax = 1.0e30f, t, tu, tv;
+			nearest[TcK] = -1;
+			for (TcL = 0; TcL < TRIANGLES; TcL++)
+			{
+				if (RayTriangle::intersect(probeOrigins[TcK],probeDirections[TcK],corners[3 * TcL],corners[3 * TcL + 1],corners[3 * TcL + 2],0.0f,tMax,t,tu,tv))
+				{
+					tMax = nearestDistance[TcK] = t;
+					nearestU[TcK] = tu;
+					nearestV[TcK] = tv;
+					nearest[TcK] = TcL;
+				}
+			}
+		}
+	},[&](long idx, int component) {return closestValue(idx / TRIANGLES,component);},[&](long idx, int component) {return closestExpected(idx / TRIANGLES,component);}).elementsPerSecond;
+	double closest8 = harness.measure("RayTriangle::closestHit<8>, TrianglePacket",(long)PROBES * TRIANGLES,3,[&]()
+	{
+		int TcK;
+		for (TcK = 0; TcK < PROBES; TcK++)
+			nearest[TcK] = RayTriangle::closestHit(probeOrigins[TcK],probeDirections[TcK],triangles8,0.0f,1.0e30f,nearestDistance[TcK],nearestU[TcK],nearestV[TcK]);
+	},[&](long idx, int component) {return closestValue(idx / TRIANGLES,component);},[&](long idx, int component) {return closestExpected(idx / TRIANGLES,component);}).elementsPerSecond;
+	double closest16 = harness.measure("RayTriangle::closestHit<16>, TrianglePacket",(long)PROBES * TRIANGLES,3,[&]()
+	{
+		int TcK;
+		for (TcK = 0; TcK < PROBES; TcK++)
+			nearest[TcK] = RayTriangle::closestHit(probeOrigins[TcK],probeDirections[TcK],triangles16,0.0f,1.0e30f,nearestDistance[TcK],nearestU[TcK],nearestV[TcK]);
+	},[&](long idx, int component) {return closestValue(idx / TRIANGLES,component);},[&](long idx, int component) {return closestExpected(idx / TRIANGLES,component);}).elementsPerSecond;
+
+	std::printf("%s",harness.report().c_str());
+	std::printf("rays against one triangle: packets of 8 %.2f, packets of 16 %.2f, streams of 8 %.2f, streams of 16 %.2f times the scalar test\n",scalar > 0.0 ? packet8 / scalar : 0.0,scalar > 0.0 ? packet16 / scalar : 0.0,scalar > 0.0 ? stream8 / scalar : 0.0,scalar > 0.0 ? stream16 / scalar : 0.0);
+	std::printf("one ray against many triangles: packets of 8 %.2f, packets of 16 %.2f times the scalar test\n",scalarClosest > 0.0 ? closest8 / scalarClosest : 0.0,scalarClosest > 0.0 ? closest16 / scalarClosest : 0.0);
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <AccuracyHarness.hpp>
+
+// decomposes every matrix of a with ThreeMatrixSVD::compute, W matrices at a time, on the calling thread; u, sigma and v must have the size of a
+template <int W> void decompose(const ThreeMatrixArray & a, ThreeMatrixArray & u, ThreeVectorArray & sigma, ThreeMatrixArray & v)
+{
+	long TcI;
+	int TcJ,TcK;
+	float packet[3][3][W];
+	float left[3][3][W];
+	float values[3][W];
+	float right[3][3][W];
+	float * sigmaOut[3] = {sigma.x(),sigma.y(),sigma.z()};
+	for (TcI = 0; TcI < a.size(); TcI += W)
+	{
+		int count = a.size() - TcI < W ? (int)(a.size() - TcI) : W;
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				const float * source = a.element(TcJ,TcK) + TcI;
+				std::copy(source,source + count,packet[TcJ][TcK]);
+				std::fill(packet[TcJ][TcK] + count,packet[TcJ][TcK] + W,0.0f);
+			}
+		}
+		ThreeMatrixSVD::compute<W>(packet,left,values,right);
+		for (TcJ = 0; TcJ < 3; TcJ++)
+		{
+			for (TcK = 0; TcK < 3; TcK++)
+			{
+				std::copy(left[TcJ][TcK],left[TcJ][TcK] + count,u.element(TcJ,TcK) + TcI);
+				std::copy(right[TcJ][TcK],right[TcJ][TcK] + count,v.element(TcJ,TcK) + TcI);
+			}
+			std::copy(values[TcJ],values[TcJ] + count,sigmaOut[TcJ] + TcI);
+		}
+	}
+}
+
+/**
+Compare the throughput and accuracy of the singular value decomposition of 3x3 matrices computed one matrix at a time by ThreeMatrixSVD and in packets of 8 and 16 matrices, one matrix per SIMD lane, by ThreeMatrixSVD::compute, on each kind of input of AccuracyHarness. The packets are decomposed on one thread, as is the scalar decomposition, so that the comparison is of one core; ThreeMatrixArray::singularValueDecomposition, which decomposes packets of 16 and would split more matrices between the threads of the pool, is timed as well. The singular values, and the elements of \f$U \Sigma V^T\f$ formed exactly from the float factors, are measured in ulp of the largest exact singular value, as in AccuracyHarness::qualify.
+
+The same selects are computed in every lane, so the packets give the scalar results, up to the contraction of multiplies and adds into fused ones, which the compiler may do differently in the vectorized and the scalar code.
+@returns zero
+*/
+int main(void)
+{
+	const int COUNT = 16384;
+	int TcI,TcJ;
+	for (TcI = AccuracyHarness::UNIFORM; TcI <= AccuracyHarness::NEAR_SINGULAR; TcI++)
+	{
+		AccuracyHarness::Inputs inputs = (AccuracyHarness::Inputs)TcI;
+		std::string suffix = std::string(" (") + AccuracyHarness::name(inputs) + ")";
+		AccuracyHarness harness(1,10);
+		ThreeMatrixArray general,left(COUNT),right(COUNT);
+		ThreeVectorArray sigma(COUNT);
+		harness.generate(general,COUNT,inputs);
+		std::vector<ThreeMatrix> matrices(COUNT),scalarLeft(COUNT),scalarRight(COUNT);
+		std::vector<ThreeVector> scalarSigma(COUNT);
+		std::vector<long double> values(3L * COUNT);
+		for (TcJ = 0; TcJ < COUNT; TcJ++)
+		{
+			matrices[TcJ] = general.at(TcJ);
+			AccuracyHarness::singularValues(matrices[TcJ],&values[3L * TcJ]);
+		}
+		auto exactSingular = [&](long idx, int component) {return AccuracyHarness::Expected(values[3L * idx + component],values[3L * idx]);};
+		auto exactProduct = [&](long idx, int component) {return AccuracyHarness::Expected(general.element(component / 3,component % 3)[idx],values[3L * idx]);};
+		auto singular = [&](long idx, int component) {return sigma.at((int)idx)[component];};
+		auto product = [&](long idx, int component)
+		{
+			int row = component / 3, column = component % 3, TcK;
+			long double sum = 0.0L;
+			for (TcK = 0; TcK < 3; TcK++)
+				sum += (long double)left.element(row,TcK)[idx] * sigma.at((int)idx)[TcK] * right.element(column,TcK)[idx];
+			return (float)sum;
+		};
+		auto scalarDecomposition = [&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < COUNT; TcK++)
+			{
+				ThreeMatrixSVD svd(matrices[TcK]);
+				scalarLeft[TcK] = svd.u();
+				scalarRight[TcK] = svd.v();
+				scalarSigma[TcK] = svd.singularValues();
+			}
+		};
+		auto scalarSingular = [&](long idx, int component) {return scalarSigma[idx][component];};
+		auto scalarProduct = [&](long idx, int component)
+		{
+			int row = component / 3, column = component % 3, TcK;
+			long double sum = 0.0L;
+			for (TcK = 0; TcK < 3; TcK++)
+				sum += (long double)scalarLeft[idx].at(row,TcK) * scalarSigma[idx][TcK] * scalarRight[idx].at(column,TcK);
+			return (float)sum;
+		};
+		double scalar = harness.measure("ThreeMatrixSVD, one matrix at a time" + suffix,COUNT,3,scalarDecomposition,scalarSingular,exactSingular).elementsPerSecond;
+		harness.measure("ThreeMatrixSVD, one matrix at a time, U Sigma V^T" + suffix,COUNT,9,scalarDecomposition,scalarProduct,exactProduct);
+		double eight = harness.measure("ThreeMatrixSVD::compute<8>" + suffix,COUNT,3,[&]() {decompose<8>(general,left,sigma,right);},singular,exactSingular).elementsPerSecond;
+		harness.measure("ThreeMatrixSVD::compute<8>, U Sigma V^T" + suffix,COUNT,9,[&]() {decompose<8>(general,left,sigma,right);},product,exactProduct);
+		double sixteen = harness.measure("ThreeMatrixSVD::compute<16>" + suffix,COUNT,3,[&]() {decompose<16>(general,left,sigma,right);},singular,exactSingular).elementsPerSecond;
+		harness.measure("ThreeMatrixSVD::compute<16>, U Sigma V^T" + suffix,COUNT,9,[&]() {decompose<16>(general,left,sigma,right);},product,exactProduct);
+		double pool = harness.measure("ThreeMatrixArray::singularValueDecomposition" + suffix,COUNT,3,[&]() {general.singularValueDecomposition(left,sigma,right);},singular,exactSingular).elementsPerSecond;
+		harness.measure("ThreeMatrixArray::singularValueDecomposition, U Sigma V^T" + suffix,COUNT,9,[&]() {general.singularValueDecomposition(left,sigma,right);},product,exactProduct);
+		std::printf("%s",harness.report().c_str());
+		std::printf("%s: packets of 8 %.2f, packets of 16 %.2f, ThreeMatrixArray %.2f times the scalar decomposition\n\n",AccuracyHarness::name(inputs),scalar > 0.0 ? eight / scalar : 0.0,scalar > 0.0 ? sixteen / scalar : 0.0,scalar > 0.0 ? pool / scalar : 0.0);
+	}
+	return 0;
+}
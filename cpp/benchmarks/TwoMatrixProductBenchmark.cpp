@@ -0,0 +1,61 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <AccuracyHarness.hpp>
+/**
+Compare the throughput of the 2x2 matrix product, \f$C_i = A_i B_i\f$, computed one matrix at a time with TwoMatrix::operator * and in bulk with TwoMatrixArray::loadProduct, which reads and writes the four element arrays as contiguous streams, one matrix per SIMD lane. The scalar product is timed over an array of TwoMatrix, as a program without the batched kernel would store its matrices, and through TwoMatrixArray::at and setAt, which gathers each matrix from the element arrays. Every product is also checked against the exact product, in ulp of the sum of the magnitudes of its terms, so that the kernels are compared at the same accuracy.
+
+The products are timed on 512 matrices, which fit in the first level cache, on 16384, which fit in the second level cache, both computed by one thread, and on \f$2^{20}\f$, which are split between the threads of the pool and come from memory. The batched product is limited by arithmetic only in the first level cache, where it is about twice as fast as the array of TwoMatrix. Beyond it, both products are limited by the rate at which the same bytes arrive, and the twelve streams of the batched product are prefetched less well than the three of the array of TwoMatrix, so it is slower from the second level cache and about as fast from memory. Either is many times faster than gathering the matrices.
+@returns zero
+*/
+int main(void)
+{
+	const int SIZES[3] = {512,16384,1 << 20};
+	int TcI,TcJ;
+	for (TcI = 0; TcI < 3; TcI++)
+	{
+		int count = SIZES[TcI];
+		// the fastest of many runs of the small sizes, which take a few microseconds
+		AccuracyHarness harness(1,count <= 16384 ? 1000 : 20);
+		int threads = count > 16384 ? ThreadPool::instance().size() : 1;
+		std::string suffix = " (" + std::to_string(count) + " matrices, " + std::to_string(threads) + (threads > 1 ? " threads)" : " thread)");
+		TwoMatrixArray a,b,c(count);
+		harness.generate(a,count,AccuracyHarness::UNIFORM);
+		harness.generate(b,count,AccuracyHarness::UNIFORM);
+		std::vector<TwoMatrix> left(count),right(count),product(count);
+		for (TcJ = 0; TcJ < count; TcJ++)
+		{
+			left[TcJ] = a.at(TcJ);
+			right[TcJ] = b.at(TcJ);
+		}
+		auto exact = [&](long idx, int component)
+		{
+			int row = component / 2, column = component % 2, TcK;
+			long double sum = 0.0L, size = 0.0L;
+			for (TcK = 0; TcK < 2; TcK++)
+			{
+				long double term = (long double)a.element(row,TcK)[idx] * b.element(TcK,column)[idx];
+				sum += term;
+				size += std::fabs(term);
+			}
+			return AccuracyHarness::Expected(sum,size);
+		};
+		double scalar = harness.measure("TwoMatrix::operator*, array of TwoMatrix" + suffix,count,4,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				product[TcK] = left[TcK] * right[TcK];
+		},[&](long idx, int component) {return product[idx].at(component / 2,component % 2);},exact).elementsPerSecond;
+		double gathered = harness.measure("TwoMatrix::operator*, through TwoMatrixArray::at" + suffix,count,4,[&]()
+		{
+			int TcK;
+			for (TcK = 0; TcK < count; TcK++)
+				c.setAt(TcK,a.at(TcK) * b.at(TcK));
+		},[&](long idx, int component) {return c.element(component / 2,component % 2)[idx];},exact).elementsPerSecond;
+		double batched = harness.measure("TwoMatrixArray::loadProduct" + suffix,count,4,[&]() {c.loadProduct(a,b);},[&](long idx, int component) {return c.element(component / 2,component % 2)[idx];},exact).elementsPerSecond;
+		std::printf("%s",harness.report().c_str());
+		std::printf("loadProduct on %d matrices: %.2f times the array of TwoMatrix, %.2f times the gathered product\n\n",count,scalar > 0.0 ? batched / scalar : 0.0,gathered > 0.0 ? batched / gathered : 0.0);
+	}
+	return 0;
+}
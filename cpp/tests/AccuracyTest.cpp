@@ -0,0 +1,14 @@
+#include <cstdio>
+#include <AccuracyHarness.hpp>
+/**
+Qualify the library's kernels with AccuracyHarness::qualify and print the report. Each kernel is run once, since only the accuracy is checked here.
+@returns zero if every kernel met its documented bounds and every expected failure still failed, one otherwise
+*/
+int main(void)
+{
+	AccuracyHarness harness(1,1);
+	bool passed = harness.qualify();
+	std::printf("%s",harness.report().c_str());
+	std::printf("%s\n",passed ? "passed" : "FAILED");
+	return passed ? 0 : 1;
+}